@@ -99,6 +99,8 @@ void BuiltinRes::initialize(graph::ShaderGraph& shaderGraph, rhi::DevicePtr devi
 
     cmdBuffer->commit();
     queue->submit(false);
+    // the pool goes out of scope, so the uploads have to be done
+    device->waitQueueIdle(queue);
 }
 
 const Skybox& BuiltinRes::skybox() {
@@ -58,7 +58,6 @@ Quad::Quad(rhi::CommandBufferPtr cmdBuffer, rhi::DevicePtr device) {
     for (size_t i = 0; i < embededTechSize; ++i) {
         meshRenderer->addTechnique(scene::makeEmbededTechnique(static_cast<scene::EmbededTechnique>(i)));
     }
-    meshRenderer->setTransformSlot("LocalMat");
 }
 
 scene::ModelPtr Quad::model() const {
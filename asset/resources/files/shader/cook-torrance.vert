@@ -15,10 +15,13 @@ layout(set = 0, binding = 0) uniform Mat {
     mat4 projectMat;
 };
 
-layout(set = 2, binding = 0) uniform LocalMat {
-    mat4 modelMat;
+// one transform per object, draws carry the object index in firstInstance
+layout(set = 3, binding = 0) readonly buffer ObjectData {
+    mat4 objectMats[];
 };
 
+#define modelMat objectMats[gl_InstanceIndex]
+
 void main () {
     f_uv = v_uv;
 #ifdef VERTEX_TANGENT
@@ -9,10 +9,13 @@ layout(set = 0, binding = 0) uniform Mat {
     mat4 projectMat;
 };
 
-layout(set = 2, binding = 0) uniform LocalMat {
-    mat4 modelMat;
+// one transform per object, draws carry the object index in firstInstance
+layout(set = 3, binding = 0) readonly buffer ObjectData {
+    mat4 objectMats[];
 };
 
+#define modelMat objectMats[gl_InstanceIndex]
+
 void main () {
     vec4 worldPos = modelMat * vec4(aPos, 1.0);
     f_worldPos = worldPos.xyz / worldPos.w;
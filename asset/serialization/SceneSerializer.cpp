@@ -1,4 +1,6 @@
 #include "SceneSerializer.h"
+#include <cstring>
+#include <meshoptimizer.h>
 #include <numeric>
 #include "BuiltinRes.h"
 #include "Mesh.h"
@@ -10,6 +12,7 @@
 #include "core/define.h"
 #include "core/thread/execution.h"
 #include "core/utils/containers.h"
+#include "core/utils/Trace.h"
 
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -41,10 +44,51 @@ void serialize(Archive& ar, raum::scene::AABB& aabb) {
     ar(aabb.minBound, aabb.maxBound);
 }
 
+template <class Archive>
+void serialize(Archive& ar, raum::scene::MeshLod& lod) {
+    ar(lod.firstIndex, lod.indexCount, lod.error);
+}
+
+template <class Archive>
+void serialize(Archive& ar, raum::scene::Meshlet& meshlet) {
+    ar(meshlet.center, meshlet.radius, meshlet.coneApex, meshlet.coneCutoff, meshlet.coneAxis);
+    ar(meshlet.firstIndex, meshlet.vertexOffset, meshlet.triangleOffset, meshlet.vertexCount, meshlet.triangleCount);
+}
+
 } // namespace cereal
 
 namespace raum::asset::serialize {
 
+namespace {
+
+// bump when the layout of any cached file changes, caches of another version are preprocessed again.
+// 2: mesh lods, 3: meshlets
+constexpr uint32_t CACHE_VERSION = 3;
+
+std::filesystem::path cacheVersionPath(const std::filesystem::path& cachePath) {
+    return cachePath / "version";
+}
+
+bool cacheValid(const std::filesystem::path& cachePath) {
+    const auto versionPath = cacheVersionPath(cachePath);
+    if (!std::filesystem::exists(versionPath)) {
+        return false;
+    }
+    uint32_t version{0};
+    InputArchive ar(versionPath);
+    ar >> version;
+    return version == CACHE_VERSION;
+}
+
+// written last, an interrupted preprocess leaves no version and runs again.
+void writeCacheVersion(const std::filesystem::path& cachePath) {
+    std::filesystem::create_directories(cachePath);
+    OutputArchive ar(cacheVersionPath(cachePath));
+    ar << CACHE_VERSION;
+}
+
+} // namespace
+
 void loadTexture(
     std::string_view name,
     uint32_t width,
@@ -139,6 +183,7 @@ void loadTexture(
 
 void texturePreprocess(const std::filesystem::path& cachePath,
                        const tinygltf::Model& rawModel) {
+    RAUM_TRACE_SCOPE("SceneSerializer::texturePreprocess");
     auto texCachePath = cachePath / "textures";
     const auto& mats = rawModel.materials;
     uint32_t count{0};
@@ -165,6 +210,7 @@ void materialPreprocess(
     const std::filesystem::path& cachePath,
     const tinygltf::Model& rawModel,
     int32_t index) {
+    RAUM_TRACE_SCOPE("SceneSerializer::materialPreprocess");
     const auto& rawTextures = rawModel.textures;
     const auto& res = rawModel.materials[index];
 
@@ -289,6 +335,97 @@ void applyNodeTransform(
     node.node.update();
 }
 
+// full detail included
+constexpr uint32_t MAX_MESH_LODS = 4;
+// each level aims at this fraction of the indices of the previous one
+constexpr float LOD_REDUCTION = 0.5f;
+// relative to the mesh extent, simplification stops short of the target count rather than exceed it
+constexpr float LOD_TARGET_ERROR = 0.05f;
+// levels keeping more of the previous one are not worth their memory
+constexpr float LOD_MAX_KEPT = 0.8f;
+constexpr uint32_t LOD_MIN_INDICES = 96;
+
+// appends the simplified levels to `indices`, which holds the full detail one. Each level is simplified from
+// the previous, errors accumulate.
+std::vector<scene::MeshLod> generateLods(std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t stride) {
+    RAUM_TRACE_SCOPE("SceneSerializer::generateLods");
+    std::vector<scene::MeshLod> lods{{0, static_cast<uint32_t>(indices.size()), 0.0f}};
+    auto scale = meshopt_simplifyScale(positions, vertexCount, stride);
+    std::vector<uint32_t> simplified;
+    while (lods.size() < MAX_MESH_LODS) {
+        auto previous = lods.back();
+        auto target = static_cast<size_t>(previous.indexCount * LOD_REDUCTION) / 3 * 3;
+        if (target < LOD_MIN_INDICES) {
+            break;
+        }
+        simplified.resize(previous.indexCount);
+        float error{0.0f};
+        auto count = meshopt_simplify(simplified.data(), indices.data() + previous.firstIndex, previous.indexCount,
+                                      positions, vertexCount, stride, target, LOD_TARGET_ERROR, 0, &error);
+        if (count == 0 || count > previous.indexCount * LOD_MAX_KEPT) {
+            break;
+        }
+        lods.emplace_back(scene::MeshLod{
+            static_cast<uint32_t>(indices.size()),
+            static_cast<uint32_t>(count),
+            previous.error + error * scale,
+        });
+        indices.insert(indices.end(), simplified.begin(), simplified.begin() + count);
+    }
+    return lods;
+}
+
+// limits of one mesh shader workgroup, see gltfpbr.mesh
+constexpr uint32_t MAX_MESHLET_VERTICES = 64;
+constexpr uint32_t MAX_MESHLET_TRIANGLES = 124;
+// favours meshlets with narrow normal cones, which backface culling can reject
+constexpr float MESHLET_CONE_WEIGHT = 0.25f;
+
+// rewrites the full detail `indices` in meshlet order, each meshlet is a contiguous index range of it too.
+scene::MeshletData generateMeshlets(std::vector<uint32_t>& indices, const float* positions, uint32_t vertexCount, uint32_t stride) {
+    RAUM_TRACE_SCOPE("SceneSerializer::generateMeshlets");
+    scene::MeshletData data;
+    auto maxMeshlets = meshopt_buildMeshletsBound(indices.size(), MAX_MESHLET_VERTICES, MAX_MESHLET_TRIANGLES);
+    std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    data.vertices.resize(maxMeshlets * MAX_MESHLET_VERTICES);
+    data.triangles.resize(maxMeshlets * MAX_MESHLET_TRIANGLES * 3);
+    auto count = meshopt_buildMeshlets(meshlets.data(), data.vertices.data(), data.triangles.data(),
+                                       indices.data(), indices.size(), positions, vertexCount, stride,
+                                       MAX_MESHLET_VERTICES, MAX_MESHLET_TRIANGLES, MESHLET_CONE_WEIGHT);
+    if (!count) {
+        return {};
+    }
+    const auto& last = meshlets[count - 1];
+    data.vertices.resize(last.vertex_offset + last.vertex_count);
+    data.triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+
+    data.meshlets.reserve(count);
+    uint32_t firstIndex{0};
+    for (size_t i = 0; i < count; ++i) {
+        const auto& meshlet = meshlets[i];
+        auto bounds = meshopt_computeMeshletBounds(&data.vertices[meshlet.vertex_offset], &data.triangles[meshlet.triangle_offset],
+                                                   meshlet.triangle_count, positions, vertexCount, stride);
+        data.meshlets.emplace_back(scene::Meshlet{
+            .center = Vec3f(bounds.center[0], bounds.center[1], bounds.center[2]),
+            .radius = bounds.radius,
+            .coneApex = Vec3f(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]),
+            .coneCutoff = bounds.cone_cutoff,
+            .coneAxis = Vec3f(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]),
+            .firstIndex = firstIndex,
+            .vertexOffset = meshlet.vertex_offset,
+            .triangleOffset = meshlet.triangle_offset,
+            .vertexCount = meshlet.vertex_count,
+            .triangleCount = meshlet.triangle_count,
+        });
+        for (uint32_t j = 0; j < meshlet.triangle_count * 3; ++j) {
+            indices[firstIndex++] = data.vertices[meshlet.vertex_offset + data.triangles[meshlet.triangle_offset + j]];
+        }
+    }
+    // degenerate triangles are left out of the meshlets
+    indices.resize(firstIndex);
+    return data;
+}
+
 void meshPreprocess(
     const std::filesystem::path& cachePath,
     const tinygltf::Model& rawModel,
@@ -296,6 +433,7 @@ void meshPreprocess(
     graph::SceneGraph& sg,
     std::string_view parentName,
     std::map<int, scene::TechniquePtr>& techs) {
+    RAUM_TRACE_SCOPE("SceneSerializer::meshPreprocess");
     const auto& rawNode = rawModel.nodes[nodeIndex];
     const auto& rawMesh = rawModel.meshes[rawNode.mesh];
     auto meshName = std::to_string(nodeIndex);
@@ -544,7 +682,37 @@ void meshPreprocess(
             materialPreprocess(cachePath, rawModel, localMatIndex);
         }
 
-        std::vector<char> indexData(indexBufferData, indexBufferData + indexBufferSource.size);
+        std::vector<uint32_t> indices(meshData.indexCount);
+        for (size_t i = 0; i < meshData.indexCount; ++i) {
+            switch (indicesAccessor.componentType) {
+                case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+                    indices[i] = reinterpret_cast<const uint32_t*>(indexBufferData)[i];
+                    break;
+                case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+                    indices[i] = reinterpret_cast<const uint16_t*>(indexBufferData)[i];
+                    break;
+                default:
+                    indices[i] = indexBufferData[i];
+                    break;
+            }
+        }
+        // levels of detail follow the full index range in the same buffer
+        std::vector<scene::MeshLod> lods;
+        scene::MeshletData meshletData;
+        if (position && prim.mode == TINYGLTF_MODE_TRIANGLES) {
+            meshletData = generateMeshlets(indices, data.data(), meshData.vertexCount, bufferAttribute.stride);
+            meshData.indexCount = static_cast<uint32_t>(indices.size());
+            lods = generateLods(indices, data.data(), meshData.vertexCount, bufferAttribute.stride);
+        }
+        std::vector<char> indexData;
+        if (meshData.indexBuffer.type == rhi::IndexType::FULL) {
+            indexData.resize(indices.size() * sizeof(rhi::FullIndexType));
+            std::memcpy(indexData.data(), indices.data(), indexData.size());
+        } else {
+            std::vector<rhi::HalfIndexType> halfIndices(indices.begin(), indices.end());
+            indexData.resize(halfIndices.size() * sizeof(rhi::HalfIndexType));
+            std::memcpy(indexData.data(), halfIndices.data(), indexData.size());
+        }
         // vertexbuffer data
         ar << meshData.vertexCount;
         ar << data;
@@ -559,6 +727,10 @@ void meshPreprocess(
         ar << localMatIndex;
         ar << prim.mode;
         ar << aabb;
+        ar << lods;
+        ar << meshletData.meshlets;
+        ar << meshletData.vertices;
+        ar << meshletData.triangles;
     }
 }
 
@@ -600,6 +772,7 @@ void scenePreprocess(const std::filesystem::path& cachePath,
                      graph::SceneGraph& sg,
                      const tinygltf::Model& rawModel,
                      uint32_t index) {
+    RAUM_TRACE_SCOPE("SceneSerializer::scenePreprocess");
     raum_check(index < rawModel.scenes.size(), "incorrect index of scene");
     const auto& scene = rawModel.scenes[index];
     auto& root = sg.addEmpty(scene.name);
@@ -638,6 +811,7 @@ void scenePreprocess(const std::filesystem::path& cachePath,
 }
 
 void assetPreprocess(graph::SceneGraph& sg, const std::filesystem::path& filePath) {
+    RAUM_TRACE_SCOPE("SceneSerializer::assetPreprocess");
     std::filesystem::path cachePath = raum::utils::resourceDirectory() / "cache" / filePath.stem();
 
     std::string err;
@@ -653,6 +827,7 @@ void assetPreprocess(graph::SceneGraph& sg, const std::filesystem::path& filePat
         }
     }
     scenePreprocess(cachePath, sg, rawModel, rawModel.defaultScene);
+    writeCacheVersion(cachePath);
 }
 
 void loadTexturesFromCache(
@@ -660,6 +835,7 @@ void loadTexturesFromCache(
     std::vector<std::pair<std::string, scene::Texture>>& textures,
     rhi::DevicePtr device,
     rhi::CommandBufferPtr cmdBuffer) {
+    RAUM_TRACE_SCOPE("SceneSerializer::loadTexturesFromCache");
     const auto texCachePath = cachePath / "textures";
     // raum_check(std::filesystem::exists(texCachePath), "textures cache not found: %s", texCachePath.string());
     if (std::filesystem::exists(texCachePath)) {
@@ -684,6 +860,7 @@ void loadTexturesFromCache(
         std::mutex taskMutex;
 
         auto imgTask = [&](int i) {
+            RAUM_TRACE_SCOPE("SceneSerializer::loadTexture");
             // load image data
             auto& entry = files[i];
             std::string texName = entry.filename().string();
@@ -716,6 +893,7 @@ void loadMaterialFromCache(
     scene::MaterialTemplatePtr matTemplate,
     std::map<int32_t, scene::TechniquePtr>& techs,
     rhi::DevicePtr device) {
+    RAUM_TRACE_SCOPE("SceneSerializer::loadMaterialFromCache");
     auto matCachePath = cachePath / "material" / std::to_string(matIndex);
     matCachePath.replace_extension(".mat");
     InputArchive ar(matCachePath);
@@ -889,6 +1067,7 @@ void loadMeshFromCache(
     std::vector<std::pair<std::string, scene::Texture>>& textures,
     rhi::CommandBufferPtr cmdBuffer,
     rhi::DevicePtr device) {
+    RAUM_TRACE_SCOPE("SceneSerializer::loadMeshFromCache");
     const auto& meshCachePath = cachePath / "mesh";
     raum_check(std::filesystem::exists(meshCachePath), "mesh cache not found: %s", meshCachePath.string());
 
@@ -939,8 +1118,10 @@ void loadMeshFromCache(
             ar >> meshData.vertexCount;
             std::vector<float> data;
             ar >> data;
+            // mesh shaders read vertices as storage
+            auto vertexUsage = device->meshShaderSupported() ? rhi::BufferUsage::VERTEX | rhi::BufferUsage::STORAGE : rhi::BufferUsage::VERTEX;
             rhi::BufferSourceInfo bufferSourceInfo{
-                .bufferUsage = rhi::BufferUsage::VERTEX,
+                .bufferUsage = vertexUsage,
                 .size = static_cast<uint32_t>(data.size() * sizeof(float)),
                 .data = data.data(),
             };
@@ -959,13 +1140,10 @@ void loadMeshFromCache(
             };
             std::vector<uint16_t> u16arr;
             switch (meshData.indexBuffer.type) {
-                case rhi::IndexType::FULL: {
-                    indexBufferSource.size = meshData.indexCount * sizeof(rhi::FullIndexType);
-                    indexBufferSource.data = indexData.data();
-                    break;
-                }
+                // indexCount covers full detail, the coarser levels follow it
+                case rhi::IndexType::FULL:
                 case rhi::IndexType::HALF: {
-                    indexBufferSource.size = meshData.indexCount * sizeof(rhi::HalfIndexType);
+                    indexBufferSource.size = static_cast<uint32_t>(indexData.size());
                     indexBufferSource.data = indexData.data();
                     break;
                 }
@@ -981,6 +1159,28 @@ void loadMeshFromCache(
             int primMode{0};
             ar >> primMode;
             ar >> mesh->aabb();
+            ar >> mesh->lods();
+            auto& meshletData = mesh->meshletData();
+            ar >> meshletData.meshlets;
+            ar >> meshletData.vertices;
+            ar >> meshletData.triangles;
+            if (device->meshShaderSupported() && !meshletData.meshlets.empty()) {
+                meshletData.meshletBuffer = rhi::BufferPtr(device->createBuffer(rhi::BufferSourceInfo{
+                    .bufferUsage = rhi::BufferUsage::STORAGE,
+                    .size = static_cast<uint32_t>(meshletData.meshlets.size() * sizeof(scene::Meshlet)),
+                    .data = meshletData.meshlets.data(),
+                }));
+                meshletData.vertexBuffer = rhi::BufferPtr(device->createBuffer(rhi::BufferSourceInfo{
+                    .bufferUsage = rhi::BufferUsage::STORAGE,
+                    .size = static_cast<uint32_t>(meshletData.vertices.size() * sizeof(uint32_t)),
+                    .data = meshletData.vertices.data(),
+                }));
+                meshletData.triangleBuffer = rhi::BufferPtr(device->createBuffer(rhi::BufferSourceInfo{
+                    .bufferUsage = rhi::BufferUsage::STORAGE,
+                    .size = static_cast<uint32_t>(meshletData.triangles.size()),
+                    .data = meshletData.triangles.data(),
+                }));
+            }
 
             if (!techs.contains(localMatIndex)) {
                 loadMaterialFromCache(cachePath, cachePath.filename().string(), localMatIndex, textures, matTemplate, techs, device);
@@ -1004,7 +1204,6 @@ void loadMeshFromCache(
             meshRenderer->addTechnique(tech);
             meshRenderer->setVertexInfo(0, meshData.vertexCount, meshData.indexCount);
             meshRenderer->setTransform(sceneNode.node.transform());
-            meshRenderer->setTransformSlot("LocalMat");
 
             auto embededTechSize = static_cast<uint32_t>(scene::EmbededTechnique::COUNT);
             for (size_t i = 0; i < embededTechSize; ++i) {
@@ -1030,6 +1229,7 @@ void loadSceneFromCache(const std::filesystem::path& cachePath,
 }
 
 void loadFromCache(graph::SceneGraph& sg, const std::filesystem::path& cachePath, rhi::DevicePtr device) {
+    RAUM_TRACE_SCOPE("SceneSerializer::loadFromCache");
     auto commandPool = rhi::CommandPoolPtr(device->createCoomandPool({}));
     auto commandBuffer = rhi::CommandBufferPtr(commandPool->makeCommandBuffer({}));
     auto* queue = device->getQueue({rhi::QueueType::GRAPHICS});
@@ -1040,11 +1240,18 @@ void loadFromCache(graph::SceneGraph& sg, const std::filesystem::path& cachePath
 
     commandBuffer->commit();
     queue->submit(false);
+    // the pool goes out of scope, so the uploads have to be done
+    device->waitQueueIdle(queue);
 }
 
 void load(graph::SceneGraph& sg, const std::filesystem::path& filePath, rhi::DevicePtr device) {
+    RAUM_TRACE_SCOPE("SceneSerializer::load");
     std::filesystem::path cachePath = raum::utils::resourceDirectory() / "cache" / filePath.stem();
-    if (!std::filesystem::exists(cachePath)) {
+    if (!cacheValid(cachePath)) {
+        if (std::filesystem::exists(cachePath)) {
+            raum_info("cache of {} is outdated, preprocessing again", filePath.string());
+            std::filesystem::remove_all(cachePath);
+        }
         graph::SceneGraph offlineSg;
         assetPreprocess(offlineSg, filePath);
     }
@@ -1053,6 +1260,7 @@ void load(graph::SceneGraph& sg, const std::filesystem::path& filePath, rhi::Dev
 }
 
 void load(graph::SceneGraph& sg, const std::filesystem::path& filePath, std::string_view sceneName, rhi::DevicePtr device) {
+    RAUM_TRACE_SCOPE("SceneSerializer::load");
     std::string err;
     std::string warn;
     tinygltf::Model rawModel;
@@ -1082,6 +1290,8 @@ void load(graph::SceneGraph& sg, const std::filesystem::path& filePath, std::str
 
     commandBuffer->commit();
     queue->submit(false);
+    // the pool goes out of scope, so the uploads have to be done
+    device->waitQueueIdle(queue);
 }
 
 } // namespace raum::asset::serialize
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <exec/static_thread_pool.hpp>
+#include <algorithm>
 
 #include "utils/containers.h"
 
@@ -14,4 +15,9 @@ exec::static_thread_pool& getIOThreadPool() {
     return ioThreadPool;
 }
 
+exec::static_thread_pool& getRenderThreadPool() {
+    static exec::static_thread_pool renderThreadPool(std::max(std::thread::hardware_concurrency(), 1u));
+    return renderThreadPool;
+}
+
 }
\ No newline at end of file
@@ -10,4 +10,7 @@ template <class... Ts>
         typename exec::any_receiver_ref<stdexec::completion_signatures<Ts...>>::template any_sender<>;
 
     exec::static_thread_pool& getIOThreadPool();
+
+    // command recording, sized to hardware concurrency
+    exec::static_thread_pool& getRenderThreadPool();
 }
\ No newline at end of file
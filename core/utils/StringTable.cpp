@@ -0,0 +1,74 @@
+#include "StringTable.h"
+#include <mutex>
+
+namespace raum {
+
+StringID StringTable::intern(std::string_view str) {
+    {
+        std::shared_lock lock(_mutex);
+        auto iter = _ids.find(str);
+        if (iter != _ids.end()) {
+            return StringID::fromValue(iter->second);
+        }
+    }
+
+    std::unique_lock lock(_mutex);
+    auto iter = _ids.find(str);
+    if (iter != _ids.end()) {
+        return StringID::fromValue(iter->second);
+    }
+    auto value = static_cast<uint32_t>(_strings.size());
+    std::string_view stored = _storage.emplace_back(str);
+    _strings.emplace_back(stored);
+    _ids.emplace(stored, value);
+    return StringID::fromValue(value);
+}
+
+StringID StringTable::find(std::string_view str) const {
+    std::shared_lock lock(_mutex);
+    auto iter = _ids.find(str);
+    return iter != _ids.end() ? StringID::fromValue(iter->second) : StringID{};
+}
+
+StringID StringTable::join(StringID parent, StringID child) {
+    auto key = static_cast<uint64_t>(parent.value()) << 32 | child.value();
+    {
+        std::shared_lock lock(_mutex);
+        auto iter = _joined.find(key);
+        if (iter != _joined.end()) {
+            return StringID::fromValue(iter->second);
+        }
+    }
+
+    std::string joined;
+    {
+        std::shared_lock lock(_mutex);
+        joined.reserve(_strings[parent.value()].size() + _strings[child.value()].size() + 1);
+        joined.append(_strings[parent.value()]).append("/").append(_strings[child.value()]);
+    }
+    auto id = intern(joined);
+
+    std::unique_lock lock(_mutex);
+    _joined.emplace(key, id.value());
+    return id;
+}
+
+std::string_view StringTable::str(StringID id) const {
+    if (!id.valid()) {
+        return {};
+    }
+    std::shared_lock lock(_mutex);
+    return _strings[id.value()];
+}
+
+uint32_t StringTable::size() const {
+    std::shared_lock lock(_mutex);
+    return static_cast<uint32_t>(_strings.size());
+}
+
+StringTable& getStringTable() {
+    static StringTable table;
+    return table;
+}
+
+} // namespace raum
@@ -0,0 +1,79 @@
+#pragma once
+#include <stdint.h>
+#include <compare>
+#include <deque>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace raum {
+
+// handle of an interned string, equal strings share one id for the lifetime of the process.
+class StringID {
+public:
+    static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+    constexpr StringID() = default;
+
+    // interns str, explicit so that lookups go through StringTable::find and never grow the table.
+    template <typename T>
+        requires std::is_convertible_v<const T&, std::string_view>
+    explicit StringID(const T& str);
+
+    static constexpr StringID fromValue(uint32_t value) {
+        StringID id;
+        id._value = value;
+        return id;
+    }
+
+    uint32_t value() const { return _value; }
+    bool valid() const { return _value != INVALID; }
+    std::string_view str() const;
+
+    auto operator<=>(const StringID&) const = default;
+
+private:
+    uint32_t _value{INVALID};
+};
+
+class StringTable {
+public:
+    StringID intern(std::string_view str);
+    // id of an interned string, invalid if it was never interned.
+    StringID find(std::string_view str) const;
+    // id of "parent/child", memoized so lookups never concatenate.
+    StringID join(StringID parent, StringID child);
+    std::string_view str(StringID id) const;
+    uint32_t size() const;
+
+private:
+    mutable std::shared_mutex _mutex;
+    // deque keeps string addresses stable
+    std::deque<std::string> _storage;
+    std::vector<std::string_view> _strings;
+    std::unordered_map<std::string_view, uint32_t> _ids;
+    std::unordered_map<uint64_t, uint32_t> _joined;
+};
+
+StringTable& getStringTable();
+
+template <typename T>
+    requires std::is_convertible_v<const T&, std::string_view>
+StringID::StringID(const T& str) : _value(getStringTable().intern(str)._value) {}
+
+inline std::string_view StringID::str() const {
+    return getStringTable().str(*this);
+}
+
+} // namespace raum
+
+template <>
+struct std::hash<raum::StringID> {
+    size_t operator()(const raum::StringID& id) const noexcept {
+        return std::hash<uint32_t>{}(id.value());
+    }
+};
@@ -0,0 +1,137 @@
+#include "Trace.h"
+
+#ifdef RAUM_ENABLE_TRACE
+    #include <algorithm>
+    #include <array>
+    #include <atomic>
+    #include <chrono>
+    #include <fstream>
+    #include <mutex>
+    #include <string>
+    #include <vector>
+    #include "log.h"
+
+namespace raum::trace {
+
+namespace {
+
+static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "ring capacity must be a power of two");
+
+// written by the owning thread only, slots are atomic so a concurrent dump never reads a torn event.
+struct Ring {
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> begin{0};
+        std::atomic<uint64_t> end{0};
+    };
+    std::array<Slot, RING_CAPACITY> slots;
+    std::atomic<uint64_t> head{0};
+    uint32_t tid{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    // rings outlive their threads so exited workers still show up in the dump
+    std::vector<Ring*> rings;
+};
+
+Registry& registry() {
+    static Registry* res = new Registry();
+    return *res;
+}
+
+Ring& localRing() {
+    thread_local Ring* ring = [] {
+        auto* res = new Ring();
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        res->tid = static_cast<uint32_t>(reg.rings.size());
+        reg.rings.emplace_back(res);
+        return res;
+    }();
+    return *ring;
+}
+
+void appendEscaped(std::string& out, const char* str) {
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            out.push_back('\\');
+        }
+        out.push_back(*str);
+    }
+}
+
+} // namespace
+
+uint64_t now() {
+    static const auto origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void record(const char* name, uint64_t begin, uint64_t end) {
+    auto& ring = localRing();
+    auto head = ring.head.load(std::memory_order_relaxed);
+    auto& slot = ring.slots[head & (RING_CAPACITY - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+bool dumpChromeTrace(const std::filesystem::path& path) {
+    std::vector<Ring*> rings;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        rings = reg.rings;
+    }
+
+    std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first{true};
+    std::vector<Event> events;
+    for (auto* ring : rings) {
+        auto head = ring->head.load(std::memory_order_acquire);
+        auto tail = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        events.clear();
+        for (auto i = tail; i < head; ++i) {
+            const auto& slot = ring->slots[i & (RING_CAPACITY - 1)];
+            events.emplace_back(Event{
+                .name = slot.name.load(std::memory_order_relaxed),
+                .begin = slot.begin.load(std::memory_order_relaxed),
+                .end = slot.end.load(std::memory_order_relaxed),
+            });
+        }
+        // slots the owner wrapped around to while they were copied, plus the one at newHead it may be writing
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto newHead = ring->head.load(std::memory_order_relaxed);
+        auto overwritten = newHead + 1 > RING_CAPACITY ? newHead + 1 - RING_CAPACITY : 0;
+        auto skip = overwritten > tail ? std::min<uint64_t>(overwritten - tail, events.size()) : 0;
+
+        json += fmt::format(R"({}{{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"thread {}"}}}})",
+                            first ? "" : ",", ring->tid, ring->tid);
+        first = false;
+        for (auto i = skip; i < events.size(); ++i) {
+            const auto& event = events[i];
+            json += R"(,{"name":")";
+            appendEscaped(json, event.name);
+            // microseconds
+            json += fmt::format(R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                                ring->tid,
+                                event.begin / 1000.0,
+                                (event.end - event.begin) / 1000.0);
+        }
+    }
+    json += "]}";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        raum_warn("failed to write trace to {}", path.string());
+        return false;
+    }
+    file << json;
+    return static_cast<bool>(file);
+}
+
+} // namespace raum::trace
+
+#endif
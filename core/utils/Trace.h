@@ -0,0 +1,58 @@
+#pragma once
+#include <stdint.h>
+#include <filesystem>
+
+// scoped trace markers, enabled by RAUM_ENABLE_TRACE. Every thread writes into its own ring buffer without
+// locking, the most recent events of all threads can be dumped as Chrome trace JSON (chrome://tracing, Perfetto).
+#ifdef RAUM_ENABLE_TRACE
+
+namespace raum::trace {
+
+// events kept per thread, older ones are overwritten
+constexpr uint32_t RING_CAPACITY{1 << 14};
+
+struct Event {
+    // string literal, only the pointer is stored
+    const char* name{nullptr};
+    // nanoseconds since the first marker of the process
+    uint64_t begin{0};
+    uint64_t end{0};
+};
+
+uint64_t now();
+void record(const char* name, uint64_t begin, uint64_t end);
+// may run while other threads keep tracing, events overwritten during the dump are skipped.
+bool dumpChromeTrace(const std::filesystem::path& path);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : _name(name), _begin(now()) {}
+    ~Scope() { record(_name, _begin, now()); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* _name;
+    uint64_t _begin;
+};
+
+} // namespace raum::trace
+
+    #define RAUM_TRACE_CONCAT_IMPL(a, b) a##b
+    #define RAUM_TRACE_CONCAT(a, b)      RAUM_TRACE_CONCAT_IMPL(a, b)
+    #define RAUM_TRACE_SCOPE(name)       ::raum::trace::Scope RAUM_TRACE_CONCAT(raumTraceScope, __COUNTER__)(name)
+
+#else
+
+namespace raum::trace {
+
+inline bool dumpChromeTrace(const std::filesystem::path&) {
+    return false;
+}
+
+} // namespace raum::trace
+
+    #define RAUM_TRACE_SCOPE(name)
+
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 #include <memory_resource>
+#include <optional>
 #include <boost/container/flat_map.hpp>
+#include <bit>
 #include <map>
 #include <set>
 #include <string>
@@ -61,6 +63,59 @@ private:
     std::pmr::memory_resource* _resource = nullptr;
 };
 
+// monotonic arena for data that lives exactly one frame, released wholesale by reset().
+// the initial block grows to the peak usage seen so far, steady-state frames never reach upstream.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(size_t initialSize = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : _upstream(upstream) {
+        grow(initialSize);
+    }
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    ~FrameArena() override {
+        _monotonic.reset();
+        _upstream->deallocate(_buffer, _capacity, alignof(std::max_align_t));
+    }
+
+    void reset() {
+        if (_used > _capacity) {
+            _monotonic.reset();
+            _upstream->deallocate(_buffer, _capacity, alignof(std::max_align_t));
+            grow(std::bit_ceil(_used));
+        } else {
+            _monotonic->release();
+        }
+        _used = 0;
+    }
+
+    size_t capacity() const { return _capacity; }
+
+private:
+    void grow(size_t size) {
+        _capacity = size;
+        _buffer = _upstream->allocate(_capacity, alignof(std::max_align_t));
+        _monotonic.emplace(_buffer, _capacity, _upstream);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        _used += bytes + alignment;
+        return _monotonic->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* _upstream{nullptr};
+    std::optional<monotonic_resource> _monotonic;
+    void* _buffer{nullptr};
+    size_t _capacity{0};
+    size_t _used{0};
+};
+
 TrackedResource* getGlobalTrackedResource();
 
 // auto* DefaultResource = std::pmr::get_default_resource();
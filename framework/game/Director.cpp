@@ -3,15 +3,48 @@
 //
 
 #include "Director.h"
+#include <algorithm>
 #include "SceneSerializer.h"
 #include "RHICommandBuffer.h"
 #include "RHIManager.h"
 #include "BuiltinRes.h"
+#include "core/utils/Trace.h"
+#include "stb_image_write.h"
 
 namespace raum::framework {
 
-Director::Director() {
-    _device = std::shared_ptr<rhi::RHIDevice>(rhi::loadRHI(rhi::API::VULKAN), rhi::unloadRHI);
+namespace {
+
+void printTimings(std::string_view name, std::vector<double>& samples) {
+    if (samples.empty()) {
+        raum_info("{} ms: no samples", name);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum{0.0};
+    for (auto sample : samples) {
+        sum += sample;
+    }
+    auto percentile = [&](double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+    };
+    raum_info("{} ms: avg {:.3f} min {:.3f} p50 {:.3f} p95 {:.3f} max {:.3f} ({} frames)",
+              name, sum / samples.size(), samples.front(), percentile(0.5), percentile(0.95), samples.back(), samples.size());
+}
+
+double toMs(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void printCommands(const rhi::SubmittedCommandStats& stats) {
+    raum_info("commands: {} total, {} draws, {} dispatches, {} binds, {} barriers in {} batches, {} copies, hash {:016x}",
+              stats.commands, stats.draws, stats.dispatches, stats.binds, stats.barriers, stats.barrierBatches, stats.copies, stats.hash);
+}
+
+} // namespace
+
+Director::Director(rhi::API api) {
+    _device = std::shared_ptr<rhi::RHIDevice>(rhi::loadRHI(api), rhi::unloadRHI);
 
     _sceneGraph = std::make_shared<graph::SceneGraph>();
     _shaderGraph = std::make_shared<graph::ShaderGraph>(_device);
@@ -30,6 +63,12 @@ void Director::attachWindow(platform::WindowPtr window) {
     _pipeline = std::make_shared<graph::Pipeline>(_device, _swapchain, _sceneGraph, _shaderGraph);
 }
 
+void Director::attachOffscreen(uint32_t width, uint32_t height) {
+    _offscreen = std::make_shared<rhi::RHIOffscreenSwapchain>(rhi::OffscreenSwapchainInfo{width, height}, _device.get());
+    _swapchain = _offscreen;
+    _pipeline = std::make_shared<graph::Pipeline>(_device, _swapchain, _sceneGraph, _shaderGraph);
+}
+
 void Director::loadScene(std::filesystem::path p, std::string_view name) {
     asset::serialize::load(*_sceneGraph, p, name, _device);
 }
@@ -89,25 +128,37 @@ void Director::postRender(std::chrono::milliseconds miliSec, rhi::CommandBufferP
 }
 
 void Director::update(std::chrono::milliseconds milisec) {
+    RAUM_TRACE_SCOPE("Director::update");
+    auto begin = std::chrono::steady_clock::now();
     auto* queue = _device->getQueue({rhi::QueueType::GRAPHICS});
 
+    // offscreen images are neither acquired nor presented
     auto* acquireSem = _swapchain->getAvailableByAcquire();
     _swapchain->acquire();
 
-    auto* renderSem = queue->getSignal();
-    _swapchain->addWaitBeforePresent(renderSem);
+    if (!_offscreen) {
+        auto* renderSem = queue->getSignal();
+        _swapchain->addWaitBeforePresent(renderSem);
+    }
 
-    auto cmd = _cmds[_swapchain->imageIndex()];
+    // the queue waited for the frame that recorded into it last
+    auto cmd = _cmds[_frameIndex];
+    _frameIndex = (_frameIndex + 1) % rhi::FRAMES_IN_FLIGHT;
 
     cmd->reset();
     cmd->enqueue(queue);
     cmd->begin({});
 
     preRender(milisec, cmd);
-    _pipeline->run(cmd);
+    cmd = _pipeline->run(cmd);
     postRender(milisec, cmd);
 
     cmd->commit();
+    _cpuTime = std::chrono::steady_clock::now() - begin;
+    if (_offscreen) {
+        queue->submit(false);
+        return;
+    }
     queue->addWait(acquireSem);
     queue->submit(true);
 
@@ -121,8 +172,64 @@ void Director::run() {
     _window->registerPollEvents(&_tick);
 }
 
+void Director::runHeadless(const HeadlessInfo& info, TickFunction* frameTick) {
+    raum_check(_offscreen, "runHeadless without an offscreen target");
+    auto& profiler = _pipeline->graphScheduler().profiler();
+    profiler.setEnabled(true);
+
+    std::vector<double> frameMs;
+    std::vector<double> cpuMs;
+    std::vector<double> gpuMs;
+    frameMs.reserve(info.frameCount);
+    cpuMs.reserve(info.frameCount);
+    gpuMs.reserve(info.frameCount);
+    for (uint32_t i = 0; i < info.frameCount; ++i) {
+        // only the last frame is counted
+        _device->resetSubmittedCommandStats();
+        auto begin = std::chrono::steady_clock::now();
+        if (frameTick) {
+            (*frameTick)(std::chrono::milliseconds{});
+        }
+        auto tickTime = std::chrono::steady_clock::now() - begin;
+        update(std::chrono::milliseconds{});
+        frameMs.emplace_back(toMs(std::chrono::steady_clock::now() - begin));
+        cpuMs.emplace_back(toMs(tickTime + _cpuTime));
+        // queries are read back when their frame slot comes around again
+        if (i >= rhi::FRAMES_IN_FLIGHT && profiler.frameMs() > 0.0) {
+            gpuMs.emplace_back(profiler.frameMs());
+        }
+    }
+    _device->waitDeviceIdle();
+
+    if (!info.capture.empty()) {
+        std::vector<uint8_t> texels;
+        if (_offscreen->readback(texels)) {
+            auto format = _offscreen->format();
+            if (format >= rhi::Format::BGRA8_UNORM && format <= rhi::Format::BGRA8_SRGB) {
+                for (size_t i = 0; i < texels.size(); i += 4) {
+                    std::swap(texels[i], texels[i + 2]);
+                }
+            }
+            auto width = static_cast<int>(_offscreen->width());
+            auto height = static_cast<int>(_offscreen->height());
+            bool res = stbi_write_png(info.capture.string().c_str(), width, height, 4, texels.data(), width * 4);
+            RAUM_ERROR_IF(!res, "failed to write {}", info.capture.string());
+        }
+    }
+
+    raum_info("headless: {} frames at {}x{}", info.frameCount, _offscreen->width(), _offscreen->height());
+    printTimings("frame", frameMs);
+    printTimings("cpu", cpuMs);
+    printTimings("gpu", gpuMs);
+    if (rhi::SubmittedCommandStats stats; _device->submittedCommandStats(stats)) {
+        printCommands(stats);
+    }
+}
+
 Director::~Director() {
-    _window->removePollEvent(&_tick);
+    if (_window) {
+        _window->removePollEvent(&_tick);
+    }
 }
 
 } // namespace raum::framework
\ No newline at end of file
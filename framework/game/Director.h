@@ -8,6 +8,7 @@
 #include "ResourceGraph.h"
 #include <filesystem>
 #include "Pipeline.h"
+#include "RHIOffscreenSwapchain.h"
 #include "window.h"
 namespace raum::framework {
 using TickFunction = utils::TickFunction<std::chrono::milliseconds>;
@@ -15,12 +16,21 @@ using RenderTask = utils::TickFunction<std::chrono::milliseconds,
                                        rhi::CommandBufferPtr,
                                        rhi::DevicePtr>;
 
+struct HeadlessInfo {
+    uint32_t frameCount{100};
+    // png of the last frame, skipped if empty
+    std::filesystem::path capture{};
+};
+
 class Director {
 public:
-    explicit Director();
+    explicit Director(rhi::API api = rhi::API::VULKAN);
     ~Director();
 
     void attachWindow(platform::WindowPtr window);
+    // renders into offscreen images instead of a window, frames are driven by runHeadless.
+    void attachOffscreen(uint32_t width, uint32_t height);
+    bool headless() const { return _offscreen != nullptr; }
 
     void loadScene(std::filesystem::path p, std::string_view name);
     void unloadScene(std::string_view name);
@@ -36,6 +46,10 @@ public:
     graph::SceneGraph& sceneGraph() { return *_sceneGraph; }
 
     void run();
+    // renders `frameCount` frames back to back, `frameTick` runs ahead of each of them like the window poll
+    // callbacks do. CPU and GPU frame timings are printed once done, the commands of the last frame too where
+    // the device counts them.
+    void runHeadless(const HeadlessInfo& info, TickFunction* frameTick);
 
     graph::PipelinePtr pipeline() { return _pipeline; }
     rhi::DevicePtr device() { return _device; }
@@ -48,9 +62,13 @@ private:
     graph::ShaderGraphPtr _shaderGraph;
     rhi::DevicePtr _device;
     rhi::SwapchainPtr _swapchain;
+    std::shared_ptr<rhi::RHIOffscreenSwapchain> _offscreen;
+    // recording part of the last update, without waiting for the queue
+    std::chrono::steady_clock::duration _cpuTime{};
 
     rhi::CommandPoolPtr _cmdPool;
     std::array<rhi::CommandBufferPtr, rhi::FRAMES_IN_FLIGHT> _cmds;
+    uint32_t _frameIndex{0};
 
     graph::PipelinePtr _pipeline;
     platform::WindowPtr _window;
@@ -3,8 +3,8 @@
 
 namespace raum::framework {
 
-World::World() {
-    _director = new Director();
+World::World(rhi::API api) {
+    _director = new Director(api);
 }
 
 void World::attachWindow(platform::WindowPtr window) {
@@ -6,7 +6,7 @@ namespace raum::framework {
 
 class World {
 public:
-    World();
+    explicit World(rhi::API api = rhi::API::VULKAN);
     ~World();
 
     void attachWindow(platform::WindowPtr window);
@@ -1,4 +1,8 @@
 #include "AccessGraph.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <type_traits>
 #include <boost/graph/depth_first_search.hpp>
 #include "RHIBuffer.h"
 #include "RHIImage.h"
@@ -9,52 +13,30 @@ namespace raum::graph {
 
 namespace {
 
-RenderGraph::VertexType getParentPass(RenderGraph& g, std::string_view name) {
-    auto pos = name.find_last_of('/');
-    if (pos == std::string::npos) {
-        return RenderGraph::null_vertex();
-    }
-    auto parentName = name.substr(0, pos);
-    auto parentVert = *boost::graph::find_vertex(parentName, g.impl());
-    return parentVert;
-}
-
-ResourceGraph::VertexType getParentResource(ResourceGraph& g, std::string_view name) {
-    auto pos = name.find_last_of('/');
-    if (pos == std::string::npos) {
-        return ResourceGraph::null_vertex();
-    }
-    auto parentName = name.substr(0, pos);
-    auto parentVert = *boost::graph::find_vertex(parentName, g.impl());
-    return parentVert;
-}
-
-std::string_view eraseView(ResourceGraph& g, std::string_view name) {
-    auto v = *boost::graph::find_vertex(name, g.impl());
-    if (std::holds_alternative<ImageViewData>(g.impl()[v].data)) {
-        const auto& viewData = std::get<ImageViewData>(g.impl()[v].data);
-        return viewData.origin;
-    } else if (std::holds_alternative<BufferViewData>(g.impl()[v].data)) {
-        const auto& viewData = std::get<BufferViewData>(g.impl()[v].data);
-        return viewData.origin;
+StringID eraseView(ResourceGraph& g, StringID name) {
+    const auto& res = g.get(name);
+    if (std::holds_alternative<ImageViewData>(res.data)) {
+        return std::get<ImageViewData>(res.data).origin;
+    } else if (std::holds_alternative<BufferViewData>(res.data)) {
+        return std::get<BufferViewData>(res.data).origin;
     }
     return name;
 }
 
-rhi::AspectMask getDepthStencilReadAspect(ResourceGraph& g, std::string_view name) {
-    auto v = *boost::graph::find_vertex(name, g.impl());
-    if (std::holds_alternative<ImageViewData>(g.impl()[v].data)) {
-        const auto& viewData = std::get<ImageViewData>(g.impl()[v].data);
-        return viewData.info.range.aspect;
+rhi::AspectMask getDepthStencilReadAspect(ResourceGraph& g, StringID name) {
+    const auto& res = g.get(name);
+    if (std::holds_alternative<ImageViewData>(res.data)) {
+        return std::get<ImageViewData>(res.data).info.range.aspect;
     }
     return rhi::AspectMask::COLOR;
-
 }
 
 } // namespace
 
 RenderGraph::VertexType getParentPass(RenderGraph& g, const RenderGraph::VertexType& v) {
-    return getParentPass(g, g.impl()[v].name);
+    // render queues are the only passes with an in edge, from their render pass
+    auto [first, last] = boost::in_edges(v, g.impl());
+    return first == last ? RenderGraph::null_vertex() : boost::source(*first, g.impl());
 }
 
 bool isDepthStencil(const AttachmentResource& res) {
@@ -138,7 +120,7 @@ rhi::PipelineStage getPipelineStage(rhi::ShaderStage visibility) {
     return stage;
 }
 
-rhi::ImageLayout getImageLayout(ResourceGraph& resg, std::string_view name, rhi::AccessFlags flags) {
+rhi::ImageLayout getImageLayout(ResourceGraph& resg, StringID name, rhi::AccessFlags flags) {
     auto depthStencilAspect = getDepthStencilReadAspect(resg, name);
     rhi::ImageLayout imgLayout{rhi::ImageLayout::UNDEFINED};
     if (test(flags, rhi::AccessFlags::INPUT_ATTACHMENT_READ)) {
@@ -196,7 +178,7 @@ rhi::Format getFormat(const Resource& res) {
     return format;
 }
 
-auto decomposeDetail(std::string_view name, ResourceGraph& resg) {
+auto decomposeDetail(StringID name, ResourceGraph& resg) {
     uint32_t samples{1};
     rhi::Format format{rhi::Format::UNKNOWN};
     uint32_t width{0};
@@ -297,7 +279,7 @@ public:
                 fbIter->second.info.width = fbIter->second.info.width ? std::min(fbIter->second.info.width, width) : width;
                 fbIter->second.info.height = fbIter->second.info.height ? std::min(fbIter->second.info.height, height) : height;
                 fbIter->second.info.layers = sliceCount;
-                fbIter->second.images.emplace_back(res.name);
+                fbIter->second.images.emplace_back(_resg.get(res.name).name);
 
                 auto resourceName = eraseView(_resg, res.name);
                 _accessMap[resourceName].emplace_back(v, access, layout, stage);
@@ -417,21 +399,30 @@ void populateBarrier(const AccessGraph::ResourceAccessMap& accessMap,
                      RenderGraph& rg,
                      AccessGraph::BufferBarrierMap& bufferBarrierMap,
                      AccessGraph::ImageBarrierMap& imageBarrierMap,
-                     AccessGraph::ImageBarrier& presentBarrier) {
+                     AccessGraph::ImageBarrier& presentBarrier,
+                     std::vector<std::pair<StringID, rhi::AccessFlags>>& finalAccesses,
+                     const std::unordered_set<RenderGraph::VertexType>& asyncPasses) {
     for (const auto& [name, status] : accessMap) {
         auto& resDetail = resg.get(name);
         auto lastAccess = resDetail.access;
         auto lastStage = rhi::PipelineStage::TOP_OF_PIPE;
         auto lastLayout = rhi::ImageLayout::UNDEFINED;
+        auto lastPass = RenderGraph::null_vertex();
         std::string_view backbuffer{};
         for (const auto& [v, access, layout, stage] : status) {
 
             // current perpass barrier
             auto parentPass = getParentPass(rg, v);
             parentPass = parentPass == RenderGraph::null_vertex() ? v : parentPass;
+            // queue switches always get a barrier, it carries the semaphore wait stage and ownership transfer
+            bool crossQueue = lastPass != RenderGraph::null_vertex() &&
+                              asyncPasses.contains(lastPass) != asyncPasses.contains(parentPass);
 
             if (std::holds_alternative<BufferData>(resDetail.data) || std::holds_alternative<BufferViewData>(resDetail.data)) {
-                if (isReadAccess(lastAccess) && isReadAccess(access)) {
+                if (isReadAccess(lastAccess) && isReadAccess(access) && !crossQueue) {
+                    // the next barrier waits for this read as well
+                    lastStage |= stage;
+                    lastPass = parentPass;
                     continue;
                 }
 
@@ -441,15 +432,19 @@ void populateBarrier(const AccessGraph::ResourceAccessMap& accessMap,
                                            lastStage,
                                            stage,
                                            lastAccess,
-                                           access));
+                                           access),
+                    lastPass);
 
                 lastAccess = access;
                 lastStage = stage;
+                lastPass = parentPass;
                 if (resDetail.residency != ResourceResidency::DONT_CARE) {
                     resDetail.access = access;
                 }
             } else if (std::holds_alternative<ImageData>(resDetail.data) || std::holds_alternative<ImageViewData>(resDetail.data) || std::holds_alternative<SwapchainData>(resDetail.data)) {
-                if (lastLayout == layout) {
+                if (lastLayout == layout && !crossQueue) {
+                    lastStage |= stage;
+                    lastPass = parentPass;
                     continue;
                 }
 
@@ -464,17 +459,20 @@ void populateBarrier(const AccessGraph::ResourceAccessMap& accessMap,
                         lastAccess,
                         access,
                         0, 0,
-                        getSubresourceRange(resDetail)});
+                        getSubresourceRange(resDetail)},
+                    lastPass);
 
                 lastAccess = access;
                 lastStage = stage;
                 lastLayout = layout;
+                lastPass = parentPass;
                 if (resDetail.residency != ResourceResidency::DONT_CARE) {
                     resDetail.access = access;
                 }
             }
         }
         if (resDetail.residency == ResourceResidency::SWAPCHAIN) {
+            const auto& swapchain = std::get<SwapchainData>(resDetail.data).swapchain;
             presentBarrier = {
                 name,
                 rhi::ImageBarrierInfo{
@@ -482,74 +480,853 @@ void populateBarrier(const AccessGraph::ResourceAccessMap& accessMap,
                     lastStage,
                     rhi::PipelineStage::BOTTOM_OF_PIPE,
                     lastLayout,
-                    rhi::ImageLayout::PRESENT,
+                    swapchain->presentLayout(),
                     lastAccess,
                     rhi::AccessFlags::NONE,
                     0, 0,
                     getSubresourceRange(resDetail)}};
             resDetail.access = rhi::AccessFlags::NONE;
         }
+        if (resDetail.residency != ResourceResidency::DONT_CARE) {
+            finalAccesses.emplace_back(name, resDetail.access);
+        }
+    }
+}
+
+// appends the bytes of `value` to a structure key, strings with their length so that neighbours can't blend
+template <typename T>
+void appendKey(std::string& key, const T& value) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view str = value;
+        appendKey(key, str.size());
+        key.append(str);
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "append fields of structs one by one");
+        key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+void appendResource(std::string& key, StringID name, ResourceGraph& resg) {
+    appendKey(key, name.value());
+    const auto& res = resg.get(name);
+    appendKey(key, res.data.index());
+    appendKey(key, res.residency);
+    // initial access of non-transient resources feeds the first barrier
+    appendKey(key, res.access);
+    std::visit(
+        overloaded{
+            [&](const ImageData& img) {
+                appendKey(key, img.info.format);
+                appendKey(key, img.info.sampleCount);
+                appendKey(key, img.info.extent.x);
+                appendKey(key, img.info.extent.y);
+                appendKey(key, img.info.extent.z);
+                appendKey(key, img.info.sliceCount);
+                appendKey(key, img.info.mipCount);
+            },
+            [&](const ImageViewData& imgView) {
+                appendKey(key, imgView.info.format);
+                appendKey(key, imgView.info.range.aspect);
+                appendKey(key, imgView.info.range.sliceCount);
+                appendResource(key, imgView.origin, resg);
+            },
+            [&](const BufferData& buffer) {
+                appendKey(key, buffer.info.bufferUsage);
+            },
+            [&](const BufferViewData& bufferView) {
+                appendKey(key, bufferView.info.offset);
+                appendKey(key, bufferView.info.size);
+                appendResource(key, bufferView.origin, resg);
+            },
+            [&](const SwapchainData& swapchainData) {
+                const auto& swapchain = swapchainData.swapchain;
+                appendKey(key, swapchain->format());
+                appendKey(key, swapchain->width());
+                appendKey(key, swapchain->height());
+            },
+            [](const auto&) {
+            },
+        },
+        res.data);
+}
+
+void appendRenderingResources(std::string& key, const PmrVector<RenderingResource>& resources, ResourceGraph& resg) {
+    for (const auto& res : resources) {
+        appendKey(key, res.bindingName);
+        appendKey(key, res.access);
+        appendKey(key, res.visibility);
+        appendResource(key, res.name, resg);
+    }
+}
+
+// structure key: everything analyze() depends on, nothing that only changes per frame(upload payload, viewport...).
+void structureKey(std::string& key, RenderGraph& rg, ResourceGraph& resg) {
+    key.clear();
+    const auto& g = rg.impl();
+    appendKey(key, boost::num_vertices(g));
+    for (auto v : boost::make_iterator_range(boost::vertices(g))) {
+        appendKey(key, g[v].name);
+        appendKey(key, g[v].data.index());
+        std::visit(
+            overloaded{
+                [&](const RenderPassData& data) {
+                    for (const auto& attachment : data.attachments) {
+                        appendKey(key, attachment.bindingName);
+                        appendKey(key, attachment.access);
+                        appendKey(key, attachment.type);
+                        appendKey(key, attachment.loadOp);
+                        appendKey(key, attachment.storeOp);
+                        appendKey(key, attachment.stencilLoadOp);
+                        appendKey(key, attachment.stencilStoreOp);
+                        appendResource(key, attachment.name, resg);
+                    }
+                },
+                [&](const RenderQueueData& data) {
+                    appendKey(key, data.flags);
+                    appendRenderingResources(key, data.resources, resg);
+                },
+                [&](const ComputePassData& data) {
+                    appendKey(key, data.programName);
+                    appendKey(key, data.queueHint);
+                    appendRenderingResources(key, data.resources, resg);
+                },
+                [&](const CopyPassData& data) {
+                    for (const auto& copy : data.copies) {
+                        appendKey(key, copy.source.value());
+                        appendKey(key, copy.target.value());
+                    }
+                    for (const auto& upload : data.uploads) {
+                        appendKey(key, upload.name.value());
+                    }
+                    for (const auto& fill : data.fills) {
+                        appendKey(key, fill.name.value());
+                    }
+                },
+                [](const auto&) {
+                },
+            },
+            g[v].data);
+    }
+}
+
+struct PassResources {
+    std::vector<StringID> reads;
+    std::vector<StringID> writes;
+    // written as a whole(cleared/discarded outputs), earlier writes no longer matter
+    std::vector<StringID> overwrites;
+};
+
+void addPassResource(PassResources& passResources, StringID name, Access access, ResourceGraph& resg) {
+    if (std::holds_alternative<SamplerData>(resg.get(name).data)) {
+        return;
+    }
+    auto resourceName = eraseView(resg, name);
+    if (access != Access::WRITE) {
+        passResources.reads.emplace_back(resourceName);
+    }
+    if (access != Access::READ) {
+        passResources.writes.emplace_back(resourceName);
+    }
+}
+
+PassResources collectPassResources(RenderGraph& rg, RenderGraph::VertexType v, ResourceGraph& resg) {
+    const auto& g = rg.impl();
+    PassResources passResources;
+    std::visit(
+        overloaded{
+            [&](const RenderPassData& data) {
+                for (const auto& attachment : data.attachments) {
+                    if (attachment.bindingName.empty()) {
+                        // loading an output reads what the previous writer left
+                        bool load = attachment.loadOp == LoadOp::LOAD || attachment.stencilLoadOp == LoadOp::LOAD;
+                        if (load) {
+                            addPassResource(passResources, attachment.name, Access::READ_WRITE, resg);
+                        } else {
+                            passResources.overwrites.emplace_back(eraseView(resg, attachment.name));
+                        }
+                    } else {
+                        addPassResource(passResources, attachment.name, attachment.access, resg);
+                    }
+                }
+                for (const auto& e : make_iterator_range(out_edges(v, g))) {
+                    if (std::holds_alternative<RenderQueueData>(g[e.m_target].data)) {
+                        const auto& queueData = std::get<RenderQueueData>(g[e.m_target].data);
+                        for (const auto& res : queueData.resources) {
+                            addPassResource(passResources, res.name, res.access, resg);
+                        }
+                    }
+                }
+            },
+            [&](const ComputePassData& data) {
+                for (const auto& res : data.resources) {
+                    addPassResource(passResources, res.name, res.access, resg);
+                }
+            },
+            [&](const CopyPassData& data) {
+                for (const auto& copy : data.copies) {
+                    addPassResource(passResources, copy.source, Access::READ, resg);
+                    addPassResource(passResources, copy.target, Access::WRITE, resg);
+                }
+                for (const auto& upload : data.uploads) {
+                    addPassResource(passResources, upload.name, Access::WRITE, resg);
+                }
+                for (const auto& fill : data.fills) {
+                    addPassResource(passResources, fill.name, Access::WRITE, resg);
+                }
+            },
+            [](const auto&) {
+            },
+        },
+        g[v].data);
+    return passResources;
+}
+
+uint32_t sharedResourceCount(const PassResources& lhs, const PassResources& rhs) {
+    uint32_t count{0};
+    for (const auto& lhsRes : {&lhs.reads, &lhs.writes, &lhs.overwrites}) {
+        for (const auto& rhsRes : {&rhs.reads, &rhs.writes, &rhs.overwrites}) {
+            for (auto name : *lhsRes) {
+                count += static_cast<uint32_t>(std::count(rhsRes->begin(), rhsRes->end(), name));
+            }
+        }
+    }
+    return count;
+}
+
+// Passes are connected by the resources they touch in declaration order. Passes not contributing to
+// swapchain/persistent/external resources are culled, the rest is ordered so that passes of the same
+// kind and sharing resources stay adjacent, fewer barriers and layout transitions in between.
+std::vector<RenderGraph::VertexType> compilePasses(RenderGraph& rg, ResourceGraph& resg) {
+    const auto& g = rg.impl();
+    std::vector<RenderGraph::VertexType> passes;
+    for (auto v : make_iterator_range(vertices(g))) {
+        if (!std::holds_alternative<RenderQueueData>(g[v].data)) {
+            passes.emplace_back(v);
+        }
+    }
+
+    auto passCount = static_cast<uint32_t>(passes.size());
+    std::vector<PassResources> passResources(passCount);
+    // read after write, producers are kept as long as consumer is alive
+    std::vector<std::vector<uint32_t>> producers(passCount);
+    // all ordering constraints: RAW, WAR, WAW
+    std::vector<std::vector<uint32_t>> successors(passCount);
+    std::vector<bool> alive(passCount, false);
+
+    struct ResourceState {
+        // shader writes may be partial, every writer since the last overwrite counts
+        std::vector<uint32_t> writers;
+        std::vector<uint32_t> readers;
+    };
+    std::unordered_map<StringID, ResourceState> states;
+    auto addEdge = [&](uint32_t from, uint32_t to) {
+        if (from != to) {
+            successors[from].emplace_back(to);
+        }
+    };
+
+    int32_t lastCopy{-1};
+    for (uint32_t i = 0; i < passCount; ++i) {
+        passResources[i] = collectPassResources(rg, passes[i], resg);
+        const auto& [reads, writes, overwrites] = passResources[i];
+
+        // copy passes carry host data which may be consumed outside of the graph(mesh buffers...),
+        // they are never culled and keep their position.
+        bool isCopy = std::holds_alternative<CopyPassData>(g[passes[i]].data);
+        if (isCopy) {
+            for (uint32_t j = 0; j < i; ++j) {
+                addEdge(j, i);
+            }
+            lastCopy = static_cast<int32_t>(i);
+            alive[i] = true;
+        } else if (lastCopy >= 0) {
+            addEdge(static_cast<uint32_t>(lastCopy), i);
+        }
+
+        for (auto name : reads) {
+            for (auto writer : states[name].writers) {
+                producers[i].emplace_back(writer);
+                addEdge(writer, i);
+            }
+        }
+        for (const auto& written : {&writes, &overwrites}) {
+            for (auto name : *written) {
+                const auto& state = states[name];
+                for (auto writer : state.writers) {
+                    addEdge(writer, i);
+                }
+                for (auto reader : state.readers) {
+                    addEdge(reader, i);
+                }
+                alive[i] = alive[i] || resg.get(name).residency != ResourceResidency::DONT_CARE;
+            }
+        }
+
+        for (auto name : reads) {
+            states[name].readers.emplace_back(i);
+        }
+        for (auto name : writes) {
+            auto& state = states[name];
+            state.writers.emplace_back(i);
+            state.readers.clear();
+        }
+        for (auto name : overwrites) {
+            auto& state = states[name];
+            state.writers.assign(1, i);
+            state.readers.clear();
+        }
+    }
+
+    std::vector<uint32_t> stack;
+    for (uint32_t i = 0; i < passCount; ++i) {
+        if (alive[i]) {
+            stack.emplace_back(i);
+        }
+    }
+    while (!stack.empty()) {
+        auto i = stack.back();
+        stack.pop_back();
+        for (auto producer : producers[i]) {
+            if (!alive[producer]) {
+                alive[producer] = true;
+                stack.emplace_back(producer);
+            }
+        }
+    }
+
+    std::vector<uint32_t> inDegrees(passCount, 0);
+    for (uint32_t i = 0; i < passCount; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+        for (auto successor : successors[i]) {
+            inDegrees[successor] += alive[successor] ? 1 : 0;
+        }
+    }
+
+    std::vector<uint32_t> ready;
+    for (uint32_t i = 0; i < passCount; ++i) {
+        if (alive[i] && !inDegrees[i]) {
+            ready.emplace_back(i);
+        }
+    }
+
+    std::vector<RenderGraph::VertexType> ordered;
+    int32_t last{-1};
+    while (!ready.empty()) {
+        auto best = ready.begin();
+        if (last >= 0) {
+            auto lastKind = g[passes[last]].data.index();
+            auto score = [&](uint32_t i) {
+                return std::make_tuple(g[passes[i]].data.index() != lastKind,
+                                       -static_cast<int64_t>(sharedResourceCount(passResources[i], passResources[last])),
+                                       i);
+            };
+            best = std::min_element(ready.begin(), ready.end(), [&](uint32_t lhs, uint32_t rhs) {
+                return score(lhs) < score(rhs);
+            });
+        } else {
+            best = std::min_element(ready.begin(), ready.end());
+        }
+        auto current = *best;
+        ready.erase(best);
+        ordered.emplace_back(passes[current]);
+        last = static_cast<int32_t>(current);
+
+        for (auto successor : successors[current]) {
+            if (alive[successor] && !--inDegrees[successor]) {
+                ready.emplace_back(successor);
+            }
+        }
+    }
+    return ordered;
+}
+
+// Compute passes move to the async compute queue unless they depend on graphics work which waits for async
+// compute itself. Graphics passes are then grouped into producers of async inputs(submitted first), work
+// independent of async compute(overlaps with it) and the rest, which waits for it on a semaphore.
+// Passes touching a common resource count as dependent, a resource is never used by both queues at once.
+AccessGraph::AsyncCompute scheduleAsyncCompute(RenderGraph& rg,
+                                               ResourceGraph& resg,
+                                               bool dedicatedCompute,
+                                               std::vector<RenderGraph::VertexType>& passes,
+                                               std::unordered_set<RenderGraph::VertexType>& asyncPasses) {
+    const auto& g = rg.impl();
+    auto passCount = static_cast<uint32_t>(passes.size());
+    std::vector<std::vector<uint32_t>> predecessors(passCount);
+    std::vector<bool> touchesSwapchain(passCount, false);
+    // first or last user of a non-transient resource, its ownership has to stay with graphics queue across frames
+    std::vector<bool> crossesFrame(passCount, false);
+    std::unordered_map<StringID, std::vector<uint32_t>> users;
+
+    int32_t lastCopy{-1};
+    for (uint32_t i = 0; i < passCount; ++i) {
+        if (std::holds_alternative<CopyPassData>(g[passes[i]].data)) {
+            for (uint32_t j = 0; j < i; ++j) {
+                predecessors[i].emplace_back(j);
+            }
+            lastCopy = static_cast<int32_t>(i);
+        } else if (lastCopy >= 0) {
+            predecessors[i].emplace_back(static_cast<uint32_t>(lastCopy));
+        }
+
+        const auto& [reads, writes, overwrites] = collectPassResources(rg, passes[i], resg);
+        for (const auto& names : {&reads, &writes, &overwrites}) {
+            for (auto name : *names) {
+                auto& passUsers = users[name];
+                if (!passUsers.empty() && passUsers.back() == i) {
+                    continue;
+                }
+                predecessors[i].insert(predecessors[i].end(), passUsers.begin(), passUsers.end());
+                passUsers.emplace_back(i);
+                touchesSwapchain[i] = touchesSwapchain[i] || resg.get(name).residency == ResourceResidency::SWAPCHAIN;
+            }
+        }
+    }
+    for (const auto& [name, passUsers] : users) {
+        if (resg.get(name).residency != ResourceResidency::DONT_CARE) {
+            crossesFrame[passUsers.front()] = true;
+            crossesFrame[passUsers.back()] = true;
+        }
+    }
+
+    std::vector<bool> async(passCount, false);
+    // depends on async compute, directly or through other passes
+    std::vector<bool> waitsAsync(passCount, false);
+    // swapchain image is acquired by the last graphics submission only
+    std::vector<bool> reachesSwapchain(passCount, false);
+    for (uint32_t i = 0; i < passCount; ++i) {
+        bool candidate{false};
+        if (std::holds_alternative<ComputePassData>(g[passes[i]].data)) {
+            auto hint = std::get<ComputePassData>(g[passes[i]].data).queueHint;
+            candidate = hint == QueueHint::ASYNC || (hint == QueueHint::AUTO && dedicatedCompute);
+            candidate = candidate && !(dedicatedCompute && crossesFrame[i]);
+        }
+        reachesSwapchain[i] = touchesSwapchain[i];
+        for (auto predecessor : predecessors[i]) {
+            candidate = candidate && (async[predecessor] || !waitsAsync[predecessor]);
+            waitsAsync[i] = waitsAsync[i] || waitsAsync[predecessor];
+            reachesSwapchain[i] = reachesSwapchain[i] || reachesSwapchain[predecessor];
+        }
+        async[i] = candidate && !reachesSwapchain[i];
+        waitsAsync[i] = waitsAsync[i] || async[i];
+    }
+
+    AccessGraph::AsyncCompute asyncCompute{};
+    if (std::find(async.begin(), async.end(), true) == async.end()) {
+        return asyncCompute;
+    }
+
+    std::vector<bool> feedsAsync(passCount, false);
+    for (uint32_t i = passCount; i-- > 0;) {
+        if (!async[i] && !feedsAsync[i]) {
+            continue;
+        }
+        for (auto predecessor : predecessors[i]) {
+            if (!async[predecessor]) {
+                feedsAsync[predecessor] = true;
+            }
+        }
+    }
+    std::vector<bool> late(passCount, false);
+    for (uint32_t i = 0; i < passCount; ++i) {
+        if (async[i] || feedsAsync[i]) {
+            continue;
+        }
+        late[i] = waitsAsync[i] || touchesSwapchain[i];
+        for (auto predecessor : predecessors[i]) {
+            late[i] = late[i] || late[predecessor];
+        }
+    }
+
+    std::vector<RenderGraph::VertexType> ordered;
+    ordered.reserve(passCount);
+    auto append = [&](auto&& pred) {
+        for (uint32_t i = 0; i < passCount; ++i) {
+            if (pred(i)) {
+                ordered.emplace_back(passes[i]);
+            }
+        }
+        return static_cast<uint32_t>(ordered.size());
+    };
+    asyncCompute.begin = append([&](uint32_t i) { return feedsAsync[i]; });
+    asyncCompute.end = append([&](uint32_t i) { return async[i]; });
+    asyncCompute.overlapEnd = append([&](uint32_t i) { return !async[i] && !feedsAsync[i] && !late[i]; });
+    append([&](uint32_t i) { return late[i]; });
+
+    for (uint32_t i = asyncCompute.begin; i < asyncCompute.end; ++i) {
+        asyncPasses.emplace(ordered[i]);
+    }
+    passes = std::move(ordered);
+    return asyncCompute;
+}
+
+// Barriers between passes of different queues only have to start after the semaphore wait, which already
+// orders them. With distinct queue families ownership is released at the end of the producer's submission
+// and acquired by the barrier.
+void addQueueTransfers(AccessGraph::CompiledGraph& compiled, uint32_t graphicsFamily, uint32_t computeFamily) {
+    auto& asyncCompute = compiled.asyncCompute;
+    auto transfer = [&](auto& barriers, RenderGraph::VertexType consumer, auto releaseBarriers) {
+        bool asyncConsumer = compiled.asyncPasses.contains(consumer);
+        for (auto& barrier : barriers) {
+            if (barrier.producer == RenderGraph::null_vertex() ||
+                compiled.asyncPasses.contains(barrier.producer) == asyncConsumer) {
+                continue;
+            }
+            if (graphicsFamily != computeFamily) {
+                barrier.info.srcQueueIndex = asyncConsumer ? graphicsFamily : computeFamily;
+                barrier.info.dstQueueIndex = asyncConsumer ? computeFamily : graphicsFamily;
+                auto& release = asyncConsumer ? asyncCompute.graphicsRelease : asyncCompute.computeRelease;
+                auto& released = (release.*releaseBarriers).emplace_back(barrier);
+                released.info.dstStage = rhi::PipelineStage::BOTTOM_OF_PIPE;
+                released.info.dstAccessFlag = rhi::AccessFlags::NONE;
+            }
+            auto& waitStage = asyncConsumer ? asyncCompute.computeWaitStage : asyncCompute.graphicsWaitStage;
+            waitStage |= barrier.info.dstStage;
+            barrier.info.srcStage = barrier.info.dstStage;
+            barrier.info.srcAccessFlag = rhi::AccessFlags::NONE;
+        }
+    };
+    for (auto& [consumer, barriers] : compiled.bufferBarrierMap) {
+        transfer(barriers, consumer, &AccessGraph::QueueRelease::bufferBarriers);
+    }
+    for (auto& [consumer, barriers] : compiled.imageBarrierMap) {
+        transfer(barriers, consumer, &AccessGraph::QueueRelease::imageBarriers);
+    }
+}
+
+// barriers on the same resource and transition within a batch collapse into one.
+template <typename T>
+void mergeBarriers(std::vector<T>& barriers) {
+    std::vector<T> merged;
+    merged.reserve(barriers.size());
+    for (auto& barrier : barriers) {
+        auto iter = std::find_if(merged.begin(), merged.end(), [&](const T& prev) {
+            if constexpr (std::is_same_v<T, AccessGraph::ImageBarrier>) {
+                return prev.name == barrier.name &&
+                       prev.info.oldLayout == barrier.info.oldLayout &&
+                       prev.info.newLayout == barrier.info.newLayout;
+            } else {
+                return prev.name == barrier.name;
+            }
+        });
+        if (iter == merged.end()) {
+            merged.emplace_back(std::move(barrier));
+        } else {
+            iter->info.srcStage |= barrier.info.srcStage;
+            iter->info.dstStage |= barrier.info.dstStage;
+            iter->info.srcAccessFlag |= barrier.info.srcAccessFlag;
+            iter->info.dstAccessFlag |= barrier.info.dstAccessFlag;
+        }
+    }
+    barriers = std::move(merged);
+}
+
+// First uses of a resource this frame(no producer) are moved into the batch of the first pass recording
+// barriers on the same queue, so passes that only start using resources don't each emit a barrier batch.
+// Aliased transients wait for passes in between and external or swapchain images for semaphores, they stay.
+void hoistFirstUseBarriers(AccessGraph::CompiledGraph& compiled, ResourceGraph& resg, RenderGraph& rg) {
+    std::unordered_set<StringID> aliased;
+    for (const auto& placement : compiled.transientPlan.placements) {
+        if (!placement.aliases.empty()) {
+            aliased.emplace(placement.name);
+        }
+    }
+    auto hoistable = [&](StringID name, RenderGraph::VertexType producer) {
+        const auto& resource = resg.get(name);
+        return producer == RenderGraph::null_vertex() && !aliased.contains(name) &&
+               (resource.residency == ResourceResidency::DONT_CARE || resource.residency == ResourceResidency::PERSISTENT);
+    };
+    auto recordsBarriers = [&](RenderGraph::VertexType v) {
+        const auto& data = rg.impl()[v].data;
+        return std::holds_alternative<RenderPassData>(data) || std::holds_alternative<ComputePassData>(data);
+    };
+
+    RenderGraph::VertexType first[2]{RenderGraph::null_vertex(), RenderGraph::null_vertex()};
+    for (auto v : compiled.passes) {
+        if (!recordsBarriers(v)) {
+            continue;
+        }
+        auto& target = first[compiled.asyncPasses.contains(v)];
+        if (target == RenderGraph::null_vertex()) {
+            target = v;
+            continue;
+        }
+        auto hoist = [&](auto& barrierMap) {
+            auto iter = barrierMap.find(v);
+            if (iter == barrierMap.end()) {
+                return;
+            }
+            auto& targetBarriers = barrierMap[target];
+            std::erase_if(iter->second, [&](auto& barrier) {
+                if (hoistable(barrier.name, barrier.producer)) {
+                    targetBarriers.emplace_back(barrier);
+                    return true;
+                }
+                return false;
+            });
+        };
+        hoist(compiled.bufferBarrierMap);
+        hoist(compiled.imageBarrierMap);
     }
 }
 
+// A barrier whose producer ran two or more passes before its consumer is split: the event is set right after
+// the producer and waited before the consumer, passes in between don't stall on it.
+void splitDeferredBarriers(AccessGraph::CompiledGraph& compiled) {
+    std::unordered_map<RenderGraph::VertexType, uint32_t> passIndices;
+    for (uint32_t i = 0; i < compiled.passes.size(); ++i) {
+        passIndices.emplace(compiled.passes[i], i);
+    }
+    auto isSplit = [&](RenderGraph::VertexType producer, RenderGraph::VertexType consumer) {
+        auto producerIter = passIndices.find(producer);
+        auto consumerIter = passIndices.find(consumer);
+        // events don't work across queues
+        return producerIter != passIndices.end() &&
+               consumerIter != passIndices.end() &&
+               consumerIter->second > producerIter->second + 1 &&
+               compiled.asyncPasses.contains(producer) == compiled.asyncPasses.contains(consumer);
+    };
+
+    std::map<std::pair<RenderGraph::VertexType, RenderGraph::VertexType>, uint32_t> splitIndices;
+    auto getSplit = [&](RenderGraph::VertexType producer, RenderGraph::VertexType consumer) -> AccessGraph::SplitBarrier& {
+        auto [iter, inserted] = splitIndices.emplace(std::make_pair(producer, consumer), static_cast<uint32_t>(compiled.splitBarriers.size()));
+        if (inserted) {
+            compiled.splitBarriers.emplace_back(producer, consumer);
+            compiled.signalMap[producer].emplace_back(iter->second);
+            compiled.waitMap[consumer].emplace_back(iter->second);
+        }
+        return compiled.splitBarriers[iter->second];
+    };
+
+    for (auto& [consumer, barriers] : compiled.bufferBarrierMap) {
+        std::erase_if(barriers, [&, consumer = consumer](AccessGraph::BufferBarrier& barrier) {
+            if (isSplit(barrier.producer, consumer)) {
+                getSplit(barrier.producer, consumer).bufferBarriers.emplace_back(barrier);
+                return true;
+            }
+            return false;
+        });
+        mergeBarriers(barriers);
+    }
+    for (auto& [consumer, barriers] : compiled.imageBarrierMap) {
+        std::erase_if(barriers, [&, consumer = consumer](AccessGraph::ImageBarrier& barrier) {
+            if (isSplit(barrier.producer, consumer)) {
+                getSplit(barrier.producer, consumer).imageBarriers.emplace_back(barrier);
+                return true;
+            }
+            return false;
+        });
+        mergeBarriers(barriers);
+    }
+    for (auto& split : compiled.splitBarriers) {
+        mergeBarriers(split.bufferBarriers);
+        mergeBarriers(split.imageBarriers);
+    }
+}
+
+std::vector<TransientRange> collectTransients(const AccessGraph::ResourceAccessMap& accessMap,
+                                              const std::vector<RenderGraph::VertexType>& passes,
+                                              const std::unordered_set<RenderGraph::VertexType>& asyncPasses,
+                                              ResourceGraph& resg,
+                                              RenderGraph& rg) {
+    std::unordered_map<RenderGraph::VertexType, uint32_t> passIndices;
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        passIndices.emplace(passes[i], i);
+    }
+
+    std::vector<TransientRange> ranges;
+    for (const auto& [name, accesses] : accessMap) {
+        const auto& resDetail = resg.get(name);
+        if (resDetail.residency != ResourceResidency::DONT_CARE || !std::holds_alternative<ImageData>(resDetail.data)) {
+            continue;
+        }
+        TransientRange range{name, std::numeric_limits<uint32_t>::max(), 0};
+        // lifetime on async compute overlaps with graphics work out of pass order, not aliased
+        bool async{false};
+        for (const auto& access : accesses) {
+            auto parentPass = getParentPass(rg, access.v);
+            parentPass = parentPass == RenderGraph::null_vertex() ? access.v : parentPass;
+            auto passIndex = passIndices.at(parentPass);
+            range.first = std::min(range.first, passIndex);
+            range.last = std::max(range.last, passIndex);
+            async = async || asyncPasses.contains(parentPass);
+        }
+        if (!async) {
+            ranges.emplace_back(range);
+        }
+    }
+    return ranges;
+}
+
+// first use of an aliased image waits for whatever touched its memory last, this frame or the previous one.
+void addAliasingBarriers(const TransientPlan& plan,
+                         const AccessGraph::ResourceAccessMap& accessMap,
+                         RenderGraph& rg,
+                         AccessGraph::ImageBarrierMap& imageBarrierMap) {
+    for (const auto& placement : plan.placements) {
+        if (placement.aliases.empty()) {
+            continue;
+        }
+        const auto& firstAccess = accessMap.at(placement.name).front();
+        auto parentPass = getParentPass(rg, firstAccess.v);
+        parentPass = parentPass == RenderGraph::null_vertex() ? firstAccess.v : parentPass;
+
+        auto& barriers = imageBarrierMap[parentPass];
+        auto iter = std::find_if(barriers.begin(), barriers.end(), [&](const AccessGraph::ImageBarrier& barrier) {
+            return barrier.name == placement.name;
+        });
+        if (iter == barriers.end()) {
+            continue;
+        }
+        for (auto alias : placement.aliases) {
+            const auto& lastAccess = accessMap.at(alias).back();
+            iter->info.srcStage |= lastAccess.stage;
+            iter->info.srcAccessFlag |= lastAccess.access;
+        }
+    }
+}
+
+namespace {
+// graphs are rebuilt per frame by samples, a handful of variants(resize, toggled passes) is expected.
+constexpr size_t MAX_COMPILED_GRAPHS = 16;
+} // namespace
+
 AccessGraph::AccessGraph(RenderGraph& rg, ResourceGraph& resg, ShaderGraph& sg) : _rg(rg), _resg(resg), _sg(sg) {}
 
 void AccessGraph::analyze() {
+    structureKey(_key, _rg, _resg);
+    _hash = std::hash<std::string>{}(_key);
+    auto iter = _compiledGraphs.find(_hash);
+    // a colliding graph is compiled over the cached one
+    _cacheHit = iter != _compiledGraphs.end() && iter->second.key == _key;
+    if (_cacheHit) {
+        _current = &iter->second;
+        // nothing to analyze, only carry resource states over to next frame
+        for (const auto& [name, access] : _current->finalAccesses) {
+            _resg.get(name).access = access;
+        }
+        _resg.applyTransients(_current->transientPlan);
+        return;
+    }
+
+    if (_compiledGraphs.size() >= MAX_COMPILED_GRAPHS) {
+        _compiledGraphs.clear();
+    }
+    _current = &_compiledGraphs[_hash];
+    *_current = CompiledGraph{};
+    _current->key = _key;
+
     auto indexMap = boost::get(boost::vertex_index, _rg.impl());
     auto colorMap = boost::make_vector_property_map<boost::default_color_type>(indexMap);
 
-    AccessVisitor visitor{{}, _resg, _sg, _accessMap, _renderPassInfoMap, _frameBufferInfoMap};
-    for (auto vertex : boost::make_iterator_range(boost::vertices(_rg.impl()))) {
-        if (!std::holds_alternative<RenderQueueData>(_rg.impl()[vertex].data)) {
-            boost::depth_first_visit(_rg.impl(), vertex, visitor, colorMap);
-        }
+    _current->passes = compilePasses(_rg, _resg);
+    _current->asyncCompute = scheduleAsyncCompute(_rg, _resg, _graphicsFamily != _computeFamily, _current->passes, _current->asyncPasses);
+
+    AccessVisitor visitor{{}, _resg, _sg, _current->accessMap, _current->renderPassInfoMap, _current->frameBufferInfoMap};
+    for (auto vertex : _current->passes) {
+        boost::depth_first_visit(_rg.impl(), vertex, visitor, colorMap);
     }
 
-    populateBarrier(_accessMap,  _resg, _rg, _bufferBarrierMap, _imageBarrierMap, _presentBarrier);
+    populateBarrier(_current->accessMap,
+                    _resg,
+                    _rg,
+                    _current->bufferBarrierMap,
+                    _current->imageBarrierMap,
+                    _current->presentBarrier,
+                    _current->finalAccesses,
+                    _current->asyncPasses);
+
+    auto transients = collectTransients(_current->accessMap, _current->passes, _current->asyncPasses, _resg, _rg);
+    _current->transientPlan = _resg.planTransients(transients);
+    addAliasingBarriers(_current->transientPlan, _current->accessMap, _rg, _current->imageBarrierMap);
+    addQueueTransfers(*_current, _graphicsFamily, _computeFamily);
+    hoistFirstUseBarriers(*_current, _resg, _rg);
+    splitDeferredBarriers(*_current);
+    _resg.applyTransients(_current->transientPlan);
 }
 
 std::vector<AccessGraph::BufferBarrier>* AccessGraph::getBufferBarrier(RenderGraph::VertexType v) {
-    if (_bufferBarrierMap.contains(v)) {
-        return &_bufferBarrierMap[v];
+    if (_current && _current->bufferBarrierMap.contains(v)) {
+        return &_current->bufferBarrierMap[v];
     }
     return nullptr;
 }
 
 std::vector<AccessGraph::ImageBarrier>* AccessGraph::getImageBarrier(RenderGraph::VertexType v) {
-    if (_imageBarrierMap.contains(v)) {
-        return &_imageBarrierMap[v];
+    if (_current && _current->imageBarrierMap.contains(v)) {
+        return &_current->imageBarrierMap[v];
     }
     return nullptr;
 }
 
+std::vector<uint32_t>* AccessGraph::getSignals(RenderGraph::VertexType v) {
+    if (_current && _current->signalMap.contains(v)) {
+        return &_current->signalMap[v];
+    }
+    return nullptr;
+}
+
+std::vector<uint32_t>* AccessGraph::getWaits(RenderGraph::VertexType v) {
+    if (_current && _current->waitMap.contains(v)) {
+        return &_current->waitMap[v];
+    }
+    return nullptr;
+}
+
+std::vector<AccessGraph::SplitBarrier>& AccessGraph::splitBarriers() {
+    raum_check(_current, "render graph not analyzed");
+    return _current->splitBarriers;
+}
+
 rhi::RenderPassInfo* AccessGraph::getRenderPassInfo(RenderGraph::VertexType v) {
-    if (_renderPassInfoMap.contains(v)) {
-        return &_renderPassInfoMap[v];
+    if (_current && _current->renderPassInfoMap.contains(v)) {
+        return &_current->renderPassInfoMap[v];
     }
     return nullptr;
 }
 
 AccessGraph::FrameBuffer* AccessGraph::getFrameBufferInfo(RenderGraph::VertexType v) {
-    if (_frameBufferInfoMap.contains(v)) {
-        return &_frameBufferInfoMap[v];
+    if (_current && _current->frameBufferInfoMap.contains(v)) {
+        return &_current->frameBufferInfoMap[v];
+    }
+    return nullptr;
+}
+
+const std::vector<RenderGraph::VertexType>& AccessGraph::passes() const {
+    raum_check(_current, "render graph not analyzed");
+    return _current->passes;
+}
+
+AccessGraph::AsyncCompute* AccessGraph::asyncCompute() {
+    if (_current && _current->asyncCompute.begin != _current->asyncCompute.end) {
+        return &_current->asyncCompute;
     }
     return nullptr;
 }
 
+void AccessGraph::setQueueFamilies(uint32_t graphics, uint32_t compute) {
+    if (_graphicsFamily != graphics || _computeFamily != compute) {
+        _graphicsFamily = graphics;
+        _computeFamily = compute;
+        invalidate();
+    }
+}
+
 AccessGraph::ImageBarrier* AccessGraph::presentBarrier() {
-    if (!_presentBarrier.name.empty()) {
-        return &_presentBarrier;
+    if (_current && _current->presentBarrier.name.valid()) {
+        return &_current->presentBarrier;
     }
     return nullptr;
 }
 
-rhi::ImageLayout AccessGraph::getImageLayout(std::string_view name, unsigned long long v) {
+rhi::ImageLayout AccessGraph::getImageLayout(StringID name, RenderGraph::VertexType v) {
     auto res = rhi::ImageLayout::UNDEFINED;
     auto dsReadAspect = getDepthStencilReadAspect(_resg, name);
 
     auto resName = eraseView(_resg, name);
-    if (_accessMap.contains(resName)) {
-        const auto& accesses = _accessMap.at(resName);
+    if (_current && _current->accessMap.contains(resName)) {
+        const auto& accesses = _current->accessMap.find(resName)->second;
         auto iter = std::find_if(accesses.begin(), accesses.end(),
                                  [v](const Access& access) {
                                      return access.v == v;
@@ -562,12 +1339,13 @@ rhi::ImageLayout AccessGraph::getImageLayout(std::string_view name, unsigned lon
 }
 
 void AccessGraph::clear() {
-    _accessMap.clear();
-    _bufferBarrierMap.clear();
-    _imageBarrierMap.clear();
-    _renderPassInfoMap.clear();
-    _frameBufferInfoMap.clear();
-    _presentBarrier.name = "";
+    // compiled graphs are kept for following frames
+    _current = nullptr;
+}
+
+void AccessGraph::invalidate() {
+    _current = nullptr;
+    _compiledGraphs.clear();
 }
 
 } // namespace raum::graph
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <unordered_set>
 #include "RenderGraph.h"
 #include "ResourceGraph.h"
 #include "ShaderGraph.h"
@@ -15,25 +16,81 @@ public:
     };
 
     struct BufferBarrier {
-        std::string_view name;
+        StringID name;
         rhi::BufferBarrierInfo info;
+        // pass of the previous access, null if it happened in an earlier frame
+        RenderGraph::VertexType producer{RenderGraph::null_vertex()};
     };
 
     struct ImageBarrier {
-        std::string_view name;
+        StringID name;
         rhi::ImageBarrierInfo info;
+        RenderGraph::VertexType producer{RenderGraph::null_vertex()};
+    };
+
+    // signaled after producer, waited before consumer; passes in between overlap with it.
+    struct SplitBarrier {
+        RenderGraph::VertexType producer{RenderGraph::null_vertex()};
+        RenderGraph::VertexType consumer{RenderGraph::null_vertex()};
+        std::vector<BufferBarrier> bufferBarriers;
+        std::vector<ImageBarrier> imageBarriers;
+    };
+
+    // queue family ownership given up by one queue before the other one acquires it
+    struct QueueRelease {
+        std::vector<BufferBarrier> bufferBarriers;
+        std::vector<ImageBarrier> imageBarriers;
+    };
+
+    // passes[0, begin) are submitted to the graphics queue ahead of async compute, [begin, end) run on the
+    // compute queue, [end, overlapEnd) on the graphics queue alongside it and the rest waits for it.
+    struct AsyncCompute {
+        uint32_t begin{0};
+        uint32_t end{0};
+        uint32_t overlapEnd{0};
+        // semaphore wait stages
+        rhi::PipelineStage computeWaitStage{rhi::PipelineStage::COMPUTE_SHADER};
+        rhi::PipelineStage graphicsWaitStage{rhi::PipelineStage::BOTTOM_OF_PIPE};
+        // recorded at the end of the graphics submission before async compute / of async compute
+        QueueRelease graphicsRelease;
+        QueueRelease computeRelease;
     };
 
     struct FrameBuffer {
-        std::vector<std::string_view> images;
+        std::vector<StringID> images;
         rhi::FrameBufferInfo info;
     };
 
-    using ResourceAccessMap = std::unordered_map<std::string_view, std::vector<Access>, hash_string, std::equal_to<>>;
+    using ResourceAccessMap = std::unordered_map<StringID, std::vector<Access>>;
     using BufferBarrierMap = std::unordered_map<RenderGraph::VertexType, std::vector<BufferBarrier>>;
     using ImageBarrierMap = std::unordered_map<RenderGraph::VertexType, std::vector<ImageBarrier>>;
     using RenderPassInfoMap = std::unordered_map<RenderGraph::VertexType, rhi::RenderPassInfo>;
     using FrameBufferInfoMap = std::unordered_map<RenderGraph::VertexType, FrameBuffer>;
+    using SplitBarrierMap = std::unordered_map<RenderGraph::VertexType, std::vector<uint32_t>>;
+
+    // analyze result of a render graph, reused as long as the graph structure stays the same.
+    struct CompiledGraph {
+        // full structure the graph was compiled from, compared on a hash hit
+        std::string key;
+        ResourceAccessMap accessMap;
+        BufferBarrierMap bufferBarrierMap;
+        ImageBarrierMap imageBarrierMap;
+        RenderPassInfoMap renderPassInfoMap;
+        FrameBufferInfoMap frameBufferInfoMap;
+        ImageBarrier presentBarrier{};
+        std::vector<SplitBarrier> splitBarriers;
+        // pass -> indices of split barriers it signals/waits
+        SplitBarrierMap signalMap;
+        SplitBarrierMap waitMap;
+        // access state of non-transient resources at the end of the frame
+        std::vector<std::pair<StringID, rhi::AccessFlags>> finalAccesses;
+        // culled and ordered top level passes
+        std::vector<RenderGraph::VertexType> passes;
+        // memory placement of transient images
+        TransientPlan transientPlan;
+        AsyncCompute asyncCompute;
+        std::unordered_set<RenderGraph::VertexType> asyncPasses;
+    };
 
     AccessGraph() = delete;
     AccessGraph(RenderGraph& rg, ResourceGraph& resg, ShaderGraph& sg);
@@ -42,24 +99,42 @@ public:
 
     std::vector<BufferBarrier>* getBufferBarrier(RenderGraph::VertexType v);
     std::vector<ImageBarrier>* getImageBarrier(RenderGraph::VertexType v);
+    std::vector<uint32_t>* getSignals(RenderGraph::VertexType v);
+    std::vector<uint32_t>* getWaits(RenderGraph::VertexType v);
+    std::vector<SplitBarrier>& splitBarriers();
     rhi::RenderPassInfo* getRenderPassInfo(RenderGraph::VertexType v);
     FrameBuffer* getFrameBufferInfo(RenderGraph::VertexType v);
     ImageBarrier* presentBarrier();
+    // passes to execute, in order
+    const std::vector<RenderGraph::VertexType>& passes() const;
+    // nullptr if every pass runs on the graphics queue
+    AsyncCompute* asyncCompute();
+
+    // async compute is picked automatically only if families differ
+    void setQueueFamilies(uint32_t graphics, uint32_t compute);
 
-    rhi::ImageLayout getImageLayout(std::string_view name, RenderGraph::VertexType v);
+    rhi::ImageLayout getImageLayout(StringID name, RenderGraph::VertexType v);
 
     void clear();
 
+    size_t structureHash() const { return _hash; }
+    bool cacheHit() const { return _cacheHit; }
+
+    // drop all compiled graphs, e.g. resources are recreated
+    void invalidate();
+
 private:
     RenderGraph& _rg;
     ResourceGraph& _resg;
     ShaderGraph& _sg;
-    ResourceAccessMap _accessMap;
-    BufferBarrierMap _bufferBarrierMap;
-    ImageBarrierMap _imageBarrierMap;
-    RenderPassInfoMap _renderPassInfoMap;
-    FrameBufferInfoMap _frameBufferInfoMap;
-    ImageBarrier _presentBarrier{};
+    std::unordered_map<size_t, CompiledGraph> _compiledGraphs;
+    CompiledGraph* _current{nullptr};
+    // reused across frames
+    std::string _key;
+    size_t _hash{0};
+    bool _cacheHit{false};
+    uint32_t _graphicsFamily{0};
+    uint32_t _computeFamily{0};
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,469 @@
+#include "BVH.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <thread>
+#include "core/thread/execution.h"
+#include "core/utils/Trace.h"
+
+namespace raum::graph {
+
+namespace {
+
+constexpr uint32_t SAH_BINS = 16;
+// deeper nodes split at the median, which bounds the depth by log2 of the object count
+constexpr uint32_t SAH_MAX_DEPTH = 64;
+constexpr uint32_t MAX_DEPTH = SAH_MAX_DEPTH + 32;
+// smaller inputs build on the calling thread
+constexpr uint32_t PARALLEL_BUILD_THRESHOLD = 16384;
+
+struct BuildItem {
+    scene::AABB bounds;
+    Vec3f centroid;
+    uint32_t object;
+};
+
+struct Bin {
+    scene::AABB bounds{Vec3f(std::numeric_limits<float>::max()), Vec3f(std::numeric_limits<float>::lowest())};
+    uint32_t count{0};
+};
+
+void grow(scene::AABB& aabb, const scene::AABB& rhs) {
+    aabb.minBound = glm::min(aabb.minBound, rhs.minBound);
+    aabb.maxBound = glm::max(aabb.maxBound, rhs.maxBound);
+}
+
+float halfArea(const scene::AABB& aabb) {
+    auto extent = aabb.maxBound - aabb.minBound;
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+scene::AABB bounds(std::span<const BuildItem> items) {
+    Bin bin;
+    for (const auto& item : items) {
+        grow(bin.bounds, item.bounds);
+    }
+    return bin.bounds;
+}
+
+// reorders `items` and returns the size of the left half, 0 makes a leaf.
+uint32_t partition(std::span<BuildItem> items, uint32_t depth, uint32_t maxObjectsPerNode) {
+    auto count = static_cast<uint32_t>(items.size());
+    if (count <= maxObjectsPerNode) {
+        return 0;
+    }
+    Vec3f centroidMin(std::numeric_limits<float>::max());
+    Vec3f centroidMax(std::numeric_limits<float>::lowest());
+    for (const auto& item : items) {
+        centroidMin = glm::min(centroidMin, item.centroid);
+        centroidMax = glm::max(centroidMax, item.centroid);
+    }
+    auto extent = centroidMax - centroidMin;
+
+    uint32_t bestAxis{0};
+    uint32_t bestBin{SAH_BINS};
+    float bestCost{std::numeric_limits<float>::max()};
+    if (depth < SAH_MAX_DEPTH) {
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            if (extent[axis] <= 0.0f) {
+                continue;
+            }
+            float scale = SAH_BINS / extent[axis];
+            std::array<Bin, SAH_BINS> bins{};
+            for (const auto& item : items) {
+                auto bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((item.centroid[axis] - centroidMin[axis]) * scale));
+                grow(bins[bin].bounds, item.bounds);
+                ++bins[bin].count;
+            }
+            // right to left sweep first, then evaluate each plane on the way back
+            std::array<float, SAH_BINS> rightCosts{};
+            Bin right;
+            for (uint32_t i = SAH_BINS - 1; i > 0; --i) {
+                grow(right.bounds, bins[i].bounds);
+                right.count += bins[i].count;
+                rightCosts[i] = right.count ? halfArea(right.bounds) * right.count : 0.0f;
+            }
+            Bin left;
+            for (uint32_t i = 0; i < SAH_BINS - 1; ++i) {
+                grow(left.bounds, bins[i].bounds);
+                left.count += bins[i].count;
+                if (!left.count || left.count == count) {
+                    continue;
+                }
+                float cost = halfArea(left.bounds) * left.count + rightCosts[i + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                }
+            }
+        }
+    }
+
+    if (bestBin < SAH_BINS) {
+        float scale = SAH_BINS / extent[bestAxis];
+        auto iter = std::partition(items.begin(), items.end(), [&](const BuildItem& item) {
+            auto bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((item.centroid[bestAxis] - centroidMin[bestAxis]) * scale));
+            return bin <= bestBin;
+        });
+        return static_cast<uint32_t>(std::distance(items.begin(), iter));
+    }
+
+    // coincident centroids or too deep
+    uint32_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    auto mid = count / 2;
+    std::nth_element(items.begin(), items.begin() + mid, items.end(), [axis](const BuildItem& lhs, const BuildItem& rhs) {
+        return lhs.centroid[axis] < rhs.centroid[axis];
+    });
+    return mid;
+}
+
+// `first` is the offset of `items` in the object order, node links are relative to `nodes`.
+void buildSubtree(std::span<BuildItem> items,
+                  uint32_t first,
+                  uint32_t depth,
+                  uint32_t maxObjectsPerNode,
+                  std::vector<BVH::Node>& nodes) {
+    auto index = nodes.size();
+    auto aabb = bounds(items);
+    nodes.emplace_back(BVH::Node{.minBound = aabb.minBound, .maxBound = aabb.maxBound});
+    auto mid = partition(items, depth, maxObjectsPerNode);
+    if (!mid) {
+        nodes[index].index = first;
+        nodes[index].count = static_cast<uint32_t>(items.size());
+        return;
+    }
+    buildSubtree(items.first(mid), first, depth + 1, maxObjectsPerNode, nodes);
+    nodes[index].index = static_cast<uint32_t>(nodes.size());
+    buildSubtree(items.subspan(mid), first + mid, depth + 1, maxObjectsPerNode, nodes);
+}
+
+// the top levels are split serially, the subtrees below are independent tasks.
+struct BuildTask {
+    std::span<BuildItem> items;
+    uint32_t first{0};
+    uint32_t depth{0};
+    std::vector<BVH::Node> nodes;
+};
+
+struct TopNode {
+    scene::AABB bounds;
+    uint32_t left{0};
+    uint32_t right{0};
+    // index of the task building this subtree, or -1
+    int32_t task{-1};
+};
+
+uint32_t splitTop(std::span<BuildItem> items,
+                  uint32_t first,
+                  uint32_t depth,
+                  uint32_t taskDepth,
+                  uint32_t maxObjectsPerNode,
+                  std::vector<BuildTask>& tasks,
+                  std::vector<TopNode>& top) {
+    auto index = static_cast<uint32_t>(top.size());
+    top.emplace_back();
+    uint32_t mid{0};
+    if (depth < taskDepth && items.size() >= PARALLEL_BUILD_THRESHOLD) {
+        mid = partition(items, depth, maxObjectsPerNode);
+    }
+    if (!mid) {
+        top[index].task = static_cast<int32_t>(tasks.size());
+        tasks.emplace_back(BuildTask{items, first, depth});
+        return index;
+    }
+    top[index].bounds = bounds(items);
+    auto left = splitTop(items.first(mid), first, depth + 1, taskDepth, maxObjectsPerNode, tasks, top);
+    auto right = splitTop(items.subspan(mid), first + mid, depth + 1, taskDepth, maxObjectsPerNode, tasks, top);
+    top[index].left = left;
+    top[index].right = right;
+    return index;
+}
+
+void emitTop(uint32_t index, const std::vector<TopNode>& top, const std::vector<BuildTask>& tasks, std::vector<BVH::Node>& nodes) {
+    const auto& topNode = top[index];
+    if (topNode.task >= 0) {
+        auto offset = static_cast<uint32_t>(nodes.size());
+        for (auto node : tasks[topNode.task].nodes) {
+            if (!node.count) {
+                node.index += offset;
+            }
+            nodes.emplace_back(node);
+        }
+        return;
+    }
+    auto self = nodes.size();
+    nodes.emplace_back(BVH::Node{.minBound = topNode.bounds.minBound, .maxBound = topNode.bounds.maxBound});
+    emitTop(topNode.left, top, tasks, nodes);
+    nodes[self].index = static_cast<uint32_t>(nodes.size());
+    emitTop(topNode.right, top, tasks, nodes);
+}
+
+bool intersects(const scene::Camera* camera, const scene::AABB& aabb) {
+    return !camera->cullingEnabled() || scene::frustumCulling(camera->frustumPlanes(), aabb);
+}
+
+// bits of `candidates` whose frustum intersects `aabb`
+CameraMask frustumMask(std::span<const scene::Camera* const> cameras, const scene::AABB& aabb, CameraMask candidates) {
+    CameraMask visible{0};
+    for (; candidates; candidates &= candidates - 1) {
+        auto index = std::countr_zero(candidates);
+        if (intersects(cameras[index], aabb)) {
+            visible |= CameraMask{1} << index;
+        }
+    }
+    return visible;
+}
+
+} // namespace
+
+void BVH::build(std::span<const scene::RenderablePtr> renderables, uint32_t maxObjectsPerNode) {
+    std::vector<scene::AABB> bounds(renderables.size());
+    for (uint32_t i = 0; i < renderables.size(); ++i) {
+        bounds[i] = static_cast<const scene::MeshRenderer*>(renderables[i].get())->mesh()->aabb();
+    }
+    build(renderables, bounds, maxObjectsPerNode);
+}
+
+void BVH::build(std::span<const scene::RenderablePtr> renderables,
+                std::span<const scene::AABB> bounds,
+                uint32_t maxObjectsPerNode) {
+    raum_check(renderables.size() == bounds.size(), "one bounds per renderable");
+    _nodes.clear();
+    _objects.clear();
+    _bounds.resize(0);
+    _ids.clear();
+    _maxLeafCount = 0;
+    _refitPending = false;
+    _maxObjectsPerNode = std::max(maxObjectsPerNode, 1u);
+    maxObjectsPerNode = _maxObjectsPerNode;
+    if (renderables.empty()) {
+        return;
+    }
+
+    std::vector<BuildItem> items(renderables.size());
+    for (uint32_t i = 0; i < renderables.size(); ++i) {
+        items[i] = {bounds[i], (bounds[i].minBound + bounds[i].maxBound) * 0.5f, i};
+    }
+
+    _nodes.reserve(2 * items.size() / maxObjectsPerNode + 1);
+    if (items.size() < PARALLEL_BUILD_THRESHOLD) {
+        buildSubtree(items, 0, 0, maxObjectsPerNode, _nodes);
+    } else {
+        // a few tasks per worker keeps them busy despite uneven splits
+        auto taskDepth = static_cast<uint32_t>(std::bit_width(std::max(std::thread::hardware_concurrency(), 1u))) + 2;
+        std::vector<BuildTask> tasks;
+        std::vector<TopNode> top;
+        splitTop(items, 0, 0, taskDepth, maxObjectsPerNode, tasks, top);
+        auto buildTask = [&](uint32_t i) {
+            auto& task = tasks[i];
+            buildSubtree(task.items, task.first, task.depth, maxObjectsPerNode, task.nodes);
+        };
+        auto sched = getRenderThreadPool().get_scheduler();
+        auto sender = stdexec::schedule(sched) | stdexec::bulk(static_cast<uint32_t>(tasks.size()), std::move(buildTask));
+        stdexec::sync_wait(std::move(sender));
+        emitTop(0, top, tasks, _nodes);
+    }
+
+    _objects.reserve(items.size());
+    _bounds.resize(static_cast<uint32_t>(items.size()));
+    _ids.reserve(items.size());
+    _positions.resize(items.size());
+    for (const auto& item : items) {
+        _positions[item.object] = static_cast<uint32_t>(_objects.size());
+        _bounds.set(static_cast<uint32_t>(_objects.size()), item.bounds);
+        _objects.emplace_back(renderables[item.object]);
+        _ids.emplace_back(item.object);
+    }
+    _active.assign(items.size(), 1);
+    _leaves.resize(items.size());
+    _parents.assign(_nodes.size(), 0);
+    _builtAreas.resize(_nodes.size());
+    _dirty.assign(_nodes.size(), 0);
+    link(0, static_cast<uint32_t>(_nodes.size()));
+}
+
+void BVH::link(uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+        const auto& node = _nodes[i];
+        _builtAreas[i] = halfArea({node.minBound, node.maxBound});
+        if (node.count) {
+            for (uint32_t j = node.index; j < node.index + node.count; ++j) {
+                _leaves[j] = i;
+            }
+            _maxLeafCount = std::max(_maxLeafCount, node.count);
+        } else {
+            _parents[i + 1] = i;
+            _parents[node.index] = i;
+        }
+    }
+    _leafMasks.resize(_maxLeafCount);
+    _visible.resize(_maxLeafCount);
+}
+
+void BVH::setActive(uint32_t object, bool active) {
+    _active[_positions[object]] = active;
+}
+
+void BVH::setBounds(uint32_t object, const scene::AABB& bounds) {
+    auto position = _positions[object];
+    _bounds.set(position, bounds);
+    _dirty[_leaves[position]] = 1;
+    _refitPending = true;
+}
+
+void BVH::refit() {
+    if (!_refitPending) {
+        return;
+    }
+    _refitPending = false;
+
+    // children follow their parents, a reverse sweep refits them first
+    std::vector<uint32_t> degraded;
+    for (auto i = static_cast<uint32_t>(_nodes.size()); i-- > 0;) {
+        if (!_dirty[i]) {
+            continue;
+        }
+        _dirty[i] = 0;
+        auto& node = _nodes[i];
+        Bin bin;
+        if (node.count) {
+            for (uint32_t j = node.index; j < node.index + node.count; ++j) {
+                grow(bin.bounds, _bounds.get(j));
+            }
+        } else {
+            grow(bin.bounds, {_nodes[i + 1].minBound, _nodes[i + 1].maxBound});
+            grow(bin.bounds, {_nodes[node.index].minBound, _nodes[node.index].maxBound});
+            if (_maxObjectsPerNode == 1 &&
+                halfArea(bin.bounds) > REBUILD_AREA_RATIO * std::max(_builtAreas[i], std::numeric_limits<float>::epsilon())) {
+                degraded.emplace_back(i);
+            }
+        }
+        node.minBound = bin.bounds.minBound;
+        node.maxBound = bin.bounds.maxBound;
+        if (i) {
+            _dirty[_parents[i]] = 1;
+        }
+    }
+
+    // ascending, an ancestor is rebuilt before its degraded descendants are reached
+    uint32_t end{0};
+    for (auto iter = degraded.rbegin(); iter != degraded.rend(); ++iter) {
+        if (*iter >= end) {
+            end = rebuild(*iter);
+        }
+    }
+}
+
+uint32_t BVH::rebuild(uint32_t index) {
+    // objects of a subtree are contiguous, from its leftmost to its rightmost leaf
+    auto leftmost = index;
+    while (!_nodes[leftmost].count) {
+        ++leftmost;
+    }
+    auto rightmost = index;
+    while (!_nodes[rightmost].count) {
+        rightmost = _nodes[rightmost].index;
+    }
+    auto first = _nodes[leftmost].index;
+    auto last = _nodes[rightmost].index + _nodes[rightmost].count;
+    uint32_t depth{0};
+    for (auto i = index; i; i = _parents[i]) {
+        ++depth;
+    }
+
+    std::vector<BuildItem> items(last - first);
+    for (auto i = first; i < last; ++i) {
+        auto aabb = _bounds.get(i);
+        items[i - first] = {aabb, (aabb.minBound + aabb.maxBound) * 0.5f, _ids[i]};
+    }
+    std::vector<Node> nodes;
+    buildSubtree(items, first, depth, 1, nodes);
+    // single object leaves, always 2n - 1 nodes
+    raum_check(nodes.size() == 2 * items.size() - 1, "subtree size changed on rebuild");
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (!nodes[i].count) {
+            nodes[i].index += index;
+        }
+        _nodes[index + i] = nodes[i];
+    }
+
+    std::vector<scene::RenderablePtr> objects(items.size());
+    std::vector<uint8_t> active(items.size());
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        auto position = _positions[items[i].object];
+        objects[i] = std::move(_objects[position]);
+        active[i] = _active[position];
+    }
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        _objects[first + i] = std::move(objects[i]);
+        _active[first + i] = active[i];
+        _bounds.set(first + i, items[i].bounds);
+        _ids[first + i] = items[i].object;
+        _positions[items[i].object] = first + i;
+    }
+    auto end = index + static_cast<uint32_t>(nodes.size());
+    link(index, end);
+    return end;
+}
+
+void BVH::cull(std::span<const scene::Camera* const> cameras,
+               std::vector<scene::RenderablePtr>& renderables,
+               std::vector<CameraMask>& masks,
+               std::vector<scene::AABB>* bounds) const {
+    RAUM_TRACE_SCOPE("BVH::cull");
+    raum_check(cameras.size() <= MAX_CULLING_CAMERAS, "at most {} culling cameras", MAX_CULLING_CAMERAS);
+    if (_nodes.empty() || cameras.empty()) {
+        return;
+    }
+
+    struct Entry {
+        uint32_t node;
+        // children only test the frustums their parent intersects
+        CameraMask candidates;
+    };
+    std::array<Entry, MAX_DEPTH + 1> stack;
+    uint32_t size{0};
+    stack[size++] = {0, cameras.size() >= MAX_CULLING_CAMERAS ? ~CameraMask{0} : (CameraMask{1} << cameras.size()) - 1};
+    while (size) {
+        auto [index, candidates] = stack[--size];
+        const auto& node = _nodes[index];
+        candidates = frustumMask(cameras, {node.minBound, node.maxBound}, candidates);
+        if (!candidates) {
+            continue;
+        }
+        if (node.count) {
+            std::fill_n(_leafMasks.begin(), node.count, 0);
+            for (; candidates; candidates &= candidates - 1) {
+                auto camera = std::countr_zero(candidates);
+                auto bit = CameraMask{1} << camera;
+                if (!cameras[camera]->cullingEnabled()) {
+                    for (uint32_t i = 0; i < node.count; ++i) {
+                        _leafMasks[i] |= bit;
+                    }
+                    continue;
+                }
+                auto count = scene::frustumCulling(cameras[camera]->frustumPlanes(), _bounds, node.index, node.count, _visible.data());
+                for (uint32_t i = 0; i < count; ++i) {
+                    _leafMasks[_visible[i] - node.index] |= bit;
+                }
+            }
+            for (uint32_t i = 0; i < node.count; ++i) {
+                if (_leafMasks[i] && _active[node.index + i]) {
+                    renderables.emplace_back(_objects[node.index + i]);
+                    masks.emplace_back(_leafMasks[i]);
+                    if (bounds) {
+                        bounds->emplace_back(_bounds.get(node.index + i));
+                    }
+                }
+            }
+        } else {
+            // left on top, objects come out in leaf order
+            stack[size++] = {node.index, candidates};
+            stack[size++] = {index + 1, candidates};
+        }
+    }
+}
+
+} // namespace raum::graph
@@ -0,0 +1,82 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "Camera.h"
+#include "Mesh.h"
+#include "Scene.h"
+
+namespace raum::graph {
+
+// one bit per culling camera
+using CameraMask = uint64_t;
+constexpr uint32_t MAX_CULLING_CAMERAS = 64;
+
+// bounding volume hierarchy over renderable bounds, built with binned SAH and stored flat in depth first
+// order: the left child of a node follows it, the right child is at `index`.
+class BVH {
+public:
+    // each bounds row loads as one 4 wide vector, w carries the links
+    struct alignas(32) Node {
+        Vec3f minBound{};
+        // right child of an interior node, first object of a leaf
+        uint32_t index{0};
+        Vec3f maxBound{};
+        // objects of a leaf, 0 for interior nodes
+        uint32_t count{0};
+    };
+    static_assert(sizeof(Node) == 32);
+
+    // subtrees are built on the render thread pool for large inputs.
+    void build(std::span<const scene::RenderablePtr> renderables, uint32_t maxObjectsPerNode = 4);
+    // `bounds` per renderable instead of the mesh bounds
+    void build(std::span<const scene::RenderablePtr> renderables,
+               std::span<const scene::AABB> bounds,
+               uint32_t maxObjectsPerNode = 4);
+
+    // `object` indexes the renderables of the last build, inactive objects are skipped by cull.
+    void setActive(uint32_t object, bool active);
+    // applied by the next refit
+    void setBounds(uint32_t object, const scene::AABB& bounds);
+    // refits the ancestors of changed objects bottom up. Trees with single object leaves also rebuild the
+    // subtrees whose surface area grew past REBUILD_AREA_RATIO of the built one, in place.
+    void refit();
+
+    // tests all frustums in a single traversal, a renderable visible to any camera is appended once and the
+    // matching `masks` entry tells which cameras see it. Cameras with culling disabled see everything. `bounds`
+    // receives the bounds of the appended renderables if set. One cull per tree at a time, it reuses the scratch.
+    void cull(std::span<const scene::Camera* const> cameras,
+              std::vector<scene::RenderablePtr>& renderables,
+              std::vector<CameraMask>& masks,
+              std::vector<scene::AABB>* bounds = nullptr) const;
+
+    const std::vector<Node>& nodes() const { return _nodes; }
+
+    static constexpr float REBUILD_AREA_RATIO{2.0f};
+
+private:
+    // parents, leaves and built areas of the nodes in [begin, end)
+    void link(uint32_t begin, uint32_t end);
+    // returns the end of the subtree
+    uint32_t rebuild(uint32_t node);
+
+    uint32_t _maxObjectsPerNode{4};
+    uint32_t _maxLeafCount{0};
+    bool _refitPending{false};
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _parents;
+    std::vector<float> _builtAreas;
+    std::vector<uint8_t> _dirty;
+    // leaf order
+    std::vector<scene::RenderablePtr> _objects;
+    scene::BoundsSoA _bounds;
+    std::vector<uint8_t> _active;
+    std::vector<uint32_t> _ids;
+    std::vector<uint32_t> _leaves;
+    // leaf position of each object
+    std::vector<uint32_t> _positions;
+    // cull scratch of _maxLeafCount entries, kept across frames
+    mutable std::vector<CameraMask> _leafMasks;
+    mutable std::vector<uint32_t> _visible;
+};
+
+} // namespace raum::graph
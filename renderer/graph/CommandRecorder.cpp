@@ -0,0 +1,79 @@
+#include "CommandRecorder.h"
+#include "RHICommandBuffer.h"
+#include "RHIDevice.h"
+#include "RHIRenderEncoder.h"
+#include "core/thread/execution.h"
+#include "core/utils/Trace.h"
+
+namespace raum::graph {
+
+CommandRecorder::CommandRecorder(rhi::DevicePtr device) : _device(device) {
+    auto queueIndex = _device->getQueue({rhi::QueueType::GRAPHICS})->index();
+    _contexts.resize(std::max(std::thread::hardware_concurrency(), 1u));
+    for (auto& context : _contexts) {
+        context.commandPool = rhi::CommandPoolPtr(_device->createCoomandPool({queueIndex}));
+    }
+}
+
+void CommandRecorder::reset() {
+    _frameIndex = (_frameIndex + 1) % rhi::FRAMES_IN_FLIGHT;
+    for (auto& context : _contexts) {
+        context.used = 0;
+    }
+    _stats = {};
+}
+
+rhi::RHICommandBuffer* CommandRecorder::acquire(Context& context) {
+    auto& cmds = context.commandBuffers[_frameIndex];
+    if (context.used == cmds.size()) {
+        cmds.emplace_back(context.commandPool->makeCommandBuffer({rhi::CommandBufferType::SECONDARY}));
+    }
+    auto* cmd = cmds[context.used++].get();
+    cmd->reset();
+    return cmd;
+}
+
+void CommandRecorder::record(const rhi::CommandBufferBeginInfo& inheritance,
+                             uint32_t count,
+                             uint32_t minChunkSize,
+                             const RecordFunc& func,
+                             std::vector<rhi::RHICommandBuffer*>& out) {
+    if (!count) {
+        return;
+    }
+    minChunkSize = std::max(minChunkSize, 1u);
+    uint32_t chunkCount = std::min(workerCount(), (count + minChunkSize - 1) / minChunkSize);
+    uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    auto first = out.size();
+    out.resize(first + chunkCount);
+    // acquire on this thread, workers only touch their own command buffer.
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        out[first + i] = acquire(_contexts[i]);
+    }
+
+    auto recordTask = [&](uint32_t i) {
+        RAUM_TRACE_SCOPE("CommandRecorder::record");
+        auto* cmd = out[first + i];
+        cmd->begin(inheritance);
+        auto encoder = rhi::RenderEncoderPtr(cmd->makeRenderEncoder());
+        func(encoder.get(), i * chunkSize, std::min(count, (i + 1) * chunkSize));
+        encoder.reset();
+        cmd->commit();
+    };
+
+    if (chunkCount == 1) {
+        recordTask(0);
+    } else {
+        auto sched = getRenderThreadPool().get_scheduler();
+        auto sender = stdexec::schedule(sched) | stdexec::bulk(chunkCount, std::move(recordTask));
+        stdexec::sync_wait(std::move(sender));
+    }
+
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        _stats += out[first + i]->renderEncoderStats();
+    }
+}
+
+} // namespace raum::graph
@@ -0,0 +1,49 @@
+#pragma once
+#include <functional>
+#include "RHIDefine.h"
+
+namespace raum::graph {
+
+// records a range of work into secondary command buffers on render worker threads,
+// each worker chunk owns its command pool since pools can't be used concurrently.
+class CommandRecorder {
+public:
+    using RecordFunc = std::function<void(rhi::RHIRenderEncoder* encoder, uint32_t first, uint32_t last)>;
+
+    CommandRecorder() = delete;
+    explicit CommandRecorder(rhi::DevicePtr device);
+    CommandRecorder(const CommandRecorder&) = delete;
+    CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+    // called once per frame, secondary command buffers of FRAMES_IN_FLIGHT frames ago are recycled.
+    void reset();
+
+    // split [0, count) into chunks of at least `minChunkSize`, record each chunk into a secondary command buffer
+    // that inherits `inheritance`, results are in chunk order.
+    void record(const rhi::CommandBufferBeginInfo& inheritance,
+                uint32_t count,
+                uint32_t minChunkSize,
+                const RecordFunc& func,
+                std::vector<rhi::RHICommandBuffer*>& out);
+
+    uint32_t workerCount() const { return static_cast<uint32_t>(_contexts.size()); }
+
+    // stats of command buffers recorded since last reset
+    const rhi::RenderEncoderStats& renderEncoderStats() const { return _stats; }
+
+private:
+    struct Context {
+        rhi::CommandPoolPtr commandPool;
+        std::array<std::vector<rhi::CommandBufferPtr>, rhi::FRAMES_IN_FLIGHT> commandBuffers;
+        uint32_t used{0};
+    };
+
+    rhi::RHICommandBuffer* acquire(Context& context);
+
+    rhi::DevicePtr _device;
+    std::vector<Context> _contexts;
+    uint32_t _frameIndex{0};
+    rhi::RenderEncoderStats _stats{};
+};
+
+} // namespace raum::graph
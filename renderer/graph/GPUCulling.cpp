@@ -0,0 +1,383 @@
+#include "GPUCulling.h"
+#include <map>
+#include <tuple>
+#include "Camera.h"
+#include "GraphUtils.h"
+#include "RHIBlitEncoder.h"
+#include "RHICommandBuffer.h"
+#include "RHIComputeEncoder.h"
+#include "RHIDevice.h"
+
+namespace raum::graph {
+
+namespace {
+
+constexpr std::string_view CULLING_PROGRAM = "asset/layout/gpuCulling";
+constexpr std::string_view MESHLET_LAYOUT_SUFFIX = "Meshlet";
+constexpr uint32_t CULLING_GROUP_SIZE{64};
+// past any dot product of unit vectors, never culls
+constexpr float NO_CONE_CUTOFF{2.0f};
+
+// matches gpuCulling.comp, bounds are in mesh space and moved by the object transform on the gpu
+struct CullObject {
+    Vec4f minBound;
+    Vec4f maxBound;
+    // indexCount, firstIndex, vertexOffset, object index
+    std::array<uint32_t, 4> draw;
+    // batch, first draw slot of the batch, mesh task batch, meshlet
+    std::array<uint32_t, 4> batch;
+    // xyz center, w radius of the bounding sphere
+    Vec4f sphere;
+    // xyz axis, w cutoff of the normal cone
+    Vec4f cone{0.0f, 0.0f, 0.0f, NO_CONE_CUTOFF};
+};
+
+struct CullParams {
+    // xyz normal, w distance to origin
+    std::array<Vec4f, 6> planes;
+    // xyz camera position, w 0 disables cone culling
+    Vec4f eye;
+    uint32_t objectCount;
+};
+static_assert(sizeof(CullParams) == 116);
+
+// strides and attribute offsets in floats, locations as in gltfpbr.vert
+MeshletConstants meshletConstants(const rhi::VertexLayout& layout) {
+    MeshletConstants constants{};
+    if (!layout.vertexBufferAttrs.empty()) {
+        constants.vertexStride = layout.vertexBufferAttrs[0].stride / sizeof(float);
+    }
+    for (const auto& attr : layout.vertexAttrs) {
+        auto offset = static_cast<uint32_t>(attr.offset / sizeof(float));
+        switch (attr.location) {
+            case 1:
+                constants.normalOffset = offset;
+                break;
+            case 2:
+                constants.uvOffset = offset;
+                break;
+            case 3:
+                constants.tangentOffset = offset;
+                break;
+            default:
+                break;
+        }
+    }
+    return constants;
+}
+
+// meshlet items of a renderer, spheres and cones stay in mesh space like the object bounds. The shader moves
+// them by the object transform each frame and drops cones of non uniformly scaled or mirrored objects.
+void appendMeshlets(const scene::MeshletData& meshletData, const CullObject& object, std::vector<CullObject>& objects) {
+    for (uint32_t i = 0; i < meshletData.meshlets.size(); ++i) {
+        const auto& meshlet = meshletData.meshlets[i];
+        auto& item = objects.emplace_back(object);
+        item.minBound = Vec4f(meshlet.center - meshlet.radius, 1.0f);
+        item.maxBound = Vec4f(meshlet.center + meshlet.radius, 1.0f);
+        item.draw[0] = meshlet.triangleCount * 3;
+        item.draw[1] = meshlet.firstIndex;
+        item.batch[3] = i;
+        item.sphere = Vec4f(meshlet.center, meshlet.radius);
+        if (meshlet.coneCutoff < 1.0f) {
+            item.cone = Vec4f(meshlet.coneAxis, meshlet.coneCutoff);
+        }
+    }
+}
+
+} // namespace
+
+GPUCulling::GPUCulling(rhi::DevicePtr device, ObjectBuffer& objectBuffer) : _device(device), _objectBuffer(objectBuffer) {
+}
+
+bool GPUCulling::supported() const {
+    return _device->drawIndirectCountSupported();
+}
+
+bool GPUCulling::meshShading() const {
+    return _device->meshShaderSupported();
+}
+
+std::string GPUCulling::meshletLayout(std::string_view shaderName) {
+    std::string layout(shaderName);
+    layout.append(MESHLET_LAYOUT_SUFFIX);
+    return layout;
+}
+
+bool GPUCulling::drawable(const DrawCall& drawCall) {
+    return drawCall.objectBindGroup && drawCall.instanceCount == 1 && drawCall.meshRenderer->drawInfo().indexCount;
+}
+
+bool GPUCulling::build(StringID queueName,
+                       StringID phase,
+                       std::span<const scene::RenderablePtr> renderables,
+                       const ShaderGraph& shg) {
+    auto [iter, inserted] = _queues.try_emplace(queueName);
+    auto& queue = iter->second;
+    if (!inserted) {
+        // frames in flight may still read the old buffers, kept until the current frame slot completes
+        auto retired = std::make_shared<Queue>(std::move(queue));
+        _device->getQueue({rhi::QueueType::GRAPHICS})->addCompleteHandler([retired]() mutable {
+            retired.reset();
+        });
+    }
+    queue = {};
+
+    const auto& cullingResource = shg.layout(CULLING_PROGRAM);
+    if (!_method) {
+        _method = scene::Method::pool().makeMethod(CULLING_PROGRAM, flat_set<std::string>{});
+        _method->bakePipeline(
+            cullingResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)],
+            cullingResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
+            cullingResource.constants,
+            cullingResource.shaderSources,
+            _device);
+    }
+
+    using BatchKey = std::tuple<const void*, const void*, const void*, const void*, bool>;
+    std::map<BatchKey, uint32_t> batchIndices;
+    std::vector<CullObject> objects;
+    objects.reserve(renderables.size());
+
+    bool complete{true};
+    for (const auto& renderable : renderables) {
+        auto* meshRenderer = static_cast<scene::MeshRenderer*>(renderable.get());
+        auto& techs = meshRenderer->techniques();
+        auto techIter = std::find_if(techs.begin(), techs.end(), [phase](const auto& tech) {
+            return tech->phase() == phase;
+        });
+        if (techIter == techs.end()) {
+            continue;
+        }
+        auto* technique = techIter->get();
+        const auto& shaderResource = shg.layout(technique->material()->shaderName());
+        const auto& drawInfo = meshRenderer->drawInfo();
+        if (!drawInfo.indexCount || drawInfo.instanceCount != 1 || !objectDataBinding(shaderResource)) {
+            complete = false;
+            continue;
+        }
+
+        const auto& mesh = *meshRenderer->mesh();
+        const auto& meshData = mesh.meshData();
+        const auto& meshletData = mesh.meshletData();
+        // meshlets cover the full detail range only. Without mesh shaders each one would be a separate indexed
+        // draw, more than the culled triangles save, so that path keeps one draw per object.
+        bool meshTasks = !meshletData.meshlets.empty() && drawInfo.firstVertex == 0 &&
+                         drawInfo.indexCount == meshData.indexCount && meshletData.meshletBuffer &&
+                         technique->meshletPipelineState();
+
+        BatchKey key{technique->pipelineState().get(),
+                     technique->material()->bindGroup().get(),
+                     meshData.vertexBuffer.buffer.get(),
+                     meshData.indexBuffer.buffer.get(),
+                     meshTasks};
+        auto [batchIter, newBatch] = batchIndices.emplace(key, static_cast<uint32_t>(queue.batches.size()));
+        if (newBatch) {
+            auto& indirectBatch = queue.batches.emplace_back(IndirectBatch{
+                .technique = technique,
+                .meshRenderer = meshRenderer,
+                .meshTasks = meshTasks,
+            });
+            const auto& objectResource = meshTasks ? shg.layout(meshletLayout(technique->material()->shaderName())) : shaderResource;
+            for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT; ++i) {
+                indirectBatch.objectBindGroups[i] = _objectBuffer.bindGroup(i, objectResource);
+            }
+            if (meshTasks) {
+                indirectBatch.meshletConstants = meshletConstants(meshData.vertexLayout);
+                queue.meshTasks = true;
+            }
+        }
+        auto batch = batchIter->second;
+
+        const auto& aabb = mesh.aabb();
+        CullObject object{
+            .minBound = Vec4f(aabb.minBound, 1.0f),
+            .maxBound = Vec4f(aabb.maxBound, 1.0f),
+            .draw = {drawInfo.indexCount, drawInfo.firstVertex, drawInfo.vertexOffset, meshRenderer->objectSlot()},
+            .batch = {batch, 0, meshTasks, 0},
+        };
+        if (meshTasks) {
+            appendMeshlets(meshletData, object, objects);
+            queue.batches[batch].maxDraws += static_cast<uint32_t>(meshletData.meshlets.size());
+        } else {
+            objects.emplace_back(object);
+            ++queue.batches[batch].maxDraws;
+        }
+    }
+
+    if (objects.empty()) {
+        return complete;
+    }
+
+    uint32_t drawCount{0};
+    for (auto& batch : queue.batches) {
+        batch.firstDraw = drawCount;
+        batch.meshletConstants.firstDraw = drawCount;
+        drawCount += batch.maxDraws;
+    }
+    for (auto& object : objects) {
+        object.batch[1] = queue.batches[object.batch[0]].firstDraw;
+    }
+
+    queue.objectCount = static_cast<uint32_t>(objects.size());
+    queue.objects = rhi::BufferPtr(_device->createBuffer(rhi::BufferSourceInfo{
+        .bufferUsage = rhi::BufferUsage::STORAGE,
+        .size = static_cast<uint32_t>(objects.size() * sizeof(CullObject)),
+        .data = objects.data(),
+    }));
+
+    scene::SlotMap cullBindings;
+    for (const auto& [name, desc] : cullingResource.bindings) {
+        if (desc.rate == Rate::PER_PASS) {
+            cullBindings.emplace(name, desc.binding);
+        }
+    }
+    const auto& cullLayout = cullingResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)];
+    for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT; ++i) {
+        queue.draws[i] = rhi::BufferPtr(_device->createBuffer(rhi::BufferInfo{
+            .bufferUsage = rhi::BufferUsage::STORAGE | rhi::BufferUsage::INDIRECT,
+            .size = drawCount * DRAW_COMMAND_STRIDE,
+        }));
+        queue.counts[i] = rhi::BufferPtr(_device->createBuffer(rhi::BufferInfo{
+            .bufferUsage = rhi::BufferUsage::STORAGE | rhi::BufferUsage::INDIRECT | rhi::BufferUsage::TRANSFER_DST,
+            .size = static_cast<uint32_t>(queue.batches.size() * sizeof(uint32_t)),
+        }));
+        queue.tasks[i] = rhi::BufferPtr(_device->createBuffer(rhi::BufferInfo{
+            .bufferUsage = rhi::BufferUsage::STORAGE | rhi::BufferUsage::INDIRECT | rhi::BufferUsage::TRANSFER_DST,
+            .size = static_cast<uint32_t>(queue.batches.size() * MESH_TASK_COMMAND_STRIDE),
+        }));
+        auto& bindGroup = queue.cullBindGroups[i];
+        bindGroup = std::make_shared<scene::BindGroup>(cullBindings, cullLayout, _device);
+        bindGroup->bindBuffer("CullObjects", 0, queue.objects);
+        bindGroup->bindBuffer("DrawCommands", 0, queue.draws[i]);
+        bindGroup->bindBuffer("DrawCounts", 0, queue.counts[i]);
+        bindGroup->bindBuffer("MeshTasks", 0, queue.tasks[i]);
+        bindGroup->bindBuffer(OBJECT_DATA_SLOT, 0, _objectBuffer.buffer(i));
+        bindGroup->update();
+    }
+
+    // mesh shaders read the visible meshlets where the cull pass compacted them
+    for (auto& batch : queue.batches) {
+        if (!batch.meshTasks) {
+            continue;
+        }
+        const auto& mesh = *batch.meshRenderer->mesh();
+        const auto& meshletData = mesh.meshletData();
+        const auto& meshletResource = shg.layout(meshletLayout(batch.technique->material()->shaderName()));
+        scene::SlotMap meshletBindings;
+        for (const auto& [name, desc] : meshletResource.bindings) {
+            if (desc.rate == Rate::PER_INSTANCE) {
+                meshletBindings.emplace(name, desc.binding);
+            }
+        }
+        const auto& instanceLayout = meshletResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_INSTANCE)];
+        for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT; ++i) {
+            auto bindGroup = std::make_shared<scene::BindGroup>(meshletBindings, instanceLayout, _device);
+            bindGroup->bindBuffer("Vertices", 0, mesh.meshData().vertexBuffer.buffer);
+            bindGroup->bindBuffer("Meshlets", 0, meshletData.meshletBuffer);
+            bindGroup->bindBuffer("MeshletVertices", 0, meshletData.vertexBuffer);
+            bindGroup->bindBuffer("MeshletTriangles", 0, meshletData.triangleBuffer);
+            bindGroup->bindBuffer("VisibleMeshlets", 0, queue.draws[i]);
+            bindGroup->update();
+            batch.meshletBindGroups[i] = bindGroup.get();
+            queue.meshletBindGroups.emplace_back(std::move(bindGroup));
+        }
+    }
+    return complete;
+}
+
+bool GPUCulling::contains(StringID queueName) const {
+    return _queues.find(queueName) != _queues.end();
+}
+
+void GPUCulling::cull(rhi::RHICommandBuffer* cmd, StringID queueName, const scene::Camera* camera, uint32_t frameIndex) {
+    auto iter = _queues.find(queueName);
+    raum_check(iter != _queues.end(), "queue {} is not built for gpu culling", queueName.str());
+    auto& queue = iter->second;
+    if (!queue.objectCount) {
+        return;
+    }
+    auto* draws = queue.draws[frameIndex].get();
+    auto* counts = queue.counts[frameIndex].get();
+    auto* tasks = queue.tasks[frameIndex].get();
+    auto countSize = static_cast<uint32_t>(queue.batches.size() * sizeof(uint32_t));
+    auto taskSize = static_cast<uint32_t>(queue.batches.size() * MESH_TASK_COMMAND_STRIDE);
+
+    {
+        auto blitEncoder = rhi::BlitEncoderPtr(cmd->makeBlitEncoder());
+        blitEncoder->fillBuffer(counts, 0, countSize, 0);
+        if (queue.meshTasks) {
+            blitEncoder->fillBuffer(tasks, 0, taskSize, 0);
+        }
+    }
+    for (auto* buffer : {counts, tasks}) {
+        cmd->appendBufferBarrier({
+            .buffer = buffer,
+            .srcStage = rhi::PipelineStage::TRANSFER,
+            .dstStage = rhi::PipelineStage::COMPUTE_SHADER,
+            .srcAccessFlag = rhi::AccessFlags::TRANSFER_WRITE,
+            .dstAccessFlag = rhi::AccessFlags::SHADER_READ | rhi::AccessFlags::SHADER_WRITE,
+        });
+    }
+    cmd->applyBarrier(rhi::DependencyFlags::BY_REGION);
+
+    CullParams params{};
+    for (uint32_t i = 0; i < params.planes.size(); ++i) {
+        if (camera) {
+            const auto& plane = camera->frustumPlanes()[i];
+            params.planes[i] = Vec4f(plane.normal, -glm::dot(plane.normal, plane.point));
+        } else {
+            params.planes[i] = Vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+    // cones are tested against the eye position, orthographic views skip them
+    if (camera && camera->eye().projectionType() == scene::Projection::PERSPECTIVE) {
+        params.eye = Vec4f(camera->eye().getPosition(), 1.0f);
+    }
+    params.objectCount = queue.objectCount;
+
+    {
+        auto computeEncoder = rhi::ComputeEncoderPtr(cmd->makeComputeEncoder());
+        computeEncoder->bindPipeline(_method->pipelineState().get());
+        computeEncoder->bindDescriptorSet(queue.cullBindGroups[frameIndex]->descriptorSet().get(), 0, nullptr, 0);
+        computeEncoder->pushConstants(rhi::ShaderStage::COMPUTE, 0, &params, sizeof(CullParams));
+        computeEncoder->dispatch((queue.objectCount + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE, 1, 1);
+    }
+
+    for (auto* buffer : {draws, counts, tasks}) {
+        cmd->appendBufferBarrier({
+            .buffer = buffer,
+            .srcStage = rhi::PipelineStage::COMPUTE_SHADER,
+            .dstStage = rhi::PipelineStage::DRAW_INDIRECT,
+            .srcAccessFlag = rhi::AccessFlags::SHADER_WRITE,
+            .dstAccessFlag = rhi::AccessFlags::INDIRECT_COMMAND_READ,
+        });
+    }
+    if (queue.meshTasks) {
+        // visible meshlets
+        cmd->appendBufferBarrier({
+            .buffer = draws,
+            .srcStage = rhi::PipelineStage::COMPUTE_SHADER,
+            .dstStage = rhi::PipelineStage::MESH_SHADER,
+            .srcAccessFlag = rhi::AccessFlags::SHADER_WRITE,
+            .dstAccessFlag = rhi::AccessFlags::SHADER_READ,
+        });
+    }
+    cmd->applyBarrier(rhi::DependencyFlags::BY_REGION);
+}
+
+IndirectDraws GPUCulling::indirectDraws(StringID queueName, uint32_t frameIndex) const {
+    auto iter = _queues.find(queueName);
+    if (iter == _queues.end() || !iter->second.objectCount) {
+        return {};
+    }
+    const auto& queue = iter->second;
+    return {
+        .batches = queue.batches,
+        .frameIndex = frameIndex,
+        .drawBuffer = queue.draws[frameIndex].get(),
+        .countBuffer = queue.counts[frameIndex].get(),
+        .taskBuffer = queue.tasks[frameIndex].get(),
+    };
+}
+
+} // namespace raum::graph
@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Method.h"
+#include "Mesh.h"
+#include "ObjectBuffer.h"
+#include "ShaderGraph.h"
+#include "core/utils/StringTable.h"
+
+namespace raum::scene {
+class Camera;
+}
+
+namespace raum::graph {
+
+// push constants of meshlet pipelines after the fragment ones, matches gltfpbr.mesh
+struct MeshletConstants {
+    uint32_t firstDraw{0};
+    // in floats
+    uint32_t vertexStride{0};
+    uint32_t normalOffset{0};
+    uint32_t uvOffset{0};
+    uint32_t tangentOffset{0};
+};
+
+// draws sharing pipeline, material and mesh buffers, drawn by one indirect count draw or one mesh task draw.
+struct IndirectBatch {
+    scene::Technique* technique{nullptr};
+    // any member of the batch, its material and mesh buffers are bound for the whole batch
+    scene::MeshRenderer* meshRenderer{nullptr};
+    // object buffer of each frame in flight
+    std::array<scene::BindGroup*, rhi::FRAMES_IN_FLIGHT> objectBindGroups{};
+    uint32_t firstDraw{0};
+    uint32_t maxDraws{0};
+    // one mesh shader workgroup per visible meshlet instead of indexed draws
+    bool meshTasks{false};
+    // mesh vertices, meshlets and visible meshlets of each frame in flight
+    std::array<scene::BindGroup*, rhi::FRAMES_IN_FLIGHT> meshletBindGroups{};
+    MeshletConstants meshletConstants{};
+};
+
+struct IndirectDraws {
+    std::span<const IndirectBatch> batches;
+    uint32_t frameIndex{0};
+    rhi::RHIBuffer* drawBuffer{nullptr};
+    // one uint per batch
+    rhi::RHIBuffer* countBuffer{nullptr};
+    // one mesh task command per batch
+    rhi::RHIBuffer* taskBuffer{nullptr};
+};
+
+// frustum culls geometry queues in a compute pass and compacts the survivors into indirect draw commands,
+// recording cost no longer depends on the object count. Mesh space bounds are uploaded once per build and
+// moved by the transforms of the shared object buffer when culling, so moving objects need no rebuild.
+// Meshes drawn by mesh shaders, where the device and the material have them, are culled per meshlet,
+// backfacing ones included.
+class GPUCulling {
+public:
+    static constexpr uint32_t DRAW_COMMAND_STRIDE{20};
+    static constexpr uint32_t MESH_TASK_COMMAND_STRIDE{12};
+    // the fragment stage keeps the first bytes
+    static constexpr uint32_t MESHLET_CONSTANT_OFFSET{16};
+
+    GPUCulling() = delete;
+    GPUCulling(rhi::DevicePtr device, ObjectBuffer& objectBuffer);
+    GPUCulling(const GPUCulling&) = delete;
+    GPUCulling& operator=(const GPUCulling&) = delete;
+
+    bool supported() const;
+    bool meshShading() const;
+
+    // layout of the mesh shader variant of `shaderName`
+    static std::string meshletLayout(std::string_view shaderName);
+
+    // indexed, single instance and its shader reads object data, after ObjectBuffer::bind.
+    static bool drawable(const DrawCall& drawCall);
+
+    // returns false if some renderables of `phase` still need the cpu path.
+    bool build(StringID queueName,
+               StringID phase,
+               std::span<const scene::RenderablePtr> renderables,
+               const ShaderGraph& shg);
+
+    bool contains(StringID queueName) const;
+
+    // records fill, dispatch and barriers, outside of any render pass. No camera draws everything.
+    void cull(rhi::RHICommandBuffer* cmd, StringID queueName, const scene::Camera* camera, uint32_t frameIndex);
+
+    IndirectDraws indirectDraws(StringID queueName, uint32_t frameIndex) const;
+
+private:
+    struct Queue {
+        std::vector<IndirectBatch> batches;
+        uint32_t objectCount{0};
+        rhi::BufferPtr objects;
+        std::array<rhi::BufferPtr, rhi::FRAMES_IN_FLIGHT> draws;
+        std::array<rhi::BufferPtr, rhi::FRAMES_IN_FLIGHT> counts;
+        std::array<rhi::BufferPtr, rhi::FRAMES_IN_FLIGHT> tasks;
+        std::array<scene::BindGroupPtr, rhi::FRAMES_IN_FLIGHT> cullBindGroups;
+        std::vector<scene::BindGroupPtr> meshletBindGroups;
+        bool meshTasks{false};
+    };
+
+    rhi::DevicePtr _device;
+    ObjectBuffer& _objectBuffer;
+    scene::MethodPtr _method;
+    std::unordered_map<StringID, Queue> _queues;
+};
+
+} // namespace raum::graph
@@ -0,0 +1,190 @@
+#include "GPUProfiler.h"
+#include <algorithm>
+#include <bit>
+#include "RHICommandBuffer.h"
+#include "RHIDevice.h"
+#include "RHIQueryPool.h"
+
+namespace raum::graph {
+
+namespace {
+
+constexpr uint32_t MIN_PASS_CAPACITY{16};
+
+const rhi::PipelineStatistic PROFILED_STATISTICS = rhi::PipelineStatistic::INPUT_ASSEMBLY_PRIMITIVES |
+                                                   rhi::PipelineStatistic::VERTEX_SHADER_INVOCATIONS |
+                                                   rhi::PipelineStatistic::FRAGMENT_SHADER_INVOCATIONS |
+                                                   rhi::PipelineStatistic::COMPUTE_SHADER_INVOCATIONS;
+// values per statistics query, in PipelineStatistic order
+constexpr uint32_t STATISTICS_COUNT{4};
+
+void writeEscaped(std::ostream& os, std::string_view str) {
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+}
+
+} // namespace
+
+GPUProfiler::GPUProfiler(rhi::DevicePtr device) : _device(device) {
+}
+
+void GPUProfiler::setPipelineStatistics(bool enable) {
+    _statistics = enable && _device->pipelineStatisticsSupported();
+}
+
+void GPUProfiler::reserve(Frame& frame, uint32_t count) {
+    if (frame.capacity >= count && (!frame.statisticsEnabled || frame.statistics)) {
+        return;
+    }
+    frame.capacity = std::max(frame.capacity, std::bit_ceil(std::max(count, MIN_PASS_CAPACITY)));
+    frame.timestamps = rhi::QueryPoolPtr(_device->createQueryPool({
+        .type = rhi::QueryType::TIMESTAMP,
+        .count = frame.capacity * 2,
+    }));
+    frame.statistics.reset();
+    if (frame.statisticsEnabled) {
+        frame.statistics = rhi::QueryPoolPtr(_device->createQueryPool({
+            .type = rhi::QueryType::PIPELINE_STATISTICS,
+            .count = frame.capacity,
+            .statistics = PROFILED_STATISTICS,
+        }));
+    }
+}
+
+void GPUProfiler::resolve(Frame& frame) {
+    if (!frame.count) {
+        return;
+    }
+    _timestampScratch.resize(frame.count * 2);
+    if (!frame.timestamps->getResults(0, frame.count * 2, _timestampScratch.data())) {
+        // not landed yet, keep showing the previous frame
+        return;
+    }
+
+    const double msPerTick = static_cast<double>(_device->timestampPeriod()) * 1e-6;
+    uint64_t frameBegin = UINT64_MAX;
+    uint64_t frameEnd = 0;
+    for (uint32_t i = 0; i < frame.count; ++i) {
+        frameBegin = std::min(frameBegin, _timestampScratch[i * 2]);
+        frameEnd = std::max(frameEnd, _timestampScratch[i * 2 + 1]);
+    }
+    _frameMs = static_cast<double>(frameEnd - frameBegin) * msPerTick;
+
+    _results.resize(frame.count);
+    _statisticsScratch.resize(STATISTICS_COUNT);
+    for (uint32_t i = 0; i < frame.count; ++i) {
+        auto& result = _results[i];
+        auto begin = _timestampScratch[i * 2];
+        auto end = std::max(begin, _timestampScratch[i * 2 + 1]);
+        result.name = frame.names[i];
+        result.beginMs = static_cast<double>(begin - frameBegin) * msPerTick;
+        result.gpuMs = static_cast<double>(end - begin) * msPerTick;
+        result.asyncCompute = frame.asyncCompute[i];
+        result.primitives = 0;
+        result.vertexInvocations = 0;
+        result.fragmentInvocations = 0;
+        result.computeInvocations = 0;
+        // queries that were never begun stay unavailable, fetch them one by one
+        if (frame.hasStatistics[i] && frame.statistics->getResults(i, 1, _statisticsScratch.data())) {
+            result.primitives = _statisticsScratch[0];
+            result.vertexInvocations = _statisticsScratch[1];
+            result.fragmentInvocations = _statisticsScratch[2];
+            result.computeInvocations = _statisticsScratch[3];
+        }
+    }
+}
+
+void GPUProfiler::beginFrame(rhi::RHICommandBuffer* cmd, uint32_t frameIndex) {
+    auto& frame = _frames[frameIndex];
+    _current = nullptr;
+    _open = false;
+    if (!_enabled) {
+        frame.count = 0;
+        frame.overflow = 0;
+        return;
+    }
+
+    resolve(frame);
+
+    frame.statisticsEnabled = _statistics;
+    reserve(frame, frame.count + frame.overflow);
+    frame.count = 0;
+    frame.overflow = 0;
+    frame.names.resize(frame.capacity);
+    frame.hasStatistics.resize(frame.capacity);
+    frame.asyncCompute.resize(frame.capacity);
+
+    cmd->resetQueryPool(frame.timestamps.get(), 0, frame.capacity * 2);
+    if (frame.statisticsEnabled) {
+        cmd->resetQueryPool(frame.statistics.get(), 0, frame.capacity);
+    }
+    _current = &frame;
+}
+
+void GPUProfiler::beginPass(rhi::RHICommandBuffer* cmd, std::string_view name, bool statistics, bool asyncCompute) {
+    if (!_current) {
+        return;
+    }
+    auto& frame = *_current;
+    if (frame.count == frame.capacity) {
+        ++frame.overflow;
+        return;
+    }
+    auto index = frame.count;
+    frame.names[index] = name;
+    frame.hasStatistics[index] = statistics && frame.statisticsEnabled;
+    frame.asyncCompute[index] = asyncCompute;
+
+    cmd->writeTimestamp(frame.timestamps.get(), index * 2, rhi::PipelineStage::TOP_OF_PIPE);
+    if (frame.hasStatistics[index]) {
+        cmd->beginQuery(frame.statistics.get(), index);
+    }
+    _open = true;
+}
+
+void GPUProfiler::endPass(rhi::RHICommandBuffer* cmd) {
+    if (!_open) {
+        return;
+    }
+    auto& frame = *_current;
+    auto index = frame.count++;
+    if (frame.hasStatistics[index]) {
+        cmd->endQuery(frame.statistics.get(), index);
+    }
+    cmd->writeTimestamp(frame.timestamps.get(), index * 2 + 1, rhi::PipelineStage::BOTTOM_OF_PIPE);
+    _open = false;
+}
+
+const PassProfile* GPUProfiler::find(std::string_view name) const {
+    auto iter = std::find_if(_results.begin(), _results.end(), [name](const PassProfile& profile) {
+        return profile.name == name;
+    });
+    return iter == _results.end() ? nullptr : &(*iter);
+}
+
+void GPUProfiler::dumpChromeTrace(std::ostream& os) const {
+    // timestamps are in microseconds, async compute gets its own track
+    os << "{\"traceEvents\":[";
+    for (size_t i = 0; i < _results.size(); ++i) {
+        const auto& result = _results[i];
+        if (i) {
+            os << ',';
+        }
+        os << "{\"name\":\"";
+        writeEscaped(os, result.name);
+        os << "\",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << (result.asyncCompute ? 1 : 0)
+           << ",\"ts\":" << result.beginMs * 1000.0
+           << ",\"dur\":" << result.gpuMs * 1000.0
+           << ",\"args\":{\"primitives\":" << result.primitives
+           << ",\"vertexInvocations\":" << result.vertexInvocations
+           << ",\"fragmentInvocations\":" << result.fragmentInvocations
+           << ",\"computeInvocations\":" << result.computeInvocations << "}}";
+    }
+    os << "]}";
+}
+
+} // namespace raum::graph
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "RHIDefine.h"
+
+namespace raum::graph {
+
+struct PassProfile {
+    std::string name;
+    // relative to the earliest pass of the frame
+    double beginMs{0.0};
+    double gpuMs{0.0};
+    uint64_t primitives{0};
+    uint64_t vertexInvocations{0};
+    uint64_t fragmentInvocations{0};
+    uint64_t computeInvocations{0};
+    bool asyncCompute{false};
+};
+
+// brackets render graph passes with timestamp and pipeline statistics queries. Each frame in flight owns its
+// query pools, they are read back when the frame slot comes around again: its fence has signaled by then so
+// the readback never waits.
+class GPUProfiler {
+public:
+    GPUProfiler() = delete;
+    explicit GPUProfiler(rhi::DevicePtr device);
+    GPUProfiler(const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+
+    void setEnabled(bool enable) { _enabled = enable; }
+    bool enabled() const { return _enabled; }
+
+    // ignored when the device can't count pipeline statistics
+    void setPipelineStatistics(bool enable);
+    bool pipelineStatistics() const { return _statistics; }
+
+    // resolve what `frameIndex` recorded FRAMES_IN_FLIGHT frames ago and reset its queries into `cmd`,
+    // recorded ahead of every pass of the frame.
+    void beginFrame(rhi::RHICommandBuffer* cmd, uint32_t frameIndex);
+
+    // passes don't nest. `statistics` is off for passes on queues without graphics support and for passes
+    // executing secondary command buffers, they don't inherit the query.
+    void beginPass(rhi::RHICommandBuffer* cmd, std::string_view name, bool statistics, bool asyncCompute);
+    void endPass(rhi::RHICommandBuffer* cmd);
+
+    // last resolved frame, in recording order
+    std::span<const PassProfile> passes() const { return _results; }
+    const PassProfile* find(std::string_view name) const;
+    double frameMs() const { return _frameMs; }
+
+    // chrome://tracing / Perfetto json of the last resolved frame
+    void dumpChromeTrace(std::ostream& os) const;
+
+private:
+    struct Frame {
+        rhi::QueryPoolPtr timestamps;
+        rhi::QueryPoolPtr statistics;
+        // pass names live in the render graph arena which is recycled before the readback
+        std::vector<std::string> names;
+        std::vector<bool> hasStatistics;
+        std::vector<bool> asyncCompute;
+        uint32_t capacity{0};
+        uint32_t count{0};
+        // passes that didn't fit, pools grow on the next reuse
+        uint32_t overflow{0};
+        bool statisticsEnabled{false};
+    };
+
+    void resolve(Frame& frame);
+    void reserve(Frame& frame, uint32_t count);
+
+    rhi::DevicePtr _device;
+    bool _enabled{false};
+    bool _statistics{false};
+    bool _open{false};
+    Frame* _current{nullptr};
+    std::array<Frame, rhi::FRAMES_IN_FLIGHT> _frames;
+
+    std::vector<uint64_t> _timestampScratch;
+    std::vector<uint64_t> _statisticsScratch;
+    std::vector<PassProfile> _results;
+    double _frameMs{0.0};
+};
+
+} // namespace raum::graph
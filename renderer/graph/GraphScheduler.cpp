@@ -1,4 +1,5 @@
 #include "GraphScheduler.h"
+#include <bit>
 #include <boost/graph/depth_first_search.hpp>
 #include "GraphUtils.h"
 #include "Mesh.h"
@@ -9,15 +10,32 @@
 #include "RHIRenderEncoder.h"
 #include "RHIUtils.h"
 #include "PBRMaterial.h"
+#include "core/utils/Trace.h"
 
 namespace raum::graph {
 
 namespace {
 
+// stages seeing a binding add up across the techniques of a pass
+void mergePassLayout(const ShaderResource& shaderResource, rhi::DescriptorSetLayoutInfo& perPassLayoutInfo) {
+    auto perPassLayout = shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)];
+    for (const auto& binding : perPassLayout->info().descriptorBindings) {
+        auto iter = std::find_if(perPassLayoutInfo.descriptorBindings.begin(),
+                                 perPassLayoutInfo.descriptorBindings.end(),
+                                 [&binding](const rhi::DescriptorBinding& bd) {
+                                     return bd.binding == binding.binding;
+                                 });
+        if (iter == perPassLayoutInfo.descriptorBindings.end()) {
+            perPassLayoutInfo.descriptorBindings.emplace_back(binding);
+        } else {
+            iter->visibility = iter->visibility | binding.visibility;
+        }
+    }
+}
+
 void prepareBindings(
     std::string_view phaseName,
     scene::TechniquePtr technique,
-    scene::MeshRendererPtr meshrenderer,
     rhi::CompareOp zCmpOp,
     scene::SlotMap& perPassBindings,
     rhi::DescriptorSetLayoutInfo& perPassLayoutInfo,
@@ -26,45 +44,164 @@ void prepareBindings(
     scene::SlotMap perBatchBindings;
     technique->depthStencilInfo().depthCompareOp = zCmpOp;
     if (phaseName == technique->phaseName()) {
-        scene::SlotMap perInstanceBindings;
         const auto& shaderResource = shg.layout(technique->material()->shaderName());
         std::for_each(
             shaderResource.bindings.begin(),
             shaderResource.bindings.end(),
-            [&perBatchBindings, &perInstanceBindings, &perPassBindings](const auto& p) {
+            [&perBatchBindings, &perPassBindings](const auto& p) {
                 if (p.second.rate == Rate::PER_BATCH) {
                     perBatchBindings.emplace(p.first, p.second.binding);
                 } else if (p.second.rate == Rate::PER_PASS) {
                     perPassBindings.emplace(p.first, p.second.binding);
-                } else if (p.second.rate == Rate::PER_INSTANCE) {
-                    perInstanceBindings.emplace(p.first, p.second.binding);
                 }
             });
 
-        if (meshrenderer) {
-            meshrenderer->prepare(perInstanceBindings,
-                                  shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_INSTANCE)],
-                                  device);
-        }
-
         if (!perBatchBindings.empty()) {
             technique->bakeMaterial(perBatchBindings,
                                     shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
                                     device);
         }
 
-        auto perPassLayout = shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)];
-        for (const auto& binding : perPassLayout->info().descriptorBindings) {
-            auto iter = std::find_if(perPassLayoutInfo.descriptorBindings.begin(),
-                                     perPassLayoutInfo.descriptorBindings.end(),
-                                     [&binding](const rhi::DescriptorBinding& bd) {
-                                         return bd.binding == binding.binding;
-                                     });
-            if (iter == perPassLayoutInfo.descriptorBindings.end()) {
-                perPassLayoutInfo.descriptorBindings.emplace_back(binding);
-            }
+        mergePassLayout(shaderResource, perPassLayoutInfo);
+    }
+}
+
+constexpr uint32_t MIN_RENDERABLES_PER_CHUNK = 64;
+
+bool gpuDriven(const RenderQueueData& data) {
+    // compaction loses the back to front order
+    return test(data.flags, RenderQueueFlags::GEOMETRY) &&
+           test(data.flags, RenderQueueFlags::GPU_DRIVEN) &&
+           !test(data.flags, RenderQueueFlags::TRANSPARENT);
+}
+
+void bindMaterial(rhi::RHIRenderEncoder* encoder, scene::Technique* technique, const RenderQueueData& data) {
+    const auto& mat = technique->material();
+    if (mat->type() == scene::MaterialType::PBR) {
+        const auto& pbrMat = static_pointer_cast<scene::PBRMaterial>(mat);
+        float alphCutoff = pbrMat->alphaCutoff();
+        encoder->pushConstants(ShaderStage::FRAGMENT, 0, &alphCutoff, sizeof(float));
+    }
+    if (technique->hasPassBinding()) {
+        encoder->bindDescriptorSet(data.bindGroup->descriptorSet().get(), 0, nullptr, 0);
+    }
+    if (technique->hasBatchBinding()) [[likely]] {
+        encoder->bindDescriptorSet(technique->material()->bindGroup()->descriptorSet().get(),
+                                   1, nullptr, 0);
+    }
+}
+
+// thread safe as long as renderables are not modified during encoding.
+void encodeGeometry(rhi::RHIRenderEncoder* encoder,
+                    std::span<const DrawCall> drawCalls,
+                    const RenderQueueData& data) {
+    // draws are sorted, encoder drops binds matching current state.
+    for (const auto& drawCall : drawCalls) {
+        auto* meshRenderer = drawCall.meshRenderer;
+        auto* technique = drawCall.technique;
+        const auto& drawInfo = meshRenderer->drawInfo();
+        const auto& meshData = meshRenderer->mesh()->meshData();
+        const auto& indexBuffer = meshData.indexBuffer;
+        const auto& vertexBuffer = meshData.vertexBuffer;
+        encoder->bindPipeline(technique->pipelineState().get());
+        bindMaterial(encoder, technique, data);
+        if (drawCall.objectBindGroup) {
+            encoder->bindDescriptorSet(drawCall.objectBindGroup->descriptorSet().get(), 3, nullptr, 0);
+        }
+        if (drawInfo.indexCount) {
+            encoder->bindIndexBuffer(indexBuffer.buffer.get(), indexBuffer.offset, indexBuffer.type);
+            encoder->bindVertexBuffer(vertexBuffer.buffer.get(), 0);
+            encoder->drawIndexed(drawInfo.indexCount, drawCall.instanceCount, drawInfo.firstVertex, drawInfo.vertexOffset, drawCall.firstInstance);
+        } else {
+            encoder->bindVertexBuffer(vertexBuffer.buffer.get(), 0);
+            encoder->draw(drawInfo.vertexCount, drawCall.instanceCount, drawInfo.firstVertex, drawCall.firstInstance);
+        }
+    }
+}
+
+// one indirect count draw or mesh task draw per batch, transforms come from the per draw object buffer.
+void encodeIndirect(rhi::RHIRenderEncoder* encoder, const IndirectDraws& indirect, const RenderQueueData& data) {
+    for (uint32_t i = 0; i < indirect.batches.size(); ++i) {
+        const auto& batch = indirect.batches[i];
+        auto* technique = batch.technique;
+        if (batch.meshTasks) {
+            encoder->bindPipeline(technique->meshletPipelineState().get());
+            bindMaterial(encoder, technique, data);
+            encoder->bindDescriptorSet(batch.meshletBindGroups[indirect.frameIndex]->descriptorSet().get(), 2, nullptr, 0);
+            encoder->bindDescriptorSet(batch.objectBindGroups[indirect.frameIndex]->descriptorSet().get(), 3, nullptr, 0);
+            auto constants = batch.meshletConstants;
+            encoder->pushConstants(ShaderStage::MESH, GPUCulling::MESHLET_CONSTANT_OFFSET, &constants, sizeof(MeshletConstants));
+            encoder->drawMeshTasksIndirect(indirect.taskBuffer, i * GPUCulling::MESH_TASK_COMMAND_STRIDE, 1, GPUCulling::MESH_TASK_COMMAND_STRIDE);
+            continue;
         }
+        encoder->bindPipeline(technique->pipelineState().get());
+        bindMaterial(encoder, technique, data);
+        encoder->bindDescriptorSet(batch.objectBindGroups[indirect.frameIndex]->descriptorSet().get(), 3, nullptr, 0);
+        const auto& meshData = batch.meshRenderer->mesh()->meshData();
+        const auto& indexBuffer = meshData.indexBuffer;
+        encoder->bindIndexBuffer(indexBuffer.buffer.get(), indexBuffer.offset, indexBuffer.type);
+        encoder->bindVertexBuffer(meshData.vertexBuffer.buffer.get(), 0);
+        encoder->drawIndexedIndirectCount(indirect.drawBuffer,
+                                          batch.firstDraw * GPUCulling::DRAW_COMMAND_STRIDE,
+                                          indirect.countBuffer,
+                                          static_cast<uint32_t>(i * sizeof(uint32_t)),
+                                          batch.maxDraws,
+                                          GPUCulling::DRAW_COMMAND_STRIDE);
+    }
+}
+
+void encodeQuad(rhi::RHIRenderEncoder* encoder, const RenderQueueData& data) {
+    const auto& quadTech = data.technique;
+    encoder->bindPipeline(quadTech->pipelineState().get());
+    if (quadTech->hasPassBinding()) [[likely]] {
+        encoder->bindDescriptorSet(data.bindGroup->descriptorSet().get(), 0, nullptr, 0);
+    }
+    if (quadTech->hasBatchBinding()) {
+        encoder->bindDescriptorSet(quadTech->material()->bindGroup()->descriptorSet().get(),
+                                   1, nullptr, 0);
+    }
+    if (quadTech->hasInstanceBinding()) {
+        // encoder->bindDescriptorSet(quadTech->bindGroup()->descriptorSet().get(), 2, nullptr, 0);
+    }
+
+    encoder->draw(3, 1, 0, 0);
+}
+
+// one method per compute pass, passes of a program share shaders and pipelines but bind their own resources
+scene::MethodPtr computeMethod(const ComputePassData& data, std::string_view passName, ShaderGraph& shg, rhi::DevicePtr device) {
+    auto method = scene::Method::pool().makeMethod(data.programName, flat_set<std::string>{}, passName);
+    if (method->pipelineState()) {
+        return method;
     }
+
+    const auto& shaderResource = shg.layout(data.programName);
+    scene::SlotMap perPassBindings;
+    scene::SlotMap perBatchBindings;
+    std::for_each(
+        shaderResource.bindings.begin(),
+        shaderResource.bindings.end(),
+        [&perBatchBindings, &perPassBindings](const auto& p) {
+            if (p.second.rate == Rate::PER_PASS) {
+                perPassBindings.emplace(p.first, p.second.binding);
+            } else if (p.second.rate == Rate::PER_BATCH) {
+                perBatchBindings.emplace(p.first, p.second.binding);
+            }
+        });
+
+    method->bakeBindGroup(
+        perPassBindings,
+        perBatchBindings,
+        shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)],
+        shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
+        device);
+
+    method->bakePipeline(
+        shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)],
+        shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
+        shaderResource.constants,
+        shaderResource.shaderSources,
+        device);
+    return method;
 }
 
 } // namespace
@@ -98,12 +235,18 @@ struct WarmUpVisitor : public boost::dfs_visitor<> {
                         }
                     }
                     for (auto& tech : meshrenderer->techniques()) {
-                        prepareBindings(phaseName, tech, meshrenderer, zCmpOp, _perPassBindings, _perPassLayoutInfo, _shg, _device);
+                        prepareBindings(phaseName, tech, zCmpOp, _perPassBindings, _perPassLayoutInfo, _shg, _device);
+                        // mesh shaders read the pass data too
+                        auto meshletLayout = GPUCulling::meshletLayout(tech->material()->shaderName());
+                        if (gpuDriven(queueData) && _gpuCulling.meshShading() &&
+                            tech->phaseName() == phaseName && _shg.contains(meshletLayout)) {
+                            mergePassLayout(_shg.layout(meshletLayout), _perPassLayoutInfo);
+                        }
                     }
                 }
             } else {
                 // render screen quad
-                prepareBindings(phaseName, queueData.technique, nullptr, zCmpOp, _perPassBindings, _perPassLayoutInfo, _shg, _device);
+                prepareBindings(phaseName, queueData.technique, zCmpOp, _perPassBindings, _perPassLayoutInfo, _shg, _device);
             }
         }
     }
@@ -120,10 +263,11 @@ struct WarmUpVisitor : public boost::dfs_visitor<> {
                 _perPassBindings,
                 descLayout,
                 _device);
-            _perPhaseBindGroups.emplace(g[v].name, queueData.bindGroup);
+            _perPhaseBindGroups.emplace(g[v].id, queueData.bindGroup);
 
             const auto& phaseName = getPhaseName(_g.impl()[v].name);
             if (test(queueData.flags, RenderQueueFlags::GEOMETRY)) {
+                bool gpuCulled = gpuDriven(queueData) && _gpuCulling.supported();
                 for (auto& renderable : _rendererables) {
                     auto meshrenderer = std::static_pointer_cast<scene::MeshRenderer>(renderable);
                     for (auto& technique : meshrenderer->techniques()) {
@@ -139,9 +283,27 @@ struct WarmUpVisitor : public boost::dfs_visitor<> {
                                 meshrenderer->mesh()->meshData().vertexLayout,
                                 shaderResource.shaderSources,
                                 _device);
+                            auto meshletLayout = GPUCulling::meshletLayout(technique->material()->shaderName());
+                            if (gpuCulled && _gpuCulling.meshShading() && _shg.contains(meshletLayout)) {
+                                const auto& meshletResource = _shg.layout(meshletLayout);
+                                const auto& layouts = meshletResource.descriptorLayouts;
+                                technique->bakeMeshletPipeline(
+                                    meshletLayout,
+                                    _renderpass,
+                                    {descLayout,
+                                     layouts[static_cast<uint32_t>(Rate::PER_BATCH)],
+                                     layouts[static_cast<uint32_t>(Rate::PER_INSTANCE)],
+                                     layouts[static_cast<uint32_t>(Rate::PER_DRAW)]},
+                                    meshletResource.constants,
+                                    meshletResource.shaderSources,
+                                    _device);
+                            }
                         }
                     }
                 }
+                if (!gpuCulled || !_gpuCulling.build(g[v].id, queueData.phase, _cullables, _shg)) {
+                    _cpuCulling = true;
+                }
             } else {
                 auto& technique = queueData.technique;
                 const auto& shaderResource = _shg.layout(technique->material()->shaderName());
@@ -159,37 +321,7 @@ struct WarmUpVisitor : public boost::dfs_visitor<> {
 
         } else if (std::holds_alternative<ComputePassData>(g[v].data)) {
             auto& computeData = std::get<ComputePassData>(_g.impl()[v].data);
-            const auto& programName = computeData.programName;
-            const auto& shaderResource = _shg.layout(programName);
-            scene::SlotMap perPassBindings;
-            scene::SlotMap perBatchBindings;
-            std::for_each(
-                shaderResource.bindings.begin(),
-                shaderResource.bindings.end(),
-                [&perBatchBindings, &perPassBindings](const auto& p) {
-                    if (p.second.rate == Rate::PER_PASS) {
-                        perPassBindings.emplace(p.first, p.second.binding);
-                    } else if (p.second.rate == Rate::PER_BATCH) {
-                        perBatchBindings.emplace(p.first, p.second.binding);
-                    }
-                });
-
-            auto method = scene::Method::pool().makeMethod(programName, flat_set<std::string>{});
-            method->bakeBindGroup(
-                perPassBindings,
-                perBatchBindings,
-                shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)],
-                shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
-                _device);
-
-            method->bakePipeline(
-                shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_PASS)],
-                shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_BATCH)],
-                shaderResource.constants,
-                shaderResource.shaderSources,
-                _device);
-
-            computeData.method = method;
+            computeData.method = computeMethod(computeData, g[v].name, _shg, _device);
         }
     }
 
@@ -200,7 +332,10 @@ struct WarmUpVisitor : public boost::dfs_visitor<> {
     ResourceGraph& _resg;
     rhi::DevicePtr _device;
     std::vector<scene::RenderablePtr>& _rendererables;
-    std::unordered_map<std::string, scene::BindGroupPtr, hash_string, std::equal_to<>>& _perPhaseBindGroups;
+    std::span<const scene::RenderablePtr> _cullables;
+    std::unordered_map<StringID, scene::BindGroupPtr>& _perPhaseBindGroups;
+    GPUCulling& _gpuCulling;
+    bool& _cpuCulling;
     rhi::RenderPassPtr _renderpass;
     rhi::DescriptorSetLayoutInfo _perPassLayoutInfo;
     scene::SlotMap _perPassBindings;
@@ -221,7 +356,7 @@ struct PreProcessVisitor : public boost::dfs_visitor<> {
             renderpass.framebuffer = getOrCreateFrameBuffer(renderpass.renderpass, v, _ag, _resg, _device, _swapchain);
         } else if (std::holds_alternative<RenderQueueData>(g[v].data)) {
             auto& queueData = std::get<RenderQueueData>(_g.impl()[v].data);
-            queueData.bindGroup = _perPhaseBindGroups.find(g[v].name)->second;
+            queueData.bindGroup = _perPhaseBindGroups.find(g[v].id)->second;
             auto bindGroup = queueData.bindGroup;
             for (auto renderingResource : queueData.resources) {
                 _resg.mount(renderingResource.name);
@@ -263,11 +398,6 @@ struct PreProcessVisitor : public boost::dfs_visitor<> {
                            _resg.get(renderingResource.name).data);
             }
             queueData.bindGroup->update();
-
-            for (auto& renderable : _renderables) {
-                auto meshRenderer = std::static_pointer_cast<scene::MeshRenderer>(renderable);
-                meshRenderer->update(_commandBuffer);
-            }
         } else if (std::holds_alternative<CopyPassData>(g[v].data)) {
             auto& copy = std::get<CopyPassData>(_g.impl()[v].data);
             for (const auto& copyPair : copy.copies) {
@@ -282,7 +412,7 @@ struct PreProcessVisitor : public boost::dfs_visitor<> {
             }
         } else if (std::holds_alternative<ComputePassData>(g[v].data)) {
             auto& compute = std::get<ComputePassData>(_g.impl()[v].data);
-            compute.method = scene::Method::pool().makeMethod(compute.programName, flat_set<std::string>{});
+            compute.method = computeMethod(compute, g[v].name, _shg, _device);
             auto& method = compute.method;
             for (const auto& res : compute.resources) {
                 _resg.mount(res.name);
@@ -336,14 +466,24 @@ struct PreProcessVisitor : public boost::dfs_visitor<> {
     rhi::CommandBufferPtr _commandBuffer;
     rhi::DevicePtr _device;
     rhi::SwapchainPtr _swapchain;
-    std::vector<scene::RenderablePtr>& _renderables;
-    std::unordered_map<std::string, scene::BindGroupPtr, hash_string, std::equal_to<>>& _perPhaseBindGroups;
+    std::unordered_map<StringID, scene::BindGroupPtr>& _perPhaseBindGroups;
 };
 
 struct RenderGraphVisitor : public boost::dfs_visitor<> {
     void discover_vertex(const RenderGraph::VertexType v, const RenderGraphImpl& g) {
         std::visit(overloaded{
                        [&](const RenderPassData& data) {
+                           // cull ahead of the pass, dispatches can't be recorded inside it
+                           for (const auto& e : make_iterator_range(out_edges(v, g))) {
+                               const auto& child = g[boost::target(e, g)];
+                               if (std::holds_alternative<RenderQueueData>(child.data)) {
+                                   const auto& queue = std::get<RenderQueueData>(child.data);
+                                   if (gpuDriven(queue) && _gpuCulling.contains(child.id)) {
+                                       _gpuCulling.cull(_commandBuffer.get(), child.id, queue.camera, _frameIndex);
+                                   }
+                               }
+                           }
+
                            auto* bufferBarriers = _accessGraph.getBufferBarrier(v);
                            if (bufferBarriers) {
                                for (auto& bufferBarrier : *bufferBarriers) {
@@ -359,90 +499,113 @@ struct RenderGraphVisitor : public boost::dfs_visitor<> {
                                    _commandBuffer->appendImageBarrier(imageBarrier.info);
                                }
                            }
+                           waitSplitBarriers(v);
                            _commandBuffer->applyBarrier(rhi::DependencyFlags::BY_REGION);
+                           _parallel = false;
+                           if (_parallelThreshold && _renderables.size() >= _parallelThreshold) {
+                               for (const auto& e : make_iterator_range(out_edges(v, g))) {
+                                   const auto& child = g[boost::target(e, g)].data;
+                                   if (std::holds_alternative<RenderQueueData>(child) &&
+                                       test(std::get<RenderQueueData>(child).flags, RenderQueueFlags::GEOMETRY)) {
+                                       _parallel = true;
+                                   }
+                               }
+                           }
+                           // secondaries would have to inherit the statistics query, parallel passes only get timestamps
+                           _profiler.beginPass(_commandBuffer.get(), g[v].name, !_parallel, false);
 
                            _renderEncoder = std::shared_ptr<rhi::RHIRenderEncoder>(_commandBuffer->makeRenderEncoder());
-                           std::vector<ClearValue> clears;
-                           clears.reserve(data.attachments.size());
+                           _clears.clear();
                            for (auto& am : data.attachments) {
-                               clears.emplace_back(am.clearValue);
+                               _clears.emplace_back(am.clearValue);
                            }
 
                            rhi::RenderPassBeginInfo beginInfo{
                                .renderPass = data.renderpass.get(),
                                .frameBuffer = data.framebuffer.get(),
                                .renderArea = data.renderArea,
-                               .clearColors = clears.data(),
+                               .clearColors = _clears.data(),
+                               .contents = _parallel ? rhi::SubpassContents::SECONDARY_COMMAND_BUFFERS : rhi::SubpassContents::INLINE,
+                           };
+                           _inheritance = {
+                               .flags = rhi::CommandBuferUsageFlag::ONE_TIME_SUBMIT,
+                               .renderPass = data.renderpass.get(),
+                               .subpass = 0,
+                               .frameBuffer = data.framebuffer.get(),
                            };
 
                            _renderEncoder->beginRenderPass(beginInfo);
                        },
                        [&](const RenderQueueData& data) {
-                           std::string_view phase = getPhaseName(g[v].name);
-                           _renderEncoder->setViewport(data.viewport);
-                           _renderEncoder->setScissor(data.viewport.rect);
+                           if (!_parallel) {
+                               _renderEncoder->setViewport(data.viewport);
+                               _renderEncoder->setScissor(data.viewport.rect);
+                           }
                            if (test(data.flags, RenderQueueFlags::GEOMETRY)) {
-                               for (const auto& renderable : _renderables) {
-                                   const auto& meshRenderer = std::static_pointer_cast<scene::MeshRenderer>(renderable);
-                                   uint32_t phaseIndex = -1;
-                                   for (const auto& tech : meshRenderer->techniques()) {
-                                       if (tech->phaseName() == phase) {
-                                           phaseIndex = &tech - &meshRenderer->techniques()[0];
-                                       }
-                                   }
-                                   raum_check(phaseIndex != -1, "Phase %s not found", phase);
-                                   const auto& technique = meshRenderer->technique(phaseIndex);
-                                   _renderEncoder->bindPipeline(technique->pipelineState().get());
-                                   const auto& mat = technique->material();
-                                   if (mat->type() == scene::MaterialType::PBR) {
-                                       const auto& pbrMat = static_pointer_cast<scene::PBRMaterial>(mat);
-                                       float alphCutoff = pbrMat->alphaCutoff();
-                                       _renderEncoder->pushConstants(ShaderStage::FRAGMENT, 0, &alphCutoff, sizeof(float));
-                                   }
-                                   if (technique->hasPassBinding()) {
-                                       _renderEncoder->bindDescriptorSet(data.bindGroup->descriptorSet().get(), 0, nullptr, 0);
-                                   }
-                                   if (technique->hasBatchBinding()) [[likely]] {
-                                       _renderEncoder->bindDescriptorSet(technique->material()->bindGroup()->descriptorSet().get(),
-                                                                         1, nullptr, 0);
-                                   }
-                                   if (technique->hasInstanceBinding()) {
-                                       _renderEncoder->bindDescriptorSet(meshRenderer->bindGroup()->descriptorSet().get(), 2, nullptr, 0);
-                                   }
-                                   const auto& drawInfo = meshRenderer->drawInfo();
-                                   const auto& meshData = meshRenderer->mesh()->meshData();
-                                   const auto& indexBuffer = meshData.indexBuffer;
-                                   const auto& vertexBuffer = meshData.vertexBuffer;
-                                   if (drawInfo.indexCount) {
-                                       _renderEncoder->bindIndexBuffer(indexBuffer.buffer.get(), indexBuffer.offset, indexBuffer.type);
-                                       _renderEncoder->bindVertexBuffer(vertexBuffer.buffer.get(), 0);
-                                       _renderEncoder->drawIndexed(drawInfo.indexCount, drawInfo.instanceCount, drawInfo.firstVertex, drawInfo.vertexOffset, drawInfo.firstInstance);
-                                   } else {
-                                       _renderEncoder->bindVertexBuffer(vertexBuffer.buffer.get(), 0);
-                                       _renderEncoder->draw(drawInfo.vertexCount, drawInfo.instanceCount, drawInfo.firstVertex, drawInfo.firstInstance);
+                               auto indirect = gpuDriven(data) ? _gpuCulling.indirectDraws(g[v].id, _frameIndex) : IndirectDraws{};
+                               auto masks = test(data.flags, RenderQueueFlags::OCCLUSION_CULLING) && !_unoccludedMasks.empty() ? _unoccludedMasks : _visibilityMasks;
+                               buildDrawCalls(_renderables, masks, cameraMask(_cullingCameras, data.camera), data.phase, data, _drawCalls);
+                               radixSort(_drawCalls, _sortScratch);
+                               _objectBuffer.bind(_drawCalls, _frameIndex, _shg);
+                               if (!indirect.batches.empty()) {
+                                   std::erase_if(_drawCalls, [](const DrawCall& drawCall) {
+                                       return GPUCulling::drawable(drawCall);
+                                   });
+                               }
+                               if (_instanceBuffer) {
+                                   _instanceBuffer->merge(_drawCalls, _shg);
+                               }
+                               if (_parallel) {
+                                   _secondaries.clear();
+                                   if (!indirect.batches.empty()) {
+                                       _recorder.record(
+                                           _inheritance, 1, 1,
+                                           [&](rhi::RHIRenderEncoder* encoder, uint32_t, uint32_t) {
+                                               encoder->setViewport(data.viewport);
+                                               encoder->setScissor(data.viewport.rect);
+                                               encodeIndirect(encoder, indirect, data);
+                                           },
+                                           _secondaries);
                                    }
+                                   _recorder.record(
+                                       _inheritance,
+                                       static_cast<uint32_t>(_drawCalls.size()),
+                                       MIN_RENDERABLES_PER_CHUNK,
+                                       [&](rhi::RHIRenderEncoder* encoder, uint32_t first, uint32_t last) {
+                                           encoder->setViewport(data.viewport);
+                                           encoder->setScissor(data.viewport.rect);
+                                           encodeGeometry(encoder, std::span(_drawCalls).subspan(first, last - first), data);
+                                       },
+                                       _secondaries);
+                                   _renderEncoder->executeCommands(_secondaries.data(), static_cast<uint32_t>(_secondaries.size()));
+                               } else {
+                                   encodeIndirect(_renderEncoder.get(), indirect, data);
+                                   encodeGeometry(_renderEncoder.get(), _drawCalls, data);
                                }
                            } else {
                                const auto& quadTech = data.technique;
-                               if (phase != quadTech->phaseName()) {
+                               if (data.phase != quadTech->phase()) {
                                    return;
                                }
-                               _renderEncoder->bindPipeline(quadTech->pipelineState().get());
-                               if (quadTech->hasPassBinding()) [[likely]] {
-                                   _renderEncoder->bindDescriptorSet(data.bindGroup->descriptorSet().get(), 0, nullptr, 0);
-                               }
-                               if (quadTech->hasBatchBinding()) {
-                                   _renderEncoder->bindDescriptorSet(quadTech->material()->bindGroup()->descriptorSet().get(),
-                                                                     1, nullptr, 0);
-                               }
-                               if (quadTech->hasInstanceBinding()) {
-                                   // _renderEncoder->bindDescriptorSet(quadTech->bindGroup()->descriptorSet().get(), 2, nullptr, 0);
+                               if (_parallel) {
+                                   // inline and secondary contents can't be mixed in a subpass
+                                   _secondaries.clear();
+                                   _recorder.record(
+                                       _inheritance, 1, 1,
+                                       [&](rhi::RHIRenderEncoder* encoder, uint32_t, uint32_t) {
+                                           encoder->setViewport(data.viewport);
+                                           encoder->setScissor(data.viewport.rect);
+                                           encodeQuad(encoder, data);
+                                       },
+                                       _secondaries);
+                                   _renderEncoder->executeCommands(_secondaries.data(), static_cast<uint32_t>(_secondaries.size()));
+                               } else {
+                                   encodeQuad(_renderEncoder.get(), data);
                                }
-
-                               _renderEncoder->draw(3, 1, 0, 0);
                            }
                        },
                        [&](const CopyPassData& copy) {
+                           _profiler.beginPass(_commandBuffer.get(), g[v].name, false, _asyncCompute);
                            for (const auto& upload : copy.uploads) {
                                auto buffer = _resg.getBuffer(upload.name);
                                if (!_blitEncoder) {
@@ -484,7 +647,10 @@ struct RenderGraphVisitor : public boost::dfs_visitor<> {
                                    _commandBuffer->appendImageBarrier(imageBarrier.info);
                                }
                            }
+                           waitSplitBarriers(v);
                            _commandBuffer->applyBarrier(rhi::DependencyFlags::BY_REGION);
+                           // graphics statistics can't be queried on a compute only queue
+                           _profiler.beginPass(_commandBuffer.get(), g[v].name, !_asyncCompute, _asyncCompute);
 
                            _computeEncoder = std::shared_ptr<rhi::RHIComputeEncoder>(_commandBuffer->makeComputeEncoder());
                            _computeEncoder->bindPipeline(data.method->pipelineState().get());
@@ -512,15 +678,21 @@ struct RenderGraphVisitor : public boost::dfs_visitor<> {
                        [&](const RenderPassData&) {
                            _renderEncoder->endRenderPass();
                            _renderEncoder.reset();
+                           _profiler.endPass(_commandBuffer.get());
+                           signalSplitBarriers(v);
                        },
                        [&](const RenderQueueData& renderQueue) {
 
                        },
                        [&](const CopyPassData& renderQueue) {
                            _blitEncoder.reset();
+                           _profiler.endPass(_commandBuffer.get());
+                           signalSplitBarriers(v);
                        },
                        [&](const ComputePassData&) {
                            _computeEncoder.reset();
+                           _profiler.endPass(_commandBuffer.get());
+                           signalSplitBarriers(v);
                        },
                        [&](auto _) {
 
@@ -529,13 +701,74 @@ struct RenderGraphVisitor : public boost::dfs_visitor<> {
                    g[v].data);
     }
 
+    rhi::RHIEvent* splitEvent(uint32_t index) {
+        while (_events.size() <= index) {
+            _events.emplace_back(_device->createEvent());
+        }
+        return _events[index].get();
+    }
+
+    void signalSplitBarriers(RenderGraph::VertexType v) {
+        auto* signals = _accessGraph.getSignals(v);
+        if (!signals) {
+            return;
+        }
+        auto& splits = _accessGraph.splitBarriers();
+        for (auto index : *signals) {
+            auto& split = splits[index];
+            for (auto& bufferBarrier : split.bufferBarriers) {
+                bufferBarrier.info.buffer = std::get<BufferData>(_resg.get(bufferBarrier.name).data).buffer.get();
+                _commandBuffer->appendBufferBarrier(bufferBarrier.info);
+            }
+            for (auto& imageBarrier : split.imageBarriers) {
+                imageBarrier.info.image = _resg.getImage(imageBarrier.name).get();
+                _commandBuffer->appendImageBarrier(imageBarrier.info);
+            }
+            _commandBuffer->setEvent(splitEvent(index), rhi::DependencyFlags::BY_REGION);
+        }
+    }
+
+    void waitSplitBarriers(RenderGraph::VertexType v) {
+        auto* waits = _accessGraph.getWaits(v);
+        if (!waits) {
+            return;
+        }
+        for (auto index : *waits) {
+            _commandBuffer->waitEvent(splitEvent(index));
+        }
+    }
+
     AccessGraph& _accessGraph;
     ResourceGraph& _resg;
-    const std::vector<scene::RenderablePtr> _renderables;
+    const std::vector<scene::RenderablePtr>& _renderables;
+    // one per renderable
+    std::span<const CameraMask> _visibilityMasks;
+    // empty unless some queue culls occlusion this frame
+    std::span<const CameraMask> _unoccludedMasks;
+    std::span<const scene::Camera* const> _cullingCameras;
     rhi::CommandBufferPtr _commandBuffer;
+    rhi::DevicePtr _device;
+    std::vector<rhi::EventPtr>& _events;
+    CommandRecorder& _recorder;
+    GPUProfiler& _profiler;
+    GPUCulling& _gpuCulling;
+    ObjectBuffer& _objectBuffer;
+    // null when instancing is off
+    InstanceBuffer* _instanceBuffer{nullptr};
+    const ShaderGraph& _shg;
+    uint32_t _frameIndex{0};
+    uint32_t _parallelThreshold{0};
+    std::vector<DrawCall>& _drawCalls;
+    std::vector<DrawCall>& _sortScratch;
+    std::vector<ClearValue>& _clears;
+    std::vector<rhi::RHICommandBuffer*>& _secondaries;
     rhi::BlitEncoderPtr _blitEncoder;
     rhi::RenderEncoderPtr _renderEncoder;
     rhi::ComputeEncoderPtr _computeEncoder;
+    rhi::CommandBufferBeginInfo _inheritance{};
+    bool _parallel{false};
+    // recording into the async compute command buffer
+    bool _asyncCompute{false};
 };
 
 GraphScheduler::GraphScheduler(
@@ -554,22 +787,43 @@ GraphScheduler::GraphScheduler(
   _accessGraph(accessGraph),
   _taskGraph(taskGraph),
   _sceneGraph(sceneGraph),
-  _shaderGraph(shaderGraph) {
+  _shaderGraph(shaderGraph),
+  _commandRecorder(device),
+  _profiler(device),
+  _objectBuffer(device),
+  _gpuCulling(device, _objectBuffer),
+  _instanceBuffer(device) {
+    _accessGraph->setQueueFamilies(_device->getQueue({rhi::QueueType::GRAPHICS})->index(),
+                                   _device->getQueue({rhi::QueueType::COMPUTE})->index());
+}
+
+void releaseOwnership(rhi::RHICommandBuffer* commandBuffer, AccessGraph::QueueRelease& release, ResourceGraph& resg) {
+    if (release.bufferBarriers.empty() && release.imageBarriers.empty()) {
+        return;
+    }
+    for (auto& bufferBarrier : release.bufferBarriers) {
+        bufferBarrier.info.buffer = std::get<BufferData>(resg.get(bufferBarrier.name).data).buffer.get();
+        commandBuffer->appendBufferBarrier(bufferBarrier.info);
+    }
+    for (auto& imageBarrier : release.imageBarriers) {
+        imageBarrier.info.image = resg.getImage(imageBarrier.name).get();
+        commandBuffer->appendImageBarrier(imageBarrier.info);
+    }
+    commandBuffer->applyBarrier(rhi::DependencyFlags::BY_REGION);
 }
 
 template <typename T>
 concept GraphVisitor = std::is_base_of_v<boost::dfs_visitor<>, T>;
 
+// compiled passes only, culled ones are skipped
 template <GraphVisitor T>
-void visitRenderGraph(T& visitor, RenderGraph& renderGraph) {
+void visitRenderGraph(T& visitor, RenderGraph& renderGraph, std::span<const RenderGraph::VertexType> passes) {
     auto& g = renderGraph.impl();
     auto indexMap = boost::get(boost::vertex_index, g);
     auto colorMap = boost::make_vector_property_map<boost::default_color_type>(indexMap);
 
-    for (auto vertex : boost::make_iterator_range(boost::vertices(g))) {
-        if (!std::holds_alternative<RenderQueueData>(g[vertex].data)) {
-            boost::depth_first_visit(g, vertex, visitor, colorMap);
-        }
+    for (auto vertex : passes) {
+        boost::depth_first_visit(g, vertex, visitor, colorMap);
     }
 }
 
@@ -577,14 +831,58 @@ void GraphScheduler::needWarmUp() {
     _warmed = false;
 }
 
-void GraphScheduler::execute(rhi::CommandBufferPtr cmd) {
-    std::vector<scene::RenderablePtr> renderables;
-    _accessGraph->analyze();
+void GraphScheduler::setParallelRecordThreshold(uint32_t threshold) {
+    _parallelRecordThreshold = threshold;
+}
+
+void GraphScheduler::setInstancing(bool enable) {
+    _instancing = enable;
+}
+
+void GraphScheduler::setLodPixelError(float pixels) {
+    _lodSettings.pixelError = pixels;
+}
+
+void GraphScheduler::setLodBias(int32_t bias) {
+    _lodSettings.bias = bias;
+}
+
+void GraphScheduler::forceLod(std::optional<uint32_t> lod) {
+    _lodSettings.forced = lod;
+}
+
+GraphScheduler::AsyncFrame& GraphScheduler::asyncFrame() {
+    auto& frame = _asyncFrames[_frameIndex];
+    if (!frame.computeCommandBuffer) {
+        if (!_computeCommandPool) {
+            auto computeQueueIndex = _device->getQueue({rhi::QueueType::COMPUTE})->index();
+            auto graphicsQueueIndex = _device->getQueue({rhi::QueueType::GRAPHICS})->index();
+            _computeCommandPool = rhi::CommandPoolPtr(_device->createCoomandPool({computeQueueIndex}));
+            _graphicsCommandPool = rhi::CommandPoolPtr(_device->createCoomandPool({graphicsQueueIndex}));
+        }
+        frame.computeCommandBuffer = rhi::CommandBufferPtr(_computeCommandPool->makeCommandBuffer({}));
+        frame.overlapCommandBuffer = rhi::CommandBufferPtr(_graphicsCommandPool->makeCommandBuffer({}));
+        frame.graphicsCommandBuffer = rhi::CommandBufferPtr(_graphicsCommandPool->makeCommandBuffer({}));
+        frame.graphicsDone = rhi::SemaphorePtr(_device->createSemaphore());
+        frame.computeDone = rhi::SemaphorePtr(_device->createSemaphore());
+    }
+    return frame;
+}
+
+rhi::CommandBufferPtr GraphScheduler::execute(rhi::CommandBufferPtr cmd) {
+    RAUM_TRACE_SCOPE("GraphScheduler::execute");
+    {
+        RAUM_TRACE_SCOPE("GraphScheduler::analyze");
+        _accessGraph->analyze();
+    }
 
     if (!_warmed) {
+        RAUM_TRACE_SCOPE("GraphScheduler::warmUp");
         collectRenderables(_renderables, _cullableRenderables, _noCullRenderables, *_sceneGraph);
+        _objectBuffer.build(_renderables);
 
         _warmed = true;
+        _cpuCulling = false;
         WarmUpVisitor warmUpVisitor{
             {},
             *_renderGraph,
@@ -594,31 +892,145 @@ void GraphScheduler::execute(rhi::CommandBufferPtr cmd) {
             *_resourceGraph,
             _device,
             _renderables,
-            _perPhaseBindGroups};
+            _cullableRenderables,
+            _perPhaseBindGroups,
+            _gpuCulling,
+            _cpuCulling};
+
+        visitRenderGraph(warmUpVisitor, *_renderGraph, _accessGraph->passes());
 
-        visitRenderGraph(warmUpVisitor, *_renderGraph);
+        _bvh.build(_cullableRenderables);
 
-        _bvhRoot = buildBVH(_cullableRenderables, 1);
+        std::vector<scene::MeshRendererPtr> occluders;
+        collectOccluders(*_sceneGraph, occluders);
+        _occlusionCulling.setOccluders(std::move(occluders));
     }
 
-    BVHCulling(_sceneGraph->cameras(), _bvhRoot, renderables);
-
-    PreProcessVisitor preProcessVisitor{
-        {},
-        *_renderGraph,
-        *_resourceGraph,
-        *_accessGraph,
-        *_shaderGraph,
-        *_sceneGraph,
-        cmd,
-        _device,
-        _swapchain,
-        renderables,
-        _perPhaseBindGroups};
-    visitRenderGraph(preProcessVisitor, *_renderGraph);
-
-    RenderGraphVisitor encodeVisitor{{}, *_accessGraph, *_resourceGraph, renderables, cmd};
-    visitRenderGraph(encodeVisitor, *_renderGraph);
+    if (_cpuCulling) {
+        RAUM_TRACE_SCOPE("GraphScheduler::cull");
+        _bvh.update();
+        collectCullingCameras(*_sceneGraph, *_renderGraph, _cullingCameras);
+        auto occlusionCameras = _occlusionCulling.empty() ? CameraMask{0} : occlusionCullingCameras(*_renderGraph, _cullingCameras);
+        _bvh.cull(_cullingCameras, _visibleRenderables, _visibilityMasks, &_visibleBounds);
+        if (occlusionCameras) {
+            _unoccludedMasks = _visibilityMasks;
+            for (; occlusionCameras; occlusionCameras &= occlusionCameras - 1) {
+                auto index = std::countr_zero(occlusionCameras);
+                const auto* camera = _cullingCameras[index];
+                if (camera->cullingEnabled()) {
+                    _occlusionCulling.cull(*camera, CameraMask{1} << index, _visibleBounds, _unoccludedMasks);
+                }
+            }
+        }
+        if (_swapchain) {
+            _lodSettings.viewportHeight = static_cast<float>(_swapchain->height());
+        }
+        selectLods(_visibleRenderables, _visibleBounds, _visibilityMasks, _cullingCameras, _lodSettings);
+    }
+
+    {
+        RAUM_TRACE_SCOPE("GraphScheduler::preProcess");
+        PreProcessVisitor preProcessVisitor{
+            {},
+            *_renderGraph,
+            *_resourceGraph,
+            *_accessGraph,
+            *_shaderGraph,
+            *_sceneGraph,
+            cmd,
+            _device,
+            _swapchain,
+            _perPhaseBindGroups};
+        visitRenderGraph(preProcessVisitor, *_renderGraph, _accessGraph->passes());
+    }
+
+    {
+        RAUM_TRACE_SCOPE("GraphScheduler::record");
+        _commandRecorder.reset();
+        _profiler.beginFrame(cmd.get(), _frameIndex);
+        _objectBuffer.update(_frameIndex);
+        _instanceBuffer.reset(_frameIndex);
+        auto statsBefore = cmd->renderEncoderStats();
+        RenderGraphVisitor encodeVisitor{
+            {},
+            *_accessGraph,
+            *_resourceGraph,
+            _visibleRenderables,
+            _visibilityMasks,
+            _unoccludedMasks,
+            _cullingCameras,
+            cmd,
+            _device,
+            _events[_frameIndex],
+            _commandRecorder,
+            _profiler,
+            _gpuCulling,
+            _objectBuffer,
+            _instancing ? &_instanceBuffer : nullptr,
+            *_shaderGraph,
+            _frameIndex,
+            _parallelRecordThreshold,
+            _drawCalls,
+            _sortScratch,
+            _clears,
+            _secondaries};
+        std::span<const RenderGraph::VertexType> passes = _accessGraph->passes();
+        auto* asyncCompute = _accessGraph->asyncCompute();
+        if (!asyncCompute) {
+            visitRenderGraph(encodeVisitor, *_renderGraph, passes);
+            _renderStats = cmd->renderEncoderStats() - statsBefore;
+        } else {
+            auto& frame = asyncFrame();
+            auto* graphicsQueue = _device->getQueue({rhi::QueueType::GRAPHICS});
+            auto* computeQueue = _device->getQueue({rhi::QueueType::COMPUTE});
+            auto encode = [&](rhi::CommandBufferPtr commandBuffer, uint32_t first, uint32_t last) {
+                encodeVisitor._commandBuffer = commandBuffer;
+                visitRenderGraph(encodeVisitor, *_renderGraph, passes.subspan(first, last - first));
+            };
+            auto begin = [](rhi::CommandBufferPtr commandBuffer, rhi::RHIQueue* queue) {
+                commandBuffer->reset();
+                commandBuffer->enqueue(queue);
+                commandBuffer->begin({});
+            };
+
+            // producers of async compute inputs, along with whatever was recorded into `cmd` before
+            encode(cmd, 0, asyncCompute->begin);
+            releaseOwnership(cmd.get(), asyncCompute->graphicsRelease, *_resourceGraph);
+            _renderStats = cmd->renderEncoderStats() - statsBefore;
+            cmd->commit();
+            graphicsQueue->flush(frame.graphicsDone.get());
+
+            begin(frame.computeCommandBuffer, computeQueue);
+            encodeVisitor._asyncCompute = true;
+            encode(frame.computeCommandBuffer, asyncCompute->begin, asyncCompute->end);
+            encodeVisitor._asyncCompute = false;
+            releaseOwnership(frame.computeCommandBuffer.get(), asyncCompute->computeRelease, *_resourceGraph);
+            frame.computeCommandBuffer->commit();
+            frame.graphicsDone->setStage(asyncCompute->computeWaitStage);
+            computeQueue->addWait(frame.graphicsDone.get());
+            computeQueue->flush(frame.computeDone.get());
+
+            if (asyncCompute->overlapEnd != asyncCompute->end) {
+                begin(frame.overlapCommandBuffer, graphicsQueue);
+                encode(frame.overlapCommandBuffer, asyncCompute->end, asyncCompute->overlapEnd);
+                frame.overlapCommandBuffer->commit();
+                graphicsQueue->flush(nullptr);
+                _renderStats += frame.overlapCommandBuffer->renderEncoderStats();
+            }
+
+            cmd = frame.graphicsCommandBuffer;
+            begin(cmd, graphicsQueue);
+            frame.computeDone->setStage(asyncCompute->graphicsWaitStage);
+            graphicsQueue->addWait(frame.computeDone.get());
+            encode(cmd, asyncCompute->overlapEnd, static_cast<uint32_t>(passes.size()));
+            _renderStats += cmd->renderEncoderStats();
+        }
+    }
+    _frameIndex = (_frameIndex + 1) % rhi::FRAMES_IN_FLIGHT;
+    scene::BindGroup::nextFrame();
+    // only ever flushed, its complete handlers and staging slot move on with the frame
+    _device->getQueue({rhi::QueueType::COMPUTE})->endFrame();
+    _renderStats += _commandRecorder.renderEncoderStats();
 
     auto* presentBarrier = _accessGraph->presentBarrier();
     if (presentBarrier) {
@@ -627,8 +1039,14 @@ void GraphScheduler::execute(rhi::CommandBufferPtr cmd) {
         cmd->applyBarrier(rhi::DependencyFlags::BY_REGION);
     }
 
+    // containers keep their capacity for the next frame
+    _visibleRenderables.clear();
+    _visibilityMasks.clear();
+    _visibleBounds.clear();
+    _unoccludedMasks.clear();
     _renderGraph->clear();
     _accessGraph->clear();
+    return cmd;
 }
 
 } // namespace raum::graph
\ No newline at end of file
@@ -1,7 +1,15 @@
 #pragma once
 #include "AccessGraph.h"
+#include "CommandRecorder.h"
+#include "GPUCulling.h"
+#include "GPUProfiler.h"
+#include "GraphUtils.h"
+#include "InstanceBuffer.h"
+#include "ObjectBuffer.h"
+#include "OcclusionCulling.h"
 #include "RenderGraph.h"
 #include "ResourceGraph.h"
+#include "SceneBVH.h"
 #include "SceneGraph.h"
 #include "ShaderGraph.h"
 #include "TaskGraph.h"
@@ -22,7 +30,29 @@ public:
         ShaderGraph* _shaderGraph);
 
     void needWarmUp();
-    void execute(rhi::CommandBufferPtr cmd);
+    // returns the command buffer to continue the frame with, it differs from `cmd` when async compute
+    // split the frame: `cmd` is submitted already then.
+    rhi::CommandBufferPtr execute(rhi::CommandBufferPtr cmd);
+
+    // geometry queues with at least `threshold` renderables are recorded on worker threads, 0 disables.
+    void setParallelRecordThreshold(uint32_t threshold);
+
+    // merge sorted draws sharing mesh, material and pipeline into instanced draws, on by default.
+    void setInstancing(bool enable);
+
+    // levels of detail are picked per visible renderable, coarser ones while their simplification error projects
+    // to at most `pixels` on the swapchain, 1 by default.
+    void setLodPixelError(float pixels);
+    // shifts every selected level, positive values are coarser
+    void setLodBias(int32_t bias);
+    // draws every renderable at `lod` when set, for debugging
+    void forceLod(std::optional<uint32_t> lod);
+
+    // draws and binds issued/skipped by the last execute
+    const rhi::RenderEncoderStats& renderStats() const { return _renderStats; }
+
+    // per pass gpu timings, disabled by default
+    GPUProfiler& profiler() { return _profiler; }
 
 private:
     RenderGraph* _renderGraph;
@@ -36,11 +66,57 @@ private:
     rhi::DevicePtr _device;
 
     bool _warmed{false};
+    uint32_t _parallelRecordThreshold{256};
+
+    CommandRecorder _commandRecorder;
+    GPUProfiler _profiler;
+    // ahead of _gpuCulling, which keeps a reference
+    ObjectBuffer _objectBuffer;
+    GPUCulling _gpuCulling;
+    InstanceBuffer _instanceBuffer;
+    bool _instancing{true};
+    LodSettings _lodSettings;
+    // off when every geometry queue is culled on the gpu
+    bool _cpuCulling{true};
+    rhi::RenderEncoderStats _renderStats{};
+    std::vector<DrawCall> _drawCalls;
+    std::vector<DrawCall> _sortScratch;
+    // recording scratch, keeps its capacity across frames
+    std::vector<ClearValue> _clears;
+    std::vector<rhi::RHICommandBuffer*> _secondaries;
+
+    // split barrier events, a frame's pool is reused once its commands retired
+    std::array<std::vector<rhi::EventPtr>, rhi::FRAMES_IN_FLIGHT> _events;
+    uint32_t _frameIndex{0};
+
+    struct AsyncFrame {
+        rhi::CommandBufferPtr computeCommandBuffer;
+        // graphics work running alongside async compute
+        rhi::CommandBufferPtr overlapCommandBuffer;
+        // graphics work waiting for async compute
+        rhi::CommandBufferPtr graphicsCommandBuffer;
+        rhi::SemaphorePtr graphicsDone;
+        rhi::SemaphorePtr computeDone;
+    };
+    AsyncFrame& asyncFrame();
+
+    rhi::CommandPoolPtr _computeCommandPool;
+    rhi::CommandPoolPtr _graphicsCommandPool;
+    std::array<AsyncFrame, rhi::FRAMES_IN_FLIGHT> _asyncFrames;
 
-    std::unordered_map<std::string, scene::BindGroupPtr, hash_string, std::equal_to<>> _perPhaseBindGroups;
+    std::unordered_map<StringID, scene::BindGroupPtr> _perPhaseBindGroups;
 
-    scene::BVHNode* _bvhRoot{nullptr};
+    SceneBVH _bvh;
     std::vector<scene::RenderablePtr> _renderables;
+    std::vector<scene::RenderablePtr> _visibleRenderables;
+    // bit i set when _cullingCameras[i] sees the matching visible renderable
+    std::vector<CameraMask> _visibilityMasks;
+    std::vector<const scene::Camera*> _cullingCameras;
+    OcclusionCulling _occlusionCulling;
+    // bounds of the visible renderables
+    std::vector<scene::AABB> _visibleBounds;
+    // _visibilityMasks without the occluded renderables, read by queues with occlusion culling
+    std::vector<CameraMask> _unoccludedMasks;
     std::span<scene::RenderablePtr> _noCullRenderables;
     std::span<scene::RenderablePtr> _cullableRenderables;
 };
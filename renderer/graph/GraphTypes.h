@@ -9,6 +9,8 @@
 #include <map>
 #include <boost/graph/adjacency_list.hpp>
 #include "Method.h"
+#include "core/utils/StringTable.h"
+#include "core/utils/containers.h"
 namespace raum::graph {
 
 constexpr size_t INVALID_VERTEX = 0xFFFFFFFF;
@@ -41,16 +43,20 @@ using ClearValue = rhi::ClearValue;
 using ShaderStage = rhi::ShaderStage;
 using BufferUsage = rhi::BufferUsage;
 
+// id of an already declared resource name, string lookups never grow the string table.
+StringID resourceName(std::string_view name);
+
+// per-frame pass data: names and lists live in the render graph arena, see RenderGraph::arena().
 struct  RenderingResource {
-    std::string name{};
-    std::string bindingName{};
+    StringID name{};
+    std::string_view bindingName{};
     Access access{Access::READ};
     ShaderStage visibility{ShaderStage::FRAGMENT};
 };
 
 struct AttachmentResource {
-    std::string name{};
-    std::string bindingName{};
+    StringID name{};
+    std::string_view bindingName{};
     ClearValue clearValue;
     Access access{Access::READ};
     ResourceType type{ResourceType::COLOR};
@@ -61,14 +67,14 @@ struct AttachmentResource {
 };
 
 struct RenderPassData {
-    std::vector<AttachmentResource> attachments;
+    PmrVector<AttachmentResource> attachments;
     rhi::RenderPassPtr renderpass;
     rhi::FrameBufferPtr framebuffer;
     rhi::Rect2D renderArea;
 };
 
 struct SubRenderPassData {
-    std::vector<AttachmentResource> attachments;
+    PmrVector<AttachmentResource> attachments;
 };
 
 enum class RenderQueueFlags: uint32_t {
@@ -77,28 +83,40 @@ enum class RenderQueueFlags: uint32_t {
     TRANSPARENT = 1 << 1,
     REVERSE_Z = 1 << 2,
     GEOMETRY = 1 << 3,
+    // geometry culled and compacted on the gpu, drawn with indirect count draws
+    GPU_DRIVEN = 1 << 4,
+    // frustum culled renderables are also tested against the scene occluders on the cpu
+    OCCLUSION_CULLING = 1 << 5,
 };
 OPERABLE(RenderQueueFlags)
 
 struct RenderQueueData {
     scene::Camera* camera{nullptr};
     rhi::Viewport viewport{};
-    std::vector<RenderingResource> resources;
+    PmrVector<RenderingResource> resources;
     scene::BindGroupPtr bindGroup; // per pass binding
     RenderQueueFlags flags{RenderQueueFlags::NONE};
     scene::TechniquePtr technique; // quad tech
+    StringID phase; // queue name without its render pass
+};
+
+enum class QueueHint : uint8_t {
+    AUTO,     // async compute queue if the device has a dedicated compute family
+    ASYNC,    // async compute queue even if it shares the graphics family
+    GRAPHICS, // always inline on the graphics queue
 };
 
 struct ComputePassData {
-    std::string programName{};
-    std::vector<RenderingResource> resources;
+    std::string_view programName{};
+    PmrVector<RenderingResource> resources;
     Vec3i dispatch{1, 1, 1};
     scene::MethodPtr method;
+    QueueHint queueHint{QueueHint::AUTO};
 };
 
 struct CopyPair {
-    std::string source{};
-    std::string target{};
+    StringID source{};
+    StringID target{};
     std::variant<rhi::BufferCopyRegion, rhi::BufferImageCopyRegion, rhi::ImageBlit, rhi::ImageCopyRegion> region;
 };
 
@@ -106,20 +124,20 @@ struct UploadPair {
     rhi::StagingBufferInfo stagingBuffer;
     uint32_t size{0};
     std::uint32_t offset{0};
-    std::string name;
+    StringID name;
 };
 
 struct FillValue {
     uint32_t value{0};
     uint32_t size{0};
     uint32_t dstOffset{0};
-    std::string name;
+    StringID name;
 };
 
 struct CopyPassData {
-    std::vector<CopyPair> copies;
-    std::vector<UploadPair> uploads;
-    std::vector<FillValue> fills;
+    PmrVector<CopyPair> copies;
+    PmrVector<UploadPair> uploads;
+    PmrVector<FillValue> fills;
 };
 
 struct BufferData {
@@ -128,7 +146,7 @@ struct BufferData {
 };
 
 struct BufferViewData {
-    std::string origin{};
+    StringID origin{};
     rhi::BufferViewInfo info{};
     rhi::BufferViewPtr bufferView;
 };
@@ -139,7 +157,7 @@ struct ImageData {
 };
 
 struct ImageViewData {
-    std::string origin{};
+    StringID origin{};
     rhi::ImageViewInfo info{};
     rhi::ImageViewPtr imageView;
 };
@@ -202,6 +220,10 @@ struct ShaderResource {
     boost::container::flat_map<ShaderStage, std::string> shaderSources;
 };
 
+// "ds" -> "ds/Depth", "ds/Stencil": aspect views created along with every depth stencil image.
+StringID depthViewName(StringID image);
+StringID stencilViewName(StringID image);
+
 using ShaderResources = std::unordered_map<std::string, ShaderResource, hash_string, std::equal_to<>>;
 using TransparentUnorderedSet = std::unordered_set<std::string, hash_string, std::equal_to<>>;
 
@@ -1,4 +1,7 @@
 #include "GraphUtils.h"
+#include <bit>
+#include <cstring>
+#include <boost/functional/hash.hpp>
 #include "RHIDevice.h"
 
 namespace raum::graph {
@@ -133,6 +136,7 @@ void collectRenderables(
     std::span<scene::RenderablePtr>& cullableRenderables,
     std::span<scene::RenderablePtr>& nocullRenderables,
     const SceneGraph& sg) {
+    renderables.clear();
     const auto& graph = sg.impl();
     std::vector<scene::MeshRendererPtr> noCullings;
     std::vector<scene::MeshRendererPtr> cullables;
@@ -160,74 +164,249 @@ void collectRenderables(
     nocullRenderables = std::span(renderables).subspan(cullables.size());
 }
 
-namespace {
-// Helper function to build a BVH node
-scene::AABB getAABB(const std::span<scene::RenderablePtr>& renderables) {
-    scene::AABB aabb{};
-    aabb.minBound = Vec3f(std::numeric_limits<float>::max());
-    aabb.maxBound = Vec3f(std::numeric_limits<float>::lowest());
-    for (const auto& renderable : renderables) {
-        auto meshRenderer = std::static_pointer_cast<const scene::MeshRenderer>(renderable);
-        const auto& meshAABB = meshRenderer->mesh()->aabb();
-        aabb.minBound = glm::min(aabb.minBound, meshAABB.minBound);
-        aabb.maxBound = glm::max(aabb.maxBound, meshAABB.maxBound);
+void collectOccluders(const SceneGraph& sg, std::vector<scene::MeshRendererPtr>& occluders) {
+    occluders.clear();
+    const auto& graph = sg.impl();
+    for (auto v : boost::make_iterator_range(boost::vertices(graph))) {
+        if (const auto* modelNode = std::get_if<ModelNode>(&graph[v].sceneNodeData)) {
+            if (!graph[v].node.enabled() || !test(modelNode->hint, ModelHint::OCCLUDER)) {
+                continue;
+            }
+            for (const auto& meshRenderer : modelNode->model->meshRenderers()) {
+                const auto& occluder = meshRenderer->mesh()->occluder();
+                if (occluder && !occluder->indices.empty()) {
+                    occluders.emplace_back(meshRenderer);
+                }
+            }
+        }
     }
-    return aabb;
 }
 
-} // namespace
+void collectCullingCameras(const SceneGraph& sg, RenderGraph& rg, std::vector<const scene::Camera*>& cameras) {
+    cameras.clear();
+    auto add = [&cameras](const scene::Camera* camera) {
+        if (camera && std::ranges::find(cameras, camera) == cameras.end()) {
+            cameras.emplace_back(camera);
+        }
+    };
+    for (const auto* cameraNode : sg.cameras()) {
+        add(cameraNode->camera.get());
+    }
+    auto& g = rg.impl();
+    for (auto v : boost::make_iterator_range(boost::vertices(g))) {
+        if (const auto* queue = std::get_if<RenderQueueData>(&g[v].data)) {
+            if (test(queue->flags, RenderQueueFlags::GEOMETRY)) {
+                add(queue->camera);
+            }
+        }
+    }
+    raum_check(cameras.size() <= MAX_CULLING_CAMERAS, "{} culling cameras, only {} are tested", cameras.size(), MAX_CULLING_CAMERAS);
+    if (cameras.size() > MAX_CULLING_CAMERAS) {
+        cameras.resize(MAX_CULLING_CAMERAS);
+    }
+}
 
-scene::BVHNode* buildBVH(std::span<scene::RenderablePtr>& renderables, uint32_t maxObjectsPerNode) {
-    // expect renderables to be sorted
+CameraMask cameraMask(std::span<const scene::Camera* const> cameras, const scene::Camera* camera) {
+    auto iter = std::ranges::find(cameras, camera);
+    if (!camera || iter == cameras.end()) {
+        return ~CameraMask{0};
+    }
+    return CameraMask{1} << std::distance(cameras.begin(), iter);
+}
 
-    if (renderables.size() <= maxObjectsPerNode) {
-        scene::BVHNode* leafNode = new scene::BVHNode();
-        leafNode->aabb = getAABB(renderables);
-        leafNode->children = renderables;
-        return leafNode;
+CameraMask occlusionCullingCameras(RenderGraph& rg, std::span<const scene::Camera* const> cameras) {
+    CameraMask mask{0};
+    auto& g = rg.impl();
+    for (auto v : boost::make_iterator_range(boost::vertices(g))) {
+        if (const auto* queue = std::get_if<RenderQueueData>(&g[v].data)) {
+            if (queue->camera && test(queue->flags, RenderQueueFlags::GEOMETRY) &&
+                test(queue->flags, RenderQueueFlags::OCCLUSION_CULLING)) {
+                // cameras past the culling limit have no bit
+                auto bit = cameraMask(cameras, queue->camera);
+                if (bit != ~CameraMask{0}) {
+                    mask |= bit;
+                }
+            }
+        }
     }
+    return mask;
+}
 
-    std::span<scene::RenderablePtr> lefts = renderables.subspan(0, renderables.size() / 2);
-    std::span<scene::RenderablePtr> rights = renderables.subspan(renderables.size() / 2);
+namespace {
 
-    scene::BVHNode* node = new scene::BVHNode();
-    node->aabb = getAABB(renderables);
-    if (!lefts.empty()) {
-        node->left = buildBVH(lefts, maxObjectsPerNode);
+// pixels per world unit of error at the distance of `aabb`
+float errorScale(const scene::Camera& camera, const scene::AABB& aabb, float viewportHeight) {
+    const auto& eye = camera.eye();
+    auto scale = eye.projection()[1][1] * 0.5f * viewportHeight;
+    if (eye.projectionType() == scene::Projection::ORTHOGRAPHIC) {
+        return scale;
     }
-    if (!rights.empty()) {
-        node->right = buildBVH(rights, maxObjectsPerNode);
+    const auto& position = eye.getPosition();
+    auto distance = glm::length(glm::max(glm::max(aabb.minBound - position, position - aabb.maxBound), Vec3f{0.0f}));
+    return scale / std::max(distance, eye.getPerspectiveFrustum().near);
+}
+
+} // namespace
+
+void selectLods(std::span<const scene::RenderablePtr> renderables,
+                std::span<const scene::AABB> bounds,
+                std::span<const CameraMask> masks,
+                std::span<const scene::Camera* const> cameras,
+                const LodSettings& settings) {
+    raum_check(renderables.size() == bounds.size() && renderables.size() == masks.size(), "one bounds and mask per renderable");
+    for (uint32_t i = 0; i < renderables.size(); ++i) {
+        auto* meshRenderer = static_cast<scene::MeshRenderer*>(renderables[i].get());
+        const auto& lods = meshRenderer->mesh()->lods();
+        if (lods.size() < 2) {
+            continue;
+        }
+        if (settings.forced) {
+            meshRenderer->setLod(*settings.forced);
+            continue;
+        }
+        // errors are in mesh space
+        const auto& transform = meshRenderer->transform();
+        auto meshScale = std::max({glm::length(Vec3f(transform[0])), glm::length(Vec3f(transform[1])), glm::length(Vec3f(transform[2]))});
+        auto lod = static_cast<uint32_t>(lods.size()) - 1;
+        for (auto mask = masks[i]; mask && lod; mask &= mask - 1) {
+            auto pixels = errorScale(*cameras[std::countr_zero(mask)], bounds[i], settings.viewportHeight) * meshScale;
+            while (lod && lods[lod].error * pixels > settings.pixelError) {
+                --lod;
+            }
+        }
+        auto biased = std::clamp(static_cast<int32_t>(lod) + settings.bias, 0, static_cast<int32_t>(lods.size()) - 1);
+        meshRenderer->setLod(static_cast<uint32_t>(biased));
     }
-    return node;
 }
 
-void BVHCulling(const scene::FrustumPlanes& frustumPlanes,
-                const scene::BVHNode* node,
-                std::vector<scene::RenderablePtr>& renderables) {
-    if (!node) {
-        return;
+namespace {
+
+// ids fill 16 bits of the sort key, past that they saturate: order degrades but merging compares the real state.
+template <typename Key = const void*>
+class SortIDs {
+public:
+    static constexpr uint32_t MAX_ID = 0xFFFF;
+
+    uint64_t get(Key k) {
+        auto [iter, added] = _ids.emplace(k, static_cast<uint32_t>(_ids.size()));
+        if (added && iter->second == MAX_ID + 1) {
+            raum_warn("more than {} sort ids in a queue, draws past that share the last id", MAX_ID + 1);
+        }
+        return std::min(iter->second, MAX_ID);
     }
-    if (scene::frustumCulling(frustumPlanes, node->aabb)) {
-        if (!node->children.empty()) {
-            for (const auto& renderable : node->children) {
-                const auto meshRenderer = std::static_pointer_cast<const scene::MeshRenderer>(renderable);
-                if (scene::frustumCulling(frustumPlanes, meshRenderer->mesh()->aabb())) {
-                    renderables.emplace_back(renderable);
-                }
-            }
+
+private:
+    std::unordered_map<Key, uint32_t> _ids;
+};
+
+// copies of a prop share buffers and index range but not the Mesh, which owns the world bounds.
+size_t meshRange(const scene::MeshRenderer& meshRenderer) {
+    const auto& meshData = meshRenderer.mesh()->meshData();
+    const auto& drawInfo = meshRenderer.drawInfo();
+    size_t seed = 9527;
+    boost::hash_combine(seed, meshData.vertexBuffer.buffer.get());
+    boost::hash_combine(seed, meshData.indexBuffer.buffer.get());
+    boost::hash_combine(seed, drawInfo.firstVertex);
+    boost::hash_combine(seed, drawInfo.indexCount);
+    boost::hash_combine(seed, drawInfo.vertexOffset);
+    return seed;
+}
+
+// positive float bits are monotonic, keep the high 16 bits.
+uint64_t quantizeDepth(float depth) {
+    depth = std::max(depth, 0.0f);
+    uint32_t bits{0};
+    std::memcpy(&bits, &depth, sizeof(float));
+    return bits >> 16;
+}
+
+} // namespace
+
+void buildDrawCalls(std::span<const scene::RenderablePtr> renderables,
+                    std::span<const CameraMask> masks,
+                    CameraMask cameraMask,
+                    StringID phase,
+                    const RenderQueueData& queueData,
+                    std::vector<DrawCall>& drawCalls) {
+    SortIDs pipelineIDs;
+    SortIDs materialIDs;
+    SortIDs<size_t> meshIDs;
+
+    bool transparent = test(queueData.flags, RenderQueueFlags::TRANSPARENT);
+    const auto* camera = queueData.camera;
+    Vec3f eyePos{0.0f};
+    Vec3f eyeForward{0.0f};
+    if (camera) {
+        eyePos = camera->eye().getPosition();
+        eyeForward = camera->eye().forward();
+    }
+
+    drawCalls.clear();
+    drawCalls.reserve(renderables.size());
+    for (uint32_t i = 0; i < renderables.size(); ++i) {
+        if (!masks.empty() && !(masks[i] & cameraMask)) {
+            continue;
+        }
+        auto* meshRenderer = static_cast<scene::MeshRenderer*>(renderables[i].get());
+        auto& techs = meshRenderer->techniques();
+        auto iter = std::find_if(techs.begin(), techs.end(), [phase](const auto& tech) {
+            return tech->phase() == phase;
+        });
+        raum_check(iter != techs.end(), "Phase {} not found", phase.str());
+        if (iter == techs.end()) {
+            continue;
+        }
+        auto* technique = iter->get();
+
+        const auto& aabb = meshRenderer->mesh()->aabb();
+        auto center = (aabb.minBound + aabb.maxBound) * 0.5f;
+        auto depth = quantizeDepth(glm::dot(center - eyePos, eyeForward));
+
+        uint64_t pipeline = pipelineIDs.get(technique->pipelineState().get());
+        uint64_t material = materialIDs.get(technique->material()->bindGroup().get());
+        uint64_t mesh = meshIDs.get(meshRange(*meshRenderer));
+        uint64_t key{0};
+        if (transparent) {
+            key = ((0xFFFF - depth) << 48) | (pipeline << 32) | (material << 16) | mesh;
         } else {
-            BVHCulling(frustumPlanes, node->left, renderables);
-            BVHCulling(frustumPlanes, node->right, renderables);
+            key = (pipeline << 48) | (material << 32) | (mesh << 16) | depth;
         }
+        drawCalls.emplace_back(key, meshRenderer, technique);
     }
 }
 
-void BVHCulling(const std::vector<CameraNode*>& cameras,
-                const scene::BVHNode* node,
-                std::vector<scene::RenderablePtr>& renderables) {
-    for (const auto& camera : cameras) {
-        const auto& frustum = camera->camera->frustumPlanes();
-        BVHCulling(frustum, node, renderables);
+void radixSort(std::vector<DrawCall>& drawCalls, std::vector<DrawCall>& scratch) {
+    constexpr uint32_t RADIX_BITS = 8;
+    constexpr uint32_t BUCKETS = 1 << RADIX_BITS;
+
+    if (drawCalls.empty()) {
+        return;
+    }
+    scratch.resize(drawCalls.size());
+    uint64_t diff{0};
+    for (const auto& drawCall : drawCalls) {
+        diff |= drawCall.key ^ drawCalls.front().key;
+    }
+
+    for (uint32_t shift = 0; shift < 64; shift += RADIX_BITS) {
+        // skip digits where all keys agree
+        if (!((diff >> shift) & (BUCKETS - 1))) {
+            continue;
+        }
+        std::array<uint32_t, BUCKETS> offsets{};
+        for (const auto& drawCall : drawCalls) {
+            ++offsets[(drawCall.key >> shift) & (BUCKETS - 1)];
+        }
+        uint32_t sum{0};
+        for (auto& offset : offsets) {
+            auto count = offset;
+            offset = sum;
+            sum += count;
+        }
+        for (const auto& drawCall : drawCalls) {
+            scratch[offsets[(drawCall.key >> shift) & (BUCKETS - 1)]++] = drawCall;
+        }
+        drawCalls.swap(scratch);
     }
 }
 
@@ -240,7 +419,15 @@ std::string_view getPhaseName(std::string_view queueName) {
     }
 }
 
-void bindResourceToMaterial(std::string_view resourceName, std::string_view slotName, scene::MaterialPtr mat, ResourceGraph& resg) {
+const ShaderBindingDesc* objectDataBinding(const ShaderResource& shaderResource) {
+    auto iter = shaderResource.bindings.find(OBJECT_DATA_SLOT);
+    if (iter == shaderResource.bindings.end() || iter->second.rate != Rate::PER_DRAW) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void bindResourceToMaterial(StringID resourceName, std::string_view slotName, scene::MaterialPtr mat, ResourceGraph& resg) {
     auto imgView = resg.getImageView(resourceName);
     auto img = resg.getImage(resourceName);
     scene::Texture texture{img, imgView, 0};
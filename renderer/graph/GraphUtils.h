@@ -1,7 +1,10 @@
 #pragma once
+#include <optional>
 #include <span>
 #include "AccessGraph.h"
+#include "BVH.h"
 #include "Material.h"
+#include "Mesh.h"
 #include "RHIDevice.h"
 #include "RenderGraph.h"
 #include "SceneGraph.h"
@@ -28,17 +31,71 @@ void collectRenderables(std::vector<scene::RenderablePtr>& renderables,
                         std::span<scene::RenderablePtr>& nocullRenderables,
                         const SceneGraph& sg);
 
-void BVHCulling(const std::vector<CameraNode*>& cameras,
-                const scene::BVHNode* node,
-                std::vector<scene::RenderablePtr>& renderables);
+// renderers of enabled models hinted OCCLUDER whose mesh carries occluder geometry.
+void collectOccluders(const SceneGraph& sg, std::vector<scene::MeshRendererPtr>& occluders);
 
-scene::BVHNode* buildBVH(std::span<scene::RenderablePtr>& renderables, uint32_t maxObjectsPerNode = 4);
+// scene cameras first, then the cameras of geometry queues, each once.
+void collectCullingCameras(const SceneGraph& sg, RenderGraph& rg, std::vector<const scene::Camera*>& cameras);
+
+// bit of `camera`, queues without a culling camera draw what any camera sees.
+CameraMask cameraMask(std::span<const scene::Camera* const> cameras, const scene::Camera* camera);
+
+// bits of the cameras whose geometry queues ask for occlusion culling.
+CameraMask occlusionCullingCameras(RenderGraph& rg, std::span<const scene::Camera* const> cameras);
+
+struct LodSettings {
+    // screen space error a level may show, in pixels
+    float pixelError{1.0f};
+    // pixels the vertical field of view maps to
+    float viewportHeight{1080.0f};
+    // added to the selected level, negative values keep more detail
+    int32_t bias{0};
+    // every renderable draws this level when set, for debugging
+    std::optional<uint32_t> forced;
+};
+
+// picks the level of detail of each renderable from the projected simplification error, the finest any camera
+// in its `masks` entry needs. `bounds` are world space, one per renderable.
+void selectLods(std::span<const scene::RenderablePtr> renderables,
+                std::span<const scene::AABB> bounds,
+                std::span<const CameraMask> masks,
+                std::span<const scene::Camera* const> cameras,
+                const LodSettings& settings);
 
 void warmUp(SceneGraph& sg, ShaderGraph& shg, rhi::DevicePtr device);
 
+// one draw of a geometry queue, technique resolved for the queue phase.
+struct DrawCall {
+    uint64_t key{0};
+    scene::MeshRenderer* meshRenderer{nullptr};
+    scene::Technique* technique{nullptr};
+    // transforms are read from `objectBindGroup` at firstInstance: the object slot, or the first merged instance.
+    uint32_t firstInstance{0};
+    uint32_t instanceCount{1};
+    // null if the shader reads no object data
+    scene::BindGroup* objectBindGroup{nullptr};
+};
+
+// key layout from msb: pipeline(16) | material bind group(16) | mesh range(16) | depth(16),
+// transparent queues put depth(back to front) first. Renderables whose `masks` entry misses `cameraMask` are
+// skipped, empty `masks` keeps all.
+void buildDrawCalls(std::span<const scene::RenderablePtr> renderables,
+                    std::span<const CameraMask> masks,
+                    CameraMask cameraMask,
+                    StringID phase,
+                    const RenderQueueData& queueData,
+                    std::vector<DrawCall>& drawCalls);
+
+// stable lsd radix sort on DrawCall::key, `scratch` is reused between calls.
+void radixSort(std::vector<DrawCall>& drawCalls, std::vector<DrawCall>& scratch);
+
 std::string_view getPhaseName(std::string_view queueName);
 
-void bindResourceToMaterial(std::string_view resourceName, std::string_view slotName, scene::MaterialPtr mat, ResourceGraph& resg);
+// per object transforms, a per_draw storage buffer indexed by instance.
+constexpr std::string_view OBJECT_DATA_SLOT = "ObjectData";
+const ShaderBindingDesc* objectDataBinding(const ShaderResource& shaderResource);
+
+void bindResourceToMaterial(StringID resourceName, std::string_view slotName, scene::MaterialPtr mat, ResourceGraph& resg);
 
 scene::MeshRendererPtr getLocalQuad(rhi::DevicePtr device);
 
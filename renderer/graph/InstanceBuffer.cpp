@@ -0,0 +1,116 @@
+#include "InstanceBuffer.h"
+#include <algorithm>
+#include <bit>
+#include "GPUCulling.h"
+#include "RHIBuffer.h"
+#include "RHIDevice.h"
+
+namespace raum::graph {
+
+namespace {
+
+constexpr uint32_t MIN_INSTANCE_CAPACITY{1024};
+
+bool sameInstance(const DrawCall& lhs, const DrawCall& rhs) {
+    if (!GPUCulling::drawable(rhs) ||
+        lhs.technique->pipelineState() != rhs.technique->pipelineState() ||
+        lhs.technique->material()->bindGroup() != rhs.technique->material()->bindGroup()) {
+        return false;
+    }
+    const auto& lhsMesh = lhs.meshRenderer->mesh()->meshData();
+    const auto& rhsMesh = rhs.meshRenderer->mesh()->meshData();
+    const auto& lhsDraw = lhs.meshRenderer->drawInfo();
+    const auto& rhsDraw = rhs.meshRenderer->drawInfo();
+    return lhsMesh.vertexBuffer.buffer == rhsMesh.vertexBuffer.buffer &&
+           lhsMesh.indexBuffer.buffer == rhsMesh.indexBuffer.buffer &&
+           lhsMesh.indexBuffer.offset == rhsMesh.indexBuffer.offset &&
+           lhsDraw.firstVertex == rhsDraw.firstVertex &&
+           lhsDraw.indexCount == rhsDraw.indexCount &&
+           lhsDraw.vertexOffset == rhsDraw.vertexOffset;
+}
+
+} // namespace
+
+InstanceBuffer::InstanceBuffer(rhi::DevicePtr device) : _device(device) {
+}
+
+void InstanceBuffer::reset(uint32_t frameIndex) {
+    auto& frame = _frames[frameIndex];
+    if (frame.chunks.size() > 1) {
+        uint32_t capacity{0};
+        for (const auto& chunk : frame.chunks) {
+            capacity += chunk.capacity;
+        }
+        frame.chunks.clear();
+        auto& chunk = frame.chunks.emplace_back();
+        chunk.capacity = std::bit_ceil(capacity);
+        chunk.buffer = rhi::BufferPtr(_device->createBuffer(rhi::BufferSourceInfo{
+            .bufferUsage = rhi::BufferUsage::STORAGE,
+            .size = static_cast<uint32_t>(chunk.capacity * sizeof(Mat4)),
+        }));
+    }
+    frame.used = 0;
+    _current = &frame;
+}
+
+InstanceBuffer::Chunk& InstanceBuffer::reserve(uint32_t count) {
+    auto& frame = *_current;
+    if (!frame.chunks.empty() && frame.used + count <= frame.chunks.back().capacity) {
+        return frame.chunks.back();
+    }
+    // earlier draws of the frame still reference the full chunk, start a new one
+    uint32_t capacity = frame.chunks.empty() ? MIN_INSTANCE_CAPACITY : frame.chunks.back().capacity * 2;
+    auto& chunk = frame.chunks.emplace_back();
+    chunk.capacity = std::max(capacity, std::bit_ceil(count));
+    chunk.buffer = rhi::BufferPtr(_device->createBuffer(rhi::BufferSourceInfo{
+        .bufferUsage = rhi::BufferUsage::STORAGE,
+        .size = static_cast<uint32_t>(chunk.capacity * sizeof(Mat4)),
+    }));
+    frame.used = 0;
+    return chunk;
+}
+
+scene::BindGroup* InstanceBuffer::bindGroup(Chunk& chunk, const ShaderResource& shaderResource) {
+    const auto& layout = shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_DRAW)];
+    auto& bindGroup = chunk.bindGroups[layout.get()];
+    if (!bindGroup) {
+        const auto* binding = objectDataBinding(shaderResource);
+        raum_check(binding, "instanced shader without {} binding", OBJECT_DATA_SLOT);
+        bindGroup = std::make_shared<scene::BindGroup>(scene::SlotMap{{OBJECT_DATA_SLOT, binding->binding}}, layout, _device);
+        bindGroup->bindBuffer(OBJECT_DATA_SLOT, 0, chunk.buffer);
+        bindGroup->update();
+    }
+    return bindGroup.get();
+}
+
+void InstanceBuffer::merge(std::vector<DrawCall>& drawCalls, const ShaderGraph& shg) {
+    raum_check(_current, "merge before reset");
+    uint32_t count = static_cast<uint32_t>(drawCalls.size());
+    uint32_t write{0};
+    for (uint32_t first = 0; first < count;) {
+        auto drawCall = drawCalls[first];
+        uint32_t last = first + 1;
+        if (GPUCulling::drawable(drawCall)) {
+            while (last < count && sameInstance(drawCall, drawCalls[last])) {
+                ++last;
+            }
+        }
+        if (last - first > 1) {
+            auto instanceCount = last - first;
+            auto& chunk = reserve(instanceCount);
+            auto* transforms = static_cast<Mat4*>(chunk.buffer->mappedData()) + _current->used;
+            for (uint32_t i = 0; i < instanceCount; ++i) {
+                transforms[i] = drawCalls[first + i].meshRenderer->transform();
+            }
+            drawCall.firstInstance = _current->used;
+            drawCall.instanceCount = instanceCount;
+            drawCall.objectBindGroup = bindGroup(chunk, shg.layout(drawCall.technique->material()->shaderName()));
+            _current->used += instanceCount;
+        }
+        drawCalls[write++] = drawCall;
+        first = last;
+    }
+    drawCalls.resize(write);
+}
+
+} // namespace raum::graph
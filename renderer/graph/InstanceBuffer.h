@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <map>
+#include <vector>
+#include "GraphUtils.h"
+
+namespace raum::graph {
+
+// transforms of instanced draws, written through a persistently mapped buffer per frame in flight. A frame
+// that outgrows its buffer chains a bigger one, they are merged when the frame slot comes around again.
+class InstanceBuffer {
+public:
+    InstanceBuffer() = delete;
+    explicit InstanceBuffer(rhi::DevicePtr device);
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    // recycles what `frameIndex` wrote FRAMES_IN_FLIGHT frames ago.
+    void reset(uint32_t frameIndex);
+
+    // collapses runs of sorted draw calls sharing pipeline, material and mesh range into one instanced draw,
+    // after ObjectBuffer::bind.
+    void merge(std::vector<DrawCall>& drawCalls, const ShaderGraph& shg);
+
+private:
+    struct Chunk {
+        rhi::BufferPtr buffer;
+        uint32_t capacity{0};
+        // one per object data layout
+        std::map<const rhi::RHIDescriptorSetLayout*, scene::BindGroupPtr> bindGroups;
+    };
+    struct Frame {
+        std::vector<Chunk> chunks;
+        uint32_t used{0};
+    };
+
+    Chunk& reserve(uint32_t count);
+    scene::BindGroup* bindGroup(Chunk& chunk, const ShaderResource& shaderResource);
+
+    rhi::DevicePtr _device;
+    std::array<Frame, rhi::FRAMES_IN_FLIGHT> _frames;
+    Frame* _current{nullptr};
+};
+
+} // namespace raum::graph
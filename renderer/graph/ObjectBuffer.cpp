@@ -0,0 +1,92 @@
+#include "ObjectBuffer.h"
+#include <algorithm>
+#include "RHIBuffer.h"
+#include "RHIDevice.h"
+
+namespace raum::graph {
+
+ObjectBuffer::ObjectBuffer(rhi::DevicePtr device) : _device(device) {
+}
+
+void ObjectBuffer::build(std::span<const scene::RenderablePtr> renderables) {
+    _renderers.clear();
+    _renderers.reserve(renderables.size());
+    for (const auto& renderable : renderables) {
+        auto* meshRenderer = static_cast<scene::MeshRenderer*>(renderable.get());
+        meshRenderer->setObjectSlot(static_cast<uint32_t>(_renderers.size()));
+        _renderers.emplace_back(meshRenderer);
+    }
+
+    auto size = static_cast<uint32_t>(std::max<size_t>(_renderers.size(), 1) * sizeof(Mat4));
+    if (_frames[0].buffer && _frames[0].buffer->info().size >= size) {
+        // slots moved, rewrite everything
+        for (auto& frame : _frames) {
+            frame.versions.assign(_renderers.size(), UINT64_MAX);
+        }
+        return;
+    }
+    // frames in flight may still read the old buffers, kept until the current frame slot completes
+    if (_frames[0].buffer) {
+        auto retired = std::make_shared<std::array<Frame, rhi::FRAMES_IN_FLIGHT>>(std::move(_frames));
+        _device->getQueue({rhi::QueueType::GRAPHICS})->addCompleteHandler([retired]() mutable {
+            retired.reset();
+        });
+    }
+    for (auto& frame : _frames) {
+        frame.buffer = rhi::BufferPtr(_device->createBuffer(rhi::BufferSourceInfo{
+            .bufferUsage = rhi::BufferUsage::STORAGE,
+            .size = size,
+        }));
+        frame.versions.assign(_renderers.size(), UINT64_MAX);
+        frame.bindGroups.clear();
+    }
+}
+
+void ObjectBuffer::update(uint32_t frameIndex) {
+    auto& frame = _frames[frameIndex];
+    auto* transforms = static_cast<Mat4*>(frame.buffer->mappedData());
+    for (uint32_t i = 0; i < _renderers.size(); ++i) {
+        auto version = _renderers[i]->transformVersion();
+        if (frame.versions[i] != version) {
+            transforms[i] = _renderers[i]->transform();
+            frame.versions[i] = version;
+        }
+    }
+}
+
+rhi::BufferPtr ObjectBuffer::buffer(uint32_t frameIndex) const {
+    return _frames[frameIndex].buffer;
+}
+
+scene::BindGroup* ObjectBuffer::bindGroup(uint32_t frameIndex, const ShaderResource& shaderResource) {
+    auto& frame = _frames[frameIndex];
+    const auto& layout = shaderResource.descriptorLayouts[static_cast<uint32_t>(Rate::PER_DRAW)];
+    auto iter = frame.bindGroups.find(layout.get());
+    if (iter == frame.bindGroups.end()) {
+        scene::BindGroupPtr bindGroup;
+        if (const auto* binding = objectDataBinding(shaderResource)) {
+            bindGroup = std::make_shared<scene::BindGroup>(scene::SlotMap{{OBJECT_DATA_SLOT, binding->binding}}, layout, _device);
+            bindGroup->bindBuffer(OBJECT_DATA_SLOT, 0, frame.buffer);
+            bindGroup->update();
+        }
+        iter = frame.bindGroups.emplace(layout.get(), bindGroup).first;
+    }
+    return iter->second.get();
+}
+
+void ObjectBuffer::bind(std::vector<DrawCall>& drawCalls, uint32_t frameIndex, const ShaderGraph& shg) {
+    // sorted by pipeline and material, neighbours mostly share the technique
+    scene::Technique* technique{nullptr};
+    scene::BindGroup* objectBindGroup{nullptr};
+    for (auto& drawCall : drawCalls) {
+        if (drawCall.technique != technique) {
+            technique = drawCall.technique;
+            objectBindGroup = bindGroup(frameIndex, shg.layout(technique->material()->shaderName()));
+        }
+        drawCall.firstInstance = drawCall.meshRenderer->objectSlot();
+        drawCall.instanceCount = drawCall.meshRenderer->drawInfo().instanceCount;
+        drawCall.objectBindGroup = objectBindGroup;
+    }
+}
+
+} // namespace raum::graph
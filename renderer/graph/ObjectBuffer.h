@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <map>
+#include <span>
+#include <vector>
+#include "GraphUtils.h"
+
+namespace raum::graph {
+
+// transforms of every renderable at a stable slot, one persistently mapped storage buffer per frame in flight.
+// A frame only rewrites the slots whose transform changed since the frame slot was last used.
+class ObjectBuffer {
+public:
+    ObjectBuffer() = delete;
+    explicit ObjectBuffer(rhi::DevicePtr device);
+    ObjectBuffer(const ObjectBuffer&) = delete;
+    ObjectBuffer& operator=(const ObjectBuffer&) = delete;
+
+    // assigns slots in `renderables` order.
+    void build(std::span<const scene::RenderablePtr> renderables);
+
+    // writes the dirty transforms of `frameIndex`.
+    void update(uint32_t frameIndex);
+
+    // transforms of `frameIndex`, also read by gpu culling
+    rhi::BufferPtr buffer(uint32_t frameIndex) const;
+
+    // null if the shader has no object data binding
+    scene::BindGroup* bindGroup(uint32_t frameIndex, const ShaderResource& shaderResource);
+
+    // object slot as first instance and the matching bind group, run after sorting and before instancing merges draws.
+    void bind(std::vector<DrawCall>& drawCalls, uint32_t frameIndex, const ShaderGraph& shg);
+
+private:
+    struct Frame {
+        rhi::BufferPtr buffer;
+        std::vector<uint64_t> versions;
+        // one per object data layout
+        std::map<const rhi::RHIDescriptorSetLayout*, scene::BindGroupPtr> bindGroups;
+    };
+
+    rhi::DevicePtr _device;
+    std::vector<scene::MeshRenderer*> _renderers;
+    std::array<Frame, rhi::FRAMES_IN_FLIGHT> _frames;
+};
+
+} // namespace raum::graph
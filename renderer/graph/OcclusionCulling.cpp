@@ -0,0 +1,309 @@
+#include "OcclusionCulling.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "core/thread/execution.h"
+#include "core/utils/Trace.h"
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace raum::graph {
+
+namespace {
+
+// candidates tested by one task
+constexpr uint32_t TEST_CHUNK = 1024;
+// in pixels from the edge
+constexpr float EDGE_TOLERANCE = 1.0f / 256.0f;
+
+// pixel x, y and depth of a clip space position in front of the near plane
+Vec3f toScreen(const Vec4f& clip) {
+    auto invW = 1.0f / clip.w;
+    return {
+        (clip.x * invW * 0.5f + 0.5f) * OcclusionCulling::WIDTH,
+        (0.5f - clip.y * invW * 0.5f) * OcclusionCulling::HEIGHT,
+        clip.z * invW,
+    };
+}
+
+// projected bounds, false if some corner is behind the near plane.
+bool screenRect(const scene::AABB& aabb, const Mat4& transform, Vec3f& minBound, Vec3f& maxBound) {
+    minBound = Vec3f{std::numeric_limits<float>::max()};
+    maxBound = Vec3f{std::numeric_limits<float>::lowest()};
+    // corners step from the min corner along the scaled transform columns
+    auto size = aabb.maxBound - aabb.minBound;
+    auto origin = transform * Vec4f{aabb.minBound, 1.0f};
+    std::array<Vec4f, 3> axes{transform[0] * size.x, transform[1] * size.y, transform[2] * size.z};
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        auto clip = origin;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            if (corner & (1 << axis)) {
+                clip += axes[axis];
+            }
+        }
+        // depth range is [0, 1] in clip space too
+        if (clip.z < 0.0f || clip.w <= 0.0f) {
+            return false;
+        }
+        auto screen = toScreen(clip);
+        minBound = glm::min(minBound, screen);
+        maxBound = glm::max(maxBound, screen);
+    }
+    return true;
+}
+
+// keeps the part in front of the near plane, a quad at most.
+uint32_t clipNear(const std::array<Vec4f, 3>& triangle, std::array<Vec4f, 4>& polygon) {
+    uint32_t count{0};
+    for (uint32_t i = 0; i < 3; ++i) {
+        const auto& a = triangle[i];
+        const auto& b = triangle[(i + 1) % 3];
+        if (a.z >= 0.0f) {
+            polygon[count++] = a;
+        }
+        if ((a.z >= 0.0f) != (b.z >= 0.0f)) {
+            polygon[count++] = glm::mix(a, b, a.z / (a.z - b.z));
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+void OcclusionCulling::setOccluders(std::vector<scene::MeshRendererPtr> occluders) {
+    _occluders = std::move(occluders);
+    _levels.clear();
+    for (uint32_t width = WIDTH, height = HEIGHT;; width = std::max(width / 2, 1u), height = std::max(height / 2, 1u)) {
+        _levels.emplace_back(Level{width, height, std::vector<float>(width * height)});
+        if (width == 1 && height == 1) {
+            break;
+        }
+    }
+}
+
+void OcclusionCulling::selectOccluders(const Mat4& viewProj) {
+    _selected.clear();
+    constexpr float screenArea = WIDTH * HEIGHT;
+    for (const auto& occluder : _occluders) {
+        Vec3f minBound, maxBound;
+        float area{1.0f};
+        // the camera is close to or inside occluders crossing the near plane, they hide the most
+        if (screenRect(occluder->mesh()->occluder()->aabb, viewProj * occluder->transform(), minBound, maxBound)) {
+            auto lo = glm::max(Vec2f(minBound), Vec2f{0.0f});
+            auto hi = glm::min(Vec2f(maxBound), Vec2f{WIDTH, HEIGHT});
+            area = hi.x > lo.x && hi.y > lo.y ? (hi.x - lo.x) * (hi.y - lo.y) / screenArea : 0.0f;
+        }
+        if (area >= MIN_OCCLUDER_AREA) {
+            _selected.emplace_back(area, occluder.get());
+        }
+    }
+    auto count = std::min<size_t>(_selected.size(), MAX_OCCLUDERS);
+    std::partial_sort(_selected.begin(), _selected.begin() + count, _selected.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+    _selected.resize(count);
+}
+
+void OcclusionCulling::setupTriangles(const Mat4& viewProj) {
+    _triangles.clear();
+    for (const auto& [area, meshRenderer] : _selected) {
+        const auto& occluder = *meshRenderer->mesh()->occluder();
+        auto transform = viewProj * meshRenderer->transform();
+        _clipPositions.resize(occluder.positions.size());
+        for (size_t i = 0; i < occluder.positions.size(); ++i) {
+            _clipPositions[i] = transform * Vec4f{occluder.positions[i], 1.0f};
+        }
+        for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3) {
+            std::array<Vec4f, 3> triangle{
+                _clipPositions[occluder.indices[i]],
+                _clipPositions[occluder.indices[i + 1]],
+                _clipPositions[occluder.indices[i + 2]],
+            };
+            std::array<Vec4f, 4> polygon;
+            auto count = clipNear(triangle, polygon);
+            for (uint32_t j = 2; j < count; ++j) {
+                Triangle screen{{toScreen(polygon[0]), toScreen(polygon[j - 1]), toScreen(polygon[j])}};
+                auto minY = std::min({screen.vertices[0].y, screen.vertices[1].y, screen.vertices[2].y});
+                auto maxY = std::max({screen.vertices[0].y, screen.vertices[1].y, screen.vertices[2].y});
+                screen.minY = static_cast<int32_t>(std::max(std::floor(minY), 0.0f));
+                screen.maxY = static_cast<int32_t>(std::min(std::ceil(maxY), HEIGHT - 1.0f));
+                if (screen.minY <= screen.maxY) {
+                    _triangles.emplace_back(screen);
+                }
+            }
+        }
+    }
+}
+
+void OcclusionCulling::rasterize(uint32_t band) {
+    RAUM_TRACE_SCOPE("OcclusionCulling::rasterize");
+    auto* depth = _levels[0].depth.data();
+    auto bandMin = static_cast<int32_t>(band * BAND_HEIGHT);
+    auto bandMax = static_cast<int32_t>(std::min((band + 1) * BAND_HEIGHT, HEIGHT)) - 1;
+    std::fill(depth + bandMin * WIDTH, depth + (bandMax + 1) * WIDTH, 1.0f);
+
+    for (const auto& triangle : _triangles) {
+        auto minY = std::max(triangle.minY, bandMin);
+        auto maxY = std::min(triangle.maxY, bandMax);
+        if (minY > maxY) {
+            continue;
+        }
+        const auto& a = triangle.vertices[0];
+        auto b = triangle.vertices[1];
+        auto c = triangle.vertices[2];
+        auto area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::abs(area) < 1e-6f) {
+            continue;
+        }
+        // both windings are drawn, occluders need not be closed
+        if (area < 0.0f) {
+            std::swap(b, c);
+            area = -area;
+        }
+        auto minX = static_cast<int32_t>(std::max(std::floor(std::min({a.x, b.x, c.x})), 0.0f));
+        auto maxX = static_cast<int32_t>(std::min(std::ceil(std::max({a.x, b.x, c.x})), WIDTH - 1.0f));
+        if (minX > maxX) {
+            continue;
+        }
+        // whole 4 pixel groups, the row width is a multiple of 4
+        minX &= ~3;
+
+        // edge functions are the barycentric weights of the opposite vertex times area
+        auto edge = [](const Vec3f& from, const Vec3f& to, float x, float y) {
+            return (to.x - from.x) * (y - from.y) - (to.y - from.y) * (x - from.x);
+        };
+        Vec3f stepX{b.y - c.y, c.y - a.y, a.y - b.y};
+        auto invArea = 1.0f / area;
+        auto depthStepX = (a.z * stepX.x + b.z * stepX.y + c.z * stepX.z) * invArea;
+        // both triangles sharing an edge round it differently, the tolerance closes the cracks between them
+        Vec3f bias{
+            glm::length(Vec2f(c) - Vec2f(b)),
+            glm::length(Vec2f(a) - Vec2f(c)),
+            glm::length(Vec2f(b) - Vec2f(a)),
+        };
+        bias *= EDGE_TOLERANCE;
+
+        for (auto y = minY; y <= maxY; ++y) {
+            auto px = static_cast<float>(minX) + 0.5f;
+            auto py = static_cast<float>(y) + 0.5f;
+            Vec3f weights{edge(b, c, px, py), edge(c, a, px, py), edge(a, b, px, py)};
+            auto z = (a.z * weights.x + b.z * weights.y + c.z * weights.z) * invArea;
+            weights += bias;
+            auto* row = depth + y * WIDTH;
+            auto x = minX;
+#if defined(__SSE2__) || defined(_M_X64)
+            const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 zero = _mm_setzero_ps();
+            // minX is 4 aligned and rows are a multiple of 4 wide, the last group stays inside the row
+            for (; x <= maxX; x += 4) {
+                __m128 offset = _mm_add_ps(_mm_set1_ps(static_cast<float>(x - minX)), lanes);
+                __m128 w0 = _mm_add_ps(_mm_set1_ps(weights.x), _mm_mul_ps(offset, _mm_set1_ps(stepX.x)));
+                __m128 w1 = _mm_add_ps(_mm_set1_ps(weights.y), _mm_mul_ps(offset, _mm_set1_ps(stepX.y)));
+                __m128 w2 = _mm_add_ps(_mm_set1_ps(weights.z), _mm_mul_ps(offset, _mm_set1_ps(stepX.z)));
+                __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+                if (_mm_movemask_ps(inside)) {
+                    __m128 zs = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(offset, _mm_set1_ps(depthStepX)));
+                    __m128 old = _mm_loadu_ps(row + x);
+                    __m128 nearest = _mm_min_ps(old, zs);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+                }
+            }
+#endif
+            for (; x <= maxX; ++x) {
+                auto offset = static_cast<float>(x - minX);
+                if (weights.x + stepX.x * offset >= 0.0f && weights.y + stepX.y * offset >= 0.0f &&
+                    weights.z + stepX.z * offset >= 0.0f) {
+                    row[x] = std::min(row[x], z + depthStepX * offset);
+                }
+            }
+        }
+    }
+}
+
+void OcclusionCulling::buildPyramid() {
+    for (size_t i = 1; i < _levels.size(); ++i) {
+        const auto& src = _levels[i - 1];
+        auto& dst = _levels[i];
+        for (uint32_t y = 0; y < dst.height; ++y) {
+            const auto* row0 = src.depth.data() + std::min(y * 2, src.height - 1) * src.width;
+            const auto* row1 = src.depth.data() + std::min(y * 2 + 1, src.height - 1) * src.width;
+            for (uint32_t x = 0; x < dst.width; ++x) {
+                auto x0 = std::min(x * 2, src.width - 1);
+                auto x1 = std::min(x * 2 + 1, src.width - 1);
+                dst.depth[y * dst.width + x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCulling::occluded(const scene::AABB& aabb, const Mat4& viewProj) const {
+    Vec3f minBound, maxBound;
+    if (!screenRect(aabb, viewProj, minBound, maxBound)) {
+        return false;
+    }
+    auto x0 = static_cast<int32_t>(std::max(std::floor(minBound.x), 0.0f));
+    auto y0 = static_cast<int32_t>(std::max(std::floor(minBound.y), 0.0f));
+    auto x1 = static_cast<int32_t>(std::min(std::floor(maxBound.x), WIDTH - 1.0f));
+    auto y1 = static_cast<int32_t>(std::min(std::floor(maxBound.y), HEIGHT - 1.0f));
+    // off screen is left to the frustum test
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+    // the finest level where the rectangle spans at most four texels
+    uint32_t level{0};
+    auto extent = static_cast<uint32_t>(std::max(x1 - x0, y1 - y0));
+    while ((extent >> level) > 2 && level + 1 < _levels.size()) {
+        ++level;
+    }
+    const auto& pyramid = _levels[level];
+    auto maxX = std::min(static_cast<uint32_t>(x1) >> level, pyramid.width - 1);
+    auto maxY = std::min(static_cast<uint32_t>(y1) >> level, pyramid.height - 1);
+    for (auto y = static_cast<uint32_t>(y0) >> level; y <= maxY; ++y) {
+        for (auto x = static_cast<uint32_t>(x0) >> level; x <= maxX; ++x) {
+            if (minBound.z <= pyramid.depth[y * pyramid.width + x]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void OcclusionCulling::cull(const scene::Camera& camera,
+                            CameraMask bit,
+                            std::span<const scene::AABB> bounds,
+                            std::span<CameraMask> masks) {
+    RAUM_TRACE_SCOPE("OcclusionCulling::cull");
+    raum_check(bounds.size() == masks.size(), "one bounds per visibility mask");
+    if (_occluders.empty()) {
+        return;
+    }
+    auto viewProj = camera.eye().projection() * camera.eye().attitude();
+    selectOccluders(viewProj);
+    setupTriangles(viewProj);
+    if (_triangles.empty()) {
+        return;
+    }
+
+    auto sched = getRenderThreadPool().get_scheduler();
+    constexpr uint32_t bands = (HEIGHT + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    auto raster = stdexec::schedule(sched) | stdexec::bulk(bands, [this](uint32_t band) {
+                      rasterize(band);
+                  });
+    stdexec::sync_wait(std::move(raster));
+    buildPyramid();
+
+    auto count = static_cast<uint32_t>(masks.size());
+    auto chunks = (count + TEST_CHUNK - 1) / TEST_CHUNK;
+    auto test = stdexec::schedule(sched) | stdexec::bulk(chunks, [&](uint32_t chunk) {
+                    auto end = std::min((chunk + 1) * TEST_CHUNK, count);
+                    for (auto i = chunk * TEST_CHUNK; i < end; ++i) {
+                        if ((masks[i] & bit) && occluded(bounds[i], viewProj)) {
+                            masks[i] &= ~bit;
+                        }
+                    }
+                });
+    stdexec::sync_wait(std::move(test));
+}
+
+} // namespace raum::graph
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <span>
+#include <vector>
+#include "BVH.h"
+
+namespace raum::graph {
+
+// software occlusion culling after the frustum test. The occluders covering most of the screen are rasterized
+// into a small depth buffer on the render thread pool, the screen rectangles of the candidates are then
+// tested against a depth pyramid whose texels keep the farthest depth they cover.
+class OcclusionCulling {
+public:
+    static constexpr uint32_t WIDTH{256};
+    static constexpr uint32_t HEIGHT{128};
+    // rows rasterized by one task
+    static constexpr uint32_t BAND_HEIGHT{16};
+    // per camera, the largest on screen first
+    static constexpr uint32_t MAX_OCCLUDERS{32};
+    // screen fraction covered by the bounds of an occluder, smaller ones hide too little to pay off
+    static constexpr float MIN_OCCLUDER_AREA{0.005f};
+
+    void setOccluders(std::vector<scene::MeshRendererPtr> occluders);
+    bool empty() const { return _occluders.empty(); }
+
+    // clears `bit` in the `masks` of the renderables hidden from `camera`, `bounds` holds their world bounds.
+    void cull(const scene::Camera& camera, CameraMask bit, std::span<const scene::AABB> bounds, std::span<CameraMask> masks);
+
+private:
+    struct Triangle {
+        // screen x, y and depth
+        std::array<Vec3f, 3> vertices;
+        int32_t minY{0};
+        int32_t maxY{0};
+    };
+    struct Level {
+        uint32_t width{0};
+        uint32_t height{0};
+        std::vector<float> depth;
+    };
+
+    void selectOccluders(const Mat4& viewProj);
+    void setupTriangles(const Mat4& viewProj);
+    void rasterize(uint32_t band);
+    void buildPyramid();
+    bool occluded(const scene::AABB& aabb, const Mat4& viewProj) const;
+
+    std::vector<scene::MeshRendererPtr> _occluders;
+    // projected area, occluder
+    std::vector<std::pair<float, const scene::MeshRenderer*>> _selected;
+    std::vector<Vec4f> _clipPositions;
+    std::vector<Triangle> _triangles;
+    // level 0 is the depth buffer
+    std::vector<Level> _levels;
+};
+
+} // namespace raum::graph
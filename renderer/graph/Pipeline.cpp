@@ -14,8 +14,8 @@ Pipeline::Pipeline(rhi::DevicePtr device, rhi::SwapchainPtr swapchain, graph::Sc
     _scheduler = new GraphScheduler(device, swapchain, _renderGraph, _resourceGraph, _accessGraph, _taskGraph, _sceneGraph.get(), _shaderGraph.get());
 }
 
-void Pipeline::run(rhi::CommandBufferPtr cmd) {
-    _scheduler->execute(cmd);
+rhi::CommandBufferPtr Pipeline::run(rhi::CommandBufferPtr cmd) {
+    return _scheduler->execute(cmd);
 }
 
 Pipeline::~Pipeline() {
@@ -18,7 +18,8 @@ public:
     Pipeline(const Pipeline&) = delete;
     ~Pipeline();
 
-    void run(rhi::CommandBufferPtr cmd);
+    // see GraphScheduler::execute
+    rhi::CommandBufferPtr run(rhi::CommandBufferPtr cmd);
 
     //    bool contains();
 
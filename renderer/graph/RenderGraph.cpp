@@ -3,6 +3,7 @@
 #include "RHIBufferView.h"
 #include "RHIImage.h"
 #include "RHIImageView.h"
+#include "RHIQueue.h"
 
 using boost::add_edge;
 using boost::add_vertex;
@@ -13,74 +14,118 @@ using boost::vertices;
 
 namespace raum::graph {
 
+namespace {
+
+std::string_view persist(std::initializer_list<std::string_view> parts, memory_resource* arena) {
+    size_t size{0};
+    for (auto part : parts) {
+        size += part.size();
+    }
+    if (!size) {
+        return {};
+    }
+    auto* p = static_cast<char*>(arena->allocate(size, 1));
+    auto* dst = p;
+    for (auto part : parts) {
+        memcpy(dst, part.data(), part.size());
+        dst += part.size();
+    }
+    return {p, size};
+}
+
+std::string_view persist(std::string_view str, memory_resource* arena) {
+    return persist({str}, arena);
+}
+
+} // namespace
+
 RenderGraph::RenderGraph(rhi::DevicePtr device) : _device(device) {
+    _names.emplace(arena());
+}
+
+RenderGraph::VertexType RenderGraph::addPass(std::string_view name, StringID passID) {
+    if (_names->contains(name)) {
+        return RenderGraph::null_vertex();
+    }
+    // once vertex storage stops growing(after warm-up) pass data is never copied off the arena.
+    auto id = add_vertex(Pass{name, passID}, _graph);
+    _names->emplace(name, id);
+    return id;
+}
+
+RenderGraph::VertexType RenderGraph::find(std::string_view name) const {
+    auto iter = _names->find(name);
+    return iter == _names->end() ? RenderGraph::null_vertex() : iter->second;
 }
 
 RenderPass RenderGraph::addRenderPass(std::string_view name) {
-    const auto& p = _names.emplace(name);
-    auto id = RenderGraph::null_vertex();
-    if (p.second) {
-        id = add_vertex(*p.first, _graph);
-        _graph[id].data = RenderPassData{};
+    auto id = addPass(persist(name, arena()), StringID{name});
+    if (id != RenderGraph::null_vertex()) {
+        _graph[id].data.emplace<RenderPassData>(RenderPassData{.attachments = PmrVector<AttachmentResource>(arena())});
     }
-    return RenderPass{id, _graph, _names};
+    return RenderPass{id, this};
 }
 
 ComputePass RenderGraph::addComputePass(std::string_view name) {
-    const auto& p = _names.emplace(name);
-    auto id = RenderGraph::null_vertex();
-    if (p.second) {
-        id = add_vertex(*p.first, _graph);
-        _graph[id].data = ComputePassData{};
+    auto id = addPass(persist(name, arena()), StringID{name});
+    if (id != RenderGraph::null_vertex()) {
+        _graph[id].data.emplace<ComputePassData>(ComputePassData{.resources = PmrVector<RenderingResource>(arena())});
     }
-    return ComputePass{std::get<ComputePassData>(_graph[id].data)};
+    return ComputePass{std::get<ComputePassData>(_graph[id].data), arena()};
 }
 
 CopyPass RenderGraph::addCopyPass(std::string_view name) {
-    const auto& p = _names.emplace(name);
-    auto id = RenderGraph::null_vertex();
-    if (p.second) {
-        id = add_vertex(*p.first, _graph);
-        _graph[id].data = CopyPassData{};
+    auto id = addPass(persist(name, arena()), StringID{name});
+    if (id != RenderGraph::null_vertex()) {
+        _graph[id].data.emplace<CopyPassData>(CopyPassData{
+            .copies = PmrVector<CopyPair>(arena()),
+            .uploads = PmrVector<UploadPair>(arena()),
+            .fills = PmrVector<FillValue>(arena()),
+        });
     }
-    return CopyPass{std::get<CopyPassData>(_graph[id].data), _device};
+    return CopyPass{std::get<CopyPassData>(_graph[id].data), _device, arena()};
 }
 
 void RenderGraph::clear() {
+    // pass data holds arena memory, release it before the arena is recycled
     _graph.clear();
-    _names.clear();
+    _names.reset();
+    _arenaIndex = (_arenaIndex + 1) % rhi::FRAMES_IN_FLIGHT;
+    _arenas[_arenaIndex].reset();
+    _names.emplace(arena());
 }
 
-RenderPass& RenderPass::addColor(std::string_view name, LoadOp loadOp, StoreOp storeOp, const ClearValue& color) {
-    auto& data = std::get<RenderPassData>(_graph[_id].data);
-    data.attachments.emplace_back(std::string{name}, "", color, Access::WRITE, ResourceType::COLOR, loadOp, storeOp);
+RenderPass& RenderPass::addColor(StringID name, LoadOp loadOp, StoreOp storeOp, const ClearValue& color) {
+    auto& data = std::get<RenderPassData>(_graph->impl()[_id].data);
+    data.attachments.emplace_back(name, "", color, Access::WRITE, ResourceType::COLOR, loadOp, storeOp);
     return *this;
 }
 
-RenderPass& RenderPass::addDepthStencil(std::string_view name, LoadOp loadOp, StoreOp storeOp, LoadOp stencilLoad, StoreOp stencilStore, float clearDepth, uint32_t clearStencil) {
-    auto& data = std::get<RenderPassData>(_graph[_id].data);
+RenderPass& RenderPass::addDepthStencil(StringID name, LoadOp loadOp, StoreOp storeOp, LoadOp stencilLoad, StoreOp stencilStore, float clearDepth, uint32_t clearStencil) {
+    auto& data = std::get<RenderPassData>(_graph->impl()[_id].data);
     ClearValue ds{.depthStencil = {clearDepth, clearStencil}};
-    data.attachments.emplace_back(std::string{name}, "", ds, Access::WRITE, ResourceType::DEPTH_STENCIL, loadOp, storeOp, stencilLoad, stencilStore);
+    data.attachments.emplace_back(name, "", ds, Access::WRITE, ResourceType::DEPTH_STENCIL, loadOp, storeOp, stencilLoad, stencilStore);
     return *this;
 }
 
-RenderPass& RenderPass::addShadingRate(std::string_view name) {
-    auto& data = std::get<RenderPassData>(_graph[_id].data);
-    data.attachments.emplace_back(std::string{name}, "", ClearValue{}, Access::WRITE, ResourceType::SHADING_RATE);
+RenderPass& RenderPass::addShadingRate(StringID name) {
+    auto& data = std::get<RenderPassData>(_graph->impl()[_id].data);
+    data.attachments.emplace_back(name, "", ClearValue{}, Access::WRITE, ResourceType::SHADING_RATE);
     return *this;
 }
 
 RenderQueue RenderPass::addQueue(std::string_view name) {
-    auto outs = out_degree(_id, _graph);
-    const auto& passName = _graph[_id].name;
-    const auto& p = _names.emplace(std::string{passName} + "/" + std::string{name});
-    auto id = RenderGraph::null_vertex();
-    if (p.second) {
-        id = add_vertex(*p.first, _graph);
-        _graph[id].data = RenderQueueData{};
-        add_edge(_id, id, _graph);
+    auto& g = _graph->impl();
+    auto* arena = _graph->arena();
+    auto phase = StringID{name};
+    // joins are memoized, the queue name lives in the string table
+    auto queueID = getStringTable().join(g[_id].id, phase);
+    auto id = _graph->addPass(queueID.str(), queueID);
+    if (id != RenderGraph::null_vertex()) {
+        g[id].data.emplace<RenderQueueData>(RenderQueueData{.resources = PmrVector<RenderingResource>(arena), .phase = phase});
+        add_edge(_id, id, g);
     }
-    return RenderQueue{id, _graph};
+    return RenderQueue{id, g, arena};
 }
 
 RenderQueue& RenderQueue::addCamera(scene::Camera* camera) {
@@ -89,49 +134,47 @@ RenderQueue& RenderQueue::addCamera(scene::Camera* camera) {
     return *this;
 }
 
-RenderQueue& RenderQueue::addUniformBuffer(std::string_view name, std::string_view bindingName) {
+RenderQueue& RenderQueue::addUniformBuffer(StringID name, std::string_view bindingName) {
     auto& data = std::get<RenderQueueData>(_graph[_id].data);
     auto& resource = data.resources.emplace_back();
     resource.name = name;
-    resource.bindingName = bindingName;
+    resource.bindingName = persist(bindingName, _arena);
     resource.access = Access::READ;
     return *this;
 }
 
-RenderQueue& RenderQueue::addSampledImage(std::string_view name, std::string_view bindingName) {
+RenderQueue& RenderQueue::addSampledImage(StringID name, std::string_view bindingName) {
     auto& data = std::get<RenderQueueData>(_graph[_id].data);
     auto& resource = data.resources.emplace_back();
     resource.name = name;
-    resource.bindingName = bindingName;
+    resource.bindingName = persist(bindingName, _arena);
     resource.access = Access::READ;
     return *this;
 }
 
-RenderQueue& RenderQueue::addSampledDepth(std::string_view name, std::string_view bindingName) {
+RenderQueue& RenderQueue::addSampledDepth(StringID name, std::string_view bindingName) {
     auto& data = std::get<RenderQueueData>(_graph[_id].data);
     auto& resource = data.resources.emplace_back();
-    resource.name.append(name);
-    resource.name.append("/Depth");
-    resource.bindingName = bindingName;
+    resource.name = depthViewName(name);
+    resource.bindingName = persist(bindingName, _arena);
     resource.access = Access::READ;
     return *this;
 }
 
-RenderQueue& RenderQueue::addSampledStencil(std::string_view name, std::string_view bindingName) {
+RenderQueue& RenderQueue::addSampledStencil(StringID name, std::string_view bindingName) {
     auto& data = std::get<RenderQueueData>(_graph[_id].data);
     auto& resource = data.resources.emplace_back();
-    resource.name.append(name);
-    resource.name.append("/Stencil");
-    resource.bindingName = bindingName;
+    resource.name = stencilViewName(name);
+    resource.bindingName = persist(bindingName, _arena);
     resource.access = Access::READ;
     return *this;
 }
 
-RenderQueue& RenderQueue::addSampler(std::string_view name, std::string_view bindingName) {
+RenderQueue& RenderQueue::addSampler(StringID name, std::string_view bindingName) {
     auto& data = std::get<RenderQueueData>(_graph[_id].data);
     auto& resource = data.resources.emplace_back();
     resource.name = name;
-    resource.bindingName = bindingName;
+    resource.bindingName = persist(bindingName, _arena);
     resource.access = Access::READ;
     return *this;
 }
@@ -155,25 +198,23 @@ RenderQueue& RenderQueue::setViewport(int32_t x, int32_t y, uint32_t w, uint32_t
     return *this;
 }
 
-ComputePass& ComputePass::addResource(std::string_view name, std::string_view bindingname, Access access) {
-    _data.resources.emplace_back(std::string{name}, std::string{bindingname}, access);
+ComputePass& ComputePass::addResource(StringID name, std::string_view bindingname, Access access) {
+    _data.resources.emplace_back(name, persist(bindingname, _arena), access);
     return *this;
 }
 
-ComputePass& ComputePass::addSampledDepth(std::string_view name, std::string_view bindingName) {
-    std::string depthName = std::string{name} + "/Depth";
-    _data.resources.emplace_back(depthName, std::string{bindingName}, Access::READ);
+ComputePass& ComputePass::addSampledDepth(StringID name, std::string_view bindingName) {
+    _data.resources.emplace_back(depthViewName(name), persist(bindingName, _arena), Access::READ);
     return *this;
 }
 
-ComputePass& ComputePass::addSampledStencil(std::string_view name, std::string_view bindingName) {
-    std::string stencilName = std::string{name} + "/Stencil";
-    _data.resources.emplace_back(stencilName, std::string{bindingName}, Access::READ);
+ComputePass& ComputePass::addSampledStencil(StringID name, std::string_view bindingName) {
+    _data.resources.emplace_back(stencilViewName(name), persist(bindingName, _arena), Access::READ);
     return *this;
 }
 
 ComputePass &ComputePass::setProgramName(std::string_view name) {
-    _data.programName = name;
+    _data.programName = persist(name, _arena);
     return *this;
 }
 
@@ -182,22 +223,29 @@ ComputePass& ComputePass::setDispatch(uint32_t x, uint32_t y, uint32_t z) {
     return *this;
 }
 
+ComputePass& ComputePass::setQueueHint(QueueHint hint) {
+    _data.queueHint = hint;
+    return *this;
+}
+
 CopyPass& CopyPass::addPair(const CopyPair& pair) {
     _data.copies.emplace_back(pair);
     return *this;
 }
 
-CopyPass& CopyPass::uploadBuffer(const void* const data, uint32_t size, std::string_view name, uint32_t dstOffset) {
-    auto stagingBuffer = _device->allocateStagingBuffer(size, 0);
+CopyPass& CopyPass::uploadBuffer(const void* const data, uint32_t size, StringID name, uint32_t dstOffset) {
+    // copy passes are recorded on the graphics queue, its submits recycle the staging memory
+    auto queueIndex = _device->getQueue({rhi::QueueType::GRAPHICS})->index();
+    auto stagingBuffer = _device->allocateStagingBuffer(size, static_cast<uint8_t>(queueIndex));
     auto* dst = static_cast<uint8_t*>(stagingBuffer.buffer->mappedData()) + stagingBuffer.offset;
     memcpy(dst, data, size);
 
-    _data.uploads.emplace_back(stagingBuffer, size, dstOffset, std::string{name});
+    _data.uploads.emplace_back(stagingBuffer, size, dstOffset, name);
     return *this;
 }
 
-CopyPass& CopyPass::fill(uint32_t value, uint32_t size, std::string_view name, uint32_t dstOffset) {
-    _data.fills.emplace_back(value, size, dstOffset, std::string{name});
+CopyPass& CopyPass::fill(uint32_t value, uint32_t size, StringID name, uint32_t dstOffset) {
+    _data.fills.emplace_back(value, size, dstOffset, name);
     return *this;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
+#include <boost/container/small_vector.hpp>
 #include <boost/graph/adjacency_list.hpp>
+#include <optional>
 #include <variant>
 #include "Camera.h"
 #include "GraphTypes.h"
@@ -9,105 +11,144 @@
 namespace raum::graph {
 struct Pass {
     std::string_view name;
+    // interned name, queues are "pass/phase"
+    StringID id;
     std::variant<RenderPassData, SubRenderPassData, ComputePassData, CopyPassData, RenderQueueData> data;
 };
 } // namespace raum::graph
 
+namespace raum::graph {
+// out-edge list kept inline, a cleared graph is refilled without touching the heap.
+struct small_vecS {};
+} // namespace raum::graph
+
 namespace boost {
-namespace graph {
 
-template <>
-struct internal_vertex_name<raum::graph::Pass> {
-    typedef multi_index::member<raum::graph::Pass, std::string_view, &raum::graph::Pass::name> type;
+template <class ValueType>
+struct container_gen<raum::graph::small_vecS, ValueType> {
+    using type = boost::container::small_vector<ValueType, 8>;
 };
 
 template <>
-struct internal_vertex_constructor<raum::graph::Pass> {
-    typedef vertex_from_name<raum::graph::Pass> type;
+struct parallel_edge_traits<raum::graph::small_vecS> {
+    using type = allow_parallel_edge_tag;
 };
 
-} // namespace graph
+namespace container {
+
+// found by ADL from boost::graph_detail
+template <class T, std::size_t N>
+graph_detail::vector_tag container_category(const small_vector<T, N>&) { return {}; }
+
+template <class T, std::size_t N>
+graph_detail::unstable_tag iterator_stability(const small_vector<T, N>&) { return {}; }
+
+} // namespace container
 } // namespace boost
 
 namespace raum::graph {
 
-using RenderGraphImpl = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, Pass, boost::no_property>;
+// bidirectional with a vecS edge list: directedS allocates every edge property on the heap.
+using RenderGraphImpl = boost::adjacency_list<small_vecS, boost::vecS, boost::bidirectionalS, Pass, boost::no_property, boost::no_property, boost::vecS>;
+
+class RenderGraph;
 
 class RenderQueue {
 public:
     RenderQueue() = delete;
-    RenderQueue(RenderGraphImpl ::vertex_descriptor renderPassID, RenderGraphImpl& graph) : _id(renderPassID), _graph(graph){};
+    RenderQueue(RenderGraphImpl ::vertex_descriptor renderPassID, RenderGraphImpl& graph, memory_resource* arena) : _id(renderPassID), _graph(graph), _arena(arena){};
 
     RenderQueue& addCamera(scene::Camera* camera);
     //RenderQueue& addScene(scene::DIrector* scene);
     RenderQueue& setViewport(int32_t x, int32_t y, uint32_t w, uint32_t h, float minDepth, float maxDepth);
-    RenderQueue& addUniformBuffer(std::string_view name, std::string_view bindingName);
-    RenderQueue& addSampledImage(std::string_view name, std::string_view bindingName);
-    RenderQueue& addSampledDepth(std::string_view name, std::string_view bindingName);
-    RenderQueue& addSampledStencil(std::string_view name, std::string_view bindingName);
-    RenderQueue& addSampler(std::string_view name, std::string_view bindingName);
+    RenderQueue& addUniformBuffer(StringID name, std::string_view bindingName);
+    RenderQueue& addSampledImage(StringID name, std::string_view bindingName);
+    RenderQueue& addSampledDepth(StringID name, std::string_view bindingName);
+    RenderQueue& addSampledStencil(StringID name, std::string_view bindingName);
+    RenderQueue& addSampler(StringID name, std::string_view bindingName);
+    // by declared resource name
+    RenderQueue& addUniformBuffer(std::string_view name, std::string_view bindingName) { return addUniformBuffer(resourceName(name), bindingName); }
+    RenderQueue& addSampledImage(std::string_view name, std::string_view bindingName) { return addSampledImage(resourceName(name), bindingName); }
+    RenderQueue& addSampledDepth(std::string_view name, std::string_view bindingName) { return addSampledDepth(resourceName(name), bindingName); }
+    RenderQueue& addSampledStencil(std::string_view name, std::string_view bindingName) { return addSampledStencil(resourceName(name), bindingName); }
+    RenderQueue& addSampler(std::string_view name, std::string_view bindingName) { return addSampler(resourceName(name), bindingName); }
     RenderQueue& addFlag(RenderQueueFlags flag);
     RenderQueue& setQuadTech(const scene::TechniquePtr& tech);
 
 private:
     RenderGraphImpl::vertex_descriptor _id{0};
     RenderGraphImpl& _graph;
+    memory_resource* _arena{nullptr};
 };
 
 class RenderPass {
 public:
-    RenderPass(RenderGraphImpl::vertex_descriptor id, RenderGraphImpl& graph, TransparentUnorderedSet& names) : _id(id), _graph(graph), _names(names) {}
-    RenderPass(const RenderPass& rhs) : _id(rhs._id), _graph(rhs._graph), _names(rhs._names) {}
+    RenderPass(RenderGraphImpl::vertex_descriptor id, RenderGraph* graph) : _id(id), _graph(graph) {}
+    RenderPass(const RenderPass& rhs) : _id(rhs._id), _graph(rhs._graph) {}
     RenderPass& operator=(const RenderPass& rhs) {
         _id = rhs._id;
         _graph = rhs._graph;
-        _names = rhs._names;
         return *this;
     }
     RenderPass(RenderPass&& rhs) = delete;
     ~RenderPass() = default;
 
-    RenderPass& addColor(std::string_view name, LoadOp loadOp, StoreOp storeOp, const ClearValue& color);
-    RenderPass& addDepthStencil(std::string_view name, LoadOp loadOp, StoreOp storeOp, LoadOp stencilLoad, StoreOp stencilStore, float clearDepth, uint32_t clearStencil);
-    RenderPass& addShadingRate(std::string_view name);
+    RenderPass& addColor(StringID name, LoadOp loadOp, StoreOp storeOp, const ClearValue& color);
+    RenderPass& addDepthStencil(StringID name, LoadOp loadOp, StoreOp storeOp, LoadOp stencilLoad, StoreOp stencilStore, float clearDepth, uint32_t clearStencil);
+    RenderPass& addShadingRate(StringID name);
+    // by declared resource name
+    RenderPass& addColor(std::string_view name, LoadOp loadOp, StoreOp storeOp, const ClearValue& color) {
+        return addColor(resourceName(name), loadOp, storeOp, color);
+    }
+    RenderPass& addDepthStencil(std::string_view name, LoadOp loadOp, StoreOp storeOp, LoadOp stencilLoad, StoreOp stencilStore, float clearDepth, uint32_t clearStencil) {
+        return addDepthStencil(resourceName(name), loadOp, storeOp, stencilLoad, stencilStore, clearDepth, clearStencil);
+    }
+    RenderPass& addShadingRate(std::string_view name) { return addShadingRate(resourceName(name)); }
 
     RenderQueue addQueue(std::string_view name);
 
 private:
     RenderGraphImpl::vertex_descriptor _id{0};
-    RenderGraphImpl& _graph;
-    TransparentUnorderedSet& _names;
+    RenderGraph* _graph{nullptr};
 };
 
 class ComputePass {
 public:
-    ComputePass(ComputePassData& data) : _data(data) {}
-    ComputePass(const ComputePass& rhs) : _data(rhs._data) {}
+    ComputePass(ComputePassData& data, memory_resource* arena) : _data(data), _arena(arena) {}
+    ComputePass(const ComputePass& rhs) : _data(rhs._data), _arena(rhs._arena) {}
     ComputePass& operator=(const ComputePass& rhs) {
         _data = rhs._data;
+        _arena = rhs._arena;
         return *this;
     }
 
     ComputePass(ComputePass&& rhs) = delete;
     ~ComputePass() = default;
 
-    ComputePass& addResource(std::string_view name, std::string_view bindingName, Access access);
-    ComputePass& addSampledDepth(std::string_view name, std::string_view bindingName);
-    ComputePass& addSampledStencil(std::string_view name, std::string_view bindingName);
+    ComputePass& addResource(StringID name, std::string_view bindingName, Access access);
+    ComputePass& addSampledDepth(StringID name, std::string_view bindingName);
+    ComputePass& addSampledStencil(StringID name, std::string_view bindingName);
+    // by declared resource name
+    ComputePass& addResource(std::string_view name, std::string_view bindingName, Access access) { return addResource(resourceName(name), bindingName, access); }
+    ComputePass& addSampledDepth(std::string_view name, std::string_view bindingName) { return addSampledDepth(resourceName(name), bindingName); }
+    ComputePass& addSampledStencil(std::string_view name, std::string_view bindingName) { return addSampledStencil(resourceName(name), bindingName); }
     ComputePass& setProgramName(std::string_view programName);
     ComputePass& setDispatch(uint32_t x, uint32_t y, uint32_t z);
+    ComputePass& setQueueHint(QueueHint hint);
 
 private:
     ComputePassData& _data;
+    memory_resource* _arena{nullptr};
 };
 
 class CopyPass {
 public:
-    CopyPass(CopyPassData& data, rhi::DevicePtr device) : _data(data),_device(device) {}
-    CopyPass(const CopyPass& rhs) : _data(rhs._data), _device(rhs._device) {}
+    CopyPass(CopyPassData& data, rhi::DevicePtr device, memory_resource* arena) : _data(data), _device(device), _arena(arena) {}
+    CopyPass(const CopyPass& rhs) : _data(rhs._data), _device(rhs._device), _arena(rhs._arena) {}
     CopyPass& operator=(const CopyPass& rhs) {
         _data = rhs._data;
         _device = rhs._device;
+        _arena = rhs._arena;
         return *this;
     }
 
@@ -115,12 +156,18 @@ public:
     ~CopyPass() = default;
 
     CopyPass& addPair(const CopyPair&);
-    CopyPass& uploadBuffer(const void* const data, uint32_t size, std::string_view name, uint32_t dstOffset);
-    CopyPass& fill(uint32_t value, uint32_t size, std::string_view name, uint32_t dstOffset);
+    CopyPass& uploadBuffer(const void* const data, uint32_t size, StringID name, uint32_t dstOffset);
+    CopyPass& fill(uint32_t value, uint32_t size, StringID name, uint32_t dstOffset);
+    // by declared resource name
+    CopyPass& uploadBuffer(const void* const data, uint32_t size, std::string_view name, uint32_t dstOffset) {
+        return uploadBuffer(data, size, resourceName(name), dstOffset);
+    }
+    CopyPass& fill(uint32_t value, uint32_t size, std::string_view name, uint32_t dstOffset) { return fill(value, size, resourceName(name), dstOffset); }
 
 private:
     CopyPassData& _data;
     rhi::DevicePtr _device;
+    memory_resource* _arena{nullptr};
 };
 
 class RenderGraph {
@@ -136,18 +183,30 @@ public:
     ComputePass addComputePass(std::string_view name);
     CopyPass addCopyPass(std::string_view name);
 
+    // drops all passes and switches to the arena of the next frame in flight.
     void clear();
 
     auto& impl() { return _graph; }
+    memory_resource* arena() { return &_arenas[_arenaIndex]; }
 
     using VertexType = RenderGraphImpl::vertex_descriptor;
     static VertexType null_vertex() { return RenderGraphImpl::null_vertex(); }
 
+    VertexType find(std::string_view name) const;
+
 private:
+    friend class RenderPass;
+
+    // name must already live in the current arena or the string table
+    VertexType addPass(std::string_view name, StringID id);
+
+    // declared first, pass data below deallocates into them on destruction
+    std::array<FrameArena, rhi::FRAMES_IN_FLIGHT> _arenas;
+    uint32_t _arenaIndex{0};
     RenderGraphImpl _graph;
     rhi::DevicePtr _device;
-   TransparentUnorderedSet _names; // pass queue names
-   TransparentUnorderedSet _resNames; // rendering resource name
+    // pass and queue names, keys live in the current arena
+    std::optional<PmrUnorderedMap<std::string_view, VertexType>> _names;
 };
 
 } // namespace raum::graph
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include "ResourceGraph.h"
+#include <algorithm>
 #include <boost/graph/depth_first_search.hpp>
 #include "RHIBuffer.h"
 #include "RHIBufferView.h"
 #include "RHIDevice.h"
 #include "RHIImage.h"
 #include "RHIImageView.h"
+#include "RHIQueue.h"
 #include "RHISwapchain.h"
+#include "core/utils/log.h"
 
 namespace raum::graph {
 using raum::rhi::RHIBuffer;
@@ -15,6 +18,23 @@ using raum::rhi::RHIImage;
 using raum::rhi::RHIImageView;
 
 namespace {
+// destroyed views first
+struct RetiredResources {
+    std::vector<rhi::ImagePtr> images;
+    std::vector<rhi::BufferPtr> buffers;
+    std::vector<rhi::BufferViewPtr> bufferViews;
+    std::vector<rhi::ImageViewPtr> imageViews;
+};
+
+// frames in flight may still use them, kept until the current frame slot completes
+template <typename T>
+void retire(RHIDevice* device, T&& resources) {
+    auto retired = std::make_shared<std::decay_t<T>>(std::forward<T>(resources));
+    device->getQueue({rhi::QueueType::GRAPHICS})->addCompleteHandler([retired]() mutable {
+        retired.reset();
+    });
+}
+
 rhi::ImageViewInfo getDefaultViewInfo(const rhi::ImageInfo& info) {
     rhi::ImageViewInfo viewInfo{};
     viewInfo.format = info.format;
@@ -48,23 +68,52 @@ bool isDepthStencil(const rhi::Format& format) {
     return format >= rhi::Format::D16_UNORM && format <= rhi::Format::D32_SFLOAT_S8_UINT;
 }
 
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool overlaps(uint64_t beginA, uint64_t endA, uint64_t beginB, uint64_t endB) {
+    return beginA < endB && beginB < endA;
+}
+
 } // namespace
 
+StringID depthViewName(StringID image) {
+    static const StringID depth{"Depth"};
+    return getStringTable().join(image, depth);
+}
+
+StringID stencilViewName(StringID image) {
+    static const StringID stencil{"Stencil"};
+    return getStringTable().join(image, stencil);
+}
+
 ResourceGraph::ResourceGraph(RHIDevice* device) : _device(device) {
 }
 
-void ResourceGraph::addBuffer(std::string_view name, const BufferData& data) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+ResourceGraph::VertexType ResourceGraph::addResource(StringID name) {
+    if (contains(name)) {
+        return null_vertex();
+    }
+    if (_vertices.size() <= name.value()) {
+        _vertices.resize(name.value() + 1, null_vertex());
+    }
+    auto v = add_vertex(_graph);
+    _graph[v].name = name;
+    _vertices[name.value()] = v;
+    return v;
+}
+
+void ResourceGraph::addBuffer(StringID name, const BufferData& data) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = data;
     }
 }
 
-void ResourceGraph::addBuffer(std::string_view name, uint32_t size, rhi::BufferUsage usage) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+void ResourceGraph::addBuffer(StringID name, uint32_t size, rhi::BufferUsage usage) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = BufferData{
             .info = {
                 .bufferUsage = usage,
@@ -74,56 +123,54 @@ void ResourceGraph::addBuffer(std::string_view name, uint32_t size, rhi::BufferU
     }
 }
 
-void ResourceGraph::addBufferView(std::string_view name, const BufferViewData& data) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+void ResourceGraph::addBufferView(StringID name, const BufferViewData& data) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = data;
-        add_edge(data.origin, v, _graph);
+        add_edge(vertex(data.origin), v, _graph);
     }
 }
 
-void ResourceGraph::addImageView(std::string_view name, const rhi::ImageInfo& info) {
+void ResourceGraph::addImageView(VertexType image, const rhi::ImageInfo& info) {
+    auto name = _graph[image].name;
     // ds/Depth , ds/Stencil
     if (isDepthStencil(info.format)) {
         ImageViewData depthView{
-            .origin = std::string{name},
+            .origin = name,
             .info = getDefaultViewInfo(info),
             .imageView = nullptr,
         };
         depthView.info.range.aspect = rhi::AspectMask::DEPTH;
-        addImageView("Depth", depthView);
+        _graph[image].depthView = addView(depthViewName(name), depthView);
 
         ImageViewData stencilView{
-            .origin = std::string{name},
+            .origin = name,
             .info = getDefaultViewInfo(info),
             .imageView = nullptr,
         };
         stencilView.info.range.aspect = rhi::AspectMask::STENCIL;
-        addImageView("Stencil", stencilView);
+        _graph[image].stencilView = addView(stencilViewName(name), stencilView);
     }
 
     ImageViewData view{
-        .origin = std::string{name},
+        .origin = name,
         .info = getDefaultViewInfo(info),
         .imageView = nullptr,
     };
-    addImageView(name, view);
+    _graph[image].view = addView(getStringTable().join(name, name), view);
 }
 
-void ResourceGraph::addImage(std::string_view name, const rhi::ImageInfo& info) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+void ResourceGraph::addImage(StringID name, const rhi::ImageInfo& info) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = ImageData{info};
-        addImageView(name, info);
+        addImageView(v, info);
     }
 }
 
-void ResourceGraph::addImage(std::string_view name, rhi::ImageUsage usage, uint32_t width, uint32_t height, rhi::Format format) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+void ResourceGraph::addImage(StringID name, rhi::ImageUsage usage, uint32_t width, uint32_t height, rhi::Format format) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         rhi::ImageInfo info{
             .type = rhi::ImageType::IMAGE_2D,
             .usage = usage,
@@ -134,38 +181,40 @@ void ResourceGraph::addImage(std::string_view name, rhi::ImageUsage usage, uint3
         };
         _graph[v].data = ImageData{info};
 
-        addImageView(name, info);
+        addImageView(v, info);
     }
 }
 
-void ResourceGraph::addImageView(std::string_view name, const ImageViewData& data) {
-    const auto& p = _names.emplace(data.origin + "/" + std::string{name});
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+ResourceGraph::VertexType ResourceGraph::addView(StringID name, const ImageViewData& data) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = data;
-        add_edge(data.origin, v, _graph);
+        add_edge(vertex(data.origin), v, _graph);
     }
+    return v;
+}
+
+void ResourceGraph::addImageView(StringID name, const ImageViewData& data) {
+    addView(getStringTable().join(data.origin, name), data);
 }
 
-void ResourceGraph::addSampler(std::string_view name, const rhi::SamplerInfo& info) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(*p.first, _graph);
+void ResourceGraph::addSampler(StringID name, const rhi::SamplerInfo& info) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = SamplerData{info};
     }
 }
 
-void ResourceGraph::import(std::string_view name, rhi::SwapchainPtr swapchain) {
-    const auto& p = _names.emplace(name);
-    if (p.second) {
-        const auto& v = add_vertex(name, _graph);
+void ResourceGraph::import(StringID name, rhi::SwapchainPtr swapchain) {
+    auto v = addResource(name);
+    if (v != null_vertex()) {
         _graph[v].data = SwapchainData{swapchain};
         _graph[v].residency = ResourceResidency::SWAPCHAIN;
     }
 }
 
-void ResourceGraph::updateImage(std::string_view name, uint32_t width, uint32_t height) {
-    auto v = *find_vertex(name, _graph);
+void ResourceGraph::updateImage(StringID name, uint32_t width, uint32_t height) {
+    auto v = vertex(name);
     auto& image = std::get<ImageData>(_graph[v].data);
     if (image.info.extent.x != width || image.info.extent.y != height) {
         unmount(name, std::numeric_limits<uint64_t>::max());
@@ -174,8 +223,19 @@ void ResourceGraph::updateImage(std::string_view name, uint32_t width, uint32_t
     }
 }
 
-void ResourceGraph::mount(std::string_view name) {
-    auto v = *find_vertex(name, _graph);
+void ResourceGraph::setResidency(StringID name, ResourceResidency residency) {
+    auto& resource = get(name);
+    if (resource.residency != residency) {
+        // transient placement no longer applies
+        unmount(name, std::numeric_limits<uint64_t>::max());
+        _placements.erase(name);
+        _appliedPlan = 0;
+        resource.residency = residency;
+    }
+}
+
+void ResourceGraph::mount(StringID name) {
+    auto v = vertex(name);
     _graph[v].life++;
 
     std::visit(overloaded{
@@ -186,15 +246,20 @@ void ResourceGraph::mount(std::string_view name) {
                    },
                    [&](BufferViewData& data) {
                        if (!data.bufferView) {
-                           const auto& v = *find_vertex(data.origin, _graph);
-                           const auto& originData = std::get<BufferData>(_graph[v].data);
+                           const auto& originData = std::get<BufferData>(get(data.origin).data);
                            data.info.buffer = originData.buffer.get();
                            data.bufferView = rhi::BufferViewPtr(_device->createBufferView(data.info));
                        }
                    },
                    [&](ImageData& data) {
                        if (!data.image) {
-                           data.image = rhi::ImagePtr(_device->createImage(data.info));
+                           auto placement = _placements.find(name);
+                           if (placement != _placements.end()) {
+                               auto* heap = _heaps[placement->second.heap].get();
+                               data.image = rhi::ImagePtr(_device->createImage(data.info, heap, placement->second.offset));
+                           } else {
+                               data.image = rhi::ImagePtr(_device->createImage(data.info));
+                           }
 
                            // depth/stencil seperate aspect view
                            if (isDepthStencil(data.info.format)) {
@@ -217,8 +282,7 @@ void ResourceGraph::mount(std::string_view name) {
                    },
                    [&](ImageViewData& data) {
                        if (!data.imageView) {
-                           const auto& v = *find_vertex(data.origin, _graph);
-                           const auto& originData = std::get<ImageData>(_graph[v].data);
+                           const auto& originData = std::get<ImageData>(get(data.origin).data);
                            data.info.image = originData.image.get();
                            data.imageView = rhi::ImageViewPtr(_device->createImageView(data.info));
                        }
@@ -229,12 +293,13 @@ void ResourceGraph::mount(std::string_view name) {
                            for (uint32_t i = 0; i < swapchain->imageCount(); ++i) {
                                auto index = static_cast<uint8_t>(i);
                                auto imagePtr = rhi::ImagePtr(swapchain->allocateImage(index));
-                               data.images.emplace(index, imagePtr);
+                               // replaces the images of a resized swapchain
+                               data.images.insert_or_assign(index, imagePtr);
 
                                const auto& imageInfo = imagePtr->info();
                                rhi::ImageViewInfo viewInfo = getDefaultViewInfo(imageInfo);
                                viewInfo.image = imagePtr.get();
-                               data.imageViews.emplace(index, rhi::ImageViewPtr(_device->createImageView(viewInfo)));
+                               data.imageViews.insert_or_assign(index, rhi::ImageViewPtr(_device->createImageView(viewInfo)));
                            }
                        }
                    },
@@ -249,17 +314,25 @@ struct UnmountVisitor : public boost::dfs_visitor<> {
         auto& resource = g[v];
         std::visit(
             overloaded{
-                [](BufferData& data) {
-                    data.buffer.reset();
+                [&](BufferData& data) {
+                    if (data.buffer) {
+                        retired.buffers.emplace_back(std::move(data.buffer));
+                    }
                 },
-                [](BufferViewData& data) {
-                    data.bufferView.reset();
+                [&](BufferViewData& data) {
+                    if (data.bufferView) {
+                        retired.bufferViews.emplace_back(std::move(data.bufferView));
+                    }
                 },
-                [](ImageData& data) {
-                    data.image.reset();
+                [&](ImageData& data) {
+                    if (data.image) {
+                        retired.images.emplace_back(std::move(data.image));
+                    }
                 },
-                [](ImageViewData& data) {
-                    data.imageView.reset();
+                [&](ImageViewData& data) {
+                    if (data.imageView) {
+                        retired.imageViews.emplace_back(std::move(data.imageView));
+                    }
                 },
                 [](auto&) {
                 },
@@ -268,112 +341,231 @@ struct UnmountVisitor : public boost::dfs_visitor<> {
     }
 
     ResourceGraphImpl& g;
+    RetiredResources& retired;
 };
 
-void ResourceGraph::unmount(std::string_view name, uint64_t life) {
-    const auto& v = *find_vertex(name, _graph);
+void ResourceGraph::unmount(StringID name, uint64_t life) {
+    const auto& v = vertex(name);
     auto& resource = _graph[v];
     if (resource.life < life) {
         auto indexMap = boost::get(boost::vertex_index, _graph);
         auto colorMap = boost::make_vector_property_map<boost::default_color_type>(indexMap);
-        UnmountVisitor uv{{}, _graph};
+        RetiredResources retired;
+        UnmountVisitor uv{{}, _graph, retired};
         boost::depth_first_visit(_graph, v, uv, colorMap);
+        if (!retired.images.empty() || !retired.buffers.empty() || !retired.bufferViews.empty() ||
+            !retired.imageViews.empty()) {
+            retire(_device, std::move(retired));
+        }
     }
 }
 
-bool ResourceGraph::contains(std::string_view name) {
-    return find_vertex(name, _graph).has_value();
-}
+TransientPlan ResourceGraph::planTransients(std::span<const TransientRange> ranges) {
+    TransientPlan plan;
+    plan.id = ++_planCount;
+    auto& report = plan.report;
 
-const Resource& ResourceGraph::get(std::string_view name) const {
-    auto v = *find_vertex(name, _graph);
-    return _graph[v];
-}
+    struct Candidate {
+        const TransientRange* range;
+        rhi::MemoryRequirement requirement;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(ranges.size());
+    uint32_t passCount{0};
+    for (const auto& range : ranges) {
+        const auto& info = std::get<ImageData>(get(range.name).data).info;
+        auto requirement = _device->memoryRequirement(info);
+        candidates.emplace_back(&range, requirement);
+        report.withoutAliasing += requirement.size;
+        passCount = std::max(passCount, range.last + 1);
+    }
+    report.resourceCount = static_cast<uint32_t>(candidates.size());
 
-Resource& ResourceGraph::get(std::string_view name) {
-    auto v = *find_vertex(name, _graph);
-    return _graph[v];
-}
+    // largest first packs tighter, name keeps the plan stable between runs.
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.requirement.size != rhs.requirement.size) {
+            return lhs.requirement.size > rhs.requirement.size;
+        }
+        return lhs.range->name.str() < rhs.range->name.str();
+    });
+
+    std::vector<uint64_t> aliveBytes(passCount, 0);
+    std::vector<std::pair<uint64_t, uint64_t>> occupied;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto* range = candidates[i].range;
+        const auto& requirement = candidates[i].requirement;
+        for (auto pass = range->first; pass <= range->last; ++pass) {
+            aliveBytes[pass] += requirement.size;
+        }
 
-const Resource& ResourceGraph::getView(std::string_view name) const {
-    auto v = *find_vertex(name, _graph);
-    size_t res{INVALID_VERTEX};
-    for (const auto& e : make_iterator_range(out_edges(v, _graph))) {
-        if (_graph[e.m_target].name.length() < (name.length() * 2 + 1)) {
-            continue;
+        // one heap per memory type set
+        auto heapIter = std::find_if(plan.heaps.begin(), plan.heaps.end(), [&](const rhi::HeapInfo& heap) {
+            return heap.memoryTypeBits == requirement.memoryTypeBits;
+        });
+        if (heapIter == plan.heaps.end()) {
+            heapIter = plan.heaps.insert(plan.heaps.end(), rhi::HeapInfo{0, requirement.memoryTypeBits});
         }
-        auto childName = std::string_view(_graph[e.m_target].name).substr(name.length() + 1, name.length());
-        if (name == childName) {
-            res = e.m_target;
-            break;
+        auto heapIndex = static_cast<uint32_t>(heapIter - plan.heaps.begin());
+
+        // memory taken by placed resources alive at the same time
+        occupied.clear();
+        for (size_t j = 0; j < i; ++j) {
+            const auto& placed = plan.placements[j];
+            const auto* placedRange = candidates[j].range;
+            if (placed.heap == heapIndex && placedRange->first <= range->last && range->first <= placedRange->last) {
+                occupied.emplace_back(placed.offset, placed.offset + placed.size);
+            }
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        // lowest gap that fits
+        uint64_t offset{0};
+        for (const auto& [begin, end] : occupied) {
+            if (alignUp(offset, requirement.alignment) + requirement.size <= begin) {
+                break;
+            }
+            offset = std::max(offset, end);
+        }
+        offset = alignUp(offset, requirement.alignment);
+        heapIter->size = std::max(heapIter->size, offset + requirement.size);
+        plan.placements.emplace_back(range->name, heapIndex, offset, requirement.size);
+    }
+
+    for (size_t i = 0; i < plan.placements.size(); ++i) {
+        auto& lhs = plan.placements[i];
+        for (size_t j = i + 1; j < plan.placements.size(); ++j) {
+            auto& rhs = plan.placements[j];
+            if (lhs.heap == rhs.heap && overlaps(lhs.offset, lhs.offset + lhs.size, rhs.offset, rhs.offset + rhs.size)) {
+                lhs.aliases.emplace_back(rhs.name);
+                rhs.aliases.emplace_back(lhs.name);
+            }
         }
     }
-    raum_check(res != INVALID_VERTEX, "can't find resource view: {}/{}", name, name);
-    return _graph[res];
+
+    for (const auto& heap : plan.heaps) {
+        report.withAliasing += heap.size;
+    }
+    if (!aliveBytes.empty()) {
+        report.peakAlive = *std::max_element(aliveBytes.begin(), aliveBytes.end());
+    }
+    return plan;
 }
 
-Resource& ResourceGraph::getView(std::string_view name) {
-    auto v = *find_vertex(name, _graph);
-    size_t res{INVALID_VERTEX};
-    for (const auto& e : make_iterator_range(out_edges(v, _graph))) {
-        if (_graph[e.m_target].name.length() < (name.length() * 2 + 1)) {
+void ResourceGraph::applyTransients(const TransientPlan& plan) {
+    if (plan.id == _appliedPlan) {
+        return;
+    }
+    _appliedPlan = plan.id;
+
+    bool changed{false};
+    // plan heap index -> heap with the same memory type set
+    std::vector<uint32_t> heapSlots(plan.heaps.size());
+    for (uint32_t i = 0; i < plan.heaps.size(); ++i) {
+        const auto& heapInfo = plan.heaps[i];
+        auto iter = std::find_if(_heaps.begin(), _heaps.end(), [&](const rhi::HeapPtr& heap) {
+            return heap->info().memoryTypeBits == heapInfo.memoryTypeBits;
+        });
+        auto slot = static_cast<uint32_t>(iter - _heaps.begin());
+        heapSlots[i] = slot;
+        if (iter != _heaps.end() && (*iter)->info().size >= heapInfo.size) {
             continue;
         }
-        auto childName = std::string_view(_graph[e.m_target].name).substr(name.length() + 1, name.length());
-        if (name == childName) {
-            res = e.m_target;
-            break;
+        uint64_t size = heapInfo.size;
+        if (iter != _heaps.end()) {
+            size = std::max(size, (*iter)->info().size);
+            // images placed in the old heap must be released before it
+            for (auto placement = _placements.begin(); placement != _placements.end();) {
+                if (placement->second.heap == slot) {
+                    unmount(placement->first, std::numeric_limits<uint64_t>::max());
+                    placement = _placements.erase(placement);
+                } else {
+                    ++placement;
+                }
+            }
+            // after the images, handlers run in order
+            retire(_device, std::move(_heaps[slot]));
+        } else {
+            _heaps.emplace_back();
         }
+        _heaps[slot] = rhi::HeapPtr(_device->createHeap({size, heapInfo.memoryTypeBits}));
+        changed = true;
     }
-    raum_check(res != INVALID_VERTEX, "can't find resource view: {}/{}", name, name);
-    return _graph[res];
-}
-
-Resource& ResourceGraph::getAspectView(std::string_view name, Aspect aspect) {
-    auto v = *find_vertex(name, _graph);
-    size_t res{INVALID_VERTEX};
-    for (const auto& e : make_iterator_range(out_edges(v, _graph))) {
-        // name = "ds"
-        // "ds/Depth" -> depth view
-        auto childName = std::string_view(_graph[e.m_target].name)
-                             .substr(
-                                 name.length() + 1,
-                                 _graph[e.m_target].name.length() - name.length() - 1);
-        if (aspect == Aspect::DEPTH && childName == "Depth") {
-            res = e.m_target;
-            break;
-        } else if (aspect == Aspect::STENCIL && childName == "Stencil") {
-            res = e.m_target;
-            break;
+
+    for (const auto& placement : plan.placements) {
+        auto slot = heapSlots[placement.heap];
+        auto iter = _placements.find(placement.name);
+        if (iter != _placements.end() && iter->second.heap == slot && iter->second.offset == placement.offset) {
+            continue;
         }
+        // recreated on next mount
+        unmount(placement.name, std::numeric_limits<uint64_t>::max());
+        _placements[placement.name] = {slot, placement.offset};
+        changed = true;
     }
-    raum_check(res != INVALID_VERTEX, "can't find resource view: {}/{}", name, name);
-    return _graph[res];
-}
-
-const Resource& ResourceGraph::getAspectView(std::string_view name, Aspect aspect) const {
-    auto v = *find_vertex(name, _graph);
-    size_t res{INVALID_VERTEX};
-    for (const auto& e : make_iterator_range(out_edges(v, _graph))) {
-        // name = "ds"
-        // "ds/Depth" -> depth view
-        auto childName = std::string_view(_graph[e.m_target].name)
-                             .substr(
-                                 name.length() + 1,
-                                 _graph[e.m_target].name.length() - name.length() - 1);
-        if (aspect == Aspect::DEPTH && childName == "Depth") {
-            res = e.m_target;
-            break;
-        } else if (aspect == Aspect::STENCIL && childName == "Stencil") {
-            res = e.m_target;
-            break;
-        }
+
+    _transientReport = plan.report;
+    if (changed) {
+        raum_info("transient images: {}, {} bytes without aliasing, {} bytes with aliasing, {} bytes peak alive.",
+                  _transientReport.resourceCount,
+                  _transientReport.withoutAliasing,
+                  _transientReport.withAliasing,
+                  _transientReport.peakAlive);
     }
-    raum_check(res != INVALID_VERTEX, "can't find resource view: {}/{}", name, name);
-    return _graph[res];
 }
 
-rhi::BufferPtr ResourceGraph::getBuffer(std::string_view name) {
+StringID resourceName(std::string_view name) {
+    auto id = getStringTable().find(name);
+    raum_check(id.valid(), "unknown resource name: {}", name);
+    return id;
+}
+
+ResourceGraph::VertexType ResourceGraph::vertex(StringID name) const {
+    return name.value() < _vertices.size() ? _vertices[name.value()] : null_vertex();
+}
+
+bool ResourceGraph::contains(StringID name) const {
+    return vertex(name) != null_vertex();
+}
+
+const Resource& ResourceGraph::get(StringID name) const {
+    auto v = vertex(name);
+    raum_check(v != null_vertex(), "can't find resource: {}", name.str());
+    return _graph[v];
+}
+
+Resource& ResourceGraph::get(StringID name) {
+    auto v = vertex(name);
+    raum_check(v != null_vertex(), "can't find resource: {}", name.str());
+    return _graph[v];
+}
+
+const Resource& ResourceGraph::getView(StringID name) const {
+    const auto& res = get(name);
+    raum_check(res.view != INVALID_VERTEX, "can't find resource view: {}/{}", name.str(), name.str());
+    return _graph[res.view];
+}
+
+Resource& ResourceGraph::getView(StringID name) {
+    const auto& res = get(name);
+    raum_check(res.view != INVALID_VERTEX, "can't find resource view: {}/{}", name.str(), name.str());
+    return _graph[res.view];
+}
+
+Resource& ResourceGraph::getAspectView(StringID name, Aspect aspect) {
+    const auto& res = get(name);
+    auto v = aspect == Aspect::DEPTH ? res.depthView : res.stencilView;
+    raum_check(v != INVALID_VERTEX, "can't find aspect view of: {}", name.str());
+    return _graph[v];
+}
+
+const Resource& ResourceGraph::getAspectView(StringID name, Aspect aspect) const {
+    const auto& res = get(name);
+    auto v = aspect == Aspect::DEPTH ? res.depthView : res.stencilView;
+    raum_check(v != INVALID_VERTEX, "can't find aspect view of: {}", name.str());
+    return _graph[v];
+}
+
+rhi::BufferPtr ResourceGraph::getBuffer(StringID name) {
     Resource& res = get(name);
     if (std::holds_alternative<BufferData>(res.data)) {
         return std::get<BufferData>(res.data).buffer;
@@ -382,7 +574,7 @@ rhi::BufferPtr ResourceGraph::getBuffer(std::string_view name) {
     return nullptr;
 }
 
-rhi::BufferViewPtr ResourceGraph::getBufferView(std::string_view name) {
+rhi::BufferViewPtr ResourceGraph::getBufferView(StringID name) {
     Resource& res = get(name);
     if (std::holds_alternative<BufferViewData>(res.data)) {
         return std::get<BufferViewData>(res.data).bufferView;
@@ -391,7 +583,7 @@ rhi::BufferViewPtr ResourceGraph::getBufferView(std::string_view name) {
     return nullptr;
 }
 
-rhi::ImagePtr ResourceGraph::getImage(std::string_view name) {
+rhi::ImagePtr ResourceGraph::getImage(StringID name) {
     Resource& res = get(name);
     if (std::holds_alternative<ImageData>(res.data)) {
         return std::get<ImageData>(res.data).image;
@@ -403,7 +595,7 @@ rhi::ImagePtr ResourceGraph::getImage(std::string_view name) {
     return nullptr;
 }
 
-rhi::ImageViewPtr ResourceGraph::getImageView(std::string_view name) {
+rhi::ImageViewPtr ResourceGraph::getImageView(StringID name) {
     Resource& res = get(name);
     if (std::holds_alternative<ImageViewData>(res.data)) {
         return std::get<ImageViewData>(res.data).imageView;
@@ -1,5 +1,6 @@
 #pragma once
 #include <boost/graph/adjacency_list.hpp>
+#include <span>
 #include <variant>
 #include "GraphTypes.h"
 
@@ -29,32 +30,51 @@ struct SwapchainData {
 };
 
 struct Resource {
-    std::string_view name{};
+    StringID name{};
     ResourceResidency residency{ResourceResidency::DONT_CARE};
     rhi::AccessFlags access{rhi::AccessFlags::NONE};
     rhi::ImageLayout layout{rhi::ImageLayout::UNDEFINED};
     std::variant<BufferData, BufferViewData, ImageData, ImageViewData, SamplerData, SwapchainData> data;
     uint64_t life{0};
+    // default and aspect views of an image, INVALID_VERTEX otherwise
+    size_t view{INVALID_VERTEX};
+    size_t depthView{INVALID_VERTEX};
+    size_t stencilView{INVALID_VERTEX};
 };
-} // namespace raum::graph
 
-namespace boost {
-namespace graph {
-
-template <>
-struct internal_vertex_name<raum::graph::Resource> {
-    typedef multi_index::member<raum::graph::Resource, std::string_view, &raum::graph::Resource::name> type;
+// [first, last] pass a transient resource is alive in, passes are indexed in render graph order.
+struct TransientRange {
+    StringID name;
+    uint32_t first{0};
+    uint32_t last{0};
 };
 
-template <>
-struct internal_vertex_constructor<raum::graph::Resource> {
-    typedef vertex_from_name<raum::graph::Resource> type;
+struct TransientPlacement {
+    StringID name;
+    uint32_t heap{0};
+    uint64_t offset{0};
+    uint64_t size{0};
+    // resources sharing memory with this one
+    std::vector<StringID> aliases;
 };
 
-} // namespace graph
-} // namespace boost
+struct TransientMemoryReport {
+    uint32_t resourceCount{0};
+    // one dedicated allocation per resource
+    uint64_t withoutAliasing{0};
+    // sum of heap sizes
+    uint64_t withAliasing{0};
+    // most bytes alive in a single pass, lower bound of withAliasing
+    uint64_t peakAlive{0};
+};
 
-namespace raum::graph {
+struct TransientPlan {
+    // stamped by planTransients, applying the plan already applied is a no-op
+    uint64_t id{0};
+    std::vector<TransientPlacement> placements;
+    std::vector<rhi::HeapInfo> heaps;
+    TransientMemoryReport report;
+};
 
 using ResourceGraphImpl = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, Resource, boost::no_property>;
 
@@ -68,41 +88,92 @@ public:
     ResourceGraph& operator=(const ResourceGraph&) = delete;
     ResourceGraph(ResourceGraph&&) = delete;
 
-    void addBuffer(std::string_view name, const BufferData& data);
-    void addBuffer(std::string_view name, uint32_t size, rhi::BufferUsage usage);
-    void addBufferView(std::string_view name, const BufferViewData& data);
-    void addImage(std::string_view name, const rhi::ImageInfo& data);
-    void addImage(std::string_view name, rhi::ImageUsage, uint32_t width, uint32_t height, rhi::Format format);
-    void addImageView(std::string_view name, const ImageViewData& data);
-    void addSampler(std::string_view name, const rhi::SamplerInfo& data);
-    void import(std::string_view name, rhi::SwapchainPtr swapchain);
-    void mount(std::string_view name);
-    void unmount(std::string_view name, uint64_t life);
-    void updateImage(std::string_view name, uint32_t width, uint32_t height);
+    // names are interned by the caller(StringID{name}), strings of existing names are found with StringTable::find.
+    void addBuffer(StringID name, const BufferData& data);
+    void addBuffer(StringID name, uint32_t size, rhi::BufferUsage usage);
+    void addBufferView(StringID name, const BufferViewData& data);
+    void addImage(StringID name, const rhi::ImageInfo& data);
+    void addImage(StringID name, rhi::ImageUsage, uint32_t width, uint32_t height, rhi::Format format);
+    void addImageView(StringID name, const ImageViewData& data);
+    void addSampler(StringID name, const rhi::SamplerInfo& data);
+    void import(StringID name, rhi::SwapchainPtr swapchain);
+    void mount(StringID name);
+    // released once the current frame slot completes, frames in flight may still use them
+    void unmount(StringID name, uint64_t life);
+    void updateImage(StringID name, uint32_t width, uint32_t height);
+    // PERSISTENT/EXTERNAL resources keep their writers alive when passes are culled
+    void setResidency(StringID name, ResourceResidency residency);
+
+    // by string: adding interns the name, everything else requires a declared one.
+    void addBuffer(std::string_view name, const BufferData& data) { addBuffer(StringID{name}, data); }
+    void addBuffer(std::string_view name, uint32_t size, rhi::BufferUsage usage) { addBuffer(StringID{name}, size, usage); }
+    void addBufferView(std::string_view name, const BufferViewData& data) { addBufferView(StringID{name}, data); }
+    void addImage(std::string_view name, const rhi::ImageInfo& data) { addImage(StringID{name}, data); }
+    void addImage(std::string_view name, rhi::ImageUsage usage, uint32_t width, uint32_t height, rhi::Format format) {
+        addImage(StringID{name}, usage, width, height, format);
+    }
+    void addImageView(std::string_view name, const ImageViewData& data) { addImageView(StringID{name}, data); }
+    void addSampler(std::string_view name, const rhi::SamplerInfo& data) { addSampler(StringID{name}, data); }
+    void import(std::string_view name, rhi::SwapchainPtr swapchain) { import(StringID{name}, swapchain); }
+    void mount(std::string_view name) { mount(resourceName(name)); }
+    void updateImage(std::string_view name, uint32_t width, uint32_t height) { updateImage(resourceName(name), width, height); }
+    void setResidency(std::string_view name, ResourceResidency residency) { setResidency(resourceName(name), residency); }
+
+    // DONT_CARE images only, others keep dedicated allocations.
+    TransientPlan planTransients(std::span<const TransientRange> ranges);
+    void applyTransients(const TransientPlan& plan);
+    const TransientMemoryReport& transientMemoryReport() const { return _transientReport; }
 
     static VertexType null_vertex() { return boost::graph_traits<ResourceGraphImpl>::null_vertex(); }
     auto& impl() { return _graph; }
 
-    bool contains(std::string_view name);
-    const Resource& get(std::string_view name) const;
-    Resource& get(std::string_view name);
-    const Resource& getView(std::string_view name) const;
-    Resource& getView(std::string_view name);
-
-    const Resource& getAspectView(std::string_view name, Aspect aspect) const;
-    Resource& getAspectView(std::string_view name, Aspect aspect);
-
-    rhi::BufferPtr getBuffer(std::string_view name);
-    rhi::BufferViewPtr getBufferView(std::string_view name);
-    rhi::ImagePtr getImage(std::string_view name);
-    rhi::ImageViewPtr getImageView(std::string_view name);
-    rhi::SwapchainPtr getSwapchain(std::string_view name);
+    // null_vertex if name was never added
+    VertexType vertex(StringID name) const;
+    bool contains(StringID name) const;
+    const Resource& get(StringID name) const;
+    Resource& get(StringID name);
+    const Resource& getView(StringID name) const;
+    Resource& getView(StringID name);
+
+    const Resource& getAspectView(StringID name, Aspect aspect) const;
+    Resource& getAspectView(StringID name, Aspect aspect);
+
+    rhi::BufferPtr getBuffer(StringID name);
+    rhi::BufferViewPtr getBufferView(StringID name);
+    rhi::ImagePtr getImage(StringID name);
+    rhi::ImageViewPtr getImageView(StringID name);
+    rhi::SwapchainPtr getSwapchain(StringID name);
+
+    VertexType vertex(std::string_view name) const { return vertex(getStringTable().find(name)); }
+    bool contains(std::string_view name) const { return contains(getStringTable().find(name)); }
+    const Resource& get(std::string_view name) const { return get(resourceName(name)); }
+    Resource& get(std::string_view name) { return get(resourceName(name)); }
+    rhi::BufferPtr getBuffer(std::string_view name) { return getBuffer(resourceName(name)); }
+    rhi::BufferViewPtr getBufferView(std::string_view name) { return getBufferView(resourceName(name)); }
+    rhi::ImagePtr getImage(std::string_view name) { return getImage(resourceName(name)); }
+    rhi::ImageViewPtr getImageView(std::string_view name) { return getImageView(resourceName(name)); }
+    rhi::SwapchainPtr getSwapchain(std::string_view name) { return getSwapchain(resourceName(name)); }
 
 private:
-    void addImageView(std::string_view name, const rhi::ImageInfo& info);
+    // null_vertex if name already exists
+    VertexType addResource(StringID name);
+    VertexType addView(StringID name, const ImageViewData& data);
+    void addImageView(VertexType image, const rhi::ImageInfo& info);
     rhi::RHIDevice* _device{nullptr};
     ResourceGraphImpl _graph;
-    std::unordered_set<std::string, hash_string, std::equal_to<>> _names;
+    // vertex of each interned name, indexed by StringID::value()
+    std::vector<VertexType> _vertices;
+
+    struct Placement {
+        uint32_t heap{0};
+        uint64_t offset{0};
+    };
+    // one heap per memory type set, shared by all plans and grown to the largest of them
+    std::vector<rhi::HeapPtr> _heaps;
+    std::unordered_map<StringID, Placement> _placements;
+    uint64_t _planCount{0};
+    uint64_t _appliedPlan{0};
+    TransientMemoryReport _transientReport{};
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "SceneBVH.h"
+
+namespace raum::graph {
+
+namespace {
+
+scene::AABB transformBounds(const scene::AABB& aabb, const Mat4& transform) {
+    auto center = Vec3f(transform * Vec4f((aabb.minBound + aabb.maxBound) * 0.5f, 1.0f));
+    auto extent = (aabb.maxBound - aabb.minBound) * 0.5f;
+    Vec3f radius{0.0f};
+    for (uint32_t column = 0; column < 3; ++column) {
+        radius += glm::abs(Vec3f(transform[column])) * extent[column];
+    }
+    return {center - radius, center + radius};
+}
+
+} // namespace
+
+void SceneBVH::build(std::span<const scene::RenderablePtr> renderables) {
+    _renderables = renderables;
+    _objects.clear();
+    _objects.reserve(renderables.size());
+    for (const auto& renderable : renderables) {
+        auto* meshRenderer = static_cast<scene::MeshRenderer*>(renderable.get());
+        _objects.emplace_back(Object{
+            .meshRenderer = meshRenderer,
+            .transformVersion = meshRenderer->transformVersion(),
+            .builtBounds = meshRenderer->mesh()->aabb(),
+            .inverseBuiltTransform = glm::inverse(meshRenderer->transform()),
+        });
+    }
+    _dynamicRenderables.clear();
+    _dynamicBounds.clear();
+    _static.build(renderables, STATIC_LEAF_SIZE);
+    buildDynamic();
+}
+
+void SceneBVH::buildDynamic() {
+    auto leafSize = _dynamicRenderables.size() <= FLAT_DYNAMIC_LIMIT ? FLAT_DYNAMIC_LIMIT : 1;
+    _dynamic.build(_dynamicRenderables, _dynamicBounds, leafSize);
+}
+
+void SceneBVH::update() {
+    bool moved{false};
+    for (uint32_t i = 0; i < _objects.size(); ++i) {
+        auto& object = _objects[i];
+        auto version = object.meshRenderer->transformVersion();
+        if (version == object.transformVersion) {
+            continue;
+        }
+        object.transformVersion = version;
+        auto bounds = transformBounds(object.builtBounds, object.meshRenderer->transform() * object.inverseBuiltTransform);
+        if (object.dynamicIndex == UINT32_MAX) {
+            _static.setActive(i, false);
+            object.dynamicIndex = static_cast<uint32_t>(_dynamicRenderables.size());
+            _dynamicRenderables.emplace_back(_renderables[i]);
+            _dynamicBounds.emplace_back(bounds);
+            moved = true;
+        } else {
+            _dynamicBounds[object.dynamicIndex] = bounds;
+            _dynamic.setBounds(object.dynamicIndex, bounds);
+        }
+    }
+    // renderables that started moving join the dynamic tree, it stays small
+    if (moved) {
+        buildDynamic();
+    } else {
+        _dynamic.refit();
+    }
+}
+
+void SceneBVH::cull(std::span<const scene::Camera* const> cameras,
+                    std::vector<scene::RenderablePtr>& renderables,
+                    std::vector<CameraMask>& masks,
+                    std::vector<scene::AABB>* bounds) const {
+    _static.cull(cameras, renderables, masks, bounds);
+    _dynamic.cull(cameras, renderables, masks, bounds);
+}
+
+} // namespace raum::graph
@@ -0,0 +1,47 @@
+#pragma once
+#include "BVH.h"
+
+namespace raum::graph {
+
+// culling trees over the cullable renderables. Renderables start in a static tree built once, the ones whose
+// transform changed since are moved to a small dynamic tree with single object leaves that is refit each frame.
+class SceneBVH {
+public:
+    // `renderables` must outlive the trees, like the spans the scheduler hands out.
+    void build(std::span<const scene::RenderablePtr> renderables);
+
+    // picks up transform changes, only the renderables that moved touch the trees.
+    void update();
+
+    void cull(std::span<const scene::Camera* const> cameras,
+              std::vector<scene::RenderablePtr>& renderables,
+              std::vector<CameraMask>& masks,
+              std::vector<scene::AABB>* bounds = nullptr) const;
+
+private:
+    struct Object {
+        scene::MeshRenderer* meshRenderer{nullptr};
+        uint64_t transformVersion{0};
+        // mesh bounds are world space for the transform at build
+        scene::AABB builtBounds{};
+        Mat4 inverseBuiltTransform{1.0f};
+        // index in the dynamic tree, UINT32_MAX while static
+        uint32_t dynamicIndex{UINT32_MAX};
+    };
+
+    // the leaf size of the static tree, leaves are tested by the batch culling kernel
+    static constexpr uint32_t STATIC_LEAF_SIZE{8};
+    // up to this many moving renderables are tested as one flat leaf instead of a tree
+    static constexpr uint32_t FLAT_DYNAMIC_LIMIT{256};
+
+    void buildDynamic();
+
+    std::span<const scene::RenderablePtr> _renderables;
+    std::vector<Object> _objects;
+    std::vector<scene::RenderablePtr> _dynamicRenderables;
+    std::vector<scene::AABB> _dynamicBounds;
+    BVH _static;
+    BVH _dynamic;
+};
+
+} // namespace raum::graph
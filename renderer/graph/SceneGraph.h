@@ -15,6 +15,8 @@ struct EmptyNode {
 enum class ModelHint:uint32_t {
     NONE = 0,
     NO_CULLING = 1,
+    // rasterized by queues with occlusion culling if its meshes carry occluder geometry
+    OCCLUDER = 1 << 1,
 };
 OPERABLE(ModelHint)
 
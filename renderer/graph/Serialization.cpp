@@ -1,6 +1,7 @@
 #include "Serialization.h"
 #include <boost/json/src.hpp>
 #include <fstream>
+#include <set>
 #include "RHIUtils.h"
 #include "boost/algorithm/string.hpp"
 #include "boost/lexical_cast.hpp"
@@ -217,6 +218,22 @@ void reflect(const std::string& source, BindingMap& bindingMap) {
     }
 }
 
+struct LayoutStage {
+    std::string_view key;
+    std::string_view ext;
+    rhi::ShaderStage stage;
+};
+
+constexpr LayoutStage LAYOUT_STAGES[] = {
+    {"vertex", ".vert", rhi::ShaderStage::VERTEX},
+    {"fragment", ".frag", rhi::ShaderStage::FRAGMENT},
+    {"compute", ".comp", rhi::ShaderStage::COMPUTE},
+    {"mesh", ".mesh", rhi::ShaderStage::MESH},
+    {"task", ".task", rhi::ShaderStage::TASK},
+};
+
+// "base": {"layout": "<file next to this one>", "stages": [...]} takes the listed stages of another layout
+// over, stages the layout defines itself win.
 const std::filesystem::path deserialize(const std::filesystem::path& layoutPath,
                                         ShaderResource& resource) {
     raum_check(std::filesystem::exists(layoutPath), "failed to read file!");
@@ -228,43 +245,39 @@ const std::filesystem::path deserialize(const std::filesystem::path& layoutPath,
         raum_check(false, "layout doesn't contains a valid path.");
     }
 
+    value baseRaw;
+    std::filesystem::path basePath;
+    std::set<std::string_view> baseStages;
+    if (data.contains("base")) {
+        const auto& base = data.at("base").as_object();
+        basePath = layoutPath.parent_path() / base.at("layout").as_string().c_str();
+        raum_check(std::filesystem::exists(basePath), "base layout {} doesn't exist!", basePath.string());
+        std::ifstream baseFile(basePath);
+        baseRaw = parse(baseFile);
+        for (const auto& stage : base.at("stages").as_array()) {
+            baseStages.emplace(stage.as_string());
+        }
+    }
+
     BindingMap bindingMap;
 
     const auto& pathID = data.at("path").as_string();
-    if (data.contains("vertex")) {
-        const auto& vert = data.at("vertex");
-        auto source = loadResource(vert.as_object(), layoutPath, ".vert");
-        resource.shaderSources.emplace(rhi::ShaderStage::VERTEX, source);
-        reflect(source, bindingMap);
-        deserializeBinding(vert.as_object(), rhi::ShaderStage::VERTEX, resource, bindingMap);
-    }
-    if (data.contains("fragment")) {
-        const auto& frag = data.at("fragment");
-        auto source = loadResource(frag.as_object(), layoutPath, ".frag");
-        resource.shaderSources.emplace(rhi::ShaderStage::FRAGMENT, source);
-        reflect(source, bindingMap);
-        deserializeBinding(frag.as_object(), rhi::ShaderStage::FRAGMENT, resource, bindingMap);
-    }
-    if (data.contains("compute")) {
-        const auto& comp = data.at("compute");
-        auto source = loadResource(comp.as_object(), layoutPath, ".comp");
-        resource.shaderSources.emplace(rhi::ShaderStage::COMPUTE, source);
-        reflect(source, bindingMap);
-        deserializeBinding(comp.as_object(), rhi::ShaderStage::COMPUTE, resource, bindingMap);
-    }
-    if (data.contains("mesh")) {
-        const auto& mesh = data.at("mesh");
-        auto source = loadResource(mesh.as_object(), layoutPath, ".mesh");
-        resource.shaderSources.emplace(rhi::ShaderStage::MESH, source);
-        reflect(source, bindingMap);
-        deserializeBinding(mesh.as_object(), rhi::ShaderStage::MESH, resource, bindingMap);
-    }
-    if (data.contains("task")) {
-        const auto& task = data.at("task");
-        auto source = loadResource(task.as_object(), layoutPath, ".task");
-        resource.shaderSources.emplace(rhi::ShaderStage::TASK, source);
+    for (const auto& layoutStage : LAYOUT_STAGES) {
+        const object* stageData{nullptr};
+        const std::filesystem::path* stagePath{&layoutPath};
+        if (data.contains(layoutStage.key)) {
+            stageData = &data.at(layoutStage.key).as_object();
+        } else if (baseStages.contains(layoutStage.key)) {
+            stageData = &baseRaw.as_object().at(layoutStage.key).as_object();
+            stagePath = &basePath;
+        }
+        if (!stageData) {
+            continue;
+        }
+        auto source = loadResource(*stageData, *stagePath, layoutStage.ext);
+        resource.shaderSources.emplace(layoutStage.stage, source);
         reflect(source, bindingMap);
-        deserializeBinding(task.as_object(), rhi::ShaderStage::TASK, resource, bindingMap);
+        deserializeBinding(*stageData, layoutStage.stage, resource, bindingMap);
     }
 
     return std::filesystem::path(pathID.c_str());
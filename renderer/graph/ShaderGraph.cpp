@@ -76,6 +76,11 @@ struct ShaderVisitor: public boost::dfs_visitor<>{
         }
 
         auto& resource = resources.at(name);
+        // mesh stage visibility is invalid without the extension, such layouts stay unused
+        if (!device->meshShaderSupported() &&
+            (resource.shaderSources.count(rhi::ShaderStage::MESH) || resource.shaderSources.count(rhi::ShaderStage::TASK))) {
+            return;
+        }
         //for(const auto& [idName, src] : resource.shaderSources) {
         //    std::string_view ext(&idName[idName.length() - 5], 5);
         //    auto stage  = str2ShaderStage.at(ext);
@@ -144,4 +149,8 @@ const ShaderResource& ShaderGraph::layout(std::string_view name) const {
     return _resources.at(name.data());
 }
 
+bool ShaderGraph::contains(std::string_view name) const {
+    return _resources.find(name) != _resources.end();
+}
+
 }
\ No newline at end of file
@@ -45,6 +45,7 @@ public:
 //    rhi::DescriptorSetLayoutInfo layoutInfo(std::string_view name, Rate rate);
 
     const ShaderResource& layout(std::string_view name) const;
+    bool contains(std::string_view name) const;
 
     void addCustomLayout(ShaderResource&& layout, std::string_view name);
 
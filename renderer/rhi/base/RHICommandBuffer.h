@@ -36,8 +36,22 @@ public:
 
     virtual void applyBarrier(DependencyFlags flags) = 0;
 
+    // split barrier: appended barriers are moved into the event and their src scope signals it,
+    // waitEvent then blocks their dst scope. Both must be recorded outside of a render pass.
+    virtual void setEvent(RHIEvent* event, DependencyFlags flags) = 0;
+    virtual void waitEvent(RHIEvent* event) = 0;
+
+    // queries are reset before being written again, reset/begin/end outside of a render pass.
+    virtual void resetQueryPool(RHIQueryPool* pool, uint32_t first, uint32_t count) = 0;
+    virtual void writeTimestamp(RHIQueryPool* pool, uint32_t index, PipelineStage stage) = 0;
+    virtual void beginQuery(RHIQueryPool* pool, uint32_t index) = 0;
+    virtual void endQuery(RHIQueryPool* pool, uint32_t index) = 0;
+
     virtual void onComplete(std::function<void()>&&) = 0;
 
+    // accumulated by render encoders since last reset
+    virtual const RenderEncoderStats& renderEncoderStats() const = 0;
+
 protected:
     explicit RHICommandBuffer(const CommandBufferInfo& info, RHIDevice* device) {}
 };
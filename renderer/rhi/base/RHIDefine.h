@@ -64,7 +64,10 @@ class RHIComputeEncoder;
 class RHIDescriptorPool;
 class RHICommandPool;
 class RHISparseImage;
+class RHIHeap;
+class RHIEvent;
 class RHISemaphore;
+class RHIQueryPool;
 
 using DevicePtr = std::shared_ptr<RHIDevice>;
 using SwapchainPtr = std::shared_ptr<RHISwapchain>;
@@ -88,6 +91,9 @@ using ComputeEncoderPtr = std::shared_ptr<RHIComputeEncoder>;
 using DescriptorPoolPtr = std::shared_ptr<RHIDescriptorPool>;
 using SparseImagePtr = std::shared_ptr<RHISparseImage>;
 using SemaphorePtr = std::shared_ptr<RHISemaphore>;
+using HeapPtr = std::shared_ptr<RHIHeap>;
+using EventPtr = std::shared_ptr<RHIEvent>;
+using QueryPoolPtr = std::shared_ptr<RHIQueryPool>;
 
 using DescriptorSetLayoutRef = std::weak_ptr<RHIDescriptorSetLayout>;
 using PipelineLayoutRef = std::weak_ptr<RHIPipelineLayout>;
@@ -99,6 +105,8 @@ static constexpr uint32_t BindingRateCount = 4;
 
 enum class API : unsigned char {
     VULKAN,
+    // records commands without a gpu, see rhi/null
+    NONE,
 };
 
 enum class Format : uint32_t {
@@ -258,6 +266,14 @@ struct SwapchainSurfaceInfo {
     uintptr_t windId;
 };
 
+// images without a surface, 4 byte texel formats only
+struct OffscreenSwapchainInfo {
+    uint32_t width{0};
+    uint32_t height{0};
+    Format format{Format::RGBA8_UNORM};
+    uint32_t imageCount{FRAMES_IN_FLIGHT};
+};
+
 enum class ShaderStage : uint32_t {
     NONE = 0,
     VERTEX = 1,
@@ -365,6 +381,18 @@ struct ImageInfo {
     std::vector<uint32_t> queueAccess{};
 };
 
+struct MemoryRequirement {
+    uint64_t size{0};
+    uint64_t alignment{1};
+    uint32_t memoryTypeBits{0};
+};
+
+// device local memory block, images placed at an offset may alias each other.
+struct HeapInfo {
+    uint64_t size{0};
+    uint32_t memoryTypeBits{0};
+};
+
 enum class AspectMask : uint32_t {
     COLOR = 1 << 0,
     DEPTH = 1 << 1,
@@ -913,6 +941,7 @@ struct BufferSourceInfo {
     BufferUsage bufferUsage{BufferUsage::UNIFORM};
     uint32_t size{0};
     std::vector<uint32_t> queueAccess{};
+    // optional, the buffer stays mapped for later host writes
     const void* data{nullptr};
 };
 
@@ -1037,11 +1066,17 @@ union ClearValue {
     ClearDepthStencil depthStencil;
 };
 
+enum class SubpassContents : uint8_t {
+    INLINE,
+    SECONDARY_COMMAND_BUFFERS,
+};
+
 struct RenderPassBeginInfo {
     RHIRenderPass* renderPass{nullptr};
     RHIFrameBuffer* frameBuffer{nullptr};
     Rect2D renderArea;
     ClearValue* clearColors;
+    SubpassContents contents{SubpassContents::INLINE};
 };
 
 struct ExecutionBarrier {
@@ -1084,6 +1119,10 @@ enum class CommandBuferUsageFlag : uint8_t {
 
 struct CommandBufferBeginInfo {
     CommandBuferUsageFlag flags{CommandBuferUsageFlag::ONE_TIME_SUBMIT};
+    // inheritance, secondary command buffer only
+    RHIRenderPass* renderPass{nullptr};
+    uint32_t subpass{0};
+    RHIFrameBuffer* frameBuffer{nullptr};
 };
 OPERABLE(CommandBuferUsageFlag)
 
@@ -1249,4 +1288,82 @@ enum class RenderEncoderHint : uint8_t {
 };
 OPERABLE(RenderEncoderHint)
 
+// binds that match current encoder state are skipped and counted.
+enum class QueryType : uint8_t {
+    TIMESTAMP,
+    PIPELINE_STATISTICS,
+};
+
+// declared in the order results are written per query
+enum class PipelineStatistic : uint32_t {
+    NONE = 0,
+    INPUT_ASSEMBLY_PRIMITIVES = 1,
+    VERTEX_SHADER_INVOCATIONS = 1 << 1,
+    CLIPPING_PRIMITIVES = 1 << 2,
+    FRAGMENT_SHADER_INVOCATIONS = 1 << 3,
+    COMPUTE_SHADER_INVOCATIONS = 1 << 4,
+};
+OPERABLE(PipelineStatistic)
+
+struct QueryPoolInfo {
+    QueryType type{QueryType::TIMESTAMP};
+    uint32_t count{0};
+    PipelineStatistic statistics{PipelineStatistic::NONE};
+};
+
+struct RenderEncoderStats {
+    uint32_t drawCalls{0};
+    uint32_t pipelineBinds{0};
+    uint32_t pipelineBindsSkipped{0};
+    uint32_t descriptorSetBinds{0};
+    uint32_t descriptorSetBindsSkipped{0};
+    uint32_t indexBufferBinds{0};
+    uint32_t indexBufferBindsSkipped{0};
+    uint32_t vertexBufferBinds{0};
+    uint32_t vertexBufferBindsSkipped{0};
+
+    RenderEncoderStats& operator+=(const RenderEncoderStats& rhs) {
+        drawCalls += rhs.drawCalls;
+        pipelineBinds += rhs.pipelineBinds;
+        pipelineBindsSkipped += rhs.pipelineBindsSkipped;
+        descriptorSetBinds += rhs.descriptorSetBinds;
+        descriptorSetBindsSkipped += rhs.descriptorSetBindsSkipped;
+        indexBufferBinds += rhs.indexBufferBinds;
+        indexBufferBindsSkipped += rhs.indexBufferBindsSkipped;
+        vertexBufferBinds += rhs.vertexBufferBinds;
+        vertexBufferBindsSkipped += rhs.vertexBufferBindsSkipped;
+        return *this;
+    }
+
+    RenderEncoderStats operator-(const RenderEncoderStats& rhs) const {
+        return {
+            drawCalls - rhs.drawCalls,
+            pipelineBinds - rhs.pipelineBinds,
+            pipelineBindsSkipped - rhs.pipelineBindsSkipped,
+            descriptorSetBinds - rhs.descriptorSetBinds,
+            descriptorSetBindsSkipped - rhs.descriptorSetBindsSkipped,
+            indexBufferBinds - rhs.indexBufferBinds,
+            indexBufferBindsSkipped - rhs.indexBufferBindsSkipped,
+            vertexBufferBinds - rhs.vertexBufferBinds,
+            vertexBufferBindsSkipped - rhs.vertexBufferBindsSkipped,
+        };
+    }
+};
+
+// commands a device has been handed by its queues, counted by backends recording on the cpu.
+struct SubmittedCommandStats {
+    uint32_t commands{0};
+    uint32_t draws{0};
+    uint32_t dispatches{0};
+    // pipelines, descriptor sets, index and vertex buffers
+    uint32_t binds{0};
+    // image, buffer and execution barriers
+    uint32_t barriers{0};
+    // pipeline barrier commands flushing them
+    uint32_t barrierBatches{0};
+    uint32_t copies{0};
+    // equal recordings of the same objects hash equal
+    uint64_t hash{0};
+};
+
 }; // namespace raum::rhi
\ No newline at end of file
@@ -4,14 +4,18 @@
 #include "RHIDescriptorPool.h"
 #include "RHIDescriptorSet.h"
 #include "RHIDescriptorSetLayout.h"
+#include "RHIEvent.h"
 #include "RHIFrameBuffer.h"
 #include "RHIGraphicsPipeline.h"
+#include "RHIHeap.h"
 #include "RHIImage.h"
 #include "RHIImageView.h"
 #include "RHIPipelineLayout.h"
+#include "RHIQueryPool.h"
 #include "RHIQueue.h"
 #include "RHIRenderPass.h"
 #include "RHISampler.h"
+#include "RHISemaphore.h"
 #include "RHIShader.h"
 #include "RHISwapchain.h"
 #include "RHISparseImage.h"
@@ -26,6 +30,12 @@ public:
     virtual RHIBuffer* createBuffer(const BufferSourceInfo&) = 0;
     virtual RHIBufferView* createBufferView(const BufferViewInfo&) = 0;
     virtual RHIImage* createImage(const ImageInfo&) = 0;
+    // placed image, memory is owned by heap
+    virtual RHIImage* createImage(const ImageInfo&, RHIHeap* heap, uint64_t offset) = 0;
+    virtual RHIHeap* createHeap(const HeapInfo&) = 0;
+    virtual RHIEvent* createEvent() = 0;
+    virtual RHISemaphore* createSemaphore() = 0;
+    virtual RHIQueryPool* createQueryPool(const QueryPoolInfo&) = 0;
     virtual RHIImageView* createImageView(const ImageViewInfo&) = 0;
     virtual RHIShader* createShader(const ShaderBinaryInfo&) = 0;
     virtual RHIShader* createShader(const ShaderSourceInfo&) = 0;
@@ -39,6 +49,7 @@ public:
     virtual RHIFrameBuffer* createFrameBuffer(const FrameBufferInfo&) = 0;
     virtual RHISparseImage* createSparseImage(const SparseImageInfo&) = 0;
 
+    // valid until the queue of `queueIndex` submits FRAMES_IN_FLIGHT more frames
     virtual StagingBufferInfo allocateStagingBuffer(uint32_t size, uint8_t queueIndex) = 0;
 
     // internal holds
@@ -49,8 +60,22 @@ public:
     virtual void waitQueueIdle(RHIQueue*) = 0;
 
     virtual void* instance() { return nullptr; }
+    virtual API api() const = 0;
+
+    // nanoseconds per timestamp tick
+    virtual float timestampPeriod() = 0;
+    virtual bool pipelineStatisticsSupported() = 0;
+    // multi draw indirect with gpu written draw counts and first instances
+    virtual bool drawIndirectCountSupported() = 0;
+    // task and mesh shader stages with indirect mesh task draws
+    virtual bool meshShaderSupported() = 0;
+
+    // commands submitted since the last reset, false if the backend doesn't count them
+    virtual bool submittedCommandStats(SubmittedCommandStats&) const { return false; }
+    virtual void resetSubmittedCommandStats() {}
 
     virtual SparseBindingRequirement sparseBindingRequirement(RHIImage* image) = 0;
+    virtual MemoryRequirement memoryRequirement(const ImageInfo& info) = 0;
 
 protected:
     virtual ~RHIDevice() = 0;
@@ -0,0 +1,16 @@
+#pragma once
+#include "RHIDefine.h"
+#include "RHIResource.h"
+namespace raum::rhi {
+class RHIDevice;
+// split barrier, signaled after the producer and waited right before the consumer.
+class RHIEvent : public RHIResource {
+public:
+    explicit RHIEvent(RHIDevice*) {}
+
+    virtual ~RHIEvent() = 0;
+};
+
+inline RHIEvent::~RHIEvent() {}
+
+} // namespace raum::rhi
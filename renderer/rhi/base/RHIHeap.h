@@ -0,0 +1,19 @@
+#pragma once
+#include "RHIDefine.h"
+#include "RHIResource.h"
+namespace raum::rhi {
+class RHIDevice;
+class RHIHeap : public RHIResource {
+public:
+    explicit RHIHeap(const HeapInfo& info, RHIDevice*) : _info(info) {}
+    const HeapInfo& info() const { return _info; }
+
+    virtual ~RHIHeap() = 0;
+
+protected:
+    const HeapInfo _info;
+};
+
+inline RHIHeap::~RHIHeap() {}
+
+} // namespace raum::rhi
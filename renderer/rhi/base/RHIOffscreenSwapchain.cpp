@@ -0,0 +1,145 @@
+#include "RHIOffscreenSwapchain.h"
+#include <algorithm>
+#include <cstring>
+#include "RHIBlitEncoder.h"
+#include "RHIBuffer.h"
+#include "RHICommandBuffer.h"
+#include "RHICommandPool.h"
+#include "RHIDevice.h"
+#include "RHIImage.h"
+#include "RHIQueue.h"
+#include "core/utils/log.h"
+
+namespace raum::rhi {
+
+namespace {
+
+constexpr uint32_t TEXEL_SIZE{4};
+
+bool texelSizeMatches(Format format) {
+    switch (format) {
+        case Format::RGBA8_UNORM:
+        case Format::RGBA8_SNORM:
+        case Format::RGBA8_UINT:
+        case Format::RGBA8_SINT:
+        case Format::RGBA8_SRGB:
+        case Format::BGRA8_UNORM:
+        case Format::BGRA8_SNORM:
+        case Format::BGRA8_UINT:
+        case Format::BGRA8_SINT:
+        case Format::BGRA8_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+RHIOffscreenSwapchain::RHIOffscreenSwapchain(const OffscreenSwapchainInfo& info, RHIDevice* device)
+: RHISwapchain(info, device), _info(info), _device(device) {
+    raum_check(texelSizeMatches(info.format), "offscreen swapchain supports 4 byte texel formats only");
+    raum_check(info.imageCount > 0, "offscreen swapchain without images");
+    _images.resize(info.imageCount, nullptr);
+}
+
+bool RHIOffscreenSwapchain::acquire() {
+    _imageIndex = (_imageIndex + 1) % _info.imageCount;
+    return true;
+}
+
+void RHIOffscreenSwapchain::resize(uint32_t w, uint32_t h) {
+    if (w == _info.width && h == _info.height) {
+        return;
+    }
+    _info.width = w;
+    _info.height = h;
+    // reallocated by the resource graph on next mount
+    std::fill(_images.begin(), _images.end(), nullptr);
+}
+
+void RHIOffscreenSwapchain::resize(uint32_t w, uint32_t h, uintptr_t) {
+    resize(w, h);
+}
+
+RHIImage* RHIOffscreenSwapchain::allocateImage(uint32_t index) {
+    ImageInfo imageInfo{};
+    imageInfo.type = ImageType::IMAGE_2D;
+    imageInfo.format = _info.format;
+    imageInfo.usage = ImageUsage::COLOR_ATTACHMENT | ImageUsage::TRANSFER_SRC | ImageUsage::TRANSFER_DST;
+    imageInfo.initialLayout = ImageLayout::UNDEFINED;
+    imageInfo.sliceCount = 1;
+    imageInfo.mipCount = 1;
+    imageInfo.sampleCount = 1;
+    imageInfo.extent = {_info.width, _info.height, 1};
+    _images[index] = _device->createImage(imageInfo);
+    return _images[index];
+}
+
+bool RHIOffscreenSwapchain::holds(RHIImage* img) {
+    return std::find(_images.begin(), _images.end(), img) != _images.end();
+}
+
+bool RHIOffscreenSwapchain::readback(std::vector<uint8_t>& texels) {
+    auto* image = _images[_imageIndex];
+    if (!image) {
+        raum_warn("offscreen image {} was never rendered to", _imageIndex);
+        return false;
+    }
+
+    auto size = _info.width * _info.height * TEXEL_SIZE;
+    auto buffer = BufferPtr(_device->createBuffer(BufferSourceInfo{
+        .bufferUsage = BufferUsage::TRANSFER_DST,
+        .size = size,
+    }));
+
+    auto* queue = _device->getQueue({QueueType::GRAPHICS});
+    auto commandPool = CommandPoolPtr(_device->createCoomandPool({queue->index()}));
+    auto commandBuffer = CommandBufferPtr(commandPool->makeCommandBuffer({}));
+    commandBuffer->enqueue(queue);
+    commandBuffer->begin({});
+
+    // writes of earlier submissions become visible to the copy
+    commandBuffer->appendImageBarrier({
+        .image = image,
+        .srcStage = PipelineStage::COLOR_ATTACHMENT_OUTPUT | PipelineStage::TRANSFER,
+        .dstStage = PipelineStage::TRANSFER,
+        .oldLayout = ImageLayout::TRANSFER_SRC_OPTIMAL,
+        .newLayout = ImageLayout::TRANSFER_SRC_OPTIMAL,
+        .srcAccessFlag = AccessFlags::COLOR_ATTACHMENT_WRITE | AccessFlags::TRANSFER_WRITE,
+        .dstAccessFlag = AccessFlags::TRANSFER_READ,
+        .range = {
+            .aspect = AspectMask::COLOR,
+            .sliceCount = 1,
+            .mipCount = 1,
+        },
+    });
+    commandBuffer->applyBarrier(DependencyFlags::BY_REGION);
+
+    BufferImageCopyRegion region{
+        .bufferSize = size,
+        .imageExtent = {_info.width, _info.height, 1},
+    };
+    auto blitEncoder = BlitEncoderPtr(commandBuffer->makeBlitEncoder());
+    blitEncoder->copyImageToBuffer(image, ImageLayout::TRANSFER_SRC_OPTIMAL, buffer.get(), &region, 1);
+    blitEncoder.reset();
+
+    commandBuffer->appendBufferBarrier({
+        .buffer = buffer.get(),
+        .srcStage = PipelineStage::TRANSFER,
+        .dstStage = PipelineStage::HOST,
+        .srcAccessFlag = AccessFlags::TRANSFER_WRITE,
+        .dstAccessFlag = AccessFlags::HOST_READ,
+    });
+    commandBuffer->applyBarrier(DependencyFlags::BY_REGION);
+    commandBuffer->commit();
+    queue->submit(false);
+    // submit only waits for older frames
+    _device->waitQueueIdle(queue);
+
+    texels.resize(size);
+    std::memcpy(texels.data(), buffer->mappedData(), size);
+    return true;
+}
+
+} // namespace raum::rhi
@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+#include "RHISwapchain.h"
+namespace raum::rhi {
+class RHIDevice;
+
+// swapchain over plain images for rendering without a window. acquire and present only rotate the images,
+// the render graph leaves the presented one in TRANSFER_SRC_OPTIMAL so it can be read back.
+class RHIOffscreenSwapchain final : public RHISwapchain {
+public:
+    explicit RHIOffscreenSwapchain(const OffscreenSwapchainInfo& info, RHIDevice* device);
+    ~RHIOffscreenSwapchain() override {}
+
+    bool acquire() override;
+    void present() override {}
+
+    uint32_t imageCount() const override { return _info.imageCount; }
+    uint32_t imageIndex() const override { return _imageIndex; }
+    uint32_t width() const override { return _info.width; }
+    uint32_t height() const override { return _info.height; }
+    Format format() const override { return _info.format; }
+    void resize(uint32_t w, uint32_t h) override;
+    void resize(uint32_t w, uint32_t h, uintptr_t surface) override;
+
+    RHIImage* allocateImage(uint32_t index) override;
+    bool imageValid(uint32_t index) override { return _images[index] != nullptr; }
+    bool holds(RHIImage* img) override;
+    // nothing to wait for or to signal
+    void addWaitBeforePresent(RHISemaphore*) override {}
+    RHISemaphore* getAvailableByAcquire() override { return nullptr; }
+    ImageLayout presentLayout() const override { return ImageLayout::TRANSFER_SRC_OPTIMAL; }
+
+    // tightly packed texels of the last presented image, submits to the graphics queue and waits for it.
+    bool readback(std::vector<uint8_t>& texels);
+
+private:
+    OffscreenSwapchainInfo _info;
+    RHIDevice* _device{nullptr};
+    uint32_t _imageIndex{0};
+    // owned by the resource graph the swapchain is imported into
+    std::vector<RHIImage*> _images;
+};
+
+} // namespace raum::rhi
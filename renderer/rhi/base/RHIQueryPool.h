@@ -0,0 +1,21 @@
+#pragma once
+#include "RHIDefine.h"
+#include "RHIResource.h"
+namespace raum::rhi {
+class RHIDevice;
+class RHIQueryPool : public RHIResource {
+public:
+    explicit RHIQueryPool(const QueryPoolInfo&, RHIDevice*) {}
+
+    virtual const QueryPoolInfo& info() const = 0;
+
+    // never waits, false when any query in range hasn't landed yet. A timestamp query writes one value,
+    // a statistics query one value per enabled statistic.
+    virtual bool getResults(uint32_t first, uint32_t count, uint64_t* results) = 0;
+
+    virtual ~RHIQueryPool() = 0;
+};
+
+inline RHIQueryPool::~RHIQueryPool() {}
+
+} // namespace raum::rhi
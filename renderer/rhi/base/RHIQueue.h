@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include "RHIDefine.h"
 #include "RHIResource.h"
 
@@ -8,12 +9,22 @@ class RHICommandBuffer;
 
 class RHIQueue: public RHIResource  {
 public:
+    // ends the frame: submits like flush and moves to the next frame slot, blocking only until the frame that
+    // used the slot before is done on the gpu. Complete handlers of that slot run then.
     virtual void submit(bool signal) = 0;
+    // submit enqueued command buffers and pending waits without waiting for completion,
+    // `signal` is signaled when they're done. Later submits on this queue are not blocked by it.
+    virtual void flush(RHISemaphore* signal) = 0;
+    // ends the frame of a queue that is only flushed, moves to the next frame slot like submit without submitting.
+    // Once per frame.
+    virtual void endFrame() = 0;
     virtual void enqueue(RHICommandBuffer*) = 0;
     virtual uint32_t index() const = 0;
     virtual void addWait(RHISemaphore* sem) = 0;
     virtual RHISemaphore* getSignal() = 0;
     virtual void bindSparse(const SparseBindingInfo& info, SparseType type) = 0;
+    // runs once the gpu is done with the current frame slot, e.g. to release resources frames in flight read.
+    virtual void addCompleteHandler(std::function<void()>&& func) = 0;
 
 protected:
     virtual ~RHIQueue() = 0;
@@ -7,6 +7,7 @@ class RHIGraphicsPipeline;
 class RHIDescriptorSet;
 class RHIBuffer;
 class RHIPipelineLayout;
+class RHICommandBuffer;
 class RHIRenderEncoder {
 public:
     virtual ~RHIRenderEncoder() = 0;
@@ -31,7 +32,18 @@ public:
     virtual void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t vertexOffset, uint32_t firstInstance) = 0;
     virtual void drawIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) = 0;
     virtual void drawIndexedIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) = 0;
+    // draw count is read from `countBuffer` at `countOffset`, clamped to `maxDrawCount`
+    virtual void drawIndexedIndirectCount(RHIBuffer* indirectBuffer,
+                                          uint32_t offset,
+                                          RHIBuffer* countBuffer,
+                                          uint32_t countOffset,
+                                          uint32_t maxDrawCount,
+                                          uint32_t stride) = 0;
+    // one x, y, z workgroup count per draw, needs RHIDevice::meshShaderSupported
+    virtual void drawMeshTasksIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) = 0;
     virtual void pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) = 0;
+    // render pass should begin with SubpassContents::SECONDARY_COMMAND_BUFFERS
+    virtual void executeCommands(RHICommandBuffer** commandBuffers, uint32_t count) = 0;
 
     virtual void clearAttachment(uint32_t* attachmentIndices, uint32_t attachmentNum, ClearValue* clearValues, ClearRect* rects, uint32_t recNum) = 0;
 };
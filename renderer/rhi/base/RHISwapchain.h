@@ -8,6 +8,7 @@ class RHISwapchain : public RHIResource {
 public:
     explicit RHISwapchain(const SwapchainInfo&, RHIDevice*) {};
     explicit RHISwapchain(const SwapchainSurfaceInfo&, RHIDevice*) {};
+    explicit RHISwapchain(const OffscreenSwapchainInfo&, RHIDevice*) {};
 
     virtual bool acquire() = 0;
     virtual void present() = 0;
@@ -25,6 +26,8 @@ public:
     virtual bool holds(RHIImage* img) = 0;
     virtual void addWaitBeforePresent(RHISemaphore* sem) = 0;
     virtual RHISemaphore* getAvailableByAcquire() = 0;
+    // layout the render graph leaves the image in after the last pass of a frame
+    virtual ImageLayout presentLayout() const { return ImageLayout::PRESENT; }
     virtual ~RHISwapchain() = 0;
 };
 
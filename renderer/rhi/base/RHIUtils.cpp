@@ -1,5 +1,6 @@
 #include "RHIUtils.h"
 #include <boost/functional/hash.hpp>
+#include <map>
 #include <unordered_set>
 #include "RHIBlitEncoder.h"
 #include "RHIBufferView.h"
@@ -681,4 +682,123 @@ void generateMipmaps(ImagePtr image, ImageLayout oldLayout, CommandBufferPtr cmd
     }
 }
 
+// bytes per texel, per block of compressed formats
+const std::map<Format, uint32_t> formatSizes = {
+    {Format::UNKNOWN, 0},
+    //{Format::A8_UNORM, 1},
+    {Format::R8_UNORM, 1},
+    {Format::R8_SNORM, 1},
+    {Format::R8_UINT, 1},
+    {Format::R8_SINT, 1},
+    {Format::R8_SRGB, 1},
+    {Format::RG8_UNORM, 2},
+    {Format::RG8_SNORM, 2},
+    {Format::RG8_UINT, 2},
+    {Format::RG8_SINT, 2},
+    {Format::RG8_SRGB, 2},
+    {Format::RGB8_UNORM, 3},
+    {Format::RGB8_SNORM, 3},
+    {Format::RGB8_UINT, 3},
+    {Format::RGB8_SINT, 3},
+    {Format::RGB8_SRGB, 3},
+    {Format::BGR8_UNORM, 3},
+    {Format::BGR8_SNORM, 3},
+    {Format::BGR8_UINT, 3},
+    {Format::BGR8_SINT, 3},
+    {Format::BGR8_SRGB, 3},
+    {Format::RGBA8_UNORM, 4},
+    {Format::RGBA8_SNORM, 4},
+    {Format::RGBA8_UINT, 4},
+    {Format::RGBA8_SINT, 4},
+    {Format::RGBA8_SRGB, 4},
+    {Format::BGRA8_UNORM, 4},
+    {Format::BGRA8_SNORM, 4},
+    {Format::BGRA8_UINT, 4},
+    {Format::BGRA8_SINT, 4},
+    {Format::BGRA8_SRGB, 4},
+    {Format::R16_UNORM, 2},
+    {Format::R16_SNORM, 2},
+    {Format::R16_UINT, 2},
+    {Format::R16_SINT, 2},
+    {Format::R16_SFLOAT, 2},
+    {Format::RG16_UNORM, 4},
+    {Format::RG16_SNORM, 4},
+    {Format::RG16_UINT, 4},
+    {Format::RG16_SINT, 4},
+    {Format::RG16_SFLOAT, 4},
+    {Format::RGB16_UNORM, 6},
+    {Format::RGB16_SNORM, 6},
+    {Format::RGB16_UINT, 6},
+    {Format::RGB16_SINT, 6},
+    {Format::RGB16_SFLOAT, 6},
+    {Format::RGBA16_UNORM, 8},
+    {Format::RGBA16_SNORM, 8},
+    {Format::RGBA16_UINT, 8},
+    {Format::RGBA16_SINT, 8},
+    {Format::RGBA16_SFLOAT, 8},
+    {Format::R32_UINT, 4},
+    {Format::R32_SINT, 4},
+    {Format::R32_SFLOAT, 4},
+    {Format::RG32_UINT, 8},
+    {Format::RG32_SINT, 8},
+    {Format::RG32_SFLOAT, 8},
+    {Format::RGB32_UINT, 12},
+    {Format::RGB32_SINT, 12},
+    {Format::RGB32_SFLOAT, 12},
+    {Format::RGBA32_UINT, 16},
+    {Format::RGBA32_SINT, 16},
+    {Format::RGBA32_SFLOAT, 16},
+    {Format::R64_UINT, 8},
+    {Format::R64_SINT, 8},
+    {Format::R64_SFLOAT, 8},
+    {Format::RG64_UINT, 16},
+    {Format::RG64_SINT, 16},
+    {Format::RG64_SFLOAT, 16},
+    {Format::RGB64_UINT, 24},
+    {Format::RGB64_SINT, 24},
+    {Format::RGB64_SFLOAT, 24},
+    {Format::RGBA64_UINT, 32},
+    {Format::RGBA64_SINT, 32},
+    {Format::RGBA64_SFLOAT, 32},
+    {Format::D16_UNORM, 2},
+    {Format::X8_D24_UNORM_PACK32, 4},
+    {Format::D32_SFLOAT, 4},
+    {Format::S8_UINT, 1},
+    {Format::D24_UNORM_S8_UINT, 4},
+    {Format::D32_SFLOAT_S8_UINT, 8},
+    {Format::BC1_RGB_UNORM, 8},
+    {Format::BC1_RGB_SRGB, 8},
+    {Format::BC1_RGBA_UNORM, 8},
+    {Format::BC1_RGBA_SRGB, 8},
+    {Format::BC2_UNORM, 16},
+    {Format::BC2_SRGB, 16},
+    {Format::BC3_UNORM, 16},
+    {Format::BC3_SRGB, 16},
+    {Format::BC4_UNORM, 8},
+    {Format::BC4_SNORM, 8},
+    {Format::BC5_UNORM, 16},
+    {Format::BC5_SNORM, 16},
+    {Format::BC6H_UFLOAT, 16},
+    {Format::BC6H_SFLOAT, 16},
+    {Format::BC7_UNORM, 16},
+    {Format::BC7_SRGB, 16},
+    {Format::ETC2_RGB8_UNORM, 8},
+    {Format::ETC2_RGB8_SRGB, 8},
+    {Format::ETC2_RGB8A1_UNORM, 8},
+    {Format::ETC2_RGB8A1_SRGB, 8},
+    {Format::ETC2_RGBA8_UNORM, 16},
+    {Format::ETC2_RGBA8_SRGB, 16},
+    {Format::ASTC_4x4_UNORM, 16},
+    {Format::ASTC_4x4_SRGB, 16},
+    {Format::ASTC_5x4_UNORM, 16},
+    {Format::ASTC_5x4_SRGB, 16},
+    {Format::ASTC_5x5_UNORM, 16},
+    {Format::ASTC_5x5_SRGB, 16},
+    {Format::ASTC_6x5_UNORM, 16},
+};
+
+uint32_t getFormatSize(Format format) {
+    return formatSizes.at(format);
+}
+
 } // namespace raum::rhi
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "NullCommandBuffer.h"
+#include "NullDevice.h"
+#include "NullEncoder.h"
+#include "NullQueue.h"
+#include "NullResource.h"
+#include "RHIQueryPool.h"
+
+namespace raum::rhi::null {
+
+CommandBuffer::CommandBuffer(const CommandBufferInfo& info, RHIDevice* device)
+: RHICommandBuffer(info, device),
+  _device(static_cast<Device*>(device)),
+  _info(info) {
+}
+
+RHIRenderEncoder* CommandBuffer::makeRenderEncoder(RenderEncoderHint) {
+    return new RenderEncoder(this);
+}
+
+RHIRenderEncoder* CommandBuffer::makeRenderEncoder() {
+    return new RenderEncoder(this);
+}
+
+RHIBlitEncoder* CommandBuffer::makeBlitEncoder() {
+    return new BlitEncoder(this);
+}
+
+RHIComputeEncoder* CommandBuffer::makeComputeEncoder() {
+    return new ComputeEncoder(this);
+}
+
+void CommandBuffer::begin(const CommandBufferBeginInfo& info) {
+    // implicit reset of the recording, like vkBeginCommandBuffer on a resettable pool
+    _stream.clear();
+    _stream.record(CommandType::BEGIN, _info.type, info.flags, info.renderPass, info.subpass, info.frameBuffer);
+}
+
+void CommandBuffer::enqueue(RHIQueue* queue) {
+    queue->enqueue(this);
+    _queue = static_cast<Queue*>(queue);
+}
+
+void CommandBuffer::reset() {
+    _stream.clear();
+    _renderEncoderStats = {};
+}
+
+void CommandBuffer::appendImageBarrier(const ImageBarrierInfo& info) {
+    _imageBarriers.emplace_back(info);
+}
+
+void CommandBuffer::appendBufferBarrier(const BufferBarrierInfo& info) {
+    _bufferBarriers.emplace_back(info);
+}
+
+void CommandBuffer::appendExecutionBarrier(const ExecutionBarrier& info) {
+    _executionBarriers.emplace_back(info);
+}
+
+void CommandBuffer::recordBarriers(const std::vector<ImageBarrierInfo>& imageBarriers,
+                                   const std::vector<BufferBarrierInfo>& bufferBarriers,
+                                   const std::vector<ExecutionBarrier>& executionBarriers) {
+    for (const auto& barrier : imageBarriers) {
+        _stream.record(CommandType::IMAGE_BARRIER,
+                       barrier.image,
+                       barrier.srcStage,
+                       barrier.dstStage,
+                       barrier.oldLayout,
+                       barrier.newLayout,
+                       barrier.srcAccessFlag,
+                       barrier.dstAccessFlag,
+                       barrier.srcQueueIndex,
+                       barrier.dstQueueIndex,
+                       barrier.range);
+    }
+    for (const auto& barrier : bufferBarriers) {
+        _stream.record(CommandType::BUFFER_BARRIER,
+                       barrier.buffer,
+                       barrier.srcStage,
+                       barrier.dstStage,
+                       barrier.srcAccessFlag,
+                       barrier.dstAccessFlag,
+                       barrier.srcQueueIndex,
+                       barrier.dstQueueIndex,
+                       barrier.offset,
+                       barrier.size);
+    }
+    for (const auto& barrier : executionBarriers) {
+        _stream.record(CommandType::EXECUTION_BARRIER,
+                       barrier.srcStage,
+                       barrier.dstStage,
+                       barrier.srcAccessFlag,
+                       barrier.dstAccessFlag);
+    }
+}
+
+void CommandBuffer::applyBarrier(DependencyFlags flags) {
+    if (!_bufferBarriers.empty() || !_imageBarriers.empty() || !_executionBarriers.empty()) {
+        recordBarriers(_imageBarriers, _bufferBarriers, _executionBarriers);
+        _stream.record(CommandType::PIPELINE_BARRIER,
+                       flags,
+                       static_cast<uint32_t>(_imageBarriers.size()),
+                       static_cast<uint32_t>(_bufferBarriers.size()),
+                       static_cast<uint32_t>(_executionBarriers.size()));
+    }
+    _bufferBarriers.clear();
+    _imageBarriers.clear();
+    _executionBarriers.clear();
+}
+
+void CommandBuffer::setEvent(RHIEvent* event, DependencyFlags flags) {
+    auto* nullEvent = static_cast<Event*>(event);
+    std::swap(nullEvent->_imageBarriers, _imageBarriers);
+    std::swap(nullEvent->_bufferBarriers, _bufferBarriers);
+    std::swap(nullEvent->_executionBarriers, _executionBarriers);
+    nullEvent->_flags = flags;
+    _imageBarriers.clear();
+    _bufferBarriers.clear();
+    _executionBarriers.clear();
+    _stream.record(CommandType::SET_EVENT,
+                   event,
+                   flags,
+                   static_cast<uint32_t>(nullEvent->_imageBarriers.size()),
+                   static_cast<uint32_t>(nullEvent->_bufferBarriers.size()),
+                   static_cast<uint32_t>(nullEvent->_executionBarriers.size()));
+}
+
+void CommandBuffer::waitEvent(RHIEvent* event) {
+    // the moved barriers take effect here, so they're recorded in front of the wait
+    auto* nullEvent = static_cast<Event*>(event);
+    recordBarriers(nullEvent->_imageBarriers, nullEvent->_bufferBarriers, nullEvent->_executionBarriers);
+    _stream.record(CommandType::WAIT_EVENT, event, nullEvent->_flags);
+}
+
+void CommandBuffer::resetQueryPool(RHIQueryPool* pool, uint32_t first, uint32_t count) {
+    _stream.record(CommandType::RESET_QUERY_POOL, pool, first, count);
+}
+
+void CommandBuffer::writeTimestamp(RHIQueryPool* pool, uint32_t index, PipelineStage stage) {
+    _stream.record(CommandType::WRITE_TIMESTAMP, pool, index, stage);
+}
+
+void CommandBuffer::beginQuery(RHIQueryPool* pool, uint32_t index) {
+    _stream.record(CommandType::BEGIN_QUERY, pool, index);
+}
+
+void CommandBuffer::endQuery(RHIQueryPool* pool, uint32_t index) {
+    _stream.record(CommandType::END_QUERY, pool, index);
+}
+
+void CommandBuffer::onComplete(std::function<void()>&& func) {
+    _queue->addCompleteHandler(std::forward<std::function<void()>>(func));
+}
+
+RHICommandBuffer* CommandPool::makeCommandBuffer(const CommandBufferInfo& info) {
+    return new CommandBuffer(info, _device);
+}
+
+} // namespace raum::rhi::null
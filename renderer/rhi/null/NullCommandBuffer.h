@@ -0,0 +1,69 @@
+#pragma once
+#include "NullCommandStream.h"
+#include "RHICommandBuffer.h"
+#include "RHICommandPool.h"
+
+namespace raum::rhi::null {
+class Device;
+class Queue;
+
+class CommandBuffer : public RHICommandBuffer {
+public:
+    explicit CommandBuffer(const CommandBufferInfo& info, RHIDevice* device);
+    ~CommandBuffer() override {}
+
+    RHIRenderEncoder* makeRenderEncoder(RenderEncoderHint hint) override;
+    RHIRenderEncoder* makeRenderEncoder() override;
+    RHIBlitEncoder* makeBlitEncoder() override;
+    RHIComputeEncoder* makeComputeEncoder() override;
+    void begin(const CommandBufferBeginInfo& info) override;
+    void enqueue(RHIQueue*) override;
+    void commit() override {}
+    void reset() override;
+    void appendImageBarrier(const ImageBarrierInfo& info) override;
+    void appendBufferBarrier(const BufferBarrierInfo& info) override;
+    void appendExecutionBarrier(const ExecutionBarrier& info) override;
+    void applyBarrier(DependencyFlags flags) override;
+    void setEvent(RHIEvent* event, DependencyFlags flags) override;
+    void waitEvent(RHIEvent* event) override;
+    void resetQueryPool(RHIQueryPool* pool, uint32_t first, uint32_t count) override;
+    void writeTimestamp(RHIQueryPool* pool, uint32_t index, PipelineStage stage) override;
+    void beginQuery(RHIQueryPool* pool, uint32_t index) override;
+    void endQuery(RHIQueryPool* pool, uint32_t index) override;
+    void onComplete(std::function<void()>&&) override;
+    const RenderEncoderStats& renderEncoderStats() const override { return _renderEncoderStats; }
+
+    RenderEncoderStats& renderEncoderStats() { return _renderEncoderStats; }
+
+    // commands since the last begin or reset
+    const CommandStream& stream() const { return _stream; }
+    CommandStream& stream() { return _stream; }
+
+    Device* device() const { return _device; }
+
+private:
+    void recordBarriers(const std::vector<ImageBarrierInfo>& imageBarriers,
+                        const std::vector<BufferBarrierInfo>& bufferBarriers,
+                        const std::vector<ExecutionBarrier>& executionBarriers);
+
+    Device* _device{nullptr};
+    Queue* _queue{nullptr};
+    CommandBufferInfo _info;
+    std::vector<ImageBarrierInfo> _imageBarriers;
+    std::vector<BufferBarrierInfo> _bufferBarriers;
+    std::vector<ExecutionBarrier> _executionBarriers;
+    RenderEncoderStats _renderEncoderStats{};
+    CommandStream _stream;
+};
+
+class CommandPool : public RHICommandPool {
+public:
+    explicit CommandPool(const CommandPoolInfo& info, RHIDevice* device) : RHICommandPool(info, device), _device(device) {}
+
+    RHICommandBuffer* makeCommandBuffer(const CommandBufferInfo& info) override;
+
+private:
+    RHIDevice* _device{nullptr};
+};
+
+} // namespace raum::rhi::null
@@ -0,0 +1,244 @@
+#include "NullCommandStream.h"
+#include <algorithm>
+#include <cstring>
+#include "core/utils/log.h"
+
+namespace raum::rhi::null {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET{14695981039346656037ull};
+constexpr uint64_t FNV_PRIME{1099511628211ull};
+
+constexpr std::array<std::string_view, static_cast<size_t>(CommandType::COUNT)> COMMAND_NAMES = {
+    "begin",
+    "image_barrier",
+    "buffer_barrier",
+    "execution_barrier",
+    "pipeline_barrier",
+    "set_event",
+    "wait_event",
+    "reset_query_pool",
+    "write_timestamp",
+    "begin_query",
+    "end_query",
+    "begin_render_pass",
+    "next_subpass",
+    "end_render_pass",
+    "bind_graphics_pipeline",
+    "set_viewport",
+    "set_scissor",
+    "set_line_width",
+    "set_depth_bias",
+    "set_blend_constant",
+    "set_depth_bounds",
+    "set_stencil_compare_mask",
+    "set_stencil_reference",
+    "bind_index_buffer",
+    "bind_vertex_buffer",
+    "draw",
+    "draw_indexed",
+    "draw_indirect",
+    "draw_indexed_indirect",
+    "draw_indexed_indirect_count",
+    "draw_mesh_tasks_indirect",
+    "execute_commands",
+    "clear_attachment",
+    "bind_compute_pipeline",
+    "dispatch",
+    "dispatch_indirect",
+    "bind_descriptor_set",
+    "push_constants",
+    "copy_buffer_to_buffer",
+    "copy_image_to_image",
+    "blit_image",
+    "copy_buffer_to_image",
+    "copy_image_to_buffer",
+    "update_buffer",
+    "fill_buffer",
+    "clear_color_image",
+    "clear_depth_stencil_image",
+    "resolve_image",
+};
+
+CommandType headerType(uint32_t header) {
+    return static_cast<CommandType>(header & 0xFF);
+}
+
+uint32_t headerPayload(uint32_t header) {
+    return header >> 8;
+}
+
+} // namespace
+
+std::string_view commandName(CommandType type) {
+    return type < CommandType::COUNT ? COMMAND_NAMES[static_cast<size_t>(type)] : "unknown";
+}
+
+void CommandStream::write(const Bytes& bytes) {
+    _words.emplace_back(bytes.size);
+    auto offset = _words.size();
+    _words.resize(offset + (bytes.size + 3) / 4, 0);
+    if (bytes.size) {
+        std::memcpy(_words.data() + offset, bytes.data, bytes.size);
+    }
+}
+
+void CommandStream::write(const Vec3u& v) {
+    _words.insert(_words.end(), {v.x, v.y, v.z});
+}
+
+void CommandStream::write(const Rect2D& rect) {
+    write(rect.x);
+    write(rect.y);
+    write(rect.w);
+    write(rect.h);
+}
+
+void CommandStream::write(const ImageSubresourceRange& range) {
+    write(range.aspect);
+    write(range.firstSlice);
+    write(range.sliceCount);
+    write(range.firstMip);
+    write(range.mipCount);
+}
+
+void CommandStream::write(const ClearValue& value) {
+    // depth stencil values overlap the first two words
+    _words.insert(_words.end(), std::begin(value.color.clearColorU), std::end(value.color.clearColorU));
+}
+
+void CommandStream::write(const ClearRect& rect) {
+    write(rect.x);
+    write(rect.y);
+    write(rect.width);
+    write(rect.height);
+    write(rect.firstSlice);
+    write(rect.sliceCount);
+}
+
+void CommandStream::write(const BufferCopyRegion& region) {
+    write(region.srcOffset);
+    write(region.dstOffset);
+    write(region.size);
+}
+
+void CommandStream::write(const ImageCopyRegion& region) {
+    write(region.srcImageAspect);
+    write(region.dstImageAspect);
+    write(region.srcOffset);
+    write(region.dstOffset);
+    write(region.extent);
+    write(region.srcBaseMip);
+    write(region.srcFirstSlice);
+    write(region.dstBaseMip);
+    write(region.dstFirstSlice);
+    write(region.sliceCount);
+}
+
+void CommandStream::write(const ImageBlit& region) {
+    write(region.srcImageAspect);
+    write(region.dstImageAspect);
+    write(region.srcOffset);
+    write(region.dstOffset);
+    write(region.srcBaseMip);
+    write(region.srcFirstSlice);
+    write(region.dstBaseMip);
+    write(region.dstFirstSlice);
+    write(region.sliceCount);
+    write(region.srcExtent);
+    write(region.dstExtent);
+}
+
+void CommandStream::write(const BufferImageCopyRegion& region) {
+    write(region.bufferSize);
+    write(region.bufferOffset);
+    write(region.bufferRowLength);
+    write(region.bufferImageHeight);
+    write(region.imageAspect);
+    write(region.baseMip);
+    write(region.firstSlice);
+    write(region.sliceCount);
+    write(region.imageOffset);
+    write(region.imageExtent);
+}
+
+void CommandStream::write(const ImageResolve& region) {
+    write(region.srcImageAspect);
+    write(region.dstImageAspect);
+    write(region.srcOffset);
+    write(region.dstOffset);
+    write(region.srcBaseMip);
+    write(region.srcFirstSlice);
+    write(region.dstBaseMip);
+    write(region.dstFirstSlice);
+    write(region.sliceCount);
+    write(region.extent);
+}
+
+void CommandStream::append(const CommandStream& other) {
+    _words.insert(_words.end(), other._words.begin(), other._words.end());
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _size += other._size;
+}
+
+void CommandStream::clear() {
+    _words.clear();
+    _counts.fill(0);
+    _size = 0;
+}
+
+uint64_t CommandStream::hash() const {
+    uint64_t res{FNV_OFFSET};
+    for (auto word : _words) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            res ^= (word >> (i * 8)) & 0xFF;
+            res *= FNV_PRIME;
+        }
+    }
+    return res;
+}
+
+std::optional<uint32_t> CommandStream::diff(const CommandStream& other) const {
+    size_t pos{0};
+    uint32_t index{0};
+    while (pos < _words.size() && pos < other._words.size()) {
+        // equal headers mean equal lengths
+        auto length = headerPayload(_words[pos]) + 1;
+        if (_words[pos] != other._words[pos] ||
+            !std::equal(_words.begin() + pos, _words.begin() + pos + length, other._words.begin() + pos)) {
+            return index;
+        }
+        pos += length;
+        ++index;
+    }
+    if (_size == other._size) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+std::string CommandStream::dump(uint32_t first, uint32_t count) const {
+    std::string res;
+    size_t pos{0};
+    uint32_t index{0};
+    auto last = static_cast<uint64_t>(first) + count;
+    while (pos < _words.size() && index < last) {
+        auto header = _words[pos];
+        auto payload = headerPayload(header);
+        if (index >= first) {
+            res += fmt::format("{:>6} {}", index, commandName(headerType(header)));
+            for (uint32_t i = 1; i <= payload; ++i) {
+                res += fmt::format(" {}", _words[pos + i]);
+            }
+            res += '\n';
+        }
+        pos += payload + 1;
+        ++index;
+    }
+    return res;
+}
+
+} // namespace raum::rhi::null
@@ -0,0 +1,167 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "RHIDefine.h"
+#include "RHIResource.h"
+
+namespace raum::rhi::null {
+
+enum class CommandType : uint8_t {
+    // command buffer
+    BEGIN,
+    IMAGE_BARRIER,
+    BUFFER_BARRIER,
+    EXECUTION_BARRIER,
+    // one per applyBarrier with anything pending, after the barriers it flushes
+    PIPELINE_BARRIER,
+    SET_EVENT,
+    WAIT_EVENT,
+    RESET_QUERY_POOL,
+    WRITE_TIMESTAMP,
+    BEGIN_QUERY,
+    END_QUERY,
+
+    // render encoder
+    BEGIN_RENDER_PASS,
+    NEXT_SUBPASS,
+    END_RENDER_PASS,
+    BIND_GRAPHICS_PIPELINE,
+    SET_VIEWPORT,
+    SET_SCISSOR,
+    SET_LINE_WIDTH,
+    SET_DEPTH_BIAS,
+    SET_BLEND_CONSTANT,
+    SET_DEPTH_BOUNDS,
+    SET_STENCIL_COMPARE_MASK,
+    SET_STENCIL_REFERENCE,
+    BIND_INDEX_BUFFER,
+    BIND_VERTEX_BUFFER,
+    DRAW,
+    DRAW_INDEXED,
+    DRAW_INDIRECT,
+    DRAW_INDEXED_INDIRECT,
+    DRAW_INDEXED_INDIRECT_COUNT,
+    DRAW_MESH_TASKS_INDIRECT,
+    // followed by the commands of the secondary command buffers
+    EXECUTE_COMMANDS,
+    CLEAR_ATTACHMENT,
+
+    // compute encoder
+    BIND_COMPUTE_PIPELINE,
+    DISPATCH,
+    DISPATCH_INDIRECT,
+
+    // shared by render and compute encoders
+    BIND_DESCRIPTOR_SET,
+    PUSH_CONSTANTS,
+
+    // blit encoder
+    COPY_BUFFER_TO_BUFFER,
+    COPY_IMAGE_TO_IMAGE,
+    BLIT_IMAGE,
+    COPY_BUFFER_TO_IMAGE,
+    COPY_IMAGE_TO_BUFFER,
+    UPDATE_BUFFER,
+    FILL_BUFFER,
+    CLEAR_COLOR_IMAGE,
+    CLEAR_DEPTH_STENCIL_IMAGE,
+    RESOLVE_IMAGE,
+
+    COUNT,
+};
+
+std::string_view commandName(CommandType type);
+
+// commands packed into 32 bit words: a header with the type in the low byte and the payload word count above
+// it, then the arguments. RHI objects are written as their object id and structs field by field, so padding
+// never ends up in the stream and equal recordings of the same objects hash equal.
+class CommandStream {
+public:
+    // raw bytes like push constants and buffer updates, stored as byte size and zero padded words
+    struct Bytes {
+        const void* data{nullptr};
+        uint32_t size{0};
+    };
+
+    template <typename... Args>
+    void record(CommandType type, const Args&... args) {
+        auto header = _words.size();
+        _words.emplace_back(0);
+        (write(args), ...);
+        auto payload = static_cast<uint32_t>(_words.size() - header - 1);
+        _words[header] = static_cast<uint32_t>(type) | payload << 8;
+        ++_counts[static_cast<size_t>(type)];
+        ++_size;
+    }
+
+    void append(const CommandStream& other);
+    void clear();
+
+    // number of commands
+    uint32_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    uint32_t count(CommandType type) const { return _counts[static_cast<size_t>(type)]; }
+    const std::vector<uint32_t>& words() const { return _words; }
+
+    // FNV-1a over all words
+    uint64_t hash() const;
+    // index of the first command that differs from `other`, nullopt if both streams are equal
+    std::optional<uint32_t> diff(const CommandStream& other) const;
+    // one line per command, index, name and payload words
+    std::string dump(uint32_t first = 0, uint32_t count = UINT32_MAX) const;
+
+    bool operator==(const CommandStream& other) const { return _words == other._words; }
+
+private:
+    template <typename T>
+    void write(const T& arg) {
+        if constexpr (std::is_pointer_v<T>) {
+            write(static_cast<uint64_t>(arg ? arg->objectID() : 0));
+        } else if constexpr (std::is_enum_v<T>) {
+            write(static_cast<std::underlying_type_t<T>>(arg));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            _words.emplace_back(arg ? 1 : 0);
+        } else if constexpr (std::is_same_v<T, float>) {
+            _words.emplace_back(std::bit_cast<uint32_t>(arg));
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) == 8) {
+            _words.emplace_back(static_cast<uint32_t>(arg));
+            _words.emplace_back(static_cast<uint32_t>(static_cast<uint64_t>(arg) >> 32));
+        } else {
+            static_assert(std::is_integral_v<T> && sizeof(T) <= 4, "write RHI structs field by field");
+            _words.emplace_back(static_cast<uint32_t>(arg));
+        }
+    }
+
+    // element count, then the elements
+    template <typename T>
+    void write(std::span<T> values) {
+        write(static_cast<uint32_t>(values.size()));
+        for (const auto& value : values) {
+            write(value);
+        }
+    }
+
+    void write(const Bytes& bytes);
+    void write(const Vec3u& v);
+    void write(const Rect2D& rect);
+    void write(const ImageSubresourceRange& range);
+    void write(const ClearValue& value);
+    void write(const ClearRect& rect);
+    void write(const BufferCopyRegion& region);
+    void write(const ImageCopyRegion& region);
+    void write(const ImageBlit& region);
+    void write(const BufferImageCopyRegion& region);
+    void write(const ImageResolve& region);
+
+    std::vector<uint32_t> _words;
+    std::array<uint32_t, static_cast<size_t>(CommandType::COUNT)> _counts{};
+    uint32_t _size{0};
+};
+
+} // namespace raum::rhi::null
@@ -0,0 +1,242 @@
+#include "NullDevice.h"
+#include <algorithm>
+#include "NullCommandBuffer.h"
+#include "NullQueue.h"
+#include "NullResource.h"
+#include "RHIOffscreenSwapchain.h"
+#include "RHIUtils.h"
+#include "core/utils/log.h"
+
+namespace raum::rhi::null {
+
+namespace {
+
+constexpr uint32_t CHUNK_SIZE{1024 * 1024 * 4};
+// typical placement alignment of optimally tiled images
+constexpr uint64_t IMAGE_ALIGNMENT{64 * 1024};
+constexpr uint32_t SPARSE_PAGE_SIZE{64 * 1024};
+
+} // namespace
+
+Device::Device() {
+    for (auto type : {QueueType::GRAPHICS, QueueType::COMPUTE, QueueType::TRANSFER, QueueType::SPARSE}) {
+        _queues.emplace(type, new Queue(QueueInfo{type}, this));
+    }
+}
+
+Device::~Device() {
+    for (auto& [_, sampler] : _samplers) {
+        delete sampler;
+    }
+    for (auto& [_, frames] : _stagingBuffers) {
+        for (auto* stagingBuffer : frames.buffers) {
+            delete stagingBuffer;
+        }
+    }
+    for (auto [_, q] : _queues) {
+        delete q;
+    }
+}
+
+RHIQueue* Device::getQueue(const QueueInfo& info) {
+    return _queues.at(info.type);
+}
+
+// no surface to present to, the window size is rendered offscreen
+RHISwapchain* Device::createSwapchain(const SwapchainInfo& info) {
+    return new RHIOffscreenSwapchain(OffscreenSwapchainInfo{info.width, info.height}, this);
+}
+
+RHISwapchain* Device::createSwapchain(const SwapchainSurfaceInfo& info) {
+    return new RHIOffscreenSwapchain(OffscreenSwapchainInfo{info.width, info.height}, this);
+}
+
+RHIBuffer* Device::createBuffer(const BufferInfo& info) {
+    return new Buffer(info, this);
+}
+
+RHIBuffer* Device::createBuffer(const BufferSourceInfo& info) {
+    return new Buffer(info, this);
+}
+
+RHIBufferView* Device::createBufferView(const BufferViewInfo& info) {
+    return new BufferView(info, this);
+}
+
+RHIImage* Device::createImage(const ImageInfo& info) {
+    return new Image(info, this);
+}
+
+RHIImage* Device::createImage(const ImageInfo& info, RHIHeap*, uint64_t) {
+    return new Image(info, this);
+}
+
+RHIHeap* Device::createHeap(const HeapInfo& info) {
+    return new Heap(info, this);
+}
+
+RHIEvent* Device::createEvent() {
+    return new Event(this);
+}
+
+RHISemaphore* Device::createSemaphore() {
+    return new Semaphore(this);
+}
+
+RHIQueryPool* Device::createQueryPool(const QueryPoolInfo& info) {
+    return new QueryPool(info, this);
+}
+
+RHIImageView* Device::createImageView(const ImageViewInfo& info) {
+    return new ImageView(info, this);
+}
+
+RHISampler* Device::getSampler(const SamplerInfo& info) {
+    if (_samplers.find(info) == _samplers.end()) {
+        _samplers[info] = new Sampler();
+    }
+    return _samplers.at(info);
+}
+
+RHIShader* Device::createShader(const ShaderBinaryInfo& info) {
+    return new Shader(info, this);
+}
+
+// nothing is compiled, shader errors only show up on a real backend
+RHIShader* Device::createShader(const ShaderSourceInfo& info) {
+    return new Shader(info, this);
+}
+
+RHIDescriptorSetLayout* Device::createDescriptorSetLayout(const DescriptorSetLayoutInfo& info) {
+    return new DescriptorSetLayout(info, this);
+}
+
+RHIGraphicsPipeline* Device::createGraphicsPipeline(const GraphicsPipelineInfo& info) {
+    return new GraphicsPipeline(info, this);
+}
+
+RHIComputePipeline* Device::createComputePipeline(const ComputePipelineInfo& info) {
+    return new ComputePipeline(info, this);
+}
+
+RHIRenderPass* Device::createRenderPass(const RenderPassInfo& info) {
+    return new RenderPass(info, this);
+}
+
+RHIFrameBuffer* Device::createFrameBuffer(const FrameBufferInfo& info) {
+    return new FrameBuffer(info, this);
+}
+
+RHIPipelineLayout* Device::createPipelineLayout(const PipelineLayoutInfo& info) {
+    return new PipelineLayout(info, this);
+}
+
+RHICommandPool* Device::createCoomandPool(const CommandPoolInfo& info) {
+    return new CommandPool(info, this);
+}
+
+RHIDescriptorPool* Device::createDescriptorPool(const DescriptorPoolInfo& info) {
+    return new DescriptorPool(info, this);
+}
+
+RHISparseImage* Device::createSparseImage(const SparseImageInfo& info) {
+    return new SparseImage(info, this);
+}
+
+StagingBufferInfo Device::allocateStagingBuffer(uint32_t size, uint8_t queueIndex) {
+    auto& frames = _stagingBuffers[queueIndex];
+    auto*& stagingBuffer = frames.buffers[frames.frameIndex];
+    if (!stagingBuffer) {
+        stagingBuffer = new RHIStagingBuffer(CHUNK_SIZE, this);
+    }
+    return stagingBuffer->allocate(size);
+}
+
+void Device::resetStagingBuffer(uint8_t queueIndex, uint32_t frameIndex) {
+    auto& frames = _stagingBuffers[queueIndex];
+    frames.frameIndex = frameIndex;
+    if (frames.buffers[frameIndex]) {
+        frames.buffers[frameIndex]->reset();
+    }
+}
+
+SparseBindingRequirement Device::sparseBindingRequirement(RHIImage* image) {
+    raum_check(test(image->info().imageFlag, ImageFlag::SPARSE_BINDING), "not a sparse image!");
+    const auto& extent = image->info().extent;
+    uint32_t firstMipTail{0};
+    while (firstMipTail + 1 < image->info().mipCount && (std::min(extent.x, extent.y) >> firstMipTail) >= SPARSE_PAGE_EXTENT) {
+        ++firstMipTail;
+    }
+    return {
+        .aspect = AspectMask::COLOR,
+        .granularity = {SPARSE_PAGE_EXTENT, SPARSE_PAGE_EXTENT, 1},
+        .flag = SparseImageFormatFlag::SINGLE_MIPTAIL,
+        .mipTailFirstLod = firstMipTail,
+        .mipTailSize = SPARSE_PAGE_SIZE,
+        .mipTailOffset = 0,
+        .mipTailStride = 0,
+    };
+}
+
+// tightly packed mip chain, block compressed formats are counted per texel and come out too large
+MemoryRequirement Device::memoryRequirement(const ImageInfo& info) {
+    uint64_t texelSize = info.format == Format::UNKNOWN ? 4 : getFormatSize(info.format);
+    uint64_t size{0};
+    for (uint32_t mip = 0; mip < info.mipCount; ++mip) {
+        uint64_t width = std::max(info.extent.x >> mip, 1u);
+        uint64_t height = std::max(info.extent.y >> mip, 1u);
+        uint64_t depth = std::max(info.extent.z >> mip, 1u);
+        size += width * height * depth * texelSize;
+    }
+    size *= std::max(info.sliceCount, 1u) * std::max(info.sampleCount, 1u);
+    return {
+        (size + IMAGE_ALIGNMENT - 1) / IMAGE_ALIGNMENT * IMAGE_ALIGNMENT,
+        IMAGE_ALIGNMENT,
+        1,
+    };
+}
+
+void Device::record(const CommandStream& stream) {
+    std::lock_guard<std::mutex> lock(_submitMutex);
+    _submitted.append(stream);
+}
+
+bool Device::submittedCommandStats(SubmittedCommandStats& stats) const {
+    auto countOf = [&](std::initializer_list<CommandType> types) {
+        uint32_t sum{0};
+        for (auto type : types) {
+            sum += _submitted.count(type);
+        }
+        return sum;
+    };
+    std::lock_guard<std::mutex> lock(_submitMutex);
+    stats = {
+        .commands = _submitted.size(),
+        .draws = countOf({CommandType::DRAW, CommandType::DRAW_INDEXED, CommandType::DRAW_INDIRECT, CommandType::DRAW_INDEXED_INDIRECT,
+                          CommandType::DRAW_INDEXED_INDIRECT_COUNT, CommandType::DRAW_MESH_TASKS_INDIRECT}),
+        .dispatches = countOf({CommandType::DISPATCH, CommandType::DISPATCH_INDIRECT}),
+        .binds = countOf({CommandType::BIND_GRAPHICS_PIPELINE, CommandType::BIND_COMPUTE_PIPELINE, CommandType::BIND_DESCRIPTOR_SET,
+                          CommandType::BIND_INDEX_BUFFER, CommandType::BIND_VERTEX_BUFFER}),
+        .barriers = countOf({CommandType::IMAGE_BARRIER, CommandType::BUFFER_BARRIER, CommandType::EXECUTION_BARRIER}),
+        .barrierBatches = _submitted.count(CommandType::PIPELINE_BARRIER),
+        .copies = countOf({CommandType::COPY_BUFFER_TO_BUFFER, CommandType::COPY_IMAGE_TO_IMAGE, CommandType::BLIT_IMAGE,
+                           CommandType::COPY_BUFFER_TO_IMAGE, CommandType::COPY_IMAGE_TO_BUFFER}),
+        .hash = _submitted.hash(),
+    };
+    return true;
+}
+
+void Device::clearSubmitted() {
+    std::lock_guard<std::mutex> lock(_submitMutex);
+    _submitted.clear();
+}
+
+Device* loadNull() {
+    return new Device();
+}
+
+void unloadNull(Device* device) {
+    delete device;
+}
+
+} // namespace raum::rhi::null
@@ -0,0 +1,107 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include "NullCommandStream.h"
+#include "RHIDevice.h"
+
+// backend without a gpu: objects own no device memory and command buffers record into a CommandStream.
+// Submitted streams are collected by the device, so the engine runs at full cpu speed and tests can count,
+// hash and diff what it would have sent to the gpu.
+namespace raum::rhi::null {
+class Queue;
+class Sampler;
+
+// optional features reported to the engine, the commands behind them are recorded either way
+struct Features {
+    bool pipelineStatistics{true};
+    bool drawIndirectCount{true};
+    bool meshShader{false};
+};
+
+class Device : public RHIDevice {
+public:
+    RHISwapchain* createSwapchain(const SwapchainInfo&) override;
+    RHISwapchain* createSwapchain(const SwapchainSurfaceInfo&) override;
+    RHIQueue* getQueue(const QueueInfo&) override;
+    RHIBuffer* createBuffer(const BufferInfo&) override;
+    RHIBuffer* createBuffer(const BufferSourceInfo&) override;
+    RHIBufferView* createBufferView(const BufferViewInfo&) override;
+    RHIImage* createImage(const ImageInfo&) override;
+    RHIImage* createImage(const ImageInfo&, RHIHeap* heap, uint64_t offset) override;
+    RHIHeap* createHeap(const HeapInfo&) override;
+    RHIEvent* createEvent() override;
+    RHISemaphore* createSemaphore() override;
+    RHIQueryPool* createQueryPool(const QueryPoolInfo&) override;
+    RHIImageView* createImageView(const ImageViewInfo&) override;
+    RHISampler* getSampler(const SamplerInfo&) override;
+    RHIShader* createShader(const ShaderBinaryInfo&) override;
+    RHIShader* createShader(const ShaderSourceInfo&) override;
+    RHIDescriptorSetLayout* createDescriptorSetLayout(const DescriptorSetLayoutInfo&) override;
+    RHIGraphicsPipeline* createGraphicsPipeline(const GraphicsPipelineInfo&) override;
+    RHIComputePipeline* createComputePipeline(const ComputePipelineInfo&) override;
+    RHIRenderPass* createRenderPass(const RenderPassInfo&) override;
+    RHIFrameBuffer* createFrameBuffer(const FrameBufferInfo&) override;
+    RHIPipelineLayout* createPipelineLayout(const PipelineLayoutInfo&) override;
+    RHICommandPool* createCoomandPool(const CommandPoolInfo&) override;
+    RHIDescriptorPool* createDescriptorPool(const DescriptorPoolInfo&) override;
+    RHISparseImage* createSparseImage(const SparseImageInfo&) override;
+
+    StagingBufferInfo allocateStagingBuffer(uint32_t size, uint8_t queueIndex) override;
+    // called by queues moving to `frameIndex`, allocations then come from that slot's buffer
+    void resetStagingBuffer(uint8_t queueIndex, uint32_t frameIndex);
+
+    void waitDeviceIdle() override {}
+    void waitQueueIdle(RHIQueue*) override {}
+
+    SparseBindingRequirement sparseBindingRequirement(RHIImage* image) override;
+    MemoryRequirement memoryRequirement(const ImageInfo& info) override;
+
+    API api() const override { return API::NONE; }
+
+    float timestampPeriod() override { return 1.0f; }
+    bool pipelineStatisticsSupported() override { return _features.pipelineStatistics; }
+    bool drawIndirectCountSupported() override { return _features.drawIndirectCount; }
+    bool meshShaderSupported() override { return _features.meshShader; }
+
+    const Features& features() const { return _features; }
+    // before anything queries them, the engine caches feature checks
+    void setFeatures(const Features& features) { _features = features; }
+
+    bool submittedCommandStats(SubmittedCommandStats& stats) const override;
+    void resetSubmittedCommandStats() override { clearSubmitted(); }
+
+    // every submitted or flushed command buffer in submission order, kept until cleared.
+    // Not synchronized with queues submitting on other threads.
+    const CommandStream& submitted() const { return _submitted; }
+    void clearSubmitted();
+
+    // called by queues
+    void record(const CommandStream& stream);
+
+private:
+    Device();
+    ~Device();
+
+    Device(const Device&) = delete;
+
+    Features _features{};
+    std::map<QueueType, Queue*> _queues;
+    struct StagingFrames {
+        std::array<RHIStagingBuffer*, FRAMES_IN_FLIGHT> buffers{};
+        uint32_t frameIndex{0};
+    };
+    std::map<uint8_t, StagingFrames> _stagingBuffers;
+    std::unordered_map<SamplerInfo, Sampler*, RHIHash<SamplerInfo>> _samplers;
+
+    mutable std::mutex _submitMutex;
+    CommandStream _submitted;
+
+    friend Device* loadNull();
+    friend void unloadNull(Device*);
+};
+
+Device* loadNull();
+void unloadNull(Device* device);
+
+} // namespace raum::rhi::null
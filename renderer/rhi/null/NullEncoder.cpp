@@ -0,0 +1,282 @@
+#include "NullEncoder.h"
+#include "NullCommandBuffer.h"
+#include "NullDevice.h"
+#include "NullResource.h"
+#include "core/utils/log.h"
+
+namespace raum::rhi::null {
+
+void RenderEncoder::beginRenderPass(const RenderPassBeginInfo& info) {
+    const auto& attachments = info.renderPass->attachments();
+    std::span<const ClearValue> clearValues;
+    if (info.clearColors) {
+        clearValues = {info.clearColors, attachments.size()};
+    }
+    _commandBuffer->stream().record(CommandType::BEGIN_RENDER_PASS,
+                                    info.renderPass,
+                                    info.frameBuffer,
+                                    info.renderArea,
+                                    info.contents,
+                                    clearValues);
+}
+
+void RenderEncoder::nextSubpass() {
+    _commandBuffer->stream().record(CommandType::NEXT_SUBPASS);
+}
+
+void RenderEncoder::endRenderPass() {
+    _commandBuffer->stream().record(CommandType::END_RENDER_PASS);
+}
+
+void RenderEncoder::bindPipeline(RHIGraphicsPipeline* pipeline) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_graphicsPipeline == pipeline) {
+        ++stats.pipelineBindsSkipped;
+        return;
+    }
+    ++stats.pipelineBinds;
+    _graphicsPipeline = static_cast<GraphicsPipeline*>(pipeline);
+    if (_pipelineLayout != _graphicsPipeline->pipelineLayout()) {
+        // sets bound with another layout are not guaranteed to be compatible
+        _pipelineLayout = _graphicsPipeline->pipelineLayout();
+        _descriptorSets.fill(nullptr);
+    }
+    _commandBuffer->stream().record(CommandType::BIND_GRAPHICS_PIPELINE, pipeline);
+}
+
+void RenderEncoder::setViewport(const Viewport& vp) {
+    _commandBuffer->stream().record(CommandType::SET_VIEWPORT, vp.rect, vp.minDepth, vp.maxDepth);
+}
+
+void RenderEncoder::setScissor(const Rect2D& rect) {
+    _commandBuffer->stream().record(CommandType::SET_SCISSOR, rect);
+}
+
+void RenderEncoder::setLineWidth(float width) {
+    _commandBuffer->stream().record(CommandType::SET_LINE_WIDTH, width);
+}
+
+void RenderEncoder::setDepthBias(float constantFactor, float clamp, float slopeFactor) {
+    _commandBuffer->stream().record(CommandType::SET_DEPTH_BIAS, constantFactor, clamp, slopeFactor);
+}
+
+void RenderEncoder::setBlendConstant(float r, float g, float b, float a) {
+    _commandBuffer->stream().record(CommandType::SET_BLEND_CONSTANT, r, g, b, a);
+}
+
+void RenderEncoder::setDepthBounds(float min, float max) {
+    _commandBuffer->stream().record(CommandType::SET_DEPTH_BOUNDS, min, max);
+}
+
+void RenderEncoder::setStencilCompareMask(FaceMode face, uint32_t mask) {
+    _commandBuffer->stream().record(CommandType::SET_STENCIL_COMPARE_MASK, face, mask);
+}
+
+void RenderEncoder::setStencilReference(FaceMode face, uint32_t ref) {
+    _commandBuffer->stream().record(CommandType::SET_STENCIL_REFERENCE, face, ref);
+}
+
+void RenderEncoder::bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t index, uint32_t* dynamicOffsets, uint32_t dynOffsetCount) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (!dynOffsetCount && index < _descriptorSets.size() && _descriptorSets[index] == descriptorSet) {
+        ++stats.descriptorSetBindsSkipped;
+        return;
+    }
+    ++stats.descriptorSetBinds;
+    if (index < _descriptorSets.size()) {
+        // dynamic offsets may change between binds of the same set
+        _descriptorSets[index] = dynOffsetCount ? nullptr : descriptorSet;
+    }
+    _commandBuffer->stream().record(CommandType::BIND_DESCRIPTOR_SET,
+                                    descriptorSet,
+                                    index,
+                                    std::span<const uint32_t>{dynamicOffsets, dynOffsetCount});
+}
+
+void RenderEncoder::bindIndexBuffer(RHIBuffer* indexBuffer, uint32_t offset, IndexType type) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_indexBuffer == indexBuffer && _indexOffset == offset && _indexType == type) {
+        ++stats.indexBufferBindsSkipped;
+        return;
+    }
+    ++stats.indexBufferBinds;
+    _indexBuffer = indexBuffer;
+    _indexOffset = offset;
+    _indexType = type;
+    _commandBuffer->stream().record(CommandType::BIND_INDEX_BUFFER, indexBuffer, offset, type);
+}
+
+void RenderEncoder::bindVertexBuffer(RHIBuffer* vertexBuffer, uint32_t index) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_vertexBuffer == vertexBuffer) {
+        ++stats.vertexBufferBindsSkipped;
+        return;
+    }
+    ++stats.vertexBufferBinds;
+    _vertexBuffer = vertexBuffer;
+    _commandBuffer->stream().record(CommandType::BIND_VERTEX_BUFFER, vertexBuffer, index);
+}
+
+void RenderEncoder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void RenderEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t vertexOffset, uint32_t firstInstance) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW_INDEXED, indexCount, instanceCount, firstVertex, vertexOffset, firstInstance);
+}
+
+void RenderEncoder::drawIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW_INDIRECT, indirectBuffer, offset, drawCount, stride);
+}
+
+void RenderEncoder::drawIndexedIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW_INDEXED_INDIRECT, indirectBuffer, offset, drawCount, stride);
+}
+
+void RenderEncoder::drawIndexedIndirectCount(RHIBuffer* indirectBuffer,
+                                             uint32_t offset,
+                                             RHIBuffer* countBuffer,
+                                             uint32_t countOffset,
+                                             uint32_t maxDrawCount,
+                                             uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW_INDEXED_INDIRECT_COUNT,
+                                    indirectBuffer,
+                                    offset,
+                                    countBuffer,
+                                    countOffset,
+                                    maxDrawCount,
+                                    stride);
+}
+
+void RenderEncoder::drawMeshTasksIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    RAUM_ERROR_IF(!_commandBuffer->device()->meshShaderSupported(), "mesh shader is not supported.");
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    _commandBuffer->stream().record(CommandType::DRAW_MESH_TASKS_INDIRECT, indirectBuffer, offset, drawCount, stride);
+}
+
+void RenderEncoder::pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) {
+    _commandBuffer->stream().record(CommandType::PUSH_CONSTANTS, stage, offset, CommandStream::Bytes{data, size});
+}
+
+void RenderEncoder::executeCommands(RHICommandBuffer** commandBuffers, uint32_t count) {
+    auto& stream = _commandBuffer->stream();
+    stream.record(CommandType::EXECUTE_COMMANDS, std::span<RHICommandBuffer* const>{commandBuffers, count});
+    // stats of secondary command buffers are collected by whoever recorded them
+    for (uint32_t i = 0; i < count; ++i) {
+        auto* secondary = static_cast<CommandBuffer*>(commandBuffers[i]);
+        stream.append(secondary->stream());
+    }
+}
+
+void RenderEncoder::clearAttachment(uint32_t* attachmentIndices, uint32_t attachmentNum, ClearValue* value, ClearRect* rects, uint32_t recNum) {
+    _commandBuffer->stream().record(CommandType::CLEAR_ATTACHMENT,
+                                    std::span<const uint32_t>{attachmentIndices, attachmentNum},
+                                    std::span<const ClearValue>{value, attachmentNum},
+                                    std::span<const ClearRect>{rects, recNum});
+}
+
+void ComputeEncoder::bindPipeline(RHIComputePipeline* pipeline) {
+    _commandBuffer->stream().record(CommandType::BIND_COMPUTE_PIPELINE, pipeline);
+}
+
+void ComputeEncoder::bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t index, uint32_t* dynamicOffsets, uint32_t dynOffsetCount) {
+    _commandBuffer->stream().record(CommandType::BIND_DESCRIPTOR_SET,
+                                    descriptorSet,
+                                    index,
+                                    std::span<const uint32_t>{dynamicOffsets, dynOffsetCount});
+}
+
+void ComputeEncoder::dispatch(uint32_t groupX, uint32_t groupY, uint32_t groupZ) {
+    _commandBuffer->stream().record(CommandType::DISPATCH, groupX, groupY, groupZ);
+}
+
+void ComputeEncoder::dispatchIndirect(RHIBuffer* indirectBuffer, uint32_t offset) {
+    _commandBuffer->stream().record(CommandType::DISPATCH_INDIRECT, indirectBuffer, offset);
+}
+
+void ComputeEncoder::pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) {
+    _commandBuffer->stream().record(CommandType::PUSH_CONSTANTS, stage, offset, CommandStream::Bytes{data, size});
+}
+
+void BlitEncoder::copyBufferToBuffer(RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, BufferCopyRegion* regions, uint32_t regionCount) {
+    _commandBuffer->stream().record(CommandType::COPY_BUFFER_TO_BUFFER,
+                                    srcBuffer,
+                                    dstBuffer,
+                                    std::span<const BufferCopyRegion>{regions, regionCount});
+}
+
+void BlitEncoder::copyImageToImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageCopyRegion* regions, uint32_t regionCount) {
+    _commandBuffer->stream().record(CommandType::COPY_IMAGE_TO_IMAGE,
+                                    srcImage,
+                                    srcLayout,
+                                    dstImage,
+                                    dstLayout,
+                                    std::span<const ImageCopyRegion>{regions, regionCount});
+}
+
+void BlitEncoder::blitImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageBlit* regions, uint32_t regionCount, Filter filter) {
+    _commandBuffer->stream().record(CommandType::BLIT_IMAGE,
+                                    srcImage,
+                                    srcLayout,
+                                    dstImage,
+                                    dstLayout,
+                                    std::span<const ImageBlit>{regions, regionCount},
+                                    filter);
+}
+
+void BlitEncoder::copyBufferToImage(RHIBuffer* buffer, RHIImage* image, ImageLayout layout, BufferImageCopyRegion* regions, uint32_t regionCount) {
+    _commandBuffer->stream().record(CommandType::COPY_BUFFER_TO_IMAGE,
+                                    buffer,
+                                    image,
+                                    layout,
+                                    std::span<const BufferImageCopyRegion>{regions, regionCount});
+}
+
+void BlitEncoder::copyImageToBuffer(RHIImage* image, ImageLayout layout, RHIBuffer* dstBuffer, BufferImageCopyRegion* regions, uint32_t regionCount) {
+    _commandBuffer->stream().record(CommandType::COPY_IMAGE_TO_BUFFER,
+                                    image,
+                                    layout,
+                                    dstBuffer,
+                                    std::span<const BufferImageCopyRegion>{regions, regionCount});
+}
+
+void BlitEncoder::updateBuffer(RHIBuffer* buffer, uint32_t dstOffset, const void* const data, uint32_t dataSize) {
+    _commandBuffer->stream().record(CommandType::UPDATE_BUFFER, buffer, dstOffset, CommandStream::Bytes{data, dataSize});
+}
+
+void BlitEncoder::fillBuffer(RHIBuffer* buffer, uint32_t dstOffset, uint32_t size, uint32_t value) {
+    _commandBuffer->stream().record(CommandType::FILL_BUFFER, buffer, dstOffset, size, value);
+}
+
+void BlitEncoder::clearColorImage(RHIImage* image, ImageLayout layout, ClearValue* data, ImageSubresourceRange* ranges, uint32_t rangeCount) {
+    _commandBuffer->stream().record(CommandType::CLEAR_COLOR_IMAGE,
+                                    image,
+                                    layout,
+                                    std::span<const ClearValue>{data, rangeCount},
+                                    std::span<const ImageSubresourceRange>{ranges, rangeCount});
+}
+
+void BlitEncoder::clearDepthStencilImage(RHIImage* image, ImageLayout layout, float depth, uint32_t stencil, ImageSubresourceRange* ranges, uint32_t rangeCount) {
+    _commandBuffer->stream().record(CommandType::CLEAR_DEPTH_STENCIL_IMAGE,
+                                    image,
+                                    layout,
+                                    depth,
+                                    stencil,
+                                    std::span<const ImageSubresourceRange>{ranges, rangeCount});
+}
+
+void BlitEncoder::resolveImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageResolve* regions, uint32_t regionCount) {
+    _commandBuffer->stream().record(CommandType::RESOLVE_IMAGE,
+                                    srcImage,
+                                    srcLayout,
+                                    dstImage,
+                                    dstLayout,
+                                    std::span<const ImageResolve>{regions, regionCount});
+}
+
+} // namespace raum::rhi::null
@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include "RHIBlitEncoder.h"
+#include "RHIComputeEncoder.h"
+#include "RHIRenderEncoder.h"
+
+namespace raum::rhi::null {
+class CommandBuffer;
+class GraphicsPipeline;
+
+// skips redundant binds and counts them the same way the vulkan encoder does, only recorded binds reach the stream
+class RenderEncoder : public RHIRenderEncoder {
+public:
+    explicit RenderEncoder(CommandBuffer* commandBuffer) : _commandBuffer(commandBuffer) {}
+    RenderEncoder(const RenderEncoder&) = delete;
+    RenderEncoder& operator=(const RenderEncoder&) = delete;
+    RenderEncoder(RenderEncoder&&) = delete;
+    ~RenderEncoder() override {}
+
+    void beginRenderPass(const RenderPassBeginInfo& info) override;
+    void nextSubpass() override;
+    void endRenderPass() override;
+    void bindPipeline(RHIGraphicsPipeline* pipeline) override;
+    void setViewport(const Viewport& vp) override;
+    void setScissor(const Rect2D& rect) override;
+    void setLineWidth(float width) override;
+    void setDepthBias(float constantFactor, float clamp, float slopeFactor) override;
+    void setBlendConstant(float r, float g, float b, float a) override;
+    void setDepthBounds(float min, float max) override;
+    void setStencilCompareMask(FaceMode face, uint32_t mask) override;
+    void setStencilReference(FaceMode face, uint32_t ref) override;
+    void bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t index, uint32_t* dynamicOffsets, uint32_t dynOffsetCount) override;
+    void bindIndexBuffer(RHIBuffer* indexBuffer, uint32_t offset, IndexType type) override;
+    void bindVertexBuffer(RHIBuffer* vertexBuffer, uint32_t index) override;
+    void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t vertexOffset, uint32_t firstInstance) override;
+    void drawIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
+    void drawIndexedIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
+    void drawIndexedIndirectCount(RHIBuffer* indirectBuffer,
+                                  uint32_t offset,
+                                  RHIBuffer* countBuffer,
+                                  uint32_t countOffset,
+                                  uint32_t maxDrawCount,
+                                  uint32_t stride) override;
+    void drawMeshTasksIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
+    void pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) override;
+    void executeCommands(RHICommandBuffer** commandBuffers, uint32_t count) override;
+
+    void clearAttachment(uint32_t* attachmentIndices, uint32_t attachmentNum, ClearValue* value, ClearRect* rects, uint32_t recNum) override;
+
+private:
+    CommandBuffer* _commandBuffer{nullptr};
+
+    // currently bound state, redundant binds are skipped
+    GraphicsPipeline* _graphicsPipeline{nullptr};
+    RHIPipelineLayout* _pipelineLayout{nullptr};
+    std::array<RHIDescriptorSet*, BindingRateCount> _descriptorSets{};
+    RHIBuffer* _indexBuffer{nullptr};
+    uint32_t _indexOffset{0};
+    IndexType _indexType{IndexType::FULL};
+    RHIBuffer* _vertexBuffer{nullptr};
+};
+
+class ComputeEncoder : public RHIComputeEncoder {
+public:
+    explicit ComputeEncoder(CommandBuffer* commandBuffer) : _commandBuffer(commandBuffer) {}
+    ~ComputeEncoder() override {}
+
+    void bindPipeline(RHIComputePipeline* pipeline) override;
+    void bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t index, uint32_t* dynamicOffsets, uint32_t dynOffsetCount) override;
+    void dispatch(uint32_t groupX, uint32_t groupY, uint32_t groupZ) override;
+    void dispatchIndirect(RHIBuffer* indirectBuffer, uint32_t offset) override;
+    void pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) override;
+
+private:
+    CommandBuffer* _commandBuffer{nullptr};
+};
+
+class BlitEncoder : public RHIBlitEncoder {
+public:
+    explicit BlitEncoder(CommandBuffer* commandBuffer) : _commandBuffer(commandBuffer) {}
+    ~BlitEncoder() override {}
+
+    void copyBufferToBuffer(RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, BufferCopyRegion* regions, uint32_t regionCount) override;
+    void copyImageToImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageCopyRegion* regions, uint32_t regionCount) override;
+    void blitImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageBlit* regions, uint32_t regionCount, Filter filter) override;
+    void copyBufferToImage(RHIBuffer* buffer, RHIImage* image, ImageLayout layout, BufferImageCopyRegion* regions, uint32_t regionCount) override;
+    void copyImageToBuffer(RHIImage* image, ImageLayout layout, RHIBuffer* dstBuffer, BufferImageCopyRegion* regions, uint32_t regionCount) override;
+    void updateBuffer(RHIBuffer* buffer, uint32_t dstOffset, const void* const data, uint32_t dataSize) override;
+    void fillBuffer(RHIBuffer* buffer, uint32_t dstOffset, uint32_t size, uint32_t value) override;
+    void clearColorImage(RHIImage* image, ImageLayout layout, ClearValue* data, ImageSubresourceRange* ranges, uint32_t rangeCount) override;
+    void clearDepthStencilImage(RHIImage* image, ImageLayout layout, float depth, uint32_t stencil, ImageSubresourceRange* ranges, uint32_t rangeCount) override;
+    void resolveImage(RHIImage* srcImage, ImageLayout srcLayout, RHIImage* dstImage, ImageLayout dstLayout, ImageResolve* regions, uint32_t regionCount) override;
+
+private:
+    CommandBuffer* _commandBuffer{nullptr};
+};
+
+} // namespace raum::rhi::null
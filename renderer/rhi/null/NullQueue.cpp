@@ -0,0 +1,71 @@
+#include "NullQueue.h"
+#include "NullCommandBuffer.h"
+#include "NullDevice.h"
+#include "NullResource.h"
+#include "core/utils/Trace.h"
+
+namespace raum::rhi::null {
+
+Queue::Queue(const QueueInfo& info, Device* device)
+: _info(info), _device(device) {
+    for (auto& sem : _signals) {
+        sem = new Semaphore(device);
+    }
+}
+
+Queue::~Queue() {
+    for (auto* sem : _signals) {
+        delete sem;
+    }
+}
+
+void Queue::enqueue(RHICommandBuffer* commandBuffer) {
+    _commandBuffers.emplace_back(static_cast<CommandBuffer*>(commandBuffer));
+}
+
+void Queue::submitCommandBuffers() {
+    for (auto* commandBuffer : _commandBuffers) {
+        _device->record(commandBuffer->stream());
+    }
+    _commandBuffers.clear();
+}
+
+void Queue::nextFrame() {
+    _currFrameIndex = (_currFrameIndex + 1) % FRAMES_IN_FLIGHT;
+    for (auto& completeFunc : _completeHandlers[_currFrameIndex]) {
+        completeFunc();
+    }
+    _completeHandlers[_currFrameIndex].clear();
+}
+
+void Queue::submit(bool) {
+    RAUM_TRACE_SCOPE("Queue::submit");
+    submitCommandBuffers();
+    nextFrame();
+    _device->resetStagingBuffer(index(), _currFrameIndex);
+}
+
+void Queue::flush(RHISemaphore*) {
+    RAUM_TRACE_SCOPE("Queue::flush");
+    submitCommandBuffers();
+}
+
+void Queue::endFrame() {
+    nextFrame();
+    _device->resetStagingBuffer(index(), _currFrameIndex);
+}
+
+void Queue::bindSparse(const SparseBindingInfo&, SparseType) {
+    nextFrame();
+    _commandBuffers.clear();
+}
+
+RHISemaphore* Queue::getSignal() {
+    return _signals[_currFrameIndex];
+}
+
+void Queue::addCompleteHandler(std::function<void()>&& func) {
+    _completeHandlers[_currFrameIndex].emplace_back(std::forward<std::function<void()>>(func));
+}
+
+} // namespace raum::rhi::null
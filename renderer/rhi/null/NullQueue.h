@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <vector>
+#include "RHIQueue.h"
+
+namespace raum::rhi::null {
+class Device;
+class CommandBuffer;
+class Semaphore;
+
+// work finishes at submit, the frame slots are still rotated so complete handlers run as late as on a gpu.
+// every queue type is its own family, like a gpu with dedicated compute and transfer queues.
+class Queue : public RHIQueue {
+public:
+    uint32_t index() const override { return static_cast<uint32_t>(_info.type); }
+
+    void submit(bool signal) override;
+    void flush(RHISemaphore* signal) override;
+    void endFrame() override;
+    void enqueue(RHICommandBuffer* commandBuffer) override;
+    void bindSparse(const SparseBindingInfo& info, SparseType type) override;
+    void addWait(RHISemaphore*) override {}
+    RHISemaphore* getSignal() override;
+
+    void addCompleteHandler(std::function<void()>&& func) override;
+
+    ~Queue() override;
+
+private:
+    explicit Queue(const QueueInfo& info, Device* device);
+    void submitCommandBuffers();
+    void nextFrame();
+
+    QueueInfo _info;
+    uint32_t _currFrameIndex{0};
+    Device* _device{nullptr};
+
+    std::vector<CommandBuffer*> _commandBuffers;
+    std::array<Semaphore*, FRAMES_IN_FLIGHT> _signals{};
+    std::array<std::vector<std::function<void()>>, FRAMES_IN_FLIGHT> _completeHandlers;
+
+    friend class Device;
+};
+
+} // namespace raum::rhi::null
@@ -0,0 +1,67 @@
+#include "NullResource.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace raum::rhi::null {
+
+namespace {
+
+bool hostAccessible(MemoryUsage usage) {
+    return usage == MemoryUsage::HOST_VISIBLE || usage == MemoryUsage::STAGING;
+}
+
+} // namespace
+
+Buffer::Buffer(const BufferInfo& info, RHIDevice* device)
+: RHIBuffer(info, device) {
+    if (hostAccessible(info.memUsage)) {
+        _data = std::make_unique<uint8_t[]>(info.size);
+        _mapped = _data.get();
+    }
+}
+
+Buffer::Buffer(const BufferSourceInfo& info, RHIDevice* device)
+: RHIBuffer(info, device) {
+    _data = std::make_unique<uint8_t[]>(info.size);
+    _mapped = _data.get();
+    if (info.data) {
+        std::memcpy(_mapped, info.data, info.size);
+    }
+}
+
+void Buffer::map(uint32_t offset, uint32_t) {
+    if (_data) {
+        _mapped = _data.get() + offset;
+    }
+}
+
+void Buffer::unmap() {
+    // host memory stays readable, like persistently mapped allocations
+    _mapped = _data.get();
+}
+
+SparseImage::SparseImage(const SparseImageInfo& info, RHIDevice* device)
+: RHISparseImage(info, device),
+  _granularity(SPARSE_PAGE_EXTENT, SPARSE_PAGE_EXTENT, 1) {
+    // mips smaller than a page go to the tail
+    auto extent = std::min(info.width, info.height);
+    while (_firstMipTail < info.maxMip && (extent >> _firstMipTail) >= SPARSE_PAGE_EXTENT) {
+        ++_firstMipTail;
+    }
+}
+
+bool QueryPool::getResults(uint32_t, uint32_t count, uint64_t* results) {
+    uint32_t valuesPerQuery{1};
+    if (_info.type == QueryType::PIPELINE_STATISTICS) {
+        valuesPerQuery = std::popcount(static_cast<uint32_t>(_info.statistics));
+    }
+    std::fill_n(results, count * valuesPerQuery, 0);
+    return true;
+}
+
+RHIDescriptorSet* DescriptorPool::makeDescriptorSet(const DescriptorSetInfo& info) {
+    return new DescriptorSet(info, _device);
+}
+
+} // namespace raum::rhi::null
@@ -0,0 +1,195 @@
+#pragma once
+#include <memory>
+#include "RHIBuffer.h"
+#include "RHIBufferView.h"
+#include "RHIComputePipeline.h"
+#include "RHIDescriptorPool.h"
+#include "RHIDescriptorSet.h"
+#include "RHIDescriptorSetLayout.h"
+#include "RHIEvent.h"
+#include "RHIFrameBuffer.h"
+#include "RHIGraphicsPipeline.h"
+#include "RHIHeap.h"
+#include "RHIImage.h"
+#include "RHIImageView.h"
+#include "RHIPipelineLayout.h"
+#include "RHIQueryPool.h"
+#include "RHIRenderPass.h"
+#include "RHISampler.h"
+#include "RHISemaphore.h"
+#include "RHIShader.h"
+#include "RHISparseImage.h"
+
+// objects of the null backend own no gpu memory, only host visible buffers keep bytes so mapped writes land.
+namespace raum::rhi::null {
+
+// width and height of a sparse page, mips below it are packed into the tail
+constexpr uint32_t SPARSE_PAGE_EXTENT{128};
+
+class Buffer : public RHIBuffer {
+public:
+    explicit Buffer(const BufferInfo& info, RHIDevice* device);
+    explicit Buffer(const BufferSourceInfo& info, RHIDevice* device);
+
+    void map(uint32_t offset, uint32_t size) override;
+    void unmap() override;
+    void* mappedData() const override { return _mapped; }
+
+private:
+    std::unique_ptr<uint8_t[]> _data;
+    uint8_t* _mapped{nullptr};
+};
+
+class BufferView : public RHIBufferView {
+public:
+    explicit BufferView(const BufferViewInfo& info, RHIDevice* device) : RHIBufferView(info, device) {}
+};
+
+class Image : public RHIImage {
+public:
+    explicit Image(const ImageInfo& info, RHIDevice* device) : RHIImage(info, device) {}
+};
+
+class ImageView : public RHIImageView {
+public:
+    explicit ImageView(const ImageViewInfo& info, RHIDevice* device) : RHIImageView(info, device), _image(info.image) {}
+
+    RHIImage* image() const override { return _image; }
+
+private:
+    RHIImage* _image{nullptr};
+};
+
+class SparseImage : public RHISparseImage {
+public:
+    explicit SparseImage(const SparseImageInfo& info, RHIDevice* device);
+
+    void prepare(RHICommandBuffer*, uint32_t, uint32_t, uint32_t, uint32_t) override {}
+    void update(RHICommandBuffer*) override {}
+    void reset(uint32_t) override {}
+    void setMiptail(uint8_t*, uint8_t) override {}
+    void analyze(RHIBuffer*, RHICommandBuffer*) override {}
+    void bind(SparseType) override {}
+    void shrink() override {}
+    const Vec3u& granularity() override { return _granularity; }
+    uint8_t firstMipTail() override { return _firstMipTail; }
+    void allocatePage(uint32_t) override {}
+    void setPageMemoryBindInfo(uint32_t, const Vec3u&, const Vec3u&, uint8_t, uint32_t) override {}
+    void initPageInfo(uint32_t, uint32_t) override {}
+
+private:
+    Vec3u _granularity{};
+    uint8_t _firstMipTail{0};
+};
+
+class Heap : public RHIHeap {
+public:
+    explicit Heap(const HeapInfo& info, RHIDevice* device) : RHIHeap(info, device) {}
+};
+
+class Event : public RHIEvent {
+public:
+    explicit Event(RHIDevice* device) : RHIEvent(device) {}
+
+private:
+    // moved in by setEvent, recorded again by waitEvent
+    std::vector<ImageBarrierInfo> _imageBarriers;
+    std::vector<BufferBarrierInfo> _bufferBarriers;
+    std::vector<ExecutionBarrier> _executionBarriers;
+    DependencyFlags _flags{DependencyFlags::BY_REGION};
+
+    friend class CommandBuffer;
+};
+
+class Semaphore : public RHISemaphore {
+public:
+    explicit Semaphore(RHIDevice* device) : RHISemaphore(device) {}
+
+    void setStage(PipelineStage stage) override { _stage = stage; }
+    PipelineStage getStage() override { return _stage; }
+
+private:
+    PipelineStage _stage{PipelineStage::TOP_OF_PIPE};
+};
+
+class QueryPool : public RHIQueryPool {
+public:
+    explicit QueryPool(const QueryPoolInfo& info, RHIDevice* device) : RHIQueryPool(info, device), _info(info) {}
+
+    const QueryPoolInfo& info() const override { return _info; }
+    // everything lands immediately and reads zero
+    bool getResults(uint32_t first, uint32_t count, uint64_t* results) override;
+
+private:
+    QueryPoolInfo _info;
+};
+
+class Shader : public RHIShader {
+public:
+    explicit Shader(const ShaderBinaryInfo& info, RHIDevice* device) : RHIShader(info, device) {}
+    explicit Shader(const ShaderSourceInfo& info, RHIDevice* device) : RHIShader(info, device) {}
+};
+
+class Sampler : public RHISampler {
+public:
+    ~Sampler() override {}
+};
+
+class DescriptorSetLayout : public RHIDescriptorSetLayout {
+public:
+    explicit DescriptorSetLayout(const DescriptorSetLayoutInfo& info, RHIDevice* device) : RHIDescriptorSetLayout(info, device) {}
+};
+
+class DescriptorSet : public RHIDescriptorSet {
+public:
+    explicit DescriptorSet(const DescriptorSetInfo& info, RHIDevice* device) : RHIDescriptorSet(info, device) {}
+
+    void update(const BindingInfo&) override {}
+    void updateBuffer(const BufferBinding&) override {}
+    void updateImage(const ImageBinding&) override {}
+    void updateSampler(const SamplerBinding&) override {}
+    void updateTexelBuffer(const TexelBufferBinding&) override {}
+};
+
+class DescriptorPool : public RHIDescriptorPool {
+public:
+    explicit DescriptorPool(const DescriptorPoolInfo& info, RHIDevice* device) : RHIDescriptorPool(info, device), _device(device) {}
+
+    RHIDescriptorSet* makeDescriptorSet(const DescriptorSetInfo& info) override;
+
+private:
+    RHIDevice* _device{nullptr};
+};
+
+class PipelineLayout : public RHIPipelineLayout {
+public:
+    explicit PipelineLayout(const PipelineLayoutInfo& info, RHIDevice* device) : RHIPipelineLayout(info, device) {}
+};
+
+class GraphicsPipeline : public RHIGraphicsPipeline {
+public:
+    explicit GraphicsPipeline(const GraphicsPipelineInfo& info, RHIDevice* device)
+    : RHIGraphicsPipeline(info, device), _pipelineLayout(info.pipelineLayout) {}
+
+    RHIPipelineLayout* pipelineLayout() const { return _pipelineLayout; }
+
+private:
+    RHIPipelineLayout* _pipelineLayout{nullptr};
+};
+
+class ComputePipeline : public RHIComputePipeline {
+public:
+    explicit ComputePipeline(const ComputePipelineInfo& info, RHIDevice* device) : RHIComputePipeline(info, device) {}
+};
+
+class RenderPass : public RHIRenderPass {
+public:
+    explicit RenderPass(const RenderPassInfo& info, RHIDevice* device) : RHIRenderPass(info, device) {}
+};
+
+class FrameBuffer : public RHIFrameBuffer {
+public:
+    explicit FrameBuffer(const FrameBufferInfo& info, RHIDevice* device) : RHIFrameBuffer(info, device) {}
+};
+
+} // namespace raum::rhi::null
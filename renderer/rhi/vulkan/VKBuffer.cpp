@@ -109,7 +109,9 @@ Buffer::Buffer(const BufferSourceInfo& info, RHIDevice* device) : RHIBuffer(info
     VkResult res = vmaCreateBuffer(allocator, &bufferInfo, &allocaInfo, &_buffer, &_allocation, &_allocInfo);
     RAUM_ERROR_IF(res != VK_SUCCESS, "Failed to create buffer!");
 
-    memcpy(_allocInfo.pMappedData, info.data, info.size);
+    if (info.data) {
+        memcpy(_allocInfo.pMappedData, info.data, info.size);
+    }
 }
 
 Buffer::~Buffer() {
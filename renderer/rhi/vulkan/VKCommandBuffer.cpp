@@ -4,19 +4,24 @@
 #include "VKBuffer.h"
 #include "VKComputeEncoder.h"
 #include "VKDevice.h"
+#include "VKEvent.h"
 #include "VKImage.h"
+#include "VKQueryPool.h"
 #include "VKQueue.h"
 #include "VKRenderEncoder.h"
 #include "VKUtils.h"
 #include "VKDescriptorSet.h"
 #include "VKCommandPool.h"
 #include "VKSparseImage.h"
+#include "VKRenderPass.h"
+#include "VKFrameBuffer.h"
 #include "RHIUtils.h"
 namespace raum::rhi {
 CommandBuffer::CommandBuffer(const CommandBufferInfo& info, CommandPool* commandPool, RHIDevice* device)
 : RHICommandBuffer(info, device),
   _device(static_cast<Device*>(device)),
-  _commandPool(commandPool) {
+  _commandPool(commandPool),
+  _info(info) {
     VkCommandBufferAllocateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     createInfo.commandBufferCount = 1;
@@ -49,6 +54,18 @@ void CommandBuffer::begin(const CommandBufferBeginInfo& info) {
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = commandBufferUsage(info.flags);
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    if (_info.type == CommandBufferType::SECONDARY) {
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        if (info.renderPass) {
+            inheritanceInfo.renderPass = static_cast<RenderPass*>(info.renderPass)->renderPass();
+            inheritanceInfo.subpass = info.subpass;
+            inheritanceInfo.framebuffer = info.frameBuffer ? static_cast<FrameBuffer*>(info.frameBuffer)->framebuffer() : VK_NULL_HANDLE;
+            beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        }
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+    }
     vkBeginCommandBuffer(_commandBuffer, &beginInfo);
 }
 
@@ -64,6 +81,7 @@ void CommandBuffer::commit() {
 
 void CommandBuffer::reset() {
     vkResetCommandBuffer(_commandBuffer, VkCommandBufferResetFlagBits{});
+    _renderEncoderStats = {};
 }
 
 void CommandBuffer::appendImageBarrier(const ImageBarrierInfo& info) {
@@ -78,63 +96,149 @@ void CommandBuffer::appendExecutionBarrier(const ExecutionBarrier& info) {
     _executionBarriers.emplace_back(info);
 }
 
-void CommandBuffer::applyBarrier(DependencyFlags flags) {
-    std::vector<VkBufferMemoryBarrier> bufferBarriers(_bufferBarriers.size());
-    std::vector<VkImageMemoryBarrier> imageBarriers(_imageBarriers.size());
-    std::vector<VkMemoryBarrier> executionBarriers(_executionBarriers.size());
-    VkPipelineStageFlags srcStageMask{VK_PIPELINE_STAGE_NONE};
-    VkPipelineStageFlags dstStageMask{VK_PIPELINE_STAGE_NONE};
-    for (size_t i = 0; i < _bufferBarriers.size(); ++i) {
-        srcStageMask |= pipelineStageFlags(_bufferBarriers[i].srcStage);
-        dstStageMask |= pipelineStageFlags(_bufferBarriers[i].dstStage);
-        bufferBarriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-        bufferBarriers[i].buffer = static_cast<Buffer*>(_bufferBarriers[i].buffer)->buffer();
-        bufferBarriers[i].srcAccessMask = accessFlags(_bufferBarriers[i].srcAccessFlag);
-        bufferBarriers[i].dstAccessMask = accessFlags(_bufferBarriers[i].dstAccessFlag);
-        bufferBarriers[i].srcQueueFamilyIndex = _bufferBarriers[i].srcQueueIndex;
-        bufferBarriers[i].dstQueueFamilyIndex = _bufferBarriers[i].dstQueueIndex;
-        bufferBarriers[i].offset = _bufferBarriers[i].offset;
-        bufferBarriers[i].size = _bufferBarriers[i].size;
-    }
+namespace {
+
+VkBufferMemoryBarrier2 bufferBarrier2(const BufferBarrierInfo& info) {
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    // legacy stage/access bits are valid synchronization2 bits
+    barrier.srcStageMask = pipelineStageFlags(info.srcStage);
+    barrier.dstStageMask = pipelineStageFlags(info.dstStage);
+    barrier.srcAccessMask = accessFlags(info.srcAccessFlag);
+    barrier.dstAccessMask = accessFlags(info.dstAccessFlag);
+    barrier.srcQueueFamilyIndex = info.srcQueueIndex;
+    barrier.dstQueueFamilyIndex = info.dstQueueIndex;
+    barrier.buffer = static_cast<Buffer*>(info.buffer)->buffer();
+    barrier.offset = info.offset;
+    // 0 covers the whole buffer
+    barrier.size = info.size ? info.size : VK_WHOLE_SIZE;
+    return barrier;
+}
 
-    for (size_t i = 0; i < _imageBarriers.size(); ++i) {
-        srcStageMask |= pipelineStageFlags(_imageBarriers[i].srcStage);
-        dstStageMask |= pipelineStageFlags(_imageBarriers[i].dstStage);
-        imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        if(isSparse(_imageBarriers[i].image)) {
-            imageBarriers[i].image = static_cast<SparseImage*>(_imageBarriers[i].image)->image();
-        } else {
-            imageBarriers[i].image = static_cast<Image*>(_imageBarriers[i].image)->image();
-        }
-        imageBarriers[i].srcAccessMask = accessFlags(_imageBarriers[i].srcAccessFlag);
-        imageBarriers[i].dstAccessMask = accessFlags(_imageBarriers[i].dstAccessFlag);
-        imageBarriers[i].oldLayout = imageLayout(_imageBarriers[i].oldLayout);
-        imageBarriers[i].newLayout = imageLayout(_imageBarriers[i].newLayout);
-        imageBarriers[i].srcQueueFamilyIndex = _imageBarriers[i].srcQueueIndex;
-        imageBarriers[i].dstQueueFamilyIndex = _imageBarriers[i].dstQueueIndex;
-        imageBarriers[i].subresourceRange.aspectMask = aspectMask(_imageBarriers[i].range.aspect);
-        imageBarriers[i].subresourceRange.baseArrayLayer = _imageBarriers[i].range.firstSlice;
-        imageBarriers[i].subresourceRange.layerCount = _imageBarriers[i].range.sliceCount;
-        imageBarriers[i].subresourceRange.baseMipLevel = _imageBarriers[i].range.firstMip;
-        imageBarriers[i].subresourceRange.levelCount = _imageBarriers[i].range.mipCount;
+VkImageMemoryBarrier2 imageBarrier2(const ImageBarrierInfo& info) {
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = pipelineStageFlags(info.srcStage);
+    barrier.dstStageMask = pipelineStageFlags(info.dstStage);
+    barrier.srcAccessMask = accessFlags(info.srcAccessFlag);
+    barrier.dstAccessMask = accessFlags(info.dstAccessFlag);
+    barrier.oldLayout = imageLayout(info.oldLayout);
+    barrier.newLayout = imageLayout(info.newLayout);
+    barrier.srcQueueFamilyIndex = info.srcQueueIndex;
+    barrier.dstQueueFamilyIndex = info.dstQueueIndex;
+    if (isSparse(info.image)) {
+        barrier.image = static_cast<SparseImage*>(info.image)->image();
+    } else {
+        barrier.image = static_cast<Image*>(info.image)->image();
     }
+    barrier.subresourceRange.aspectMask = aspectMask(info.range.aspect);
+    barrier.subresourceRange.baseArrayLayer = info.range.firstSlice;
+    barrier.subresourceRange.layerCount = info.range.sliceCount;
+    barrier.subresourceRange.baseMipLevel = info.range.firstMip;
+    barrier.subresourceRange.levelCount = info.range.mipCount;
+    return barrier;
+}
 
-    for(size_t i = 0; i < _executionBarriers.size(); ++i) {
-        srcStageMask |= pipelineStageFlags(_executionBarriers[i].srcStage);
-        dstStageMask |= pipelineStageFlags(_executionBarriers[i].dstStage);
-        executionBarriers[i].srcAccessMask = accessFlags(_executionBarriers[i].srcAccessFlag);
-        executionBarriers[i].dstAccessMask = accessFlags(_executionBarriers[i].dstAccessFlag);
-        executionBarriers[i].sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+VkMemoryBarrier2 memoryBarrier2(const ExecutionBarrier& info) {
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = pipelineStageFlags(info.srcStage);
+    barrier.dstStageMask = pipelineStageFlags(info.dstStage);
+    barrier.srcAccessMask = accessFlags(info.srcAccessFlag);
+    barrier.dstAccessMask = accessFlags(info.dstAccessFlag);
+    return barrier;
+}
+
+} // namespace
+
+VkDependencyInfo CommandBuffer::dependencyInfo(const std::vector<ImageBarrierInfo>& imageBarriers,
+                                               const std::vector<BufferBarrierInfo>& bufferBarriers,
+                                               const std::vector<ExecutionBarrier>& executionBarriers,
+                                               DependencyFlags flags) {
+    // scratch arrays keep their capacity, no allocation after warm up
+    _vkImageBarriers.clear();
+    _vkBufferBarriers.clear();
+    _vkMemoryBarriers.clear();
+    for (const auto& barrier : imageBarriers) {
+        _vkImageBarriers.emplace_back(imageBarrier2(barrier));
+    }
+    for (const auto& barrier : bufferBarriers) {
+        _vkBufferBarriers.emplace_back(bufferBarrier2(barrier));
     }
+    for (const auto& barrier : executionBarriers) {
+        _vkMemoryBarriers.emplace_back(memoryBarrier2(barrier));
+    }
+
+    VkDependencyInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    info.dependencyFlags = dependencyFlags(flags);
+    info.memoryBarrierCount = static_cast<uint32_t>(_vkMemoryBarriers.size());
+    info.pMemoryBarriers = _vkMemoryBarriers.data();
+    info.bufferMemoryBarrierCount = static_cast<uint32_t>(_vkBufferBarriers.size());
+    info.pBufferMemoryBarriers = _vkBufferBarriers.data();
+    info.imageMemoryBarrierCount = static_cast<uint32_t>(_vkImageBarriers.size());
+    info.pImageMemoryBarriers = _vkImageBarriers.data();
+    return info;
+}
 
-    if (!_bufferBarriers.empty() || !_imageBarriers.empty()) {
-        vkCmdPipelineBarrier(_commandBuffer, srcStageMask, dstStageMask, dependencyFlags(flags),
-                             executionBarriers.size(), executionBarriers.data(),
-                             static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
-                             static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+void CommandBuffer::applyBarrier(DependencyFlags flags) {
+    if (!_bufferBarriers.empty() || !_imageBarriers.empty() || !_executionBarriers.empty()) {
+        auto info = dependencyInfo(_imageBarriers, _bufferBarriers, _executionBarriers, flags);
+        vkCmdPipelineBarrier2(_commandBuffer, &info);
     }
     _bufferBarriers.clear();
     _imageBarriers.clear();
+    _executionBarriers.clear();
+}
+
+void CommandBuffer::setEvent(RHIEvent* event, DependencyFlags flags) {
+    auto* vkEvent = static_cast<Event*>(event);
+    std::swap(vkEvent->_imageBarriers, _imageBarriers);
+    std::swap(vkEvent->_bufferBarriers, _bufferBarriers);
+    std::swap(vkEvent->_executionBarriers, _executionBarriers);
+    vkEvent->_flags = flags;
+    _imageBarriers.clear();
+    _bufferBarriers.clear();
+    _executionBarriers.clear();
+
+    auto info = dependencyInfo(vkEvent->_imageBarriers, vkEvent->_bufferBarriers, vkEvent->_executionBarriers, flags);
+    vkCmdSetEvent2(_commandBuffer, vkEvent->event(), &info);
+}
+
+void CommandBuffer::waitEvent(RHIEvent* event) {
+    auto* vkEvent = static_cast<Event*>(event);
+    auto info = dependencyInfo(vkEvent->_imageBarriers, vkEvent->_bufferBarriers, vkEvent->_executionBarriers, vkEvent->_flags);
+    vkCmdWaitEvents2(_commandBuffer, 1, &vkEvent->_event, &info);
+
+    // ready for next frame once the waiting stages are done
+    VkPipelineStageFlags2 dstStages{VK_PIPELINE_STAGE_2_NONE};
+    for (const auto& barrier : _vkImageBarriers) {
+        dstStages |= barrier.dstStageMask;
+    }
+    for (const auto& barrier : _vkBufferBarriers) {
+        dstStages |= barrier.dstStageMask;
+    }
+    for (const auto& barrier : _vkMemoryBarriers) {
+        dstStages |= barrier.dstStageMask;
+    }
+    vkCmdResetEvent2(_commandBuffer, vkEvent->event(), dstStages);
+}
+
+void CommandBuffer::resetQueryPool(RHIQueryPool* pool, uint32_t first, uint32_t count) {
+    vkCmdResetQueryPool(_commandBuffer, static_cast<QueryPool*>(pool)->queryPool(), first, count);
+}
+
+void CommandBuffer::writeTimestamp(RHIQueryPool* pool, uint32_t index, PipelineStage stage) {
+    // legacy stage bits share their values with the synchronization2 ones
+    vkCmdWriteTimestamp2(_commandBuffer, pipelineStageFlags(stage), static_cast<QueryPool*>(pool)->queryPool(), index);
+}
+
+void CommandBuffer::beginQuery(RHIQueryPool* pool, uint32_t index) {
+    vkCmdBeginQuery(_commandBuffer, static_cast<QueryPool*>(pool)->queryPool(), index, 0);
+}
+
+void CommandBuffer::endQuery(RHIQueryPool* pool, uint32_t index) {
+    vkCmdEndQuery(_commandBuffer, static_cast<QueryPool*>(pool)->queryPool(), index);
 }
 
 void CommandBuffer::onComplete(std::function<void()>&& func) {
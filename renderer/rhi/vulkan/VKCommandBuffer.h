@@ -30,15 +30,30 @@ public:
     void appendBufferBarrier(const BufferBarrierInfo& info) override;
     void appendExecutionBarrier(const ExecutionBarrier& info) override;
     void applyBarrier(DependencyFlags flags) override;
+    void setEvent(RHIEvent* event, DependencyFlags flags) override;
+    void waitEvent(RHIEvent* event) override;
+    void resetQueryPool(RHIQueryPool* pool, uint32_t first, uint32_t count) override;
+    void writeTimestamp(RHIQueryPool* pool, uint32_t index, PipelineStage stage) override;
+    void beginQuery(RHIQueryPool* pool, uint32_t index) override;
+    void endQuery(RHIQueryPool* pool, uint32_t index) override;
     void onComplete(std::function<void()>&&) override;
+    const RenderEncoderStats& renderEncoderStats() const override { return _renderEncoderStats; }
+
+    RenderEncoderStats& renderEncoderStats() { return _renderEncoderStats; }
 
     CommandBufferType type() const { return _info.type; }
 
     VkCommandBuffer commandBuffer() const { return _commandBuffer; }
+    Device* device() const { return _device; }
 
     ~CommandBuffer();
 
 private:
+    VkDependencyInfo dependencyInfo(const std::vector<ImageBarrierInfo>& imageBarriers,
+                                    const std::vector<BufferBarrierInfo>& bufferBarriers,
+                                    const std::vector<ExecutionBarrier>& executionBarriers,
+                                    DependencyFlags flags);
+
     bool _enqueued{false};
     CommandBufferStatus _status{CommandBufferStatus::AVAILABLE};
     Device* _device{nullptr};
@@ -48,6 +63,10 @@ private:
     std::vector<ImageBarrierInfo> _imageBarriers;
     std::vector<BufferBarrierInfo> _bufferBarriers;
     std::vector<ExecutionBarrier> _executionBarriers;
+    std::vector<VkImageMemoryBarrier2> _vkImageBarriers;
+    std::vector<VkBufferMemoryBarrier2> _vkBufferBarriers;
+    std::vector<VkMemoryBarrier2> _vkMemoryBarriers;
+    RenderEncoderStats _renderEncoderStats{};
 
     VkCommandBuffer _commandBuffer;
 };
@@ -4,6 +4,7 @@
 #include "VKComputePipeline.h"
 #include "VKDescriptorSet.h"
 #include "VKPipelineLayout.h"
+#include "VKUtils.h"
 namespace raum::rhi {
 
 ComputeEncoder::ComputeEncoder(CommandBuffer* commandBuffer)
@@ -32,7 +33,7 @@ void ComputeEncoder::dispatchIndirect(RHIBuffer* indirectBuffer, uint32_t offset
 }
 
 void ComputeEncoder::pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) {
-    vkCmdPushConstants(_commandBuffer->commandBuffer(), _pipeline->pipelineLayout()->layout(), static_cast<VkShaderStageFlags>(stage), offset, size, data);
+    vkCmdPushConstants(_commandBuffer->commandBuffer(), _pipeline->pipelineLayout()->layout(), shaderStageFlags(stage), offset, size, data);
 }
 
 } // namespace raum::rhi
\ No newline at end of file
@@ -11,9 +11,9 @@ namespace raum::rhi {
         }                                                                  \
     }
 
+// texel size is in RHIUtils, getFormatSize
 struct FormatInfo {
     VkFormat format;
-    uint32_t size;
     uint32_t macroPixelCount;
 };
 
@@ -1,24 +1,30 @@
 #include "VKDevice.h"
+#include <algorithm>
 #include "RHIManager.h"
 #include "VKBuffer.h"
 #include "VKCommandPool.h"
 #include "VKDescriptorPool.h"
 #include "VKDescriptorSet.h"
 #include "VKDescriptorSetLayout.h"
+#include "VKEvent.h"
 #include "VKFrameBuffer.h"
 #include "VKGraphicsPipeline.h"
+#include "VKHeap.h"
 #include "VKImage.h"
 #include "VKImageView.h"
 #include "VKPipelineLayout.h"
+#include "VKQueryPool.h"
 #include "VKQueue.h"
 #include "VKRenderPass.h"
 #include "VKSampler.h"
+#include "VKSemaphore.h"
 #include "VKShader.h"
 #include "VKSwapchain.h"
 #include "VKSparseImage.h"
 #include "VKUtils.h"
 #include "VkBufferView.h"
 #include "VKComputePipeline.h"
+#include "NullDevice.h"
 #include "core/utils/log.h"
 namespace raum::rhi {
 
@@ -133,6 +139,12 @@ Device::~Device() {
         delete sampler;
     }
 
+    for (auto& [_, frames] : _stagingBuffers) {
+        for (auto* stagingBuffer : frames.buffers) {
+            delete stagingBuffer;
+        }
+    }
+
     for (auto [_, q] : _queues) {
         delete q;
     }
@@ -229,6 +241,35 @@ void Device::initDevice() {
 
     _physicalDevice = rankDevices(devices);
 
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(_physicalDevice, &props);
+    _timestampPeriod = props.limits.timestampPeriod;
+
+    uint32_t extNum{0};
+    vkEnumerateDeviceExtensionProperties(_physicalDevice, nullptr, &extNum, nullptr);
+    std::vector<VkExtensionProperties> availableExts(extNum);
+    vkEnumerateDeviceExtensionProperties(_physicalDevice, nullptr, &extNum, availableExts.data());
+    log(availableExts);
+    bool meshShaderExt = std::any_of(availableExts.begin(), availableExts.end(), [](const VkExtensionProperties& ext) {
+        return strcmp(ext.extensionName, VK_EXT_MESH_SHADER_EXTENSION_NAME) == 0;
+    });
+
+    VkPhysicalDeviceMeshShaderFeaturesEXT supportedMesh{};
+    supportedMesh.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    VkPhysicalDeviceVulkan12Features supported12{};
+    supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    supported12.pNext = meshShaderExt ? &supportedMesh : nullptr;
+    VkPhysicalDeviceFeatures2 supportedFeatures{};
+    supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures.pNext = &supported12;
+    vkGetPhysicalDeviceFeatures2(_physicalDevice, &supportedFeatures);
+    _pipelineStatistics = supportedFeatures.features.pipelineStatisticsQuery;
+    _drawIndirectCount = supported12.drawIndirectCount &&
+                         supportedFeatures.features.multiDrawIndirect &&
+                         supportedFeatures.features.drawIndirectFirstInstance;
+    // the meshlet path culls in compute, task shaders are not required
+    _meshShader = meshShaderExt && supportedMesh.meshShader;
+
     // for further use
     auto* queue = new Queue(QueueInfo{QueueType::COMPUTE}, this);
     _queues.emplace(QueueType::COMPUTE, queue);
@@ -239,33 +280,71 @@ void Device::initDevice() {
     queue = new Queue(QueueInfo{QueueType::GRAPHICS}, this);
     _queues.emplace(QueueType::GRAPHICS, queue);
 
-    VkDeviceQueueCreateInfo queueInfo{};
-    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-
+    // one queue per family, queue types sharing a family share the queue
     float priority = 1.0f;
-    queueInfo.queueFamilyIndex = queue->_index;
-    queueInfo.queueCount = 1;
-    queueInfo.pQueuePriorities = &priority;
+    std::vector<VkDeviceQueueCreateInfo> queueInfos;
+    for (auto [_, q] : _queues) {
+        auto iter = std::find_if(queueInfos.begin(), queueInfos.end(), [q](const VkDeviceQueueCreateInfo& info) {
+            return info.queueFamilyIndex == q->_index;
+        });
+        if (iter == queueInfos.end()) {
+            VkDeviceQueueCreateInfo queueInfo{};
+            queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueInfo.queueFamilyIndex = q->_index;
+            queueInfo.queueCount = 1;
+            queueInfo.pQueuePriorities = &priority;
+            queueInfos.emplace_back(queueInfo);
+        }
+    }
 
+    // software rasterizers like lavapipe come without sparse residency
     VkPhysicalDeviceFeatures deviceFeatures{};
-    deviceFeatures.sparseBinding = 1;
-    deviceFeatures.sparseResidencyImage2D = 1;
-    deviceFeatures.shaderResourceResidency = 1;
+    deviceFeatures.sparseBinding = supportedFeatures.features.sparseBinding;
+    deviceFeatures.sparseResidencyImage2D = supportedFeatures.features.sparseResidencyImage2D;
+    deviceFeatures.shaderResourceResidency = supportedFeatures.features.shaderResourceResidency;
+    deviceFeatures.pipelineStatisticsQuery = _pipelineStatistics;
+    deviceFeatures.multiDrawIndirect = _drawIndirectCount;
+    deviceFeatures.drawIndirectFirstInstance = _drawIndirectCount;
+
+    bool swapchainExt = std::any_of(availableExts.begin(), availableExts.end(), [](const VkExtensionProperties& ext) {
+        return strcmp(ext.extensionName, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+    });
 
     std::vector<const char*> exts{};
-    exts.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    // headless devices render offscreen only
+    if (swapchainExt) {
+        exts.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
     exts.emplace_back(VK_KHR_MAINTENANCE1_EXTENSION_NAME);
+    if (_meshShader) {
+        exts.emplace_back(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+    }
 
-    uint32_t extNum{0};
-    vkEnumerateDeviceExtensionProperties(_physicalDevice, nullptr, &extNum, nullptr);
-    std::vector<VkExtensionProperties> availableExts(extNum);
-    vkEnumerateDeviceExtensionProperties(_physicalDevice, nullptr, &extNum, availableExts.data());
-    log(availableExts);
+
+    VkPhysicalDeviceVulkan13Features features13{};
+    features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    features13.synchronization2 = VK_TRUE;
+
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.drawIndirectCount = _drawIndirectCount;
+    // queues pace frames in flight with it, core and required since 1.2
+    features12.timelineSemaphore = VK_TRUE;
+    features13.pNext = &features12;
+
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshFeatures{};
+    meshFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    meshFeatures.meshShader = _meshShader;
+    meshFeatures.taskShader = _meshShader && supportedMesh.taskShader;
+    if (_meshShader) {
+        features12.pNext = &meshFeatures;
+    }
 
     VkDeviceCreateInfo deviceInfo{};
     deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceInfo.pQueueCreateInfos = &queueInfo;
-    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pNext = &features13;
+    deviceInfo.pQueueCreateInfos = queueInfos.data();
+    deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
     deviceInfo.pEnabledFeatures = &deviceFeatures;
     deviceInfo.enabledExtensionCount = exts.size();
     deviceInfo.ppEnabledExtensionNames = exts.data();
@@ -274,6 +353,11 @@ void Device::initDevice() {
     VkResult res = vkCreateDevice(_physicalDevice, &deviceInfo, nullptr, &_device);
     RAUM_CRITICAL_IF(res != VK_SUCCESS, "failed to create logic device.");
 
+    if (_meshShader) {
+        _cmdDrawMeshTasksIndirect = reinterpret_cast<PFN_vkCmdDrawMeshTasksIndirectEXT>(
+            vkGetDeviceProcAddr(_device, "vkCmdDrawMeshTasksIndirectEXT"));
+    }
+
     //vkGetDeviceQueue(_device, queue->_index, 0, &queue->_vkQueue);
 
     VmaAllocatorCreateInfo allocInfo{};
@@ -317,6 +401,26 @@ RHIImage* Device::createImage(const ImageInfo& info) {
     return new Image(info, this);
 }
 
+RHIImage* Device::createImage(const ImageInfo& info, RHIHeap* heap, uint64_t offset) {
+    return new Image(info, this, heap, offset);
+}
+
+RHIHeap* Device::createHeap(const HeapInfo& info) {
+    return new Heap(info, this);
+}
+
+RHISemaphore* Device::createSemaphore() {
+    return new Semaphore(this);
+}
+
+RHIEvent* Device::createEvent() {
+    return new Event(this);
+}
+
+RHIQueryPool* Device::createQueryPool(const QueryPoolInfo& info) {
+    return new QueryPool(info, this);
+}
+
 RHIImageView* Device::createImageView(const ImageViewInfo& info) {
     return new ImageView(info, this);
 }
@@ -372,6 +476,23 @@ RHISparseImage* Device::createSparseImage(const raum::rhi::SparseImageInfo& info
     return new SparseImage(info, this);
 }
 
+MemoryRequirement Device::memoryRequirement(const ImageInfo& info) {
+    auto createInfo = imageCreateInfo(info);
+    VkDeviceImageMemoryRequirements imageRequirements{};
+    imageRequirements.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+    imageRequirements.pCreateInfo = &createInfo;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    vkGetDeviceImageMemoryRequirements(_device, &imageRequirements, &requirements);
+
+    return {
+        requirements.memoryRequirements.size,
+        requirements.memoryRequirements.alignment,
+        requirements.memoryRequirements.memoryTypeBits,
+    };
+}
+
 SparseBindingRequirement Device::sparseBindingRequirement(RHIImage* image) {
     auto* img = static_cast<Image*>(image);
     raum_check(test(image->info().imageFlag, rhi::ImageFlag::SPARSE_BINDING), "not a sparse image!");
@@ -429,15 +550,20 @@ SparseBindingRequirement Device::sparseBindingRequirement(RHIImage* image) {
 }
 
 StagingBufferInfo Device::allocateStagingBuffer(uint32_t size, uint8_t queueIndex) {
-    if (!_stagingBuffers.contains(queueIndex)) {
-        _stagingBuffers.emplace(queueIndex, new RHIStagingBuffer(ChunkSize, this));
+    auto& frames = _stagingBuffers[queueIndex];
+    auto*& stagingBuffer = frames.buffers[frames.frameIndex];
+    if (!stagingBuffer) {
+        stagingBuffer = new RHIStagingBuffer(ChunkSize, this);
     }
-    return _stagingBuffers.at(queueIndex)->allocate(size);
+    return stagingBuffer->allocate(size);
 }
 
-void Device::resetStagingBuffer(uint8_t queueIndex) {
-    if (_stagingBuffers.contains(queueIndex)) {
-        _stagingBuffers.at(queueIndex)->reset();
+// the queue waited for the slot's previous frame, its copies are done
+void Device::resetStagingBuffer(uint8_t queueIndex, uint32_t frameIndex) {
+    auto& frames = _stagingBuffers[queueIndex];
+    frames.frameIndex = frameIndex;
+    if (frames.buffers[frameIndex]) {
+        frames.buffers[frameIndex]->reset();
     }
 }
 
@@ -460,10 +586,17 @@ void unloadVK(Device* device) {
 }
 
 RHIDevice* loadRHI(API api) {
+    if (api == API::NONE) {
+        return null::loadNull();
+    }
     return loadVK();
 }
 
 void unloadRHI(RHIDevice* device) {
+    if (device->api() == API::NONE) {
+        null::unloadNull(static_cast<null::Device*>(device));
+        return;
+    }
     unloadVK(static_cast<Device*>(device));
 }
 
@@ -25,6 +25,11 @@ public:
     RHIBuffer *createBuffer(const BufferSourceInfo &) override;
     RHIBufferView *createBufferView(const BufferViewInfo &) override;
     RHIImage *createImage(const ImageInfo &) override;
+    RHIImage *createImage(const ImageInfo &, RHIHeap *heap, uint64_t offset) override;
+    RHIHeap *createHeap(const HeapInfo &) override;
+    RHIEvent *createEvent() override;
+    RHISemaphore *createSemaphore() override;
+    RHIQueryPool *createQueryPool(const QueryPoolInfo &) override;
     RHIImageView *createImageView(const ImageViewInfo &) override;
     RHISampler *getSampler(const SamplerInfo &) override;
     RHIShader *createShader(const ShaderBinaryInfo &) override;
@@ -40,14 +45,25 @@ public:
     RHISparseImage* createSparseImage(const SparseImageInfo&) override;
 
     StagingBufferInfo allocateStagingBuffer(uint32_t size, uint8_t queueIndex) override;
-    void resetStagingBuffer(uint8_t queueIndex);
+    // called by queues moving to `frameIndex`, allocations then come from that slot's buffer
+    void resetStagingBuffer(uint8_t queueIndex, uint32_t frameIndex);
 
     void waitDeviceIdle() override;
     void waitQueueIdle(RHIQueue*) override;
 
     SparseBindingRequirement sparseBindingRequirement(RHIImage* image) override;
+    MemoryRequirement memoryRequirement(const ImageInfo& info) override;
 
     void *instance() override { return _instance; }
+    API api() const override { return API::VULKAN; }
+
+    float timestampPeriod() override { return _timestampPeriod; }
+    bool pipelineStatisticsSupported() override { return _pipelineStatistics; }
+    bool drawIndirectCountSupported() override { return _drawIndirectCount; }
+    bool meshShaderSupported() override { return _meshShader; }
+
+    // extension entry, null without mesh shader support
+    PFN_vkCmdDrawMeshTasksIndirectEXT cmdDrawMeshTasksIndirect() const { return _cmdDrawMeshTasksIndirect; }
 
 private:
     Device();
@@ -64,9 +80,18 @@ private:
     VkPhysicalDevice _physicalDevice;
     VkDevice _device;
     VmaAllocator _allocator;
+    float _timestampPeriod{1.0f};
+    bool _pipelineStatistics{false};
+    bool _drawIndirectCount{false};
+    bool _meshShader{false};
+    PFN_vkCmdDrawMeshTasksIndirectEXT _cmdDrawMeshTasksIndirect{nullptr};
 
     std::map<QueueType, Queue *> _queues;
-    std::map<uint8_t, RHIStagingBuffer*> _stagingBuffers;
+    struct StagingFrames {
+        std::array<RHIStagingBuffer*, FRAMES_IN_FLIGHT> buffers{};
+        uint32_t frameIndex{0};
+    };
+    std::map<uint8_t, StagingFrames> _stagingBuffers;
     std::vector<VkDescriptorPool> _descriptorPools;
     std::unordered_map<SamplerInfo, Sampler *, RHIHash<SamplerInfo>> _samplers;
 
@@ -0,0 +1,18 @@
+#include "VKEvent.h"
+#include "VKDevice.h"
+namespace raum::rhi {
+
+Event::Event(Device* device) : RHIEvent(device), _device(device) {
+    VkEventCreateInfo eci{};
+    eci.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    eci.flags = VK_EVENT_CREATE_DEVICE_ONLY_BIT;
+
+    auto res = vkCreateEvent(_device->device(), &eci, nullptr, &_event);
+    raum_check(res == VK_SUCCESS, "failed to create event!");
+}
+
+Event::~Event() {
+    vkDestroyEvent(_device->device(), _event, nullptr);
+}
+
+} // namespace raum::rhi
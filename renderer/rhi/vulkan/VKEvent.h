@@ -0,0 +1,31 @@
+#pragma once
+#include "RHIEvent.h"
+#include "VKDefine.h"
+namespace raum::rhi {
+class Device;
+class Event : public RHIEvent {
+public:
+    explicit Event(Device* device);
+    Event() = delete;
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+    Event(Event&&) = delete;
+
+    ~Event();
+
+    VkEvent event() const { return _event; }
+
+private:
+    // dependency passed to vkCmdWaitEvents2 must match the one signaled
+    std::vector<ImageBarrierInfo> _imageBarriers;
+    std::vector<BufferBarrierInfo> _bufferBarriers;
+    std::vector<ExecutionBarrier> _executionBarriers;
+    DependencyFlags _flags{DependencyFlags::BY_REGION};
+
+    VkEvent _event{VK_NULL_HANDLE};
+    Device* _device{nullptr};
+
+    friend class CommandBuffer;
+};
+
+} // namespace raum::rhi
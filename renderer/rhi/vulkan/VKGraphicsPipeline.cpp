@@ -15,6 +15,7 @@ _layout(static_cast<PipelineLayout*>(pipelineInfo.pipelineLayout)) {
     pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 
     std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+    bool meshPipeline{false};
     for (auto* rhiSHader : pipelineInfo.shaders) {
         auto* shader = static_cast<Shader*>(rhiSHader);
         if (shader->stage() == ShaderStage::VERTEX) {
@@ -41,6 +42,7 @@ _layout(static_cast<PipelineLayout*>(pipelineInfo.pipelineLayout)) {
             meshStage.module = shader->shaderModule();
             meshStage.pSpecializationInfo = nullptr;
             shaderStages.emplace_back(meshStage);
+            meshPipeline = true;
         } else if (shader->stage() == ShaderStage::FRAGMENT) {
             VkPipelineShaderStageCreateInfo fragmentStage{};
             fragmentStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -103,13 +105,14 @@ _layout(static_cast<PipelineLayout*>(pipelineInfo.pipelineLayout)) {
     vertexInputState.pVertexBindingDescriptions = bindingDescs.data();
     vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attrDescs.size());
     vertexInputState.pVertexAttributeDescriptions = attrDescs.data();
-    pipelineCreateInfo.pVertexInputState = &vertexInputState;
+    // mesh shaders fetch their own vertices and assemble primitives
+    pipelineCreateInfo.pVertexInputState = meshPipeline ? nullptr : &vertexInputState;
 
     VkPipelineInputAssemblyStateCreateInfo iaInfo{};
     iaInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
     iaInfo.topology = primitiveTopology(pipelineInfo.primitiveType);
     iaInfo.primitiveRestartEnable = VK_FALSE;
-    pipelineCreateInfo.pInputAssemblyState = &iaInfo;
+    pipelineCreateInfo.pInputAssemblyState = meshPipeline ? nullptr : &iaInfo;
 
     VkPipelineViewportStateCreateInfo vpInfo{};
     vpInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -0,0 +1,27 @@
+#include "VKHeap.h"
+#include "VKDevice.h"
+#include "core/utils/log.h"
+namespace raum::rhi {
+
+Heap::Heap(const HeapInfo& info, RHIDevice* device)
+: RHIHeap(info, device), _device(static_cast<Device*>(device)) {
+    VkMemoryRequirements requirements{};
+    requirements.size = info.size;
+    // placement offsets are aligned by the caller
+    requirements.alignment = 1;
+    requirements.memoryTypeBits = info.memoryTypeBits;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    allocInfo.priority = 1.0f;
+
+    VkResult res = vmaAllocateMemory(_device->allocator(), &requirements, &allocInfo, &_allocation, nullptr);
+    RAUM_ERROR_IF(res != VK_SUCCESS, "Failed to allocate heap.");
+}
+
+Heap::~Heap() {
+    vmaFreeMemory(_device->allocator(), _allocation);
+}
+
+} // namespace raum::rhi
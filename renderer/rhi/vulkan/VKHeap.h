@@ -0,0 +1,22 @@
+#pragma once
+#include "RHIHeap.h"
+#include "vk_mem_alloc.h"
+namespace raum::rhi {
+class Device;
+class Heap : public RHIHeap {
+public:
+    explicit Heap(const HeapInfo& info, RHIDevice* device);
+    Heap() = delete;
+    Heap(const Heap&) = delete;
+    Heap& operator=(const Heap&) = delete;
+    Heap(Heap&&) = delete;
+
+    ~Heap();
+
+    VmaAllocation allocation() const { return _allocation; }
+
+private:
+    VmaAllocation _allocation{nullptr};
+    Device* _device{nullptr};
+};
+} // namespace raum::rhi
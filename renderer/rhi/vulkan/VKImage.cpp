@@ -1,10 +1,10 @@
 #include "VKImage.h"
 #include "VKUtils.h"
 #include "VKDevice.h"
+#include "VKHeap.h"
 namespace raum::rhi {
 
-Image::Image(const ImageInfo& info, RHIDevice* device)
-: RHIImage(info, device), _device(static_cast<Device*>(device)) {
+VkImageCreateInfo imageCreateInfo(const ImageInfo& info) {
     VkImageCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     createInfo.format = formatInfo(info.format).format;
@@ -26,6 +26,12 @@ Image::Image(const ImageInfo& info, RHIDevice* device)
         createInfo.pQueueFamilyIndices = info.queueAccess.data();
     }
     createInfo.initialLayout = imageLayout(info.initialLayout);
+    return createInfo;
+}
+
+Image::Image(const ImageInfo& info, RHIDevice* device)
+: RHIImage(info, device), _device(static_cast<Device*>(device)) {
+    auto createInfo = imageCreateInfo(_info);
 
     VmaAllocationCreateInfo allocInfo{};
     allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
@@ -36,14 +42,27 @@ Image::Image(const ImageInfo& info, RHIDevice* device)
     RAUM_ERROR_IF(res != VK_SUCCESS, "Failed to create image.");
 }
 
+Image::Image(const ImageInfo& info, RHIDevice* device, RHIHeap* heap, uint64_t offset)
+: RHIImage(info, device), _device(static_cast<Device*>(device)), _placed(true) {
+    auto createInfo = imageCreateInfo(_info);
+    VkResult res = vkCreateImage(_device->device(), &createInfo, nullptr, &_image);
+    RAUM_ERROR_IF(res != VK_SUCCESS, "Failed to create placed image.");
+
+    auto* vkHeap = static_cast<Heap*>(heap);
+    res = vmaBindImageMemory2(_device->allocator(), vkHeap->allocation(), offset, _image, nullptr);
+    RAUM_ERROR_IF(res != VK_SUCCESS, "Failed to bind placed image memory.");
+}
+
 Image::Image(const ImageInfo& imgInfo, RHIDevice* device, VkImage image)
 : RHIImage(imgInfo, device), _swapchain(true), _image(image) {
 }
 
 Image::~Image() {
-    if (!_swapchain) {
+    if (_placed) {
+        vkDestroyImage(_device->device(), _image, nullptr);
+    } else if (!_swapchain) {
         vmaDestroyImage(_device->allocator(), _image, _allocation);
     }
 }
 
-}
\ No newline at end of file
+}
@@ -4,9 +4,13 @@
 namespace raum::rhi {
 class Device;
 class Swapchain;
+
+VkImageCreateInfo imageCreateInfo(const ImageInfo& info);
+
 class Image : public RHIImage {
 public:
     explicit Image(const ImageInfo& imgInfo, RHIDevice* device);
+    explicit Image(const ImageInfo& imgInfo, RHIDevice* device, RHIHeap* heap, uint64_t offset);
     Image() = delete;
     Image(const Image&) = delete;
     Image& operator=(const Image&) = delete;
@@ -18,10 +22,11 @@ public:
 
 private:
     explicit Image(const ImageInfo& imgInfo, RHIDevice* device, VkImage image);
-    VmaAllocation _allocation;
+    VmaAllocation _allocation{nullptr};
     VkImage _image;
     Device* _device{nullptr};
     bool _swapchain{false};
+    bool _placed{false};
 
     friend class Swapchain;
 };
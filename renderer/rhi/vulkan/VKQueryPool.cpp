@@ -0,0 +1,38 @@
+#include "VKQueryPool.h"
+#include <bit>
+#include "VKDevice.h"
+#include "VKUtils.h"
+namespace raum::rhi {
+
+QueryPool::QueryPool(const QueryPoolInfo& info, Device* device) : RHIQueryPool(info, device), _info(info), _device(device) {
+    VkQueryPoolCreateInfo qpi{};
+    qpi.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    qpi.queryType = queryType(info.type);
+    qpi.queryCount = info.count;
+    if (info.type == QueryType::PIPELINE_STATISTICS) {
+        qpi.pipelineStatistics = pipelineStatisticFlags(info.statistics);
+        _valuesPerQuery = std::popcount(static_cast<uint32_t>(info.statistics));
+    }
+
+    auto res = vkCreateQueryPool(_device->device(), &qpi, nullptr, &_queryPool);
+    raum_check(res == VK_SUCCESS, "failed to create query pool!");
+}
+
+bool QueryPool::getResults(uint32_t first, uint32_t count, uint64_t* results) {
+    auto stride = sizeof(uint64_t) * _valuesPerQuery;
+    auto res = vkGetQueryPoolResults(_device->device(),
+                                     _queryPool,
+                                     first,
+                                     count,
+                                     stride * count,
+                                     results,
+                                     stride,
+                                     VK_QUERY_RESULT_64_BIT);
+    return res == VK_SUCCESS;
+}
+
+QueryPool::~QueryPool() {
+    vkDestroyQueryPool(_device->device(), _queryPool, nullptr);
+}
+
+} // namespace raum::rhi
@@ -0,0 +1,28 @@
+#pragma once
+#include "RHIQueryPool.h"
+#include "VKDefine.h"
+namespace raum::rhi {
+class Device;
+class QueryPool : public RHIQueryPool {
+public:
+    explicit QueryPool(const QueryPoolInfo& info, Device* device);
+    QueryPool() = delete;
+    QueryPool(const QueryPool&) = delete;
+    QueryPool& operator=(const QueryPool&) = delete;
+    QueryPool(QueryPool&&) = delete;
+
+    ~QueryPool();
+
+    const QueryPoolInfo& info() const override { return _info; }
+    bool getResults(uint32_t first, uint32_t count, uint64_t* results) override;
+
+    VkQueryPool queryPool() const { return _queryPool; }
+
+private:
+    QueryPoolInfo _info;
+    uint32_t _valuesPerQuery{1};
+    VkQueryPool _queryPool{VK_NULL_HANDLE};
+    Device* _device{nullptr};
+};
+
+} // namespace raum::rhi
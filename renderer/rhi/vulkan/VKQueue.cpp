@@ -6,6 +6,7 @@
 #include "VKSemaphore.h"
 #include "VKSparseImage.h"
 #include "VKUtils.h"
+#include "core/utils/Trace.h"
 namespace raum::rhi {
 Queue::Queue(const QueueInfo& info, Device* device)
 : _device(static_cast<Device*>(device)) {
@@ -18,7 +19,17 @@ Queue::Queue(const QueueInfo& info, Device* device)
     vkGetPhysicalDeviceQueueFamilyProperties(physicDevice, &queueFamilyCount, queueFamilies.data());
 
     std::optional<uint32_t> index;
-    for (size_t i = 0; i < queueFamilies.size(); ++i) {
+    if (_info.type == QueueType::COMPUTE) {
+        // a family without graphics runs asynchronously to the graphics queue
+        for (size_t i = 0; i < queueFamilies.size(); ++i) {
+            const auto flags = queueFamilies[i].queueFlags;
+            if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+                index = static_cast<uint32_t>(i);
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i < queueFamilies.size() && !index.has_value(); ++i) {
         const auto& queueFamily = queueFamilies[i];
         if (_info.type == QueueType::GRAPHICS && queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
             index = static_cast<uint32_t>(i);
@@ -35,6 +46,17 @@ Queue::Queue(const QueueInfo& info, Device* device)
         }
     }
 
+    if (!index.has_value() && _info.type == QueueType::SPARSE) {
+        // sparse binding is unsupported, the queue only exists so that lookups succeed
+        for (size_t i = 0; i < queueFamilies.size(); ++i) {
+            if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+                RAUM_WARN("no sparse binding queue family, falling back to graphics");
+                index = static_cast<uint32_t>(i);
+                break;
+            }
+        }
+    }
+
     // vs warning
     if (index.has_value()) {
         _index = index.value();
@@ -44,12 +66,18 @@ Queue::Queue(const QueueInfo& info, Device* device)
 }
 
 void Queue::initQueue() {
-    _frameFence.resize(FRAMES_IN_FLIGHT);
-    for (auto& fence : _frameFence) {
-        VkFenceCreateInfo info{};
-        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        vkCreateFence(_device->device(), &info, nullptr, &fence);
-    }
+    VkSemaphoreTypeCreateInfo typeInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    VkSemaphoreCreateInfo info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &typeInfo,
+    };
+    VkResult res = vkCreateSemaphore(_device->device(), &info, nullptr, &_timeline);
+    RAUM_CRITICAL_IF(res != VK_SUCCESS, "failed to create timeline semaphore");
+
     _signals.resize(FRAMES_IN_FLIGHT);
     for (auto& sem : _signals) {
         sem = new Semaphore(_device);
@@ -59,9 +87,7 @@ void Queue::initQueue() {
 Queue::~Queue() {
     if (_vkQueue != VK_NULL_HANDLE) {
         vkQueueWaitIdle(_vkQueue);
-        for (auto fence : _frameFence) {
-            vkDestroyFence(_device->device(), fence, nullptr);
-        }
+        vkDestroySemaphore(_device->device(), _timeline, nullptr);
     }
 }
 
@@ -69,7 +95,7 @@ void Queue::enqueue(RHICommandBuffer* cmdBuffer) {
     _commandBuffers.emplace_back(static_cast<CommandBuffer*>(cmdBuffer));
 }
 
-void Queue::submit(bool signal) {
+void Queue::submitCommandBuffers(VkSemaphore signal) {
     VkSubmitInfo info{};
     info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -83,12 +109,15 @@ void Queue::submit(bool signal) {
     // image available & pre task
     std::vector<VkSemaphore> waitSems;
     std::vector<VkPipelineStageFlags> waitStages;
+    // binary semaphores ignore their values
+    std::vector<uint64_t> waitValues;
 
     if (!_waits.empty()) {
         for (auto* s : _waits) {
             waitSems.emplace_back(s->semaphore());
             waitStages.emplace_back(pipelineStageFlags(s->getStage()));
         }
+        waitValues.resize(waitSems.size(), 0);
         info.pWaitSemaphores = waitSems.data();
         info.pWaitDstStageMask = waitStages.data();
 
@@ -98,29 +127,73 @@ void Queue::submit(bool signal) {
         info.pWaitDstStageMask = nullptr;
     }
     info.waitSemaphoreCount = waitSems.size();
-    info.commandBufferCount = static_cast<uint32_t>(_commandBuffers.size());
-    VkSemaphore sem;
-    if (signal) {
-        info.signalSemaphoreCount = 1;
-        sem = _signals[_currFrameIndex]->semaphore();
-        info.pSignalSemaphores = &sem;
-    } else {
-        info.signalSemaphoreCount = 0;
-        info.pSignalSemaphores = nullptr;
-    }
 
-    VkFence lastFence = _frameFence[(_currFrameIndex - 1 + FRAMES_IN_FLIGHT) % FRAMES_IN_FLIGHT];
-    vkQueueSubmit(_vkQueue, 1, &info, lastFence);
-    vkWaitForFences(_device->device(), 1, &lastFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(_device->device(), 1, &_frameFence[_currFrameIndex]);
+    std::array<VkSemaphore, 2> signalSems{_timeline, signal};
+    std::array<uint64_t, 2> signalValues{++_timelineValue, 0};
+    info.signalSemaphoreCount = signal != VK_NULL_HANDLE ? 2 : 1;
+    info.pSignalSemaphores = signalSems.data();
 
+    VkTimelineSemaphoreSubmitInfo timelineInfo{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size()),
+        .pWaitSemaphoreValues = waitValues.data(),
+        .signalSemaphoreValueCount = info.signalSemaphoreCount,
+        .pSignalSemaphoreValues = signalValues.data(),
+    };
+    info.pNext = &timelineInfo;
+
+    vkQueueSubmit(_vkQueue, 1, &info, VK_NULL_HANDLE);
+    _commandBuffers.clear();
+}
+
+void Queue::waitTimeline(uint64_t value) {
+    uint64_t completed{0};
+    vkGetSemaphoreCounterValue(_device->device(), _timeline, &completed);
+    if (completed >= value) {
+        return;
+    }
+    RAUM_TRACE_SCOPE("Queue::waitTimeline");
+    VkSemaphoreWaitInfo waitInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .semaphoreCount = 1,
+        .pSemaphores = &_timeline,
+        .pValues = &value,
+    };
+    vkWaitSemaphores(_device->device(), &waitInfo, UINT64_MAX);
+}
+
+void Queue::nextFrame() {
+    // values only grow, so this covers the flushed batches of the frame too
+    _frameValues[_currFrameIndex] = _timelineValue;
     _currFrameIndex = (_currFrameIndex + 1) % FRAMES_IN_FLIGHT;
+    waitTimeline(_frameValues[_currFrameIndex]);
+
     for (auto& completeFunc : _completeHandlers[_currFrameIndex]) {
         completeFunc();
     }
     _completeHandlers[_currFrameIndex].clear();
-    _commandBuffers.clear();
-    _device->resetStagingBuffer(_index);
+}
+
+void Queue::submit(bool signal) {
+    RAUM_TRACE_SCOPE("Queue::submit");
+    VkSemaphore sem = signal ? _signals[_currFrameIndex]->semaphore() : VK_NULL_HANDLE;
+    submitCommandBuffers(sem);
+    nextFrame();
+    _device->resetStagingBuffer(_index, _currFrameIndex);
+}
+
+void Queue::flush(RHISemaphore* signal) {
+    RAUM_TRACE_SCOPE("Queue::flush");
+    auto sem = signal ? static_cast<Semaphore*>(signal)->semaphore() : VK_NULL_HANDLE;
+    submitCommandBuffers(sem);
+}
+
+void Queue::endFrame() {
+    nextFrame();
+    // a family shared with the graphics queue is reset by its submit, which also waits for the work flushed here
+    if (_index != _device->getQueue({QueueType::GRAPHICS})->index()) {
+        _device->resetStagingBuffer(_index, _currFrameIndex);
+    }
 }
 
 void Queue::bindSparse(const SparseBindingInfo& info, SparseType type) {
@@ -166,17 +239,24 @@ void Queue::bindSparse(const SparseBindingInfo& info, SparseType type) {
     } else {
         bindInfo.waitSemaphoreCount = 0;
     }
-    bindInfo.signalSemaphoreCount = 1;
-    auto signalSem = _signals[_currFrameIndex]->semaphore();
-    bindInfo.pSignalSemaphores = &signalSem;
+    std::vector<uint64_t> waitValues(bindInfo.waitSemaphoreCount, 0);
+    std::array<VkSemaphore, 2> signalSems{_timeline, _signals[_currFrameIndex]->semaphore()};
+    std::array<uint64_t, 2> signalValues{++_timelineValue, 0};
+    bindInfo.signalSemaphoreCount = 2;
+    bindInfo.pSignalSemaphores = signalSems.data();
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size()),
+        .pWaitSemaphoreValues = waitValues.data(),
+        .signalSemaphoreValueCount = bindInfo.signalSemaphoreCount,
+        .pSignalSemaphoreValues = signalValues.data(),
+    };
+    bindInfo.pNext = &timelineInfo;
 
     vkQueueBindSparse(_vkQueue, 1, &bindInfo, VK_NULL_HANDLE);
 
-    _currFrameIndex = (_currFrameIndex + 1) % FRAMES_IN_FLIGHT;
-    for (auto& completeFunc : _completeHandlers[_currFrameIndex]) {
-        completeFunc();
-    }
-    _completeHandlers[_currFrameIndex].clear();
+    nextFrame();
     _commandBuffers.clear();
 }
 
@@ -61,11 +61,15 @@ public:
 
     void submit(bool signal) override;
 
+    void flush(RHISemaphore* signal) override;
+
+    void endFrame() override;
+
     void enqueue(RHICommandBuffer* commandBuffer) override;
 
     void bindSparse(const SparseBindingInfo& info, SparseType type) override;
 
-    void addCompleteHandler(std::function<void()>&& func);
+    void addCompleteHandler(std::function<void()>&& func) override;
 
     VkQueue queue() const { return _vkQueue; }
 
@@ -78,6 +82,10 @@ public:
 private:
     Queue(const QueueInfo& info, Device* device);
     void initQueue();
+    void submitCommandBuffers(VkSemaphore signal);
+    // rotates to the next frame slot, waits until its last submission retired and runs its complete handlers
+    void nextFrame();
+    void waitTimeline(uint64_t value);
 
     VkQueue _vkQueue{VK_NULL_HANDLE};
 
@@ -87,7 +95,12 @@ private:
     Device* _device{nullptr};
 
     std::vector<CommandBuffer*> _commandBuffers;
-    std::vector<VkFence> _frameFence;
+
+    // signaled with an increasing value by every submission on this queue, flushes included
+    VkSemaphore _timeline{VK_NULL_HANDLE};
+    uint64_t _timelineValue{0};
+    // value to wait for before a frame slot is reused
+    std::array<uint64_t, FRAMES_IN_FLIGHT> _frameValues{};
 
     std::vector<Semaphore*> _waits;
     std::vector<Semaphore*> _signals;
@@ -42,13 +42,14 @@ void RenderEncoder::beginRenderPass(const RenderPassBeginInfo& info) {
     beginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     beginInfo.pClearValues = clearValues.data();
 
-    VkSubpassContents contents = _commandBuffer->type() == CommandBufferType::PRIMARY ? VK_SUBPASS_CONTENTS_INLINE : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+    _contents = info.contents;
+    VkSubpassContents contents = _contents == SubpassContents::INLINE ? VK_SUBPASS_CONTENTS_INLINE : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
 
     vkCmdBeginRenderPass(_commandBuffer->commandBuffer(), &beginInfo, contents);
 }
 
 void RenderEncoder::nextSubpass() {
-    VkSubpassContents contents = _commandBuffer->type() == CommandBufferType::PRIMARY ? VK_SUBPASS_CONTENTS_INLINE : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+    VkSubpassContents contents = _contents == SubpassContents::INLINE ? VK_SUBPASS_CONTENTS_INLINE : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
     vkCmdNextSubpass(_commandBuffer->commandBuffer(), contents);
 }
 
@@ -57,7 +58,18 @@ void RenderEncoder::endRenderPass() {
 }
 
 void RenderEncoder::bindPipeline(RHIGraphicsPipeline* pipeline) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_graphicsPipeline == pipeline) {
+        ++stats.pipelineBindsSkipped;
+        return;
+    }
+    ++stats.pipelineBinds;
     _graphicsPipeline = static_cast<GraphicsPipeline*>(pipeline);
+    if (_pipelineLayout != _graphicsPipeline->pipelineLayout()) {
+        // sets bound with another layout are not guaranteed to be compatible
+        _pipelineLayout = _graphicsPipeline->pipelineLayout();
+        _descriptorSets.fill(nullptr);
+    }
     vkCmdBindPipeline(_commandBuffer->commandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, _graphicsPipeline->pipeline());
 }
 
@@ -120,7 +132,16 @@ void RenderEncoder::setStencilReference(FaceMode face, uint32_t ref) {
 }
 
 void RenderEncoder::bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t index, uint32_t* dynamicOffsets, uint32_t dynOffsetCount) {
-    auto* descSet = static_cast<DescriptorSet*>(descriptorSet)->descriptorSet();
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (!dynOffsetCount && index < _descriptorSets.size() && _descriptorSets[index] == descriptorSet) {
+        ++stats.descriptorSetBindsSkipped;
+        return;
+    }
+    ++stats.descriptorSetBinds;
+    if (index < _descriptorSets.size()) {
+        // dynamic offsets may change between binds of the same set
+        _descriptorSets[index] = dynOffsetCount ? nullptr : descriptorSet;
+    }
     VkDescriptorSet kSet = static_cast<DescriptorSet*>(descriptorSet)->descriptorSet();
     vkCmdBindDescriptorSets(_commandBuffer->commandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -133,11 +154,27 @@ void RenderEncoder::bindDescriptorSet(RHIDescriptorSet* descriptorSet, uint32_t
 }
 
 void RenderEncoder::bindIndexBuffer(RHIBuffer* buffer, uint32_t offset, IndexType type) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_indexBuffer == buffer && _indexOffset == offset && _indexType == type) {
+        ++stats.indexBufferBindsSkipped;
+        return;
+    }
+    ++stats.indexBufferBinds;
+    _indexBuffer = buffer;
+    _indexOffset = offset;
+    _indexType = type;
     auto* kBuffer = static_cast<Buffer*>(buffer);
     vkCmdBindIndexBuffer(_commandBuffer->commandBuffer(), kBuffer->buffer(), offset, indexType(type));
 }
 
 void RenderEncoder::bindVertexBuffer(RHIBuffer* buffer, uint32_t index) {
+    auto& stats = _commandBuffer->renderEncoderStats();
+    if (_vertexBuffer == buffer) {
+        ++stats.vertexBufferBindsSkipped;
+        return;
+    }
+    ++stats.vertexBufferBinds;
+    _vertexBuffer = buffer;
     auto* kBuffer = static_cast<Buffer*>(buffer);
     VkBuffer buff = kBuffer->buffer();
     VkDeviceSize offset = 0;
@@ -145,28 +182,66 @@ void RenderEncoder::bindVertexBuffer(RHIBuffer* buffer, uint32_t index) {
 }
 
 void RenderEncoder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
     vkCmdDraw(_commandBuffer->commandBuffer(), vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
 void RenderEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t vertexOffset, uint32_t firstInstance) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
     vkCmdDrawIndexed(_commandBuffer->commandBuffer(), indexCount, instanceCount, firstVertex, vertexOffset, firstInstance);
 }
 
 void RenderEncoder::drawIndirect(RHIBuffer* buffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
     auto* kBuffer = static_cast<Buffer*>(buffer);
     vkCmdDrawIndirect(_commandBuffer->commandBuffer(), kBuffer->buffer(), offset, drawCount, stride);
 }
 
 void RenderEncoder::drawIndexedIndirect(RHIBuffer* buffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
     auto* kBuffer = static_cast<Buffer*>(buffer);
     vkCmdDrawIndexedIndirect(_commandBuffer->commandBuffer(), kBuffer->buffer(), offset, drawCount, stride);
 }
 
+void RenderEncoder::drawIndexedIndirectCount(RHIBuffer* buffer,
+                                             uint32_t offset,
+                                             RHIBuffer* countBuffer,
+                                             uint32_t countOffset,
+                                             uint32_t maxDrawCount,
+                                             uint32_t stride) {
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    auto* kBuffer = static_cast<Buffer*>(buffer);
+    auto* kCountBuffer = static_cast<Buffer*>(countBuffer);
+    vkCmdDrawIndexedIndirectCount(_commandBuffer->commandBuffer(),
+                                  kBuffer->buffer(),
+                                  offset,
+                                  kCountBuffer->buffer(),
+                                  countOffset,
+                                  maxDrawCount,
+                                  stride);
+}
+
+void RenderEncoder::drawMeshTasksIndirect(RHIBuffer* buffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+    auto drawMeshTasks = _commandBuffer->device()->cmdDrawMeshTasksIndirect();
+    RAUM_ERROR_IF(!drawMeshTasks, "mesh shader is not supported.");
+    ++_commandBuffer->renderEncoderStats().drawCalls;
+    auto* kBuffer = static_cast<Buffer*>(buffer);
+    drawMeshTasks(_commandBuffer->commandBuffer(), kBuffer->buffer(), offset, drawCount, stride);
+}
+
 void RenderEncoder::pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) {
     VkShaderStageFlags stageFlag = shaderStageFlags(stage);
     vkCmdPushConstants(_commandBuffer->commandBuffer(), _graphicsPipeline->pipelineLayout()->layout(), stageFlag, offset, size, static_cast<uint32_t*>(data));
 }
 
+void RenderEncoder::executeCommands(RHICommandBuffer** commandBuffers, uint32_t count) {
+    std::vector<VkCommandBuffer> cmds(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        cmds[i] = static_cast<CommandBuffer*>(commandBuffers[i])->commandBuffer();
+    }
+    vkCmdExecuteCommands(_commandBuffer->commandBuffer(), count, cmds.data());
+}
+
 void RenderEncoder::clearAttachment(uint32_t* attachmentIndices, uint32_t attachmentNum, ClearValue * clearValues, ClearRect* rects, uint32_t recNum) {
     std::vector<VkClearAttachment> attachments(attachmentNum);
     fillClearAttachment(attachments, clearValues, attachmentIndices, attachmentNum, _renderPass->attachments());
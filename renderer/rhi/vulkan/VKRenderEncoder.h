@@ -5,6 +5,7 @@ namespace raum::rhi {
 class CommandBuffer;
 class GraphicsPipeline;
 class RenderPass;
+class PipelineLayout;
 class RenderEncoder : public RHIRenderEncoder {
 public:
     explicit RenderEncoder(CommandBuffer* commandBuffer, RenderEncoderHint hint);
@@ -33,7 +34,15 @@ public:
     void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t vertexOffset, uint32_t firstInstance) override;
     void drawIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
     void drawIndexedIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
+    void drawIndexedIndirectCount(RHIBuffer* indirectBuffer,
+                                  uint32_t offset,
+                                  RHIBuffer* countBuffer,
+                                  uint32_t countOffset,
+                                  uint32_t maxDrawCount,
+                                  uint32_t stride) override;
+    void drawMeshTasksIndirect(RHIBuffer* indirectBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
     void pushConstants(ShaderStage stage, uint32_t offset, void* data, uint32_t size) override;
+    void executeCommands(RHICommandBuffer** commandBuffers, uint32_t count) override;
 
     void clearAttachment(uint32_t* attachmentIndices, uint32_t attachmentNum, ClearValue* value, ClearRect* rects, uint32_t recNum) override;
 
@@ -42,6 +51,15 @@ private:
     GraphicsPipeline* _graphicsPipeline{nullptr};
     RenderPass* _renderPass{nullptr};
     RenderEncoderHint _hint{RenderEncoderHint::NONE};
+    SubpassContents _contents{SubpassContents::INLINE};
+
+    // currently bound state, redundant binds are skipped
+    PipelineLayout* _pipelineLayout{nullptr};
+    std::array<RHIDescriptorSet*, BindingRateCount> _descriptorSets{};
+    RHIBuffer* _indexBuffer{nullptr};
+    uint32_t _indexOffset{0};
+    IndexType _indexType{IndexType::FULL};
+    RHIBuffer* _vertexBuffer{nullptr};
 };
 
 } // namespace raum::rhi
\ No newline at end of file
@@ -13,7 +13,8 @@ Shader::Shader(const ShaderSourceInfo& shaderInfo, RHIDevice* device)
     shaderc::Compiler shaderCompiler{};
     shaderc::CompileOptions options{};
     options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
-    options.SetTargetSpirv(shaderc_spirv_version_1_3);
+    // GL_EXT_mesh_shader needs 1.4
+    options.SetTargetSpirv(shaderc_spirv_version_1_4);
     options.SetOptimizationLevel(shaderc_optimization_level_performance);
     options.SetGenerateDebugInfo();
 
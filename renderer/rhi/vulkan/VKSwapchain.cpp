@@ -11,6 +11,7 @@
 #include "VKQueue.h"
 #include "VKSemaphore.h"
 #include "VKUtils.h"
+#include "core/utils/Trace.h"
 
 namespace raum::rhi {
 
@@ -122,12 +123,17 @@ void Swapchain::initialize(uintptr_t hwnd, SyncType type, uint32_t width, uint32
     _valid.resize(imageCount, 0);
 
 #else
-    #pragma error Run Away
+    // render offscreen with RHIOffscreenSwapchain instead
+    RAUM_CRITICAL_IF(true, "window surfaces are only implemented for win32");
+    uint32_t imageCount{0};
 #endif
 
-    _acquireSemaphores.resize(imageCount);
-    for (auto& sem : _acquireSemaphores) {
-        sem = new Semaphore(_device);
+    // one per frame in flight, a semaphore is signaled again only after the frame waiting on it retired
+    if (_acquireSemaphores.empty()) {
+        _acquireSemaphores.resize(FRAMES_IN_FLIGHT);
+        for (auto& sem : _acquireSemaphores) {
+            sem = new Semaphore(_device);
+        }
     }
 }
 
@@ -148,15 +154,17 @@ void Swapchain::addWaitBeforePresent(RHISemaphore* s) {
 }
 
 RHISemaphore* Swapchain::getAvailableByAcquire() {
-    return _acquireSemaphores[_imageIndex];
+    return _acquireSemaphores[_frameIndex];
 }
 
 bool Swapchain::acquire() {
-    auto imageAvailableSem = _acquireSemaphores[_imageIndex];
+    RAUM_TRACE_SCOPE("Swapchain::acquire");
+    auto imageAvailableSem = _acquireSemaphores[_frameIndex];
     return vkAcquireNextImageKHR(_device->device(), _swapchain, UINT64_MAX, imageAvailableSem->semaphore(), VK_NULL_HANDLE, &_imageIndex) == VK_SUCCESS;
 }
 
 void Swapchain::present() {
+    RAUM_TRACE_SCOPE("Swapchain::present");
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
@@ -178,6 +186,7 @@ void Swapchain::present() {
     presentInfo.pImageIndices = &_imageIndex;
     presentInfo.pResults = nullptr;
     vkQueuePresentKHR(_presentQueue->_vkQueue, &presentInfo);
+    _frameIndex = (_frameIndex + 1) % FRAMES_IN_FLIGHT;
 }
 
 void Swapchain::destroy() {
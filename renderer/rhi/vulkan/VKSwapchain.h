@@ -45,6 +45,7 @@ private:
     Queue* _presentQueue{nullptr};
 
     uint32_t _imageIndex{0};
+    uint32_t _frameIndex{0};
     std::vector<VkImage> _vkImages;
     std::vector<uint32_t> _valid;
     std::vector<Semaphore*> _acquireSemaphores;
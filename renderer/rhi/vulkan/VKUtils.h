@@ -77,6 +77,10 @@ VkImageAspectFlags aspectMask(AspectMask mask);
 
 VkCommandBufferLevel commandBufferLevel(CommandBufferType commandBufferLevel);
 
+VkQueryType queryType(QueryType type);
+
+VkQueryPipelineStatisticFlags pipelineStatisticFlags(PipelineStatistic statistics);
+
 void fillClearColors(std::vector<VkClearValue>& clearValues,
                      ClearValue* colors,
                      const std::vector<AttachmentInfo>& attachmentInfos);
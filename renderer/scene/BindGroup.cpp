@@ -3,15 +3,21 @@
 #include <algorithm>
 namespace raum::scene {
 
+namespace {
+// starts a full ring ahead, sets never handed out look long retired
+std::atomic<uint64_t> frameCount{rhi::FRAMES_IN_FLIGHT};
+} // namespace
+
 BindGroup::BindGroup(const SlotMap &bindings, rhi::DescriptorSetLayoutPtr layout, rhi::DevicePtr device)
 :_device(device), _bindingMap(bindings) {
-    const auto& poolInfo = rhi::makeDescriptorPoolInfo({layout.get()});
+    // room for a set per frame in flight, they are allocated on the first update reaching them
+    const auto& poolInfo = rhi::makeDescriptorPoolInfo(std::vector<rhi::RHIDescriptorSetLayout*>(rhi::FRAMES_IN_FLIGHT, layout.get()));
     _descriptorSetPool = rhi::DescriptorPoolPtr(device->createDescriptorPool(poolInfo));
     rhi::DescriptorSetInfo descSetInfo{
         .layout = layout.get(),
         .bindingInfos = {},
     };
-    _descriptorSet = rhi::DescriptorSetPtr (_descriptorSetPool->makeDescriptorSet(descSetInfo));
+    _descriptorSets[_setIndex] = rhi::DescriptorSetPtr (_descriptorSetPool->makeDescriptorSet(descSetInfo));
     _descriptorSetLayout = layout;
     _updateIndices.resize(16);
 
@@ -104,11 +110,16 @@ BindGroup::BindGroup(const SlotMap &bindings, rhi::DescriptorSetLayoutPtr layout
             }
         }
     }
-    _descriptorSet->update(_currentBinding);
+    _descriptorSets[_setIndex]->update(_currentBinding);
 }
 
 rhi::DescriptorSetPtr BindGroup::descriptorSet() const {
-    return _descriptorSet;
+    _handOutFrames[_setIndex].store(frameCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return _descriptorSets[_setIndex];
+}
+
+void BindGroup::nextFrame() {
+    frameCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void BindGroup::bindBuffer(std::string_view name, uint32_t index, rhi::BufferPtr buffer) {
@@ -186,18 +197,27 @@ void BindGroup::bindTexelBuffer(std::string_view name, uint32_t index, rhi::Buff
 }
 
 void BindGroup::update() {
-    for(auto& bufferBinding : _updateInfo.bufferBindings) {
-        _descriptorSet->updateBuffer(bufferBinding);
-    }
-    for(auto& imageBinding  : _updateInfo.imageBindings) {
-        _descriptorSet->updateImage(imageBinding);
+    if(_updateInfo.bufferBindings.empty() &&
+       _updateInfo.imageBindings.empty() &&
+       _updateInfo.samplerBindings.empty() &&
+       _updateInfo.texelBufferBindings.empty()) {
+        return;
     }
-    for(auto& samplerBinding : _updateInfo.samplerBindings) {
-        _descriptorSet->updateSampler(samplerBinding);
-    }
-    for(auto& texelBufferBinding : _updateInfo.texelBufferBindings) {
-        _descriptorSet->updateTexelBuffer(texelBufferBinding);
+
+    // the next set was written FRAMES_IN_FLIGHT updates ago and misses the writes since, so it gets all bindings
+    _setIndex = (_setIndex + 1) % rhi::FRAMES_IN_FLIGHT;
+    raum_check(frameCount.load(std::memory_order_relaxed) - _handOutFrames[_setIndex].load(std::memory_order_relaxed) >= rhi::FRAMES_IN_FLIGHT,
+               "bind group updated more than once per frame, set {} may still be read by a frame in flight", _setIndex);
+    auto& descriptorSet = _descriptorSets[_setIndex];
+    if(!descriptorSet) {
+        rhi::DescriptorSetInfo descSetInfo{
+            .layout = _descriptorSetLayout.get(),
+            .bindingInfos = {},
+        };
+        descriptorSet = rhi::DescriptorSetPtr(_descriptorSetPool->makeDescriptorSet(descSetInfo));
     }
+    descriptorSet->update(_currentBinding);
+
     _updateInfo.bufferBindings.clear();
     _updateInfo.imageBindings.clear();
     _updateInfo.samplerBindings.clear();
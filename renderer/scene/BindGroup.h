@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <boost/container/flat_map.hpp>
 #include "RHIDescriptorSetLayout.h"
 #include "RHIDevice.h"
@@ -12,6 +13,7 @@ public:
               rhi::DescriptorSetLayoutPtr layout,
               rhi::DevicePtr device);
 
+    // the set written by the last update, bind it after updating. Stamped with the current frame.
     rhi::DescriptorSetPtr descriptorSet() const;
 
     bool contains(std::string_view slotName) const;
@@ -38,12 +40,20 @@ public:
                          uint32_t index,
                          rhi::BufferViewPtr bufferView);
 
+    // writes pending bindings into the next of FRAMES_IN_FLIGHT sets, the previous ones may still be read by frames
+    // in flight. Called at most once per frame, checks the next set wasn't handed out by one of the last frames.
     void update();
 
+    // once per frame, after recording it.
+    static void nextFrame();
+
 private:
     SlotMap _bindingMap;
     rhi::DescriptorPoolPtr _descriptorSetPool;
-    rhi::DescriptorSetPtr _descriptorSet;
+    std::array<rhi::DescriptorSetPtr, rhi::FRAMES_IN_FLIGHT> _descriptorSets;
+    uint32_t _setIndex{0};
+    // frame each set was last handed out in
+    mutable std::array<std::atomic<uint64_t>, rhi::FRAMES_IN_FLIGHT> _handOutFrames{};
     rhi::DescriptorSetLayoutPtr _descriptorSetLayout;
     rhi::BindingInfo _currentBinding;
     rhi::BindingInfo _updateInfo;
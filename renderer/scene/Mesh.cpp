@@ -1,6 +1,5 @@
 #include "Mesh.h"
-#include "RHICommandBuffer.h"
-#include "RHIBlitEncoder.h"
+#include <algorithm>
 namespace raum::scene {
 
 MeshData& Mesh::meshData() {
@@ -19,6 +18,30 @@ const AABB& Mesh::aabb() const {
     return _aabb;
 }
 
+void Mesh::setOccluder(OccluderMeshPtr occluder) {
+    _occluder = occluder;
+}
+
+const OccluderMeshPtr& Mesh::occluder() const {
+    return _occluder;
+}
+
+std::vector<MeshLod>& Mesh::lods() {
+    return _lods;
+}
+
+const std::vector<MeshLod>& Mesh::lods() const {
+    return _lods;
+}
+
+MeshletData& Mesh::meshletData() {
+    return _meshletData;
+}
+
+const MeshletData& Mesh::meshletData() const {
+    return _meshletData;
+}
+
 MeshRenderer::MeshRenderer(MeshPtr mesh) : _mesh(mesh) {}
 
 void MeshRenderer::addTechnique(TechniquePtr tech) {
@@ -56,47 +79,23 @@ std::vector<TechniquePtr>& MeshRenderer::techniques() {
     return _techs;
 }
 
-BindGroupPtr MeshRenderer::bindGroup() {
-    return _bindGroup;
-}
-
 const DrawInfo& MeshRenderer::drawInfo() const {
     return _drawInfo;
 }
 
 void MeshRenderer::setTransform(const Mat4& transform) {
     _transform = transform;
-    _dirty = true;
-}
-
-void MeshRenderer::setTransformSlot(std::string_view name) {
-    _localSLotName = name;
-}
-
-void MeshRenderer::prepare(
-    const SlotMap& bindings,
-    rhi::DescriptorSetLayoutPtr layout,
-    rhi::DevicePtr device) {
-    if(!_bindGroup) {
-        _bindGroup = std::make_shared<BindGroup>(bindings, layout, device);
-        rhi::BufferSourceInfo bsInfo{
-            .bufferUsage = rhi::BufferUsage::UNIFORM | rhi::BufferUsage::TRANSFER_DST,
-            .size = 16 * sizeof(float),
-            .data = &_transform[0],
-        };
-        _localBuffer = rhi::BufferPtr(device->createBuffer(bsInfo));
-    }
+    ++_transformVersion;
 }
 
-void MeshRenderer::update(rhi::CommandBufferPtr cmdBuffer) {
-    if (!_localSLotName.empty()) {
-        if (_dirty) {
-            auto blitEncoder = rhi::BlitEncoderPtr(cmdBuffer->makeBlitEncoder());
-            blitEncoder->updateBuffer(_localBuffer.get(), 0, &_transform[0], 16 * sizeof(float));
-        }
-        _bindGroup->bindBuffer(_localSLotName, 0, _localBuffer);
-        _bindGroup->update();
+void MeshRenderer::setLod(uint32_t lod) {
+    const auto& lods = _mesh->lods();
+    if (lods.empty()) {
+        return;
     }
+    _lod = std::min(lod, static_cast<uint32_t>(lods.size()) - 1);
+    _drawInfo.firstVertex = lods[_lod].firstIndex;
+    _drawInfo.indexCount = lods[_lod].indexCount;
 }
 
 
@@ -26,6 +26,53 @@ struct MeshData {
     uint32_t indexCount{0};
 };
 
+// index range of a level of detail, all levels share the mesh index buffer. `error` is the simplification
+// error in mesh space units, 0 for full detail.
+struct MeshLod {
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    float error{0.0f};
+};
+
+// cluster of the full detail triangles, culled on its own by the gpu driven path. Bounds and cone are in
+// mesh space, a cone cutoff of 1 or more never culls. Matches Meshlet in gltfpbr.mesh.
+struct Meshlet {
+    Vec3f center{};
+    float radius{0.0f};
+    Vec3f coneApex{};
+    float coneCutoff{1.0f};
+    Vec3f coneAxis{};
+    // triangles * 3 indices of the full detail range, drawn by the vertex shader path
+    uint32_t firstIndex{0};
+    // into MeshletData vertices and triangles, read by the mesh shader path
+    uint32_t vertexOffset{0};
+    uint32_t triangleOffset{0};
+    uint32_t vertexCount{0};
+    uint32_t triangleCount{0};
+};
+static_assert(sizeof(Meshlet) == 64);
+
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    // mesh vertex of each meshlet vertex
+    std::vector<uint32_t> vertices;
+    // three meshlet vertices per triangle, each meshlet starts 4 byte aligned
+    std::vector<uint8_t> triangles;
+    // uploaded when the device supports mesh shaders
+    rhi::BufferPtr meshletBuffer;
+    rhi::BufferPtr vertexBuffer;
+    rhi::BufferPtr triangleBuffer;
+};
+
+// triangles rasterized by software occlusion culling, in the space of the vertex buffer. Meshes keep no cpu
+// copy of their vertices, the application supplies the geometry, usually a simplified hull.
+struct OccluderMesh {
+    std::vector<Vec3f> positions;
+    std::vector<uint32_t> indices;
+    AABB aabb;
+};
+using OccluderMeshPtr = std::shared_ptr<const OccluderMesh>;
+
 class Mesh {
 public:
     Mesh() = default;
@@ -36,9 +83,23 @@ public:
     AABB& aabb();
     const AABB& aabb() const;
 
+    void setOccluder(OccluderMeshPtr occluder);
+    const OccluderMeshPtr& occluder() const;
+
+    // finest first, empty without a generated chain
+    std::vector<MeshLod>& lods();
+    const std::vector<MeshLod>& lods() const;
+
+    // empty without generated meshlets
+    MeshletData& meshletData();
+    const MeshletData& meshletData() const;
+
 private:
     MeshData _data;
     AABB _aabb;
+    OccluderMeshPtr _occluder;
+    std::vector<MeshLod> _lods;
+    MeshletData _meshletData;
 };
 
 using MeshPtr = std::shared_ptr<Mesh>;
@@ -64,6 +125,7 @@ using MeshRef = std::reference_wrapper<Mesh>;
 struct DrawInfo {
     uint32_t firstVertex{0};
     uint32_t vertexCount{0};
+    // the render graph draws with the object slot as first instance
     uint32_t firstInstance{0};
     uint32_t instanceCount{1};
     uint32_t indexCount{0};
@@ -81,34 +143,30 @@ public:
     void setVertexInfo(uint32_t firstVertex, uint32_t vertexCount, uint32_t indexCount);
     void setInstanceInfo(uint32_t firstInstance, uint32_t instanceCount);
     void setTransform(const Mat4& transform);
-
-    void setTransformSlot(std::string_view name);
+    // draws the index range of mesh()->lods()[lod], clamped to the coarsest level. Meshes without lods ignore it.
+    void setLod(uint32_t lod);
 
     const MeshPtr& mesh() const;
     TechniquePtr technique(uint32_t index);
     const DrawInfo& drawInfo() const;
+    const Mat4& transform() const { return _transform; }
+    uint32_t lod() const { return _lod; }
+    // bumped by setTransform, object buffers compare it to skip clean slots
+    uint64_t transformVersion() const { return _transformVersion; }
     std::vector<TechniquePtr>& techniques();
-    BindGroupPtr bindGroup();
-
-    void prepare(const SlotMap& bindings,
-                 rhi::DescriptorSetLayoutPtr layout,
-                 rhi::DevicePtr device);
-
-    void update(rhi::CommandBufferPtr cmdBuffer);
 
-    
-    bool hasInstanceBinding() const;
-    bool hasPassBinding() const;
+    // index of the transform in the shared object data buffer, assigned by the render graph
+    void setObjectSlot(uint32_t slot) { _objectSlot = slot; }
+    uint32_t objectSlot() const { return _objectSlot; }
 
 private:
-    bool _dirty{false};
-    std::string _localSLotName;
     MeshPtr _mesh;
     std::vector<TechniquePtr> _techs;
     DrawInfo _drawInfo{};
     Mat4 _transform{1.0};
-    BindGroupPtr _bindGroup;
-    rhi::BufferPtr _localBuffer;
+    uint64_t _transformVersion{0};
+    uint32_t _objectSlot{0};
+    uint32_t _lod{0};
 };
 using MeshRendererPtr = std::shared_ptr<MeshRenderer>;
 
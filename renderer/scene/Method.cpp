@@ -113,11 +113,11 @@ Method::Pool& Method::pool() {
     return pool;
 }
 
-MethodPtr Method::Pool::makeMethod(std::string_view programName, flat_set<std::string> defines) {
+MethodPtr Method::Pool::makeMethod(std::string_view programName, flat_set<std::string> defines, std::string_view instance) {
     size_t seed = 9527;
     boost::hash_combine(seed, programName);
     boost::hash_combine(seed, defines);
-    auto* t = new Method(programName, defines);
+    boost::hash_combine(seed, instance);
     if (!_methods.contains(seed)) {
         _methods.emplace(seed, MethodPtr(new Method(programName, defines)));
     }
@@ -90,12 +90,13 @@ public:
     public:
         void clear();
         void shrink();
-        MethodPtr makeMethod(std::string_view programName, flat_set<std::string> defines);
+        // methods of different `instance`s own their bind groups, shaders and pipelines are shared anyway
+        MethodPtr makeMethod(std::string_view programName, flat_set<std::string> defines, std::string_view instance = {});
     };
 
     static Pool& pool();
 
-    friend MethodPtr Pool::makeMethod(std::string_view programName, flat_set<std::string> defines);
+    friend MethodPtr Pool::makeMethod(std::string_view programName, flat_set<std::string> defines, std::string_view instance);
 
 private:
 
@@ -1,5 +1,10 @@
 #include "Scene.h"
+#include <array>
+#include <bit>
 #include "Common.h"
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
 
 namespace raum::scene {
 
@@ -19,28 +24,180 @@ float distance(const Vec3f& point, const Plane& plane) {
 }
 
 bool frustumCulling(const scene::FrustumPlanes& frustum, const AABB& aabb) {
-    bool outside = false;
     for (const auto& plane : frustum) {
         Vec3f mostPoint{};
         mostPoint.x = plane.normal.x > 0 ? aabb.maxBound.x : aabb.minBound.x;
         mostPoint.y = plane.normal.y > 0 ? aabb.maxBound.y : aabb.minBound.y;
         mostPoint.z = plane.normal.z > 0 ? aabb.maxBound.z : aabb.minBound.z;
+        // called per object, skip the normal check of distance()
+        if (glm::dot(plane.normal, mostPoint - plane.point) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
 
-        auto dist = distance(mostPoint, plane);
-        if (distance(mostPoint, plane) < 0.0f) {
-            outside = true;
-            break;
+void BoundsSoA::resize(uint32_t size) {
+    for (auto* component : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+        component->resize(size);
+    }
+}
+
+void BoundsSoA::set(uint32_t index, const AABB& aabb) {
+    minX[index] = aabb.minBound.x;
+    minY[index] = aabb.minBound.y;
+    minZ[index] = aabb.minBound.z;
+    maxX[index] = aabb.maxBound.x;
+    maxY[index] = aabb.maxBound.y;
+    maxZ[index] = aabb.maxBound.z;
+}
+
+AABB BoundsSoA::get(uint32_t index) const {
+    return {{minX[index], minY[index], minZ[index]}, {maxX[index], maxY[index], maxZ[index]}};
+}
+
+namespace {
+
+// the sign of a plane normal picks the same corner for every box, so each plane reads one array per axis.
+struct CullPlane {
+    const float* x;
+    const float* y;
+    const float* z;
+    float nx;
+    float ny;
+    float nz;
+    float d;
+};
+
+uint32_t cullScalar(const std::array<CullPlane, 6>& planes, uint32_t begin, uint32_t end, uint32_t* visible) {
+    uint32_t count{0};
+    for (uint32_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (const auto& plane : planes) {
+            inside &= plane.nx * plane.x[i] + plane.ny * plane.y[i] + plane.nz * plane.z[i] + plane.d >= 0.0f;
         }
+        visible[count] = i;
+        count += inside;
     }
-    return !outside;
+    return count;
 }
 
-void buildBVH(BVHNode* node, std::vector<scene::ModelPtr>& models) {
-    raum_check(node, "");
+#if defined(__AVX2__)
+constexpr CullKernel WIDEST_KERNEL = CullKernel::AVX2;
+#elif defined(__SSE2__) || defined(_M_X64)
+constexpr CullKernel WIDEST_KERNEL = CullKernel::SSE;
+#else
+constexpr CullKernel WIDEST_KERNEL = CullKernel::SCALAR;
+#endif
 
+#if defined(__SSE2__) || defined(_M_X64)
+// advances `i` past the last full group of 4, the rest is left to cullScalar
+uint32_t cullSSE(const std::array<CullPlane, 6>& planes, uint32_t& i, uint32_t end, uint32_t* visible) {
+    uint32_t visibleCount{0};
+    for (; i + 4 <= end; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.nx), _mm_loadu_ps(plane.x + i)), _mm_set1_ps(plane.d));
+            dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.ny), _mm_loadu_ps(plane.y + i)), dist);
+            dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.nz), _mm_loadu_ps(plane.z + i)), dist);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+        }
+        for (auto mask = static_cast<uint32_t>(_mm_movemask_ps(inside)); mask; mask &= mask - 1) {
+            visible[visibleCount++] = i + std::countr_zero(mask);
+        }
+    }
+    return visibleCount;
+}
+#endif
 
+#if defined(__AVX2__)
+uint32_t cullAVX2(const std::array<CullPlane, 6>& planes, uint32_t& i, uint32_t end, uint32_t* visible) {
+    uint32_t visibleCount{0};
+    for (; i + 8 <= end; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            __m256 dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.nx), _mm256_loadu_ps(plane.x + i)), _mm256_set1_ps(plane.d));
+            dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.ny), _mm256_loadu_ps(plane.y + i)), dist);
+            dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.nz), _mm256_loadu_ps(plane.z + i)), dist);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        for (auto mask = static_cast<uint32_t>(_mm256_movemask_ps(inside)); mask; mask &= mask - 1) {
+            visible[visibleCount++] = i + std::countr_zero(mask);
+        }
+    }
+    return visibleCount;
+}
+#endif
+
+} // namespace
+
+bool cullKernelAvailable(CullKernel kernel) {
+    switch (kernel) {
+        case CullKernel::SCALAR:
+            return true;
+        case CullKernel::SSE:
+#if defined(__SSE2__) || defined(_M_X64)
+            return true;
+#else
+            return false;
+#endif
+        case CullKernel::AVX2:
+#if defined(__AVX2__)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+uint32_t frustumCulling(const scene::FrustumPlanes& frustum,
+                        const BoundsSoA& bounds,
+                        uint32_t first,
+                        uint32_t count,
+                        uint32_t* visible) {
+    return frustumCulling(frustum, bounds, first, count, visible, WIDEST_KERNEL);
 }
 
+uint32_t frustumCulling(const scene::FrustumPlanes& frustum,
+                        const BoundsSoA& bounds,
+                        uint32_t first,
+                        uint32_t count,
+                        uint32_t* visible,
+                        CullKernel kernel) {
+    raum_check(cullKernelAvailable(kernel), "cull kernel {} not built", static_cast<uint32_t>(kernel));
+    std::array<CullPlane, 6> planes;
+    for (uint32_t i = 0; i < planes.size(); ++i) {
+        const auto& plane = frustum[i];
+        planes[i] = {
+            plane.normal.x > 0 ? bounds.maxX.data() : bounds.minX.data(),
+            plane.normal.y > 0 ? bounds.maxY.data() : bounds.minY.data(),
+            plane.normal.z > 0 ? bounds.maxZ.data() : bounds.minZ.data(),
+            plane.normal.x,
+            plane.normal.y,
+            plane.normal.z,
+            -glm::dot(plane.normal, plane.point),
+        };
+    }
 
+    uint32_t i = first;
+    uint32_t end = first + count;
+    uint32_t visibleCount{0};
+    switch (kernel) {
+#if defined(__AVX2__)
+        case CullKernel::AVX2:
+            visibleCount = cullAVX2(planes, i, end, visible);
+            break;
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        case CullKernel::SSE:
+            visibleCount = cullSSE(planes, i, end, visible);
+            break;
+#endif
+        default:
+            break;
+    }
+    return visibleCount + cullScalar(planes, i, end, visible + visibleCount);
+}
 
-}
\ No newline at end of file
+}
@@ -14,17 +14,49 @@ public:
     std::vector<Model> models;
 };
 
-struct BVHNode {
-    BVHNode* left{nullptr};
-    BVHNode* right{nullptr};
-    AABB aabb{};
-    std::span<RenderablePtr> children;
+// should be rendered / inside or intersect with frustum
+bool frustumCulling(const scene::FrustumPlanes& frustum, const AABB& aabb);
+
+// bounds in structure of arrays form, one array per component
+struct BoundsSoA {
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> minZ;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    std::vector<float> maxZ;
+
+    uint32_t size() const { return static_cast<uint32_t>(minX.size()); }
+    void resize(uint32_t size);
+    void set(uint32_t index, const AABB& aabb);
+    AABB get(uint32_t index) const;
 };
 
-void buildBVH(BVHNode* node, std::vector<scene::ModelPtr>& models);
+// batch version of frustumCulling, 8 boxes per iteration with AVX2, 4 with SSE, scalar otherwise. Writes the
+// indices of the visible boxes in [first, first + count) to `visible`, which needs room for `count`, and
+// returns how many.
+uint32_t frustumCulling(const scene::FrustumPlanes& frustum,
+                        const BoundsSoA& bounds,
+                        uint32_t first,
+                        uint32_t count,
+                        uint32_t* visible);
+
+// instruction sets of the batch kernel, AVX2 is only built with RAUM_ENABLE_AVX2.
+enum class CullKernel : uint8_t {
+    SCALAR,
+    SSE,
+    AVX2,
+};
 
-// should be rendered / inside or intersect with frustum
-bool frustumCulling(const scene::FrustumPlanes& frustum, const AABB& aabb);
+bool cullKernelAvailable(CullKernel kernel);
+
+// forces one kernel, for comparing them
+uint32_t frustumCulling(const scene::FrustumPlanes& frustum,
+                        const BoundsSoA& bounds,
+                        uint32_t first,
+                        uint32_t count,
+                        uint32_t* visible,
+                        CullKernel kernel);
 
 float distance(const Vec3f& point, const Plane& plane);
 
@@ -12,7 +12,7 @@ std::unordered_map<std::size_t, rhi::ShaderPtr> _shaderMap;
 } // namespace
 
 Technique::Technique(MaterialPtr material, std::string_view phaseName)
-: _material(material), _phaseName(phaseName) {
+: _material(material), _phaseName(phaseName), _phase(phaseName) {
 }
 
 MaterialPtr Technique::material() {
@@ -70,11 +70,44 @@ void Technique::bakePipeline(rhi::RenderPassPtr renderpass,
     if (_pso) {
         return;
     }
+    _bindingBound = {
+        passDescSet && !passDescSet->info().descriptorBindings.empty(),
+        batchDescSet && !batchDescSet->info().descriptorBindings.empty(),
+        instDescSet && !instDescSet->info().descriptorBindings.empty(),
+        drawDescSet && !drawDescSet->info().descriptorBindings.empty(),
+    };
+    _pso = createPipeline(_material->shaderName(), renderpass, {passDescSet, batchDescSet, instDescSet, drawDescSet},
+                          constants, vertexLayout, shaderIn, device);
+}
+
+void Technique::bakeMeshletPipeline(std::string_view shaderName,
+                                    rhi::RenderPassPtr renderpass,
+                                    std::array<rhi::DescriptorSetLayoutPtr, 4> descSets,
+                                    const std::vector<rhi::PushConstantRange>& constants,
+                                    const boost::container::flat_map<rhi::ShaderStage, std::string>& shaderIn,
+                                    rhi::DevicePtr device) {
+    if (_meshletPso) {
+        return;
+    }
+    _meshletPso = createPipeline(shaderName, renderpass, descSets, constants, {}, shaderIn, device);
+}
+
+rhi::GraphicsPipelinePtr Technique::meshletPipelineState() {
+    return _meshletPso;
+}
+
+rhi::GraphicsPipelinePtr Technique::createPipeline(std::string_view shaderName,
+                                                   rhi::RenderPassPtr renderpass,
+                                                   const std::array<rhi::DescriptorSetLayoutPtr, 4>& descSets,
+                                                   const std::vector<rhi::PushConstantRange>& constants,
+                                                   const rhi::VertexLayout& vertexLayout,
+                                                   const boost::container::flat_map<rhi::ShaderStage, std::string>& shaderIn,
+                                                   rhi::DevicePtr device) {
     std::vector<rhi::RHIShader*> shaders;
     shaders.reserve(shaderIn.size());
 
-    std::ranges::for_each(shaderIn, [device, &shaders, this](const auto& p) {
-        auto shaderPath = _material->shaderName();
+    std::ranges::for_each(shaderIn, [device, &shaders, shaderName, this](const auto& p) {
+        std::string shaderPath(shaderName);
         size_t seed = 9527;
         boost::hash_combine(seed, shaderPath);
         std::string prefix = "#version 450 core\n";
@@ -94,18 +127,12 @@ void Technique::bakePipeline(rhi::RenderPassPtr renderpass,
         shaders.emplace_back(shader.get());
     });
     std::vector<rhi::RHIDescriptorSetLayout*> setLayouts = {
-        passDescSet.get(),
-        batchDescSet.get(),
-        instDescSet.get(),
-        drawDescSet.get(),
+        descSets[0].get(),
+        descSets[1].get(),
+        descSets[2].get(),
+        descSets[3].get(),
     };
 
-    _bindingBound = {
-        passDescSet && !passDescSet->info().descriptorBindings.empty(),
-        batchDescSet && !batchDescSet->info().descriptorBindings.empty(),
-        instDescSet && !instDescSet->info().descriptorBindings.empty(),
-        drawDescSet && !drawDescSet->info().descriptorBindings.empty(),
-    };
     rhi::PipelineLayoutInfo layoutInfo = {
         constants,
         setLayouts,
@@ -128,7 +155,7 @@ void Technique::bakePipeline(rhi::RenderPassPtr renderpass,
     if (!_psoMap.contains(info)) {
         _psoMap.emplace(info, rhi::GraphicsPipelinePtr(device->createGraphicsPipeline(info)));
     }
-    _pso = _psoMap.at(info);
+    return _psoMap.at(info);
 }
 
 bool Technique::hasPassBinding() const {
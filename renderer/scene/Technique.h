@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include "Material.h"
+#include "core/utils/StringTable.h"
 
 namespace raum::scene {
 
@@ -11,6 +12,8 @@ public:
 
     MaterialPtr material();
     const std::string& phaseName() const;
+    // interned phaseName, compared per draw instead of the string
+    StringID phase() const { return _phase; }
 
     void setPrimitiveType(rhi::PrimitiveType type);
     rhi::PrimitiveType primitiveType() const;
@@ -32,6 +35,17 @@ public:
                       const boost::container::flat_map<rhi::ShaderStage, std::string>& shaderIn,
                       rhi::DevicePtr device);
 
+    // mesh shader variant drawn by the gpu driven meshlet path, `shaderName` names its layout. Bindings of
+    // `descSets` are bound by the caller.
+    void bakeMeshletPipeline(std::string_view shaderName,
+                             rhi::RenderPassPtr renderpass,
+                             std::array<rhi::DescriptorSetLayoutPtr, 4> descSets,
+                             const std::vector<rhi::PushConstantRange>& constants,
+                             const boost::container::flat_map<rhi::ShaderStage, std::string>& shaderIn,
+                             rhi::DevicePtr device);
+    // null until baked
+    rhi::GraphicsPipelinePtr meshletPipelineState();
+
     void bakeMaterial(const SlotMap& perBatchBinding,
                       rhi::DescriptorSetLayoutPtr batchLayout,
                       rhi::DevicePtr device);
@@ -42,9 +56,19 @@ public:
     bool hasDrawBinding() const;
 
 private:
+    rhi::GraphicsPipelinePtr createPipeline(std::string_view shaderName,
+                                            rhi::RenderPassPtr renderpass,
+                                            const std::array<rhi::DescriptorSetLayoutPtr, 4>& descSets,
+                                            const std::vector<rhi::PushConstantRange>& constants,
+                                            const rhi::VertexLayout& vertexLayout,
+                                            const boost::container::flat_map<rhi::ShaderStage, std::string>& shaderIn,
+                                            rhi::DevicePtr device);
+
     std::string _phaseName;
+    StringID _phase;
     MaterialPtr _material;
     rhi::GraphicsPipelinePtr _pso;
+    rhi::GraphicsPipelinePtr _meshletPso;
     rhi::PrimitiveType _primitiveType{rhi::PrimitiveType::TRIANGLE_LIST};
     rhi::RasterizationInfo _rasterizationInfo;
     rhi::DepthStencilInfo _depthStencilInfo;
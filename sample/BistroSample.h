@@ -167,7 +167,7 @@ public:
         auto& renderGraph = _ppl->renderGraph();
         auto uploadPass = renderGraph.addCopyPass("cambufferUpdate");
 
-        _ppl->resourceGraph().updateImage("forwardDS", _swapchain->width(), _swapchain->height());
+        _ppl->resourceGraph().updateImage(_forwardDS, _swapchain->width(), _swapchain->height());
 
         auto& eye = _cam->eye();
         auto p = eye.getPosition();
@@ -230,12 +230,12 @@ private:
 
     scene::TechniquePtr _rasterBlitTech;
 
-    const std::string _presentBuffer = "presentBuffer";
-    const std::string _forwardRT = "forwardRT";
-    const std::string _forwardDS = "forwardDS";
-    const std::string _camBuffer = "camBuffer";
-    const std::string _camPose = "camPose";
-    const std::string _light = "light";
+    const StringID _presentBuffer{"presentBuffer"};
+    const StringID _forwardRT{"forwardRT"};
+    const StringID _forwardDS{"forwardDS"};
+    const StringID _camBuffer{"camBuffer"};
+    const StringID _camPose{"camPose"};
+    const StringID _light{"light"};
 
     const std::string _name = "BistroSample";
 
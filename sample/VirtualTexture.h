@@ -245,7 +245,7 @@ public:
         auto& renderGraph = _ppl->renderGraph();
         auto uploadPass = renderGraph.addCopyPass("cambufferUpdate");
 
-        _ppl->resourceGraph().updateImage("forwardDS", swapchain->width(), swapchain->height());
+        _ppl->resourceGraph().updateImage(_forwardDS, swapchain->width(), swapchain->height());
 
         auto& eye = _cam->eye();
         Mat4 modelMat = Mat4(1.0f);
@@ -284,9 +284,9 @@ private:
     std::shared_ptr<scene::Camera> _cam;
     std::shared_ptr<scene::Scene> _scene;
 
-    const std::string _forwardRT = "forwardRT";
-    const std::string _forwardDS = "forwardDS";
-    const std::string _mvp = "mvp";
+    const StringID _forwardRT{"forwardRT"};
+    const StringID _forwardDS{"forwardDS"};
+    const StringID _mvp{"mvp"};
 
     const std::string _name = "VirtualTexture";
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdlib>
 #include <iostream>
+#include <string_view>
 #include "BistroSample.h"
 #include "GraphSample.h"
 #include "VirtualTexture.h"
@@ -16,29 +17,56 @@ using platform::Window;
 constexpr uint32_t s_width = 1080u;
 constexpr uint32_t s_height = 720u;
 
+// --headless [--frames N] [--capture file.png], --null renders headless on the null device
+inline bool parseHeadless(int argc, char** argv, framework::HeadlessInfo& info, rhi::API& api) {
+    bool headless{false};
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--null") {
+            headless = true;
+            api = rhi::API::NONE;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            info.frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--capture" && i + 1 < argc) {
+            info.capture = argv[++i];
+        }
+    }
+    return headless;
+}
+
 class Sample {
 public:
     Sample(int argc, char** argv) {
-        _world = new framework::World();
+        rhi::API api{rhi::API::VULKAN};
+        _headless = parseHeadless(argc, argv, _headlessInfo, api);
+
+        _world = new framework::World(api);
         auto& director = _world->director();
         auto device = director.device();
 
-        _window = std::make_shared<platform::Window>(argc, argv, s_width, s_height, device->instance());
         _tick = platform::TickFunction{[&](std::chrono::milliseconds miliSec) {
             this->show();
         }};
-        _window->registerPollEvents(&_tick);
 
-        _world->attachWindow(_window);
+        if (_headless) {
+            director.attachOffscreen(s_width, s_height);
+        } else {
+            _window = std::make_shared<platform::Window>(argc, argv, s_width, s_height, device->instance());
+            _window->registerPollEvents(&_tick);
 
-        _world->run();
+            _world->attachWindow(_window);
 
-        auto swapchain = director.swapchain();
+            _world->run();
 
-        auto resizeHandler = [&, swapchain](uint32_t w, uint32_t h) {
-            swapchain->resize(w, h, _window->handle());
-        };
-        _resizeListener.add(resizeHandler);
+            auto swapchain = director.swapchain();
+
+            auto resizeHandler = [&, swapchain](uint32_t w, uint32_t h) {
+                swapchain->resize(w, h, _window->handle());
+            };
+            _resizeListener.add(resizeHandler);
+        }
 
         _samples = {
             // std::make_shared<sample::GraphSample>(&_world->director()),
@@ -60,8 +88,12 @@ public:
         _closeListener.remove();
     }
 
-    void showWindow() {
-        _window->show();
+    void run() {
+        if (_headless) {
+            _world->director().runHeadless(_headlessInfo, &_tick);
+        } else {
+            _window->show();
+        }
     }
 
     void show() {
@@ -96,6 +128,8 @@ private:
     std::vector<uint32_t> _inited;
     platform::WindowPtr _window;
     framework::World* _world{nullptr};
+    bool _headless{false};
+    framework::HeadlessInfo _headlessInfo;
     framework::EventListener<framework::ResizeEventTag> _resizeListener;
     framework::EventListener<framework::CloseEventTag> _closeListener;
     platform::TickFunction _tick;
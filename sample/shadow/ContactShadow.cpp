@@ -18,7 +18,7 @@ void ContactShadowSample::hide() {
 
 void ContactShadowSample::show() {
     auto& renderGraph = _ppl->renderGraph();
-    _ppl->resourceGraph().updateImage("forwardDS", _swapchain->width(), _swapchain->height());
+    _ppl->resourceGraph().updateImage(_forwardDS, _swapchain->width(), _swapchain->height());
 
     static bool firstTime = true;
     if (firstTime) {
@@ -213,8 +213,7 @@ void ContactShadowSample::init() {
     if (!resourceGraph.contains(_sssInfo)) {
         resourceGraph.addBuffer(_sssInfo, 24, graph::BufferUsage::UNIFORM | graph::BufferUsage::TRANSFER_DST);
         for (size_t i = 0; i < 8; ++i) {
-            _waveOffsetBuffers[i] = "waveOffsetBuffer";
-            _waveOffsetBuffers[i].append(std::to_string(i));
+            _waveOffsetBuffers[i] = StringID{"waveOffsetBuffer" + std::to_string(i)};
             resourceGraph.addBuffer(_waveOffsetBuffers[i], 8, graph::BufferUsage::UNIFORM | graph::BufferUsage::TRANSFER_DST);
         }
     }
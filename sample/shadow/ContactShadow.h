@@ -50,22 +50,22 @@ private:
     std::shared_ptr<scene::Camera> _shadowCam;
     std::shared_ptr<scene::Scene> _scene;
 
-    const std::string _forwardRT = "forwardRT";
-    const std::string _forwardDS = "forwardDS";
-    const std::string _shadowMapRT = "shadowMap";
-    const std::string _shadowMapDS = "shadowMapDS";
-    const std::string _camBuffer = "camBuffer";
-    const std::string _camPose = "camPose";
-    const std::string _shadowVPBuffer = "shadowVP";
-    const std::string _light = "light";
-    const std::string _shadowSampler = "shadowSampler";
-    const std::string _sssInfo = "uniformInfoBuffer";
-    const std::string _sssOuput = "sssOuput";
-    const std::string _viewportSize = "ViewportSize";
+    const StringID _forwardRT{"forwardRT"};
+    const StringID _forwardDS{"forwardDS"};
+    const StringID _shadowMapRT{"shadowMap"};
+    const StringID _shadowMapDS{"shadowMapDS"};
+    const StringID _camBuffer{"camBuffer"};
+    const StringID _camPose{"camPose"};
+    const StringID _shadowVPBuffer{"shadowVP"};
+    const StringID _light{"light"};
+    const StringID _shadowSampler{"shadowSampler"};
+    const StringID _sssInfo{"uniformInfoBuffer"};
+    const StringID _sssOuput{"sssOuput"};
+    const StringID _viewportSize{"ViewportSize"};
 
     const std::string _name = "ContactShadowSample";
 
-    std::array<std::string, 8> _waveOffsetBuffers;
+    std::array<StringID, 8> _waveOffsetBuffers;
 
     framework::EventListener<framework::KeyboardEventTag> _keyListener;
     framework::EventListener<framework::MouseButtonEventTag> _mouseListener;
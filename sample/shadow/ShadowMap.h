@@ -102,7 +102,7 @@ public:
 
     void show() override {
         auto& renderGraph = _ppl->renderGraph();
-        _ppl->resourceGraph().updateImage("forwardDS", _swapchain->width(), _swapchain->height());
+        _ppl->resourceGraph().updateImage(_forwardDS, _swapchain->width(), _swapchain->height());
 
         // shadow buffer upload pass
         {
@@ -183,15 +183,15 @@ private:
     std::shared_ptr<scene::Camera> _shadowCam;
     std::shared_ptr<scene::Scene> _scene;
 
-    const std::string _forwardRT = "forwardRT";
-    const std::string _forwardDS = "forwardDS";
-    const std::string _shadowMapRT = "shadowMap";
-    const std::string _shadowMapDS = "shadowMapDS";
-    const std::string _camBuffer = "camBuffer";
-    const std::string _camPose = "camPose";
-    const std::string _shadowVPBuffer = "shadowVP";
-    const std::string _light = "light";
-    const std::string _shadowSampler = "shadowSampler";
+    const StringID _forwardRT{"forwardRT"};
+    const StringID _forwardDS{"forwardDS"};
+    const StringID _shadowMapRT{"shadowMap"};
+    const StringID _shadowMapDS{"shadowMapDS"};
+    const StringID _camBuffer{"camBuffer"};
+    const StringID _camPose{"camPose"};
+    const StringID _shadowVPBuffer{"shadowVP"};
+    const StringID _light{"light"};
+    const StringID _shadowSampler{"shadowSampler"};
 
     const std::string _name = "ShadowMap";
 
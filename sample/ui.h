@@ -16,7 +16,7 @@ public:
     }
 
     void show() {
-        _sample->showWindow();
+        _sample->run();
     }
 
 
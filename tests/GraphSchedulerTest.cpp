@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "Camera.h"
+#include "GraphScheduler.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "NullDevice.h"
+#include "RHICommandBuffer.h"
+#include "RHICommandPool.h"
+#include "RHIOffscreenSwapchain.h"
+#include "RHIQueue.h"
+
+namespace raum::graph {
+
+namespace {
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 64;
+constexpr uint32_t RENDERABLE_COUNT = 4;
+
+// one unlit mesh drawn RENDERABLE_COUNT times into the swapchain, the layout has no bindings so a frame
+// only binds the pipeline and the mesh buffers.
+class GraphSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _device = rhi::DevicePtr(rhi::null::loadNull(), [](rhi::RHIDevice* device) {
+            rhi::null::unloadNull(static_cast<rhi::null::Device*>(device));
+        });
+        _swapchain = std::make_shared<rhi::RHIOffscreenSwapchain>(rhi::OffscreenSwapchainInfo{WIDTH, HEIGHT}, _device.get());
+        _queue = _device->getQueue({rhi::QueueType::GRAPHICS});
+        _pool = rhi::CommandPoolPtr(_device->createCoomandPool({_queue->index()}));
+        _cmd = rhi::CommandBufferPtr(_pool->makeCommandBuffer({}));
+
+        _shaderGraph = std::make_unique<ShaderGraph>(_device);
+        _shaderGraph->addVertex("test/unlit", ShaderResource{
+                                                  .shaderSources = {
+                                                      {rhi::ShaderStage::VERTEX, "void main() {}"},
+                                                      {rhi::ShaderStage::FRAGMENT, "void main() {}"},
+                                                  },
+                                              });
+        _shaderGraph->compile("test");
+
+        _renderGraph = std::make_unique<RenderGraph>(_device);
+        _resourceGraph = std::make_unique<ResourceGraph>(_device.get());
+        _accessGraph = std::make_unique<AccessGraph>(*_renderGraph, *_resourceGraph, *_shaderGraph);
+        _sceneGraph = std::make_unique<SceneGraph>();
+        _resourceGraph->import(PRESENT, _swapchain);
+
+        makeScene();
+        _scheduler = std::make_unique<GraphScheduler>(_device, _swapchain, _renderGraph.get(), _resourceGraph.get(),
+                                                      _accessGraph.get(), nullptr, _sceneGraph.get(), _shaderGraph.get());
+        _scheduler->setInstancing(false);
+    }
+
+    void TearDown() override {
+        _device->waitDeviceIdle();
+        _scheduler.reset();
+        _sceneGraph.reset();
+        _accessGraph.reset();
+        _resourceGraph.reset();
+        _renderGraph.reset();
+        _shaderGraph.reset();
+        _cmd.reset();
+        _pool.reset();
+        _swapchain.reset();
+        _camera.reset();
+        _device.reset();
+    }
+
+    // renderables side by side on the x axis, the camera looks at them down the z axis
+    void makeScene() {
+        auto mesh = std::make_shared<scene::Mesh>();
+        auto& meshData = mesh->meshData();
+        meshData.vertexBuffer.buffer = rhi::BufferPtr(_device->createBuffer(rhi::BufferInfo{.bufferUsage = rhi::BufferUsage::VERTEX, .size = 36}));
+        meshData.indexBuffer.buffer = rhi::BufferPtr(_device->createBuffer(rhi::BufferInfo{.bufferUsage = rhi::BufferUsage::INDEX, .size = 12}));
+        meshData.vertexCount = 3;
+        meshData.indexCount = 3;
+        mesh->aabb() = scene::AABB{Vec3f{-0.5f}, Vec3f{0.5f}};
+
+        auto material = std::make_shared<scene::Material>("test/unlit", "test/unlit", scene::MaterialType::CUSTOM, std::set<std::string>{});
+        auto technique = std::make_shared<scene::Technique>(material, "unlit");
+        technique->blendInfo().attachmentBlends.emplace_back();
+
+        auto model = std::make_shared<scene::Model>();
+        for (uint32_t i = 0; i < RENDERABLE_COUNT; ++i) {
+            auto& meshRenderer = model->meshRenderers().emplace_back(std::make_shared<scene::MeshRenderer>(mesh));
+            meshRenderer->addTechnique(technique);
+            meshRenderer->setVertexInfo(0, meshData.vertexCount, meshData.indexCount);
+            Mat4 transform{1.0f};
+            transform[3] = Vec4f{static_cast<float>(i) * 2.0f - 3.0f, 0.0f, 0.0f, 1.0f};
+            meshRenderer->setTransform(transform);
+        }
+        _sceneGraph->addModel("test").model = model;
+
+        _camera = std::make_shared<scene::Camera>(scene::PerspectiveFrustum{
+            .fov = {60.0f},
+            .aspect = static_cast<float>(WIDTH) / HEIGHT,
+            .near = 0.1f,
+            .far = 100.0f,
+        });
+        lookAt({0.0f, 0.0f, 0.0f});
+    }
+
+    void lookAt(const Vec3f& target) {
+        auto& eye = _camera->eye();
+        eye.setPosition(0.0f, 0.0f, 10.0f);
+        eye.lookAt(target, {0.0f, 1.0f, 0.0f});
+        _camera->update();
+    }
+
+    // records and submits one frame, returns what reached the queue
+    rhi::SubmittedCommandStats frame() {
+        _device->resetSubmittedCommandStats();
+        _swapchain->acquire();
+
+        _renderGraph->addRenderPass("forward")
+            .addColor(PRESENT, LoadOp::CLEAR, StoreOp::STORE, {0.0f, 0.0f, 0.0f, 1.0f})
+            .addQueue("unlit")
+            .addCamera(_camera.get())
+            .setViewport(0, 0, WIDTH, HEIGHT, 0.0f, 1.0f)
+            .addFlag(RenderQueueFlags::GEOMETRY);
+
+        _cmd->reset();
+        _cmd->enqueue(_queue);
+        _cmd->begin({});
+        auto cmd = _scheduler->execute(_cmd);
+        cmd->commit();
+        _queue->submit(false);
+
+        rhi::SubmittedCommandStats stats;
+        EXPECT_TRUE(_device->submittedCommandStats(stats));
+        return stats;
+    }
+
+    static inline const StringID PRESENT{"test/present"};
+
+    rhi::DevicePtr _device;
+    std::shared_ptr<rhi::RHIOffscreenSwapchain> _swapchain;
+    rhi::RHIQueue* _queue{nullptr};
+    rhi::CommandPoolPtr _pool;
+    rhi::CommandBufferPtr _cmd;
+    std::unique_ptr<ShaderGraph> _shaderGraph;
+    std::unique_ptr<RenderGraph> _renderGraph;
+    std::unique_ptr<ResourceGraph> _resourceGraph;
+    std::unique_ptr<AccessGraph> _accessGraph;
+    std::unique_ptr<SceneGraph> _sceneGraph;
+    std::unique_ptr<GraphScheduler> _scheduler;
+    scene::CameraPtr _camera;
+};
+
+} // namespace
+
+TEST_F(GraphSchedulerTest, DrawsEveryVisibleRenderable) {
+    // past the first use of every frame slot
+    for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT; ++i) {
+        frame();
+    }
+    auto stats = frame();
+    EXPECT_EQ(stats.draws, RENDERABLE_COUNT);
+    EXPECT_EQ(stats.dispatches, 0u);
+    // sorted draws share the pipeline and the mesh buffers
+    EXPECT_EQ(stats.binds, 3u);
+    // at least the transition of the swapchain image to its present layout
+    EXPECT_GE(stats.barriers, 1u);
+
+    const auto& renderStats = _scheduler->renderStats();
+    EXPECT_EQ(renderStats.pipelineBinds, 1u);
+    EXPECT_EQ(renderStats.pipelineBindsSkipped, RENDERABLE_COUNT - 1);
+}
+
+TEST_F(GraphSchedulerTest, SkipsCulledRenderables) {
+    auto visible = frame();
+    EXPECT_EQ(visible.draws, RENDERABLE_COUNT);
+
+    // facing away from every renderable
+    lookAt({0.0f, 0.0f, 20.0f});
+    auto culled = frame();
+    EXPECT_EQ(culled.draws, 0u);
+    EXPECT_GE(culled.barriers, 1u);
+}
+
+} // namespace raum::graph
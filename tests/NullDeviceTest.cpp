@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "NullDevice.h"
+#include "RHIBlitEncoder.h"
+#include "RHICommandBuffer.h"
+#include "RHIComputeEncoder.h"
+#include "RHIRenderEncoder.h"
+
+namespace raum::rhi {
+
+namespace {
+
+class NullDeviceTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _device = null::loadNull();
+        _queue = _device->getQueue({QueueType::GRAPHICS});
+        _pool = CommandPoolPtr(_device->createCoomandPool({_queue->index()}));
+        _indexBuffer = BufferPtr(_device->createBuffer(BufferInfo{.bufferUsage = BufferUsage::INDEX, .size = 64}));
+        _vertexBuffer = BufferPtr(_device->createBuffer(BufferInfo{.bufferUsage = BufferUsage::VERTEX, .size = 256}));
+    }
+
+    void TearDown() override {
+        _indexBuffer.reset();
+        _vertexBuffer.reset();
+        _pool.reset();
+        null::unloadNull(_device);
+    }
+
+    CommandBufferPtr beginCommandBuffer() {
+        auto cmd = CommandBufferPtr(_pool->makeCommandBuffer({}));
+        cmd->enqueue(_queue);
+        cmd->begin({});
+        return cmd;
+    }
+
+    // `count` indexed draws of the same buffers
+    void recordDraws(RHICommandBuffer* cmd, uint32_t count) {
+        auto encoder = RenderEncoderPtr(cmd->makeRenderEncoder());
+        for (uint32_t i = 0; i < count; ++i) {
+            encoder->bindIndexBuffer(_indexBuffer.get(), 0, IndexType::FULL);
+            encoder->bindVertexBuffer(_vertexBuffer.get(), 0);
+            encoder->drawIndexed(3, 1, i * 3, 0, 0);
+        }
+    }
+
+    SubmittedCommandStats stats() const {
+        SubmittedCommandStats res;
+        EXPECT_TRUE(_device->submittedCommandStats(res));
+        return res;
+    }
+
+    null::Device* _device{nullptr};
+    RHIQueue* _queue{nullptr};
+    CommandPoolPtr _pool;
+    BufferPtr _indexBuffer;
+    BufferPtr _vertexBuffer;
+};
+
+} // namespace
+
+TEST_F(NullDeviceTest, CountsDrawsAndSkipsRedundantBinds) {
+    auto cmd = beginCommandBuffer();
+    recordDraws(cmd.get(), 4);
+    cmd->commit();
+    _queue->submit(false);
+
+    auto res = stats();
+    EXPECT_EQ(res.draws, 4);
+    EXPECT_EQ(res.binds, 2);
+    EXPECT_EQ(res.dispatches, 0);
+    EXPECT_EQ(cmd->renderEncoderStats().drawCalls, 4);
+    EXPECT_EQ(cmd->renderEncoderStats().indexBufferBindsSkipped, 3);
+    EXPECT_EQ(cmd->renderEncoderStats().vertexBufferBindsSkipped, 3);
+}
+
+TEST_F(NullDeviceTest, BatchesBarriersPerApply) {
+    auto cmd = beginCommandBuffer();
+    for (auto* buffer : {_indexBuffer.get(), _vertexBuffer.get()}) {
+        cmd->appendBufferBarrier({
+            .buffer = buffer,
+            .srcStage = PipelineStage::TRANSFER,
+            .dstStage = PipelineStage::VERTEX_INPUT,
+            .srcAccessFlag = AccessFlags::TRANSFER_WRITE,
+            .dstAccessFlag = AccessFlags::VERTEX_ATTRIBUTE_READ,
+        });
+    }
+    cmd->applyBarrier(DependencyFlags::BY_REGION);
+    // nothing pending, no barrier command
+    cmd->applyBarrier(DependencyFlags::BY_REGION);
+    cmd->appendExecutionBarrier({
+        .srcStage = PipelineStage::COMPUTE_SHADER,
+        .dstStage = PipelineStage::DRAW_INDIRECT,
+    });
+    cmd->applyBarrier(DependencyFlags::BY_REGION);
+    cmd->commit();
+    _queue->submit(false);
+
+    auto res = stats();
+    EXPECT_EQ(res.barriers, 3);
+    EXPECT_EQ(res.barrierBatches, 2);
+}
+
+TEST_F(NullDeviceTest, CountsDispatchesAndCopies) {
+    auto cmd = beginCommandBuffer();
+    {
+        auto blit = BlitEncoderPtr(cmd->makeBlitEncoder());
+        BufferCopyRegion region{.srcOffset = 0, .dstOffset = 0, .size = 64};
+        blit->copyBufferToBuffer(_vertexBuffer.get(), _indexBuffer.get(), &region, 1);
+    }
+    {
+        auto compute = ComputeEncoderPtr(cmd->makeComputeEncoder());
+        compute->dispatch(8, 1, 1);
+        compute->dispatch(4, 4, 1);
+    }
+    cmd->commit();
+    _queue->flush(nullptr);
+
+    auto res = stats();
+    EXPECT_EQ(res.copies, 1);
+    EXPECT_EQ(res.dispatches, 2);
+    EXPECT_EQ(res.draws, 0);
+}
+
+TEST_F(NullDeviceTest, ResetClearsStats) {
+    auto cmd = beginCommandBuffer();
+    recordDraws(cmd.get(), 2);
+    cmd->commit();
+    _queue->submit(false);
+    EXPECT_GT(stats().commands, 0);
+
+    _device->resetSubmittedCommandStats();
+    auto res = stats();
+    EXPECT_EQ(res.commands, 0);
+    EXPECT_EQ(res.draws, 0);
+    EXPECT_EQ(res.binds, 0);
+}
+
+TEST_F(NullDeviceTest, EqualRecordingsHashEqual) {
+    auto frame = [&](uint32_t draws) {
+        _device->resetSubmittedCommandStats();
+        auto cmd = beginCommandBuffer();
+        recordDraws(cmd.get(), draws);
+        cmd->commit();
+        _queue->submit(false);
+        return stats().hash;
+    };
+    auto first = frame(3);
+    EXPECT_EQ(frame(3), first);
+    EXPECT_NE(frame(2), first);
+}
+
+TEST_F(NullDeviceTest, FlushOnlyQueueRunsCompleteHandlers) {
+    auto* compute = _device->getQueue({QueueType::COMPUTE});
+    bool completed{false};
+    compute->addCompleteHandler([&completed]() {
+        completed = true;
+    });
+    for (uint32_t i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+        EXPECT_FALSE(completed);
+        compute->flush(nullptr);
+        compute->endFrame();
+    }
+    EXPECT_TRUE(completed);
+}
+
+} // namespace raum::rhi
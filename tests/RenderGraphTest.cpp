@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "NullDevice.h"
+#include "RenderGraph.h"
+#include "ResourceGraph.h"
+
+namespace {
+
+// global allocations while counting, this executable replaces operator new
+std::atomic<bool> counting{false};
+std::atomic<uint32_t> allocations{0};
+
+void* allocate(std::size_t size, std::size_t alignment) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    size = size ? size : 1;
+    void* p = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                                                     : std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace raum::graph {
+
+namespace {
+
+class RenderGraphTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _device = rhi::DevicePtr(rhi::null::loadNull(), [](rhi::RHIDevice* device) {
+            rhi::null::unloadNull(static_cast<rhi::null::Device*>(device));
+        });
+        _renderGraph = std::make_unique<RenderGraph>(_device);
+        _resourceGraph = std::make_unique<ResourceGraph>(_device.get());
+        _resourceGraph->addImage(COLOR, rhi::ImageUsage::COLOR_ATTACHMENT | rhi::ImageUsage::SAMPLED, 64, 64, rhi::Format::RGBA8_UNORM);
+        _resourceGraph->addImage(HISTORY, rhi::ImageUsage::SAMPLED | rhi::ImageUsage::STORAGE, 64, 64, rhi::Format::RGBA8_UNORM);
+        _resourceGraph->addImage(DEPTH, rhi::ImageUsage::DEPTH_STENCIL_ATTACHMENT, 64, 64, rhi::Format::D24_UNORM_S8_UINT);
+    }
+
+    void TearDown() override {
+        _renderGraph.reset();
+        _resourceGraph.reset();
+        _device.reset();
+    }
+
+    // what a sample records every frame
+    void build() {
+        _renderGraph->clear();
+        auto forward = _renderGraph->addRenderPass("forward");
+        forward.addColor(COLOR, LoadOp::CLEAR, StoreOp::STORE, {0.0, 0.0, 0.0, 1.0})
+            .addDepthStencil(DEPTH, LoadOp::CLEAR, StoreOp::STORE, LoadOp::CLEAR, StoreOp::STORE, 1.0f, 0);
+        auto queue = forward.addQueue("default");
+        queue.addSampledImage(HISTORY, "history").addFlag(RenderQueueFlags::GEOMETRY);
+        auto resolve = _renderGraph->addComputePass("resolve");
+        resolve.setProgramName("resolve")
+            .addResource(COLOR, "input", Access::READ)
+            .addResource(HISTORY, "output", Access::WRITE)
+            .setDispatch(8, 8, 1);
+    }
+
+    static inline const StringID COLOR{"test/color"};
+    static inline const StringID HISTORY{"test/history"};
+    static inline const StringID DEPTH{"test/depth"};
+
+    rhi::DevicePtr _device;
+    std::unique_ptr<RenderGraph> _renderGraph;
+    std::unique_ptr<ResourceGraph> _resourceGraph;
+};
+
+} // namespace
+
+TEST_F(RenderGraphTest, BuildsWithoutHeapAllocationsAfterWarmUp) {
+    // every frame in flight arena and the vertex storage reach their peak
+    for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT * 2; ++i) {
+        build();
+    }
+
+    allocations = 0;
+    counting = true;
+    for (uint32_t i = 0; i < rhi::FRAMES_IN_FLIGHT; ++i) {
+        build();
+    }
+    counting = false;
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_NE(_renderGraph->find("forward/default"), RenderGraph::null_vertex());
+}
+
+} // namespace raum::graph
@@ -0,0 +1,136 @@
+#include "Bench.h"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include "core/utils/log.h"
+
+namespace raum::bench {
+
+namespace {
+
+double toNs(Clock::duration duration) {
+    return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+void appendEscaped(std::string& out, std::string_view str) {
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+        }
+        out.push_back(c);
+    }
+}
+
+} // namespace
+
+bool State::next() {
+    auto now = Clock::now();
+    if (_running) {
+        if (!_paused) {
+            _elapsed += now - _begin;
+        }
+        if (_warmedUp) {
+            _samples.emplace_back(toNs(_elapsed));
+        }
+        _warmedUp = true;
+    } else {
+        _running = true;
+        _start = now;
+    }
+
+    auto iterations = _samples.size();
+    if (iterations >= _limits.maxIterations ||
+        (iterations >= _limits.minIterations && now - _start >= _limits.minTime)) {
+        return false;
+    }
+    _elapsed = {};
+    _paused = false;
+    _begin = Clock::now();
+    return true;
+}
+
+void State::pause() {
+    if (!_paused) {
+        _elapsed += Clock::now() - _begin;
+        _paused = true;
+    }
+}
+
+void State::resume() {
+    if (_paused) {
+        _paused = false;
+        _begin = Clock::now();
+    }
+}
+
+void Registry::add(std::string name, std::function<void(State&)> func) {
+    _benchmarks.emplace_back(Benchmark{
+        .name = std::move(name),
+        .func = std::move(func),
+    });
+}
+
+Result run(const Benchmark& benchmark, const State::Limits& limits) {
+    State state(limits);
+    benchmark.func(state);
+
+    Result res{.name = benchmark.name};
+    auto samples = state.samples();
+    if (samples.empty()) {
+        return res;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+    };
+    res.iterations = samples.size();
+    res.meanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    res.minNs = samples.front();
+    res.medianNs = percentile(0.5);
+    res.p95Ns = percentile(0.95);
+    res.maxNs = samples.back();
+    if (res.meanNs > 0.0) {
+        res.itemsPerSecond = state.items() * 1e9 / res.meanNs;
+        res.bytesPerSecond = state.bytes() * 1e9 / res.meanNs;
+    }
+    return res;
+}
+
+bool writeJson(const std::filesystem::path& path,
+               const std::vector<std::pair<std::string, std::string>>& context,
+               const std::vector<Result>& results) {
+    std::string json = R"({"context":{)";
+    for (const auto& [key, value] : context) {
+        json += &key == &context.front().first ? "\"" : ",\"";
+        appendEscaped(json, key);
+        json += R"(":")";
+        appendEscaped(json, value);
+        json += "\"";
+    }
+    json += R"(},"benchmarks":[)";
+    for (const auto& res : results) {
+        json += &res == &results.front() ? R"({"name":")" : R"(,{"name":")";
+        appendEscaped(json, res.name);
+        json += fmt::format(R"(","iterations":{},"mean_ns":{:.1f},"min_ns":{:.1f},"median_ns":{:.1f},"p95_ns":{:.1f},)"
+                            R"("max_ns":{:.1f},"items_per_second":{:.1f},"bytes_per_second":{:.1f}}})",
+                            res.iterations,
+                            res.meanNs,
+                            res.minNs,
+                            res.medianNs,
+                            res.p95Ns,
+                            res.maxNs,
+                            res.itemsPerSecond,
+                            res.bytesPerSecond);
+    }
+    json += "]}\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        raum_warn("failed to write results to {}", path.string());
+        return false;
+    }
+    file << json;
+    return static_cast<bool>(file);
+}
+
+} // namespace raum::bench
@@ -0,0 +1,112 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+#include "RHIDefine.h"
+
+namespace raum::graph {
+class ShaderGraph;
+}
+
+namespace raum::bench {
+
+using Clock = std::chrono::steady_clock;
+
+// drives the timed loop of a benchmark:
+//
+//     while (state.next()) {
+//         state.pause();
+//         ... untimed setup ...
+//         state.resume();
+//         ... measured work ...
+//     }
+//
+// the first iteration warms caches and lazy allocations up and is not recorded.
+class State {
+public:
+    struct Limits {
+        Clock::duration minTime{std::chrono::milliseconds{500}};
+        uint32_t minIterations{5};
+        uint32_t maxIterations{100000};
+    };
+
+    explicit State(const Limits& limits) : _limits(limits) {}
+
+    bool next();
+    void pause();
+    void resume();
+
+    // work done by a single iteration, reported as rates
+    void setItems(uint64_t items) { _items = items; }
+    void setBytes(uint64_t bytes) { _bytes = bytes; }
+
+    uint64_t items() const { return _items; }
+    uint64_t bytes() const { return _bytes; }
+    // nanoseconds of the recorded iterations
+    const std::vector<double>& samples() const { return _samples; }
+
+private:
+    Limits _limits;
+    Clock::time_point _start{};
+    Clock::time_point _begin{};
+    Clock::duration _elapsed{};
+    bool _running{false};
+    bool _paused{false};
+    bool _warmedUp{false};
+    uint64_t _items{0};
+    uint64_t _bytes{0};
+    std::vector<double> _samples;
+};
+
+struct Benchmark {
+    // "group/case/parameter", filtered by substring
+    std::string name;
+    std::function<void(State&)> func;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations{0};
+    double meanNs{0.0};
+    double minNs{0.0};
+    double medianNs{0.0};
+    double p95Ns{0.0};
+    double maxNs{0.0};
+    double itemsPerSecond{0.0};
+    double bytesPerSecond{0.0};
+};
+
+// shared by the benchmarks of one run, device backed groups are skipped without a device.
+struct Context {
+    rhi::DevicePtr device;
+    std::shared_ptr<graph::ShaderGraph> shaderGraph;
+    // cache load input, preprocessed on first use
+    std::filesystem::path scene;
+};
+
+class Registry {
+public:
+    void add(std::string name, std::function<void(State&)> func);
+    const std::vector<Benchmark>& benchmarks() const { return _benchmarks; }
+
+private:
+    std::vector<Benchmark> _benchmarks;
+};
+
+Result run(const Benchmark& benchmark, const State::Limits& limits);
+
+// {"context": {...}, "benchmarks": [{"name", "iterations", "mean_ns", ...}]}, one object per result.
+bool writeJson(const std::filesystem::path& path,
+               const std::vector<std::pair<std::string, std::string>>& context,
+               const std::vector<Result>& results);
+
+// cpu only
+void registerCullingBenchmarks(Registry& registry);
+// need context.device
+void registerGraphBenchmarks(Registry& registry, Context& context);
+void registerAssetBenchmarks(Registry& registry, Context& context);
+void registerRHIBenchmarks(Registry& registry, Context& context);
+
+} // namespace raum::bench
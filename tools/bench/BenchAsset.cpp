@@ -0,0 +1,63 @@
+#include "Bench.h"
+#include "BuiltinRes.h"
+#include "RHIDevice.h"
+#include "SceneGraph.h"
+#include "SceneSerializer.h"
+#include "core/utils/log.h"
+#include "core/utils/utils.h"
+
+namespace raum::bench {
+
+namespace {
+
+uint64_t directorySize(const std::filesystem::path& dir) {
+    uint64_t res{0};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+            res += entry.file_size();
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+void registerAssetBenchmarks(Registry& registry, Context& context) {
+    if (context.scene.empty()) {
+        return;
+    }
+
+    // throughput in bytes of the cache directory, uploads are waited for
+    registry.add(fmt::format("serializer/load_cache/{}", context.scene.stem().string()), [&context](State& state) {
+        if (!std::filesystem::exists(context.scene)) {
+            raum_warn("scene {} not found", context.scene.string());
+            return;
+        }
+        // materials reference the image based lighting of the skybox
+        static bool builtinLoaded{false};
+        if (!builtinLoaded) {
+            asset::BuiltinRes::initialize(*context.shaderGraph, context.device);
+            builtinLoaded = true;
+        }
+
+        // preprocesses the gltf into the cache if it is not there yet
+        {
+            graph::SceneGraph sceneGraph;
+            asset::serialize::load(sceneGraph, context.scene, context.device);
+            context.device->waitDeviceIdle();
+        }
+        state.setBytes(directorySize(utils::resourceDirectory() / "cache" / context.scene.stem()));
+
+        while (state.next()) {
+            state.pause();
+            auto sceneGraph = std::make_unique<graph::SceneGraph>();
+            state.resume();
+            asset::serialize::load(*sceneGraph, context.scene, context.device);
+            context.device->waitDeviceIdle();
+            state.pause();
+            sceneGraph.reset();
+        }
+    });
+}
+
+} // namespace raum::bench
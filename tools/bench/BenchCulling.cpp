@@ -0,0 +1,127 @@
+#include <cmath>
+#include <numbers>
+#include <random>
+#include "BVH.h"
+#include "Bench.h"
+#include "Scene.h"
+#include "core/utils/log.h"
+
+namespace raum::bench {
+
+namespace {
+
+constexpr uint32_t OBJECT_COUNTS[] = {1000, 10000, 100000, 1000000};
+
+struct SyntheticScene {
+    std::vector<scene::RenderablePtr> renderables;
+    std::vector<scene::AABB> bounds;
+    // half size of the cube the objects are scattered in
+    float extent{0.0f};
+};
+
+// boxes of 0.5 to 2 units at a constant density of one per 8 cubic units, seeded by count.
+SyntheticScene makeScene(uint32_t count) {
+    SyntheticScene res;
+    res.extent = std::cbrt(static_cast<float>(count) * 8.0f) * 0.5f;
+    std::mt19937 rng(count);
+    std::uniform_real_distribution<float> position(-res.extent, res.extent);
+    std::uniform_real_distribution<float> halfSize(0.25f, 1.0f);
+    res.renderables.reserve(count);
+    res.bounds.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Vec3f center{position(rng), position(rng), position(rng)};
+        Vec3f half{halfSize(rng), halfSize(rng), halfSize(rng)};
+        res.renderables.emplace_back(std::make_shared<scene::Renderable>());
+        res.bounds.emplace_back(scene::AABB{center - half, center + half});
+    }
+    return res;
+}
+
+// placed in the middle of the scene, looking out along evenly spaced directions
+std::vector<std::unique_ptr<scene::Camera>> makeCameras(uint32_t count, float extent) {
+    std::vector<std::unique_ptr<scene::Camera>> res;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& camera = res.emplace_back(std::make_unique<scene::Camera>(scene::PerspectiveFrustum{
+            .fov = {60.0f},
+            .aspect = 16.0f / 9.0f,
+            .near = 0.1f,
+            .far = extent * 2.0f,
+        }));
+        auto angle = 2.0f * std::numbers::pi_v<float> * i / count;
+        auto& eye = camera->eye();
+        eye.setPosition(0.0f, 0.0f, 0.0f);
+        eye.lookAt({std::sin(angle), 0.0f, std::cos(angle)}, {0.0f, 1.0f, 0.0f});
+        camera->update();
+    }
+    return res;
+}
+
+constexpr std::pair<scene::CullKernel, std::string_view> CULL_KERNELS[] = {
+    {scene::CullKernel::SCALAR, "scalar"},
+    {scene::CullKernel::SSE, "sse"},
+    {scene::CullKernel::AVX2, "avx2"},
+};
+
+} // namespace
+
+void registerCullingBenchmarks(Registry& registry) {
+    // the SoA frustum kernel alone, one camera over all boxes
+    for (auto count : OBJECT_COUNTS) {
+        for (const auto& entry : CULL_KERNELS) {
+            auto kernel = entry.first;
+            if (!scene::cullKernelAvailable(kernel)) {
+                continue;
+            }
+            registry.add(fmt::format("kernel/frustum/{}/{}", count, entry.second), [count, kernel](State& state) {
+                auto scene = makeScene(count);
+                scene::BoundsSoA bounds;
+                bounds.resize(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    bounds.set(i, scene.bounds[i]);
+                }
+                auto cameras = makeCameras(1, scene.extent);
+                const auto& planes = cameras.front()->frustumPlanes();
+                std::vector<uint32_t> visible(count);
+                state.setItems(count);
+                while (state.next()) {
+                    scene::frustumCulling(planes, bounds, 0, count, visible.data(), kernel);
+                }
+            });
+        }
+    }
+
+    for (auto count : OBJECT_COUNTS) {
+        registry.add(fmt::format("bvh/build/{}", count), [count](State& state) {
+            auto scene = makeScene(count);
+            graph::BVH bvh;
+            state.setItems(count);
+            while (state.next()) {
+                bvh.build(scene.renderables, scene.bounds);
+            }
+        });
+
+        for (uint32_t cameraCount : {1u, 4u}) {
+            registry.add(fmt::format("bvh/cull/{}/cameras:{}", count, cameraCount), [count, cameraCount](State& state) {
+                auto scene = makeScene(count);
+                graph::BVH bvh;
+                bvh.build(scene.renderables, scene.bounds);
+                auto cameras = makeCameras(cameraCount, scene.extent);
+                std::vector<const scene::Camera*> cameraPtrs;
+                for (const auto& camera : cameras) {
+                    cameraPtrs.emplace_back(camera.get());
+                }
+
+                std::vector<scene::RenderablePtr> visible;
+                std::vector<graph::CameraMask> masks;
+                state.setItems(count);
+                while (state.next()) {
+                    visible.clear();
+                    masks.clear();
+                    bvh.cull(cameraPtrs, visible, masks);
+                }
+            });
+        }
+    }
+}
+
+} // namespace raum::bench
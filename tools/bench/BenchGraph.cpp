@@ -0,0 +1,165 @@
+#include "AccessGraph.h"
+#include "Bench.h"
+#include "RenderGraph.h"
+#include "ResourceGraph.h"
+#include "Serialization.h"
+#include "ShaderGraph.h"
+#include "core/utils/log.h"
+#include "core/utils/utils.h"
+
+namespace raum::bench {
+
+namespace {
+
+constexpr uint32_t PASS_COUNTS[] = {10, 50, 100, 500};
+constexpr uint32_t TARGET_SIZE{1024};
+constexpr std::string_view OUTPUT{"bench/output"};
+
+StringID targetName(uint32_t pass) {
+    return StringID{fmt::format("bench/target{}", pass)};
+}
+
+// a chain where every pass reads the target of the pass before it, every fourth pass runs a compute program
+// and render passes also sample the target three passes back. Only the output is persistent, so nothing is
+// culled and the intermediate targets alias each other.
+void generateGraph(graph::RenderGraph& rg, graph::ResourceGraph& resg, uint32_t passCount) {
+    for (uint32_t i = 0; i < passCount; ++i) {
+        bool last = i + 1 == passCount;
+        auto target = last ? StringID{OUTPUT} : targetName(i);
+        if (!resg.contains(target)) {
+            resg.addImage(target,
+                          rhi::ImageUsage::COLOR_ATTACHMENT | rhi::ImageUsage::SAMPLED | rhi::ImageUsage::STORAGE,
+                          TARGET_SIZE,
+                          TARGET_SIZE,
+                          rhi::Format::RGBA8_UNORM);
+        }
+
+        auto name = fmt::format("pass{}", i);
+        if (i % 4 == 3 && !last) {
+            auto pass = rg.addComputePass(name);
+            pass.setProgramName("bench")
+                .addResource(targetName(i - 1), "input", graph::Access::READ)
+                .addResource(target, "output", graph::Access::WRITE);
+        } else {
+            auto pass = rg.addRenderPass(name);
+            pass.addColor(target, graph::LoadOp::CLEAR, graph::StoreOp::STORE, {0.0, 0.0, 0.0, 1.0});
+            auto queue = pass.addQueue("main");
+            if (i > 0) {
+                queue.addSampledImage(targetName(i - 1), "input");
+            }
+            if (i > 2) {
+                queue.addSampledImage(targetName(i - 3), "history");
+            }
+        }
+    }
+    resg.setResidency(StringID{OUTPUT}, graph::ResourceResidency::PERSISTENT);
+}
+
+struct GraphFixture {
+    explicit GraphFixture(Context& context)
+    : renderGraph(context.device),
+      resourceGraph(context.device.get()),
+      accessGraph(renderGraph, resourceGraph, *context.shaderGraph) {}
+
+    graph::RenderGraph renderGraph;
+    graph::ResourceGraph resourceGraph;
+    graph::AccessGraph accessGraph;
+};
+
+struct LayoutFile {
+    std::filesystem::path dir;
+    std::string name;
+};
+
+// same walk as BuiltinRes::initialize
+std::vector<LayoutFile> collectLayouts(const std::filesystem::path& root) {
+    std::vector<LayoutFile> res;
+    if (!std::filesystem::exists(root)) {
+        return res;
+    }
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        auto filename = entry.path().filename().string();
+        if (entry.is_regular_file() && filename.ends_with(".layout")) {
+            res.emplace_back(entry.path().parent_path(), filename);
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+void registerGraphBenchmarks(Registry& registry, Context& context) {
+    for (auto passCount : PASS_COUNTS) {
+        registry.add(fmt::format("rendergraph/build/{}", passCount), [&context, passCount](State& state) {
+            GraphFixture fixture(context);
+            state.setItems(passCount);
+            while (state.next()) {
+                fixture.renderGraph.clear();
+                generateGraph(fixture.renderGraph, fixture.resourceGraph, passCount);
+            }
+        });
+
+        registry.add(fmt::format("accessgraph/analyze/{}", passCount), [&context, passCount](State& state) {
+            GraphFixture fixture(context);
+            generateGraph(fixture.renderGraph, fixture.resourceGraph, passCount);
+            state.setItems(passCount);
+            while (state.next()) {
+                state.pause();
+                fixture.accessGraph.invalidate();
+                state.resume();
+                fixture.accessGraph.analyze();
+            }
+        });
+
+        // unchanged structure, hashing and carrying resource states over only
+        registry.add(fmt::format("accessgraph/analyze_cached/{}", passCount), [&context, passCount](State& state) {
+            GraphFixture fixture(context);
+            generateGraph(fixture.renderGraph, fixture.resourceGraph, passCount);
+            state.setItems(passCount);
+            while (state.next()) {
+                fixture.accessGraph.analyze();
+            }
+        });
+    }
+
+    registry.add("shadergraph/deserialize/builtin", [&context](State& state) {
+        auto layouts = collectLayouts(utils::resourceDirectory());
+        if (layouts.empty()) {
+            raum_warn("no layouts found in {}", utils::resourceDirectory().string());
+            return;
+        }
+        state.setItems(layouts.size());
+        while (state.next()) {
+            state.pause();
+            graph::ShaderGraph shaderGraph(context.device);
+            state.resume();
+            for (const auto& layout : layouts) {
+                graph::deserialize(layout.dir, layout.name, shaderGraph);
+            }
+            state.pause();
+        }
+    });
+
+    // descriptor set layouts are cached by the device utils, after warm up this measures graph traversal and
+    // cache lookups like a reload of the built-in shaders does.
+    registry.add("shadergraph/compile/builtin", [&context](State& state) {
+        auto layouts = collectLayouts(utils::resourceDirectory());
+        if (layouts.empty()) {
+            raum_warn("no layouts found in {}", utils::resourceDirectory().string());
+            return;
+        }
+        state.setItems(layouts.size());
+        while (state.next()) {
+            state.pause();
+            graph::ShaderGraph shaderGraph(context.device);
+            for (const auto& layout : layouts) {
+                graph::deserialize(layout.dir, layout.name, shaderGraph);
+            }
+            state.resume();
+            shaderGraph.compile("asset");
+            state.pause();
+        }
+    });
+}
+
+} // namespace raum::bench
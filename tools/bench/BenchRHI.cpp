@@ -0,0 +1,95 @@
+#include "BindGroup.h"
+#include "Bench.h"
+#include "RHIBuffer.h"
+#include "RHIStagingBuffer.h"
+#include "RHIUtils.h"
+#include "core/utils/log.h"
+
+namespace raum::bench {
+
+namespace {
+
+constexpr uint32_t STAGING_CHUNK_SIZE{4 << 20};
+constexpr uint32_t STAGING_SIZES[] = {256, 4096, 65536};
+// uploads of a busy frame
+constexpr uint32_t ALLOCATIONS_PER_FRAME{1024};
+// BindGroup tracks up to 16 binding slots
+constexpr uint32_t BINDING_COUNTS[] = {4, 16};
+
+struct BindGroupFixture {
+    BindGroupFixture(uint32_t bindingCount, rhi::DevicePtr device) {
+        rhi::DescriptorSetLayoutInfo info;
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            info.descriptorBindings.emplace_back(i,
+                                                 rhi::DescriptorType::UNIFORM_BUFFER,
+                                                 1,
+                                                 rhi::ShaderStage::VERTEX | rhi::ShaderStage::FRAGMENT,
+                                                 std::vector<rhi::RHISampler*>());
+            names.emplace_back(fmt::format("slot{}", i));
+        }
+        scene::SlotMap slots;
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            slots.emplace(names[i], i);
+        }
+        bindGroup = std::make_shared<scene::BindGroup>(slots, rhi::getOrCreateDescriptorSetLayout(info, device), device);
+        for (auto& buffer : buffers) {
+            buffer = rhi::BufferPtr(device->createBuffer(rhi::BufferInfo{
+                .bufferUsage = rhi::BufferUsage::UNIFORM,
+                .size = 256,
+            }));
+        }
+    }
+
+    // slot map keys point into it
+    std::vector<std::string> names;
+    std::array<rhi::BufferPtr, 2> buffers;
+    scene::BindGroupPtr bindGroup;
+};
+
+} // namespace
+
+void registerRHIBenchmarks(Registry& registry, Context& context) {
+    for (auto size : STAGING_SIZES) {
+        registry.add(fmt::format("staging/allocate/{}", size), [&context, size](State& state) {
+            rhi::RHIStagingBuffer staging(STAGING_CHUNK_SIZE, context.device.get());
+            state.setItems(ALLOCATIONS_PER_FRAME);
+            state.setBytes(static_cast<uint64_t>(size) * ALLOCATIONS_PER_FRAME);
+            while (state.next()) {
+                for (uint32_t i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+                    staging.allocate(size);
+                }
+                staging.reset();
+            }
+        });
+    }
+
+    for (auto bindingCount : BINDING_COUNTS) {
+        // every slot changes, one descriptor write per binding
+        registry.add(fmt::format("bindgroup/update/{}", bindingCount), [&context, bindingCount](State& state) {
+            BindGroupFixture fixture(bindingCount, context.device);
+            state.setItems(bindingCount);
+            uint32_t frame{0};
+            while (state.next()) {
+                const auto& buffer = fixture.buffers[++frame & 1];
+                for (const auto& name : fixture.names) {
+                    fixture.bindGroup->bindBuffer(name, 0, buffer);
+                }
+                fixture.bindGroup->update();
+            }
+        });
+
+        // nothing changes, the dirty checks only
+        registry.add(fmt::format("bindgroup/rebind_same/{}", bindingCount), [&context, bindingCount](State& state) {
+            BindGroupFixture fixture(bindingCount, context.device);
+            state.setItems(bindingCount);
+            while (state.next()) {
+                for (const auto& name : fixture.names) {
+                    fixture.bindGroup->bindBuffer(name, 0, fixture.buffers[0]);
+                }
+                fixture.bindGroup->update();
+            }
+        });
+    }
+}
+
+} // namespace raum::bench
@@ -0,0 +1,184 @@
+#include <charconv>
+#include <ctime>
+#include <thread>
+#include "Bench.h"
+#include "RHIDevice.h"
+#include "RHIManager.h"
+#include "ShaderGraph.h"
+#include "core/utils/log.h"
+#include "core/utils/utils.h"
+
+using namespace raum;
+
+namespace {
+
+struct Options {
+    std::string filter;
+    std::filesystem::path out;
+    std::filesystem::path scene;
+    bench::State::Limits limits;
+    rhi::API api{rhi::API::VULKAN};
+    bool cpuOnly{false};
+    bool list{false};
+};
+
+void printUsage() {
+    fmt::print(
+        "raum_bench [options]\n"
+        "  --filter <text>     run benchmarks whose name contains text\n"
+        "  --out <file.json>   write results as json\n"
+        "  --min-time <ms>     minimum time per benchmark, 500 by default\n"
+        "  --scene <file>      gltf for the cache load benchmark, DamagedHelmet by default\n"
+        "  --api <vulkan|none> device to run on, none records commands without a gpu\n"
+        "  --cpu-only          skip benchmarks that need a device\n"
+        "  --list              print benchmark names and exit\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    options.scene = utils::resourceDirectory() / "models" / "DamagedHelmet" / "DamagedHelmet.gltf";
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.out = argv[++i];
+        } else if (arg == "--scene" && hasValue) {
+            options.scene = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            std::string_view value = argv[++i];
+            uint32_t ms{0};
+            auto [_, ec] = std::from_chars(value.data(), value.data() + value.size(), ms);
+            if (ec != std::errc{}) {
+                return false;
+            }
+            options.limits.minTime = std::chrono::milliseconds{ms};
+        } else if (arg == "--api" && hasValue) {
+            std::string_view value = argv[++i];
+            if (value == "vulkan") {
+                options.api = rhi::API::VULKAN;
+            } else if (value == "none") {
+                options.api = rhi::API::NONE;
+            } else {
+                return false;
+            }
+        } else if (arg == "--cpu-only") {
+            options.cpuOnly = true;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string formatTime(double ns) {
+    if (ns >= 1e6) {
+        return fmt::format("{:.3f} ms", ns / 1e6);
+    }
+    if (ns >= 1e3) {
+        return fmt::format("{:.3f} us", ns / 1e3);
+    }
+    return fmt::format("{:.1f} ns", ns);
+}
+
+std::string formatRate(double perSecond) {
+    if (perSecond >= 1e9) {
+        return fmt::format("{:.2f}G/s", perSecond / 1e9);
+    }
+    if (perSecond >= 1e6) {
+        return fmt::format("{:.2f}M/s", perSecond / 1e6);
+    }
+    if (perSecond >= 1e3) {
+        return fmt::format("{:.2f}k/s", perSecond / 1e3);
+    }
+    return fmt::format("{:.2f}/s", perSecond);
+}
+
+std::string timestamp() {
+    auto now = std::time(nullptr);
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return buf;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    bench::Context context;
+    context.scene = options.scene;
+    if (!options.cpuOnly && !options.list) {
+        context.device = rhi::DevicePtr(rhi::loadRHI(options.api), rhi::unloadRHI);
+        context.shaderGraph = std::make_shared<graph::ShaderGraph>(context.device);
+    }
+
+    bench::Registry registry;
+    bench::registerCullingBenchmarks(registry);
+    if (!options.cpuOnly) {
+        bench::registerGraphBenchmarks(registry, context);
+        bench::registerAssetBenchmarks(registry, context);
+        bench::registerRHIBenchmarks(registry, context);
+    }
+
+    std::vector<bench::Result> results;
+    if (!options.list) {
+        fmt::print("{:<44} {:>10} {:>14} {:>14} {:>14} {:>12}\n", "benchmark", "iterations", "mean", "median", "p95", "items");
+    }
+    for (const auto& benchmark : registry.benchmarks()) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (options.list) {
+            fmt::print("{}\n", benchmark.name);
+            continue;
+        }
+        auto res = bench::run(benchmark, options.limits);
+        if (!res.iterations) {
+            fmt::print("{:<44} {:>10}\n", res.name, "skipped");
+            continue;
+        }
+        fmt::print("{:<44} {:>10} {:>14} {:>14} {:>14} {:>12}\n",
+                   res.name,
+                   res.iterations,
+                   formatTime(res.meanNs),
+                   formatTime(res.medianNs),
+                   formatTime(res.p95Ns),
+                   res.itemsPerSecond > 0.0 ? formatRate(res.itemsPerSecond) : "");
+        results.emplace_back(std::move(res));
+    }
+
+    if (!options.out.empty() && !options.list) {
+        std::vector<std::pair<std::string, std::string>> info{
+            {"date", timestamp()},
+            {"api", options.cpuOnly || options.api == rhi::API::NONE ? "none" : "vulkan"},
+            {"threads", std::to_string(std::thread::hardware_concurrency())},
+#ifdef NDEBUG
+            {"build", "release"},
+#else
+            {"build", "debug"},
+#endif
+        };
+        if (!bench::writeJson(options.out, info, results)) {
+            return 1;
+        }
+    }
+
+    context.shaderGraph.reset();
+    if (context.device) {
+        context.device->waitDeviceIdle();
+    }
+    return 0;
+}
@@ -247,7 +247,6 @@ void processMesh(tinygltf::Mesh& mesh, tinygltf::Model& rawModel) {
         meshRenderer->addTechnique(tech);
         meshRenderer->setVertexInfo(0, meshData.vertexCount, meshData.indexCount);
         meshRenderer->setTransform(sceneNode.node.transform());
-        meshRenderer->setTransformSlot("LocalMat");
 
         auto embededTechSize = static_cast<uint32_t>(scene::EmbededTechnique::COUNT);
         for (size_t i = 0; i < embededTechSize; ++i) {